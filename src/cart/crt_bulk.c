@@ -267,3 +267,524 @@ crt_bulk_abort(crt_context_t crt_ctx, crt_bulk_opid_t opid)
 {
 	return HG_Bulk_cancel(opid);
 }
+
+/*
+ * Bulk registration cache.
+ *
+ * Creating a bulk handle registers the memory with the network provider, which
+ * is expensive for large buffers. Clients which keep doing I/O from the same
+ * buffers can reuse the handle instead. Each cached handle holds one reference
+ * of the HG bulk handle, every user takes another one, so a handle evicted
+ * while in use stays valid until its last user frees it.
+ *
+ * Handles are keyed by address, which says nothing about the memory behind it
+ * once a buffer is freed and the address reused. So only buffers within a
+ * region registered by crt_bulk_cache_register() are cached, their owner
+ * promises to call crt_bulk_cache_deregister() before releasing the memory,
+ * which drops the handles of the region from all contexts. Other buffers are
+ * registered for every transfer as without the cache.
+ */
+
+/** Buffer registered for caching, linked on crt_gdata::cg_bulk_regions */
+struct crt_bulk_region {
+	d_list_t	br_link;
+	uint64_t	br_addr;
+	uint64_t	br_len;
+};
+
+struct crt_bulk_cache_entry {
+	/** link in crt_bulk_cache::bc_htable */
+	d_list_t	 bce_hlink;
+	/** link in crt_bulk_cache::bc_lru */
+	d_list_t	 bce_lru;
+	crt_bulk_t	 bce_bulk;
+	bool		 bce_bound;
+	unsigned int	 bce_ksize;
+	/** bulk permission followed by the address and length of each iov */
+	uint64_t	 bce_key[0];
+};
+
+static inline struct crt_bulk_cache_entry *
+bce_link2ptr(d_list_t *rlink)
+{
+	return container_of(rlink, struct crt_bulk_cache_entry, bce_hlink);
+}
+
+static bool
+bce_key_cmp(struct d_hash_table *htable, d_list_t *rlink,
+	    const void *key, unsigned int ksize)
+{
+	struct crt_bulk_cache_entry *bce = bce_link2ptr(rlink);
+
+	return bce->bce_ksize == ksize && memcmp(bce->bce_key, key, ksize) == 0;
+}
+
+static uint32_t
+bce_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	return (uint32_t)d_hash_murmur64(key, ksize, 5731);
+}
+
+static uint32_t
+bce_rec_hash(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct crt_bulk_cache_entry *bce = bce_link2ptr(rlink);
+
+	return bce_key_hash(htable, bce->bce_key, bce->bce_ksize);
+}
+
+static d_hash_table_ops_t bulk_cache_ops = {
+	.hop_key_cmp	= bce_key_cmp,
+	.hop_key_hash	= bce_key_hash,
+	.hop_rec_hash	= bce_rec_hash,
+};
+
+int
+crt_bulk_cache_init(struct crt_context *ctx)
+{
+	struct crt_bulk_cache	*bc = &ctx->cc_bulk_cache;
+	int			 rc;
+
+	D_INIT_LIST_HEAD(&bc->bc_lru);
+	bc->bc_max = crt_gdata.cg_bulk_cache_size;
+	if (bc->bc_max == 0)
+		return 0;
+
+	rc = D_MUTEX_INIT(&bc->bc_mutex, NULL);
+	if (rc != 0)
+		return rc;
+
+	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, CRT_BULK_CACHE_BITS,
+					 NULL, &bulk_cache_ops,
+					 &bc->bc_htable);
+	if (rc != 0) {
+		D_ERROR("d_hash_table_create() failed, "DF_RC"\n", DP_RC(rc));
+		D_MUTEX_DESTROY(&bc->bc_mutex);
+		bc->bc_max = 0;
+	}
+
+	return rc;
+}
+
+/* Remove \a bce from the cache and drop the cache reference, lock held */
+static void
+bce_delete(struct crt_bulk_cache *bc, struct crt_bulk_cache_entry *bce)
+{
+	bool deleted;
+
+	deleted = d_hash_rec_delete_at(&bc->bc_htable, &bce->bce_hlink);
+	D_ASSERT(deleted);
+	d_list_del(&bce->bce_lru);
+	bc->bc_nr--;
+
+	crt_bulk_free(bce->bce_bulk);
+	D_FREE(bce);
+}
+
+void
+crt_bulk_cache_fini(struct crt_context *ctx)
+{
+	struct crt_bulk_cache		*bc = &ctx->cc_bulk_cache;
+	struct crt_bulk_cache_entry	*bce;
+	struct crt_bulk_cache_entry	*tmp;
+	struct crt_bulk_cache_stats	*stats = &bc->bc_stats;
+	uint64_t			 lookups;
+
+	if (bc->bc_max == 0)
+		return;
+
+	/* still on the context list, hide it from deregister and stats */
+	D_RWLOCK_WRLOCK(&crt_gdata.cg_rwlock);
+	bc->bc_max = 0;
+	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
+
+	lookups = stats->bcs_hits + stats->bcs_misses + stats->bcs_bypasses;
+	D_INFO("ctx %d bulk cache: "DF_U64"%% hit rate, "DF_U64" hits, "DF_U64
+	       " misses, "DF_U64" bypasses, "DF_U64" evictions, "DF_U64
+	       " invalidations\n", ctx->cc_idx,
+	       lookups == 0 ? 0 : stats->bcs_hits * 100 / lookups,
+	       stats->bcs_hits, stats->bcs_misses, stats->bcs_bypasses,
+	       stats->bcs_evictions, stats->bcs_invalidations);
+
+	D_MUTEX_LOCK(&bc->bc_mutex);
+	d_list_for_each_entry_safe(bce, tmp, &bc->bc_lru, bce_lru)
+		bce_delete(bc, bce);
+	D_MUTEX_UNLOCK(&bc->bc_mutex);
+
+	d_hash_table_destroy_inplace(&bc->bc_htable, true /* force */);
+	D_MUTEX_DESTROY(&bc->bc_mutex);
+}
+
+/* Is every iov of \a sgl within a registered region, region mutex held */
+static bool
+bulk_region_covered_locked(d_sg_list_t *sgl)
+{
+	struct crt_bulk_region	*br;
+	uint64_t		 addr;
+	uint64_t		 len;
+	int			 i;
+
+	for (i = 0; i < sgl->sg_nr; i++) {
+		addr = (uint64_t)sgl->sg_iovs[i].iov_buf;
+		len = sgl->sg_iovs[i].iov_buf_len;
+
+		d_list_for_each_entry(br, &crt_gdata.cg_bulk_regions, br_link) {
+			if (addr >= br->br_addr &&
+			    addr + len <= br->br_addr + br->br_len)
+				break;
+		}
+		if (&br->br_link == &crt_gdata.cg_bulk_regions)
+			return false;
+	}
+	return true;
+}
+
+static bool
+bulk_region_covered(d_sg_list_t *sgl)
+{
+	bool covered;
+
+	D_MUTEX_LOCK(&crt_gdata.cg_bulk_region_mutex);
+	covered = bulk_region_covered_locked(sgl);
+	D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+
+	return covered;
+}
+
+int
+crt_bulk_create_cached(crt_context_t crt_ctx, d_sg_list_t *sgl,
+		       crt_bulk_perm_t bulk_perm, bool bind,
+		       crt_bulk_t *bulk_hdl)
+{
+	struct crt_context		*ctx = crt_ctx;
+	struct crt_bulk_cache		*bc;
+	struct crt_bulk_cache_entry	*bce;
+	d_list_t			*rlink;
+	uint64_t			 key[1 + 2 * CRT_BULK_CACHE_IOV_MAX];
+	unsigned int			 ksize;
+	int				 i;
+	int				 rc;
+
+	if (ctx == CRT_CONTEXT_NULL || !crt_sgl_valid(sgl) ||
+	    bulk_hdl == NULL) {
+		D_ERROR("invalid parameter, crt_ctx: %p, crt_sgl_valid: %d, "
+			"bulk_hdl: %p.\n", crt_ctx, crt_sgl_valid(sgl),
+			bulk_hdl);
+		return -DER_INVAL;
+	}
+
+	bc = &ctx->cc_bulk_cache;
+	if (bc->bc_max == 0)
+		goto create;
+
+	if (sgl->sg_nr > CRT_BULK_CACHE_IOV_MAX || !bulk_region_covered(sgl)) {
+		D_MUTEX_LOCK(&bc->bc_mutex);
+		bc->bc_stats.bcs_bypasses++;
+		D_MUTEX_UNLOCK(&bc->bc_mutex);
+		goto create;
+	}
+
+	key[0] = bulk_perm;
+	for (i = 0; i < sgl->sg_nr; i++) {
+		key[1 + 2 * i] = (uint64_t)sgl->sg_iovs[i].iov_buf;
+		key[2 + 2 * i] = sgl->sg_iovs[i].iov_buf_len;
+	}
+	ksize = sizeof(key[0]) * (1 + 2 * sgl->sg_nr);
+
+	D_MUTEX_LOCK(&bc->bc_mutex);
+	rlink = d_hash_rec_find(&bc->bc_htable, key, ksize);
+	if (rlink != NULL) {
+		bce = bce_link2ptr(rlink);
+		d_list_move(&bce->bce_lru, &bc->bc_lru);
+		rc = crt_bulk_addref(bce->bce_bulk);
+		if (rc == 0 && bind && !bce->bce_bound) {
+			rc = crt_bulk_bind(bce->bce_bulk, crt_ctx);
+			if (rc == 0)
+				bce->bce_bound = true;
+			else
+				crt_bulk_free(bce->bce_bulk);
+		}
+		if (rc == 0) {
+			*bulk_hdl = bce->bce_bulk;
+			bc->bc_stats.bcs_hits++;
+		}
+		D_MUTEX_UNLOCK(&bc->bc_mutex);
+		return rc;
+	}
+	D_MUTEX_UNLOCK(&bc->bc_mutex);
+
+	D_ALLOC(bce, sizeof(*bce) + ksize);
+	if (bce == NULL)
+		return -DER_NOMEM;
+
+	rc = crt_bulk_create(crt_ctx, sgl, bulk_perm, &bce->bce_bulk);
+	if (rc != 0)
+		goto free_bce;
+	if (bind) {
+		rc = crt_bulk_bind(bce->bce_bulk, crt_ctx);
+		if (rc != 0)
+			goto free_bulk;
+		bce->bce_bound = true;
+	}
+	/* one reference for the cache, one for the caller */
+	rc = crt_bulk_addref(bce->bce_bulk);
+	if (rc != 0)
+		goto free_bulk;
+
+	bce->bce_ksize = ksize;
+	memcpy(bce->bce_key, key, ksize);
+
+	/*
+	 * Check the regions again under the lock, crt_bulk_cache_deregister()
+	 * may have dropped them since, and its invalidation would miss this.
+	 */
+	D_MUTEX_LOCK(&crt_gdata.cg_bulk_region_mutex);
+	D_MUTEX_LOCK(&bc->bc_mutex);
+	if (!bulk_region_covered_locked(sgl)) {
+		/* deregistered meanwhile, the caller owns the only handle */
+		bc->bc_stats.bcs_bypasses++;
+		rc = -DER_NONEXIST;
+	} else {
+		/* fails if another thread cached the same buffers meanwhile */
+		rc = d_hash_rec_insert(&bc->bc_htable, key, ksize,
+				       &bce->bce_hlink, true /* exclusive */);
+	}
+	if (rc == 0) {
+		d_list_add(&bce->bce_lru, &bc->bc_lru);
+		bc->bc_nr++;
+		bc->bc_stats.bcs_misses++;
+		while (bc->bc_nr > bc->bc_max) {
+			bce_delete(bc, d_list_entry(bc->bc_lru.prev,
+						    struct crt_bulk_cache_entry,
+						    bce_lru));
+			bc->bc_stats.bcs_evictions++;
+		}
+	}
+	D_MUTEX_UNLOCK(&bc->bc_mutex);
+	D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+
+	*bulk_hdl = bce->bce_bulk;
+	if (rc == 0)
+		return 0;
+
+	/* keep the first handle cached (if any), the caller owns this one */
+	crt_bulk_free(bce->bce_bulk);
+	D_FREE(bce);
+	return 0;
+
+free_bulk:
+	crt_bulk_free(bce->bce_bulk);
+free_bce:
+	D_FREE(bce);
+	return rc;
+
+create:
+	rc = crt_bulk_create(crt_ctx, sgl, bulk_perm, bulk_hdl);
+	if (rc != 0 || !bind)
+		return rc;
+
+	rc = crt_bulk_bind(*bulk_hdl, crt_ctx);
+	if (rc != 0)
+		crt_bulk_free(*bulk_hdl);
+	return rc;
+}
+
+/* Does any iov of \a bce overlap with [start, end) */
+static bool
+bce_overlap(struct crt_bulk_cache_entry *bce, uint64_t start, uint64_t end)
+{
+	uint64_t	addr;
+	uint64_t	len;
+	int		i;
+
+	for (i = 1; i < bce->bce_ksize / sizeof(bce->bce_key[0]); i += 2) {
+		addr = bce->bce_key[i];
+		len = bce->bce_key[i + 1];
+		if (addr < end && start < addr + len)
+			return true;
+	}
+	return false;
+}
+
+/* Drop the cached handles overlapping with [start, start + len) */
+static void
+bulk_cache_invalidate(struct crt_bulk_cache *bc, uint64_t start, size_t len)
+{
+	struct crt_bulk_cache_entry	*bce;
+	struct crt_bulk_cache_entry	*tmp;
+
+	if (bc->bc_max == 0)
+		return;
+
+	D_MUTEX_LOCK(&bc->bc_mutex);
+	d_list_for_each_entry_safe(bce, tmp, &bc->bc_lru, bce_lru) {
+		if (len != 0 && !bce_overlap(bce, start, start + len))
+			continue;
+		bce_delete(bc, bce);
+		bc->bc_stats.bcs_invalidations++;
+	}
+	D_MUTEX_UNLOCK(&bc->bc_mutex);
+}
+
+int
+crt_bulk_cache_invalidate(crt_context_t crt_ctx, void *addr, size_t len)
+{
+	struct crt_context *ctx = crt_ctx;
+
+	if (ctx == CRT_CONTEXT_NULL) {
+		D_ERROR("invalid parameter, NULL crt_ctx.\n");
+		return -DER_INVAL;
+	}
+
+	bulk_cache_invalidate(&ctx->cc_bulk_cache, (uint64_t)addr, len);
+	return 0;
+}
+
+int
+crt_bulk_cache_register(void *addr, size_t len)
+{
+	struct crt_bulk_region	*br;
+	uint64_t		 start = (uint64_t)addr;
+	int			 rc = 0;
+
+	if (addr == NULL || len == 0) {
+		D_ERROR("invalid parameter, addr: %p, len: %zu.\n", addr, len);
+		return -DER_INVAL;
+	}
+
+	D_MUTEX_LOCK(&crt_gdata.cg_bulk_region_mutex);
+	d_list_for_each_entry(br, &crt_gdata.cg_bulk_regions, br_link) {
+		if (start < br->br_addr + br->br_len &&
+		    br->br_addr < start + len) {
+			D_ERROR("region %p/%zu overlaps with "DF_X64"/"DF_U64
+				"\n", addr, len, br->br_addr, br->br_len);
+			D_GOTO(out, rc = -DER_EXIST);
+		}
+	}
+
+	D_ALLOC_PTR(br);
+	if (br == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	br->br_addr = start;
+	br->br_len = len;
+	d_list_add(&br->br_link, &crt_gdata.cg_bulk_regions);
+out:
+	D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+	return rc;
+}
+
+int
+crt_bulk_cache_deregister(void *addr, size_t len)
+{
+	struct crt_bulk_region	*br;
+	struct crt_context	*ctx;
+	d_list_t		*ctx_list;
+	uint64_t		 start = (uint64_t)addr;
+	int			 i;
+
+	D_MUTEX_LOCK(&crt_gdata.cg_bulk_region_mutex);
+	d_list_for_each_entry(br, &crt_gdata.cg_bulk_regions, br_link) {
+		if (br->br_addr == start && br->br_len == len)
+			break;
+	}
+	if (&br->br_link == &crt_gdata.cg_bulk_regions) {
+		D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+		D_ERROR("region %p/%zu is not registered\n", addr, len);
+		return -DER_NONEXIST;
+	}
+	d_list_del(&br->br_link);
+	D_FREE(br);
+
+	/* the buffer may be used with any context, drop it from all of them */
+	D_RWLOCK_RDLOCK(&crt_gdata.cg_rwlock);
+	if (crt_gdata.cg_inited) {
+		ctx_list = crt_provider_get_ctx_list(true,
+						     crt_gdata.cg_primary_prov);
+		d_list_for_each_entry(ctx, ctx_list, cc_link)
+			bulk_cache_invalidate(&ctx->cc_bulk_cache, start, len);
+
+		for (i = 0; i < crt_gdata.cg_num_secondary_provs; i++) {
+			ctx_list = crt_provider_get_ctx_list(false,
+					crt_gdata.cg_secondary_provs[i]);
+			d_list_for_each_entry(ctx, ctx_list, cc_link)
+				bulk_cache_invalidate(&ctx->cc_bulk_cache,
+						      start, len);
+		}
+	}
+	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
+	D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+
+	return 0;
+}
+
+void
+crt_bulk_region_fini(void)
+{
+	struct crt_bulk_region	*br;
+	struct crt_bulk_region	*tmp;
+
+	D_MUTEX_LOCK(&crt_gdata.cg_bulk_region_mutex);
+	d_list_for_each_entry_safe(br, tmp, &crt_gdata.cg_bulk_regions,
+				   br_link) {
+		d_list_del(&br->br_link);
+		D_FREE(br);
+	}
+	D_MUTEX_UNLOCK(&crt_gdata.cg_bulk_region_mutex);
+}
+
+static void
+bulk_cache_stats_add(struct crt_bulk_cache *bc,
+		     struct crt_bulk_cache_stats *stats)
+{
+	if (bc->bc_max == 0)
+		return;
+
+	D_MUTEX_LOCK(&bc->bc_mutex);
+	stats->bcs_hits += bc->bc_stats.bcs_hits;
+	stats->bcs_misses += bc->bc_stats.bcs_misses;
+	stats->bcs_bypasses += bc->bc_stats.bcs_bypasses;
+	stats->bcs_evictions += bc->bc_stats.bcs_evictions;
+	stats->bcs_invalidations += bc->bc_stats.bcs_invalidations;
+	D_MUTEX_UNLOCK(&bc->bc_mutex);
+}
+
+int
+crt_bulk_cache_stats_get(crt_context_t crt_ctx,
+			 struct crt_bulk_cache_stats *stats)
+{
+	struct crt_context	*ctx = crt_ctx;
+	d_list_t		*ctx_list;
+	int			 i;
+
+	if (stats == NULL) {
+		D_ERROR("invalid parameter, NULL stats.\n");
+		return -DER_INVAL;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	if (ctx != CRT_CONTEXT_NULL) {
+		bulk_cache_stats_add(&ctx->cc_bulk_cache, stats);
+		return 0;
+	}
+
+	/* sum of all contexts */
+	D_RWLOCK_RDLOCK(&crt_gdata.cg_rwlock);
+	if (crt_gdata.cg_inited) {
+		ctx_list = crt_provider_get_ctx_list(true,
+						     crt_gdata.cg_primary_prov);
+		d_list_for_each_entry(ctx, ctx_list, cc_link)
+			bulk_cache_stats_add(&ctx->cc_bulk_cache, stats);
+
+		for (i = 0; i < crt_gdata.cg_num_secondary_provs; i++) {
+			ctx_list = crt_provider_get_ctx_list(false,
+					crt_gdata.cg_secondary_provs[i]);
+			d_list_for_each_entry(ctx, ctx_list, cc_link)
+				bulk_cache_stats_add(&ctx->cc_bulk_cache,
+						     stats);
+		}
+	}
+	D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
+
+	return 0;
+}
@@ -162,8 +162,16 @@ crt_context_init(crt_context_t crt_ctx)
 		D_GOTO(out_binheap_destroy, rc);
 	}
 
+	rc = crt_bulk_cache_init(ctx);
+	if (rc != 0) {
+		D_ERROR("crt_bulk_cache_init() failed, " DF_RC "\n", DP_RC(rc));
+		D_GOTO(out_epi_table_destroy, rc);
+	}
+
 	D_GOTO(out, rc);
 
+out_epi_table_destroy:
+	d_hash_table_destroy_inplace(&ctx->cc_epi_table, true /* force */);
 out_binheap_destroy:
 	d_binheap_destroy_inplace(&ctx->cc_bh_timeout);
 out_mutex_destroy:
@@ -735,6 +743,9 @@ crt_context_destroy(crt_context_t crt_ctx, int force)
 
 	provider = ctx->cc_hg_ctx.chc_provider;
 
+	/* cached bulk handles must be released before the HG class */
+	crt_bulk_cache_fini(ctx);
+
 	rc = crt_hg_ctx_fini(&ctx->cc_hg_ctx);
 	if (rc) {
 		D_ERROR("crt_hg_ctx_fini failed() rc: " DF_RC "\n", DP_RC(rc));
@@ -442,13 +442,16 @@ grp_li_uri_set(struct crt_lookup_item *li, int tag, const char *uri)
 			D_FREE(ui);
 			D_GOTO(exit, rc);
 		}
+		atomic_fetch_add(&grp_priv->gp_uri_cache_gen, 1);
 	} else {
 		ui = crt_ui_link2ptr(rlink);
 		if (ui->ui_uri[tag] == NULL) {
 			D_STRNDUP(uri_dup, uri, CRT_ADDR_STR_MAX_LEN);
 			if (uri_dup) {
-				if (!atomic_compare_exchange(&ui->ui_uri[tag],
-							     nul_str, uri_dup))
+				if (atomic_compare_exchange(&ui->ui_uri[tag],
+							    nul_str, uri_dup))
+					atomic_fetch_add(&grp_priv->gp_uri_cache_gen, 1);
+				else
 					D_FREE(uri_dup);
 			} else {
 				rc = -DER_NOMEM;
@@ -1637,6 +1640,112 @@ out:
 	D_FREE(tmp_uri);
 }
 
+/*
+ * Reply with the URIs (every tag) this server knows for the ranks in
+ * [ubl_rank_start, ubl_rank_start + ubl_rank_nr). Only the primary group is
+ * supported. At most CRT_URI_BULK_LOOKUP_MAX URIs and as many ranks are
+ * returned per reply, the caller resumes from ubl_rank_next. The group lock is
+ * held until the reply has been packed as the reply references the cached URI
+ * strings directly.
+ */
+void
+crt_hdlr_uri_bulk_lookup(crt_rpc_t *rpc_req)
+{
+	struct crt_uri_bulk_lookup_in	*ubl_in;
+	struct crt_uri_bulk_lookup_out	*ubl_out;
+	struct crt_grp_priv		*grp_priv;
+	struct crt_grp_cache		*uris = NULL;
+	struct crt_uri_item		*ui;
+	d_list_t			*rlink;
+	crt_phy_addr_t			 uri;
+	d_rank_t			 rank;
+	uint32_t			 rank_nr;
+	uint32_t			 uri_nr = 0;
+	uint32_t			 nr;
+	uint32_t			 off;
+	uint32_t			 i;
+	bool				 locked = false;
+	int				 rc = 0;
+
+	ubl_in = crt_req_get(rpc_req);
+	ubl_out = crt_reply_get(rpc_req);
+	ubl_out->ubl_rank_next = CRT_NO_RANK;
+
+	if (!crt_is_service()) {
+		D_ERROR("crt_hdlr_uri_bulk_lookup invalid on client.\n");
+		D_GOTO(out, rc = -DER_PROTO);
+	}
+
+	grp_priv = crt_gdata.cg_grp->gg_primary_grp;
+	if (!crt_grp_id_identical(ubl_in->ubl_grp_id,
+				  grp_priv->gp_pub.cg_grpid)) {
+		D_ERROR("Bulk URI lookup only supported on the primary group, "
+			"not %s\n", ubl_in->ubl_grp_id);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	locked = true;
+	ubl_out->ubl_version = grp_priv->gp_membs_ver;
+
+	/* Do not wrap around the rank space */
+	rank_nr = min(ubl_in->ubl_rank_nr, CRT_NO_RANK - ubl_in->ubl_rank_start);
+	if (rank_nr == 0)
+		D_GOTO(out, rc = 0);
+
+	D_ALLOC_ARRAY(uris, CRT_URI_BULK_LOOKUP_MAX);
+	if (uris == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (off = 0; off < rank_nr && off < CRT_URI_BULK_LOOKUP_MAX; off++) {
+		rank = ubl_in->ubl_rank_start + off;
+		rlink = d_hash_rec_find(&grp_priv->gp_uri_lookup_cache,
+					(void *)&rank, sizeof(rank));
+		if (rlink == NULL)
+			continue;
+
+		ui = crt_ui_link2ptr(rlink);
+		for (i = 0, nr = 0; i < CRT_SRV_CONTEXT_NUM; i++)
+			if (atomic_load_relaxed(&ui->ui_uri[i]) != NULL)
+				nr++;
+
+		/* Never split the URIs of a rank over two replies */
+		if (uri_nr + nr > CRT_URI_BULK_LOOKUP_MAX) {
+			d_hash_rec_decref(&grp_priv->gp_uri_lookup_cache, rlink);
+			break;
+		}
+
+		for (i = 0; i < CRT_SRV_CONTEXT_NUM; i++) {
+			uri = atomic_load_relaxed(&ui->ui_uri[i]);
+			/* Tags may be filled in concurrently, stay in bounds */
+			if (uri == NULL || uri_nr == CRT_URI_BULK_LOOKUP_MAX)
+				continue;
+
+			uris[uri_nr].gc_rank = rank;
+			uris[uri_nr].gc_tag = i;
+			uris[uri_nr].gc_uri = uri;
+			uri_nr++;
+		}
+		d_hash_rec_decref(&grp_priv->gp_uri_lookup_cache, rlink);
+	}
+
+	if (off < rank_nr)
+		ubl_out->ubl_rank_next = ubl_in->ubl_rank_start + off;
+
+	ubl_out->ubl_uris.ca_arrays = uris;
+	ubl_out->ubl_uris.ca_count = uri_nr;
+
+out:
+	ubl_out->ubl_rc = rc;
+	rc = crt_reply_send(rpc_req);
+	if (rc != 0)
+		D_ERROR("crt_reply_send failed, rc: %d, opc: %#x.\n",
+			rc, rpc_req->cr_opc);
+	if (locked)
+		D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+	D_FREE(uris);
+}
+
 int
 crt_group_attach(crt_group_id_t srv_grpid, crt_group_t **attached_grp)
 {
@@ -2072,6 +2181,453 @@ out:
 	return rc;
 }
 
+struct crt_uri_prefetch_cb_arg {
+	struct crt_grp_priv	*upa_grp_priv;
+	/* end of the requested rank range, exclusive */
+	uint64_t		 upa_rank_end;
+	uint32_t		 upa_nr_inserted;
+	crt_cb_t		 upa_comp_cb;
+	void			*upa_arg;
+};
+
+static bool
+crt_grp_rank_is_member(struct crt_grp_priv *grp_priv, d_rank_t rank)
+{
+	bool found;
+
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	found = d_rank_in_rank_list(grp_priv_get_membs(grp_priv), rank);
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+
+	return found;
+}
+
+static void
+uri_prefetch_cb(const struct crt_cb_info *cb_info);
+
+/*
+ * Ask \a contact_rank for the URIs of [rank_start, upa_rank_end). The
+ * callback owns \a upa once the request has been created, it is invoked even
+ * if sending fails.
+ */
+static int
+uri_prefetch_send(crt_context_t ctx, d_rank_t contact_rank,
+		  struct crt_uri_prefetch_cb_arg *upa, d_rank_t rank_start)
+{
+	struct crt_uri_bulk_lookup_in	*ubl_in;
+	crt_endpoint_t			 ep;
+	crt_rpc_t			*rpc;
+	int				 rc;
+
+	ep.ep_grp = &upa->upa_grp_priv->gp_pub;
+	ep.ep_rank = contact_rank;
+	ep.ep_tag = 0;
+
+	rc = crt_req_create(ctx, &ep, CRT_OPC_URI_BULK_LOOKUP, &rpc);
+	if (rc != 0) {
+		D_ERROR("crt_req_create() failed, "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+
+	ubl_in = crt_req_get(rpc);
+	ubl_in->ubl_grp_id = upa->upa_grp_priv->gp_pub.cg_grpid;
+	ubl_in->ubl_rank_start = rank_start;
+	ubl_in->ubl_rank_nr = upa->upa_rank_end - rank_start;
+
+	crt_req_send(rpc, uri_prefetch_cb, upa);
+	return 0;
+}
+
+static void
+uri_prefetch_cb(const struct crt_cb_info *cb_info)
+{
+	struct crt_uri_prefetch_cb_arg	*upa = cb_info->cci_arg;
+	struct crt_uri_bulk_lookup_in	*ubl_in;
+	struct crt_uri_bulk_lookup_out	*ubl_out;
+	struct crt_grp_priv		*grp_priv = upa->upa_grp_priv;
+	struct crt_grp_cache		*uris;
+	struct crt_cb_info		 comp_info;
+	uint32_t			 version;
+	int				 i;
+	int				 rc;
+
+	rc = cb_info->cci_rc;
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	ubl_in = crt_req_get(cb_info->cci_rpc);
+	ubl_out = crt_reply_get(cb_info->cci_rpc);
+	rc = ubl_out->ubl_rc;
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	/* A peer behind our view of the membership may hand out stale URIs */
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	version = grp_priv->gp_membs_ver;
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+	if (ubl_out->ubl_version < version) {
+		D_DEBUG(DB_TRACE, "rank %u has group version %u, local %u\n",
+			cb_info->cci_rpc->cr_ep.ep_rank, ubl_out->ubl_version,
+			version);
+		D_GOTO(out, rc = -DER_STALE);
+	}
+
+	uris = ubl_out->ubl_uris.ca_arrays;
+	for (i = 0; i < ubl_out->ubl_uris.ca_count; i++) {
+		/* Never let a peer add ranks the group does not know about */
+		if (!crt_grp_rank_is_member(grp_priv, uris[i].gc_rank))
+			continue;
+
+		rc = crt_grp_lc_uri_insert(grp_priv, uris[i].gc_rank,
+					   uris[i].gc_tag, uris[i].gc_uri);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		upa->upa_nr_inserted++;
+	}
+
+	/* Fetch the rest of the range, the next rank must make progress */
+	if (ubl_out->ubl_rank_next != CRT_NO_RANK) {
+		if (ubl_out->ubl_rank_next <= ubl_in->ubl_rank_start ||
+		    ubl_out->ubl_rank_next >= upa->upa_rank_end) {
+			D_ERROR("invalid next rank %u for range [%u, "DF_U64")\n",
+				ubl_out->ubl_rank_next, ubl_in->ubl_rank_start,
+				upa->upa_rank_end);
+			D_GOTO(out, rc = -DER_PROTO);
+		}
+
+		rc = uri_prefetch_send(cb_info->cci_rpc->cr_ctx,
+				       cb_info->cci_rpc->cr_ep.ep_rank, upa,
+				       ubl_out->ubl_rank_next);
+		if (rc == 0)
+			return;
+		D_GOTO(out, rc);
+	}
+
+	D_DEBUG(DB_TRACE, "prefetched %u URIs for group %s\n",
+		upa->upa_nr_inserted, grp_priv->gp_pub.cg_grpid);
+
+out:
+	if (rc != 0)
+		D_DEBUG(DB_TRACE, "URI prefetch failed after %u URIs, "DF_RC"\n",
+			upa->upa_nr_inserted, DP_RC(rc));
+
+	if (upa->upa_comp_cb != NULL) {
+		comp_info.cci_rpc = cb_info->cci_rpc;
+		comp_info.cci_arg = upa->upa_arg;
+		comp_info.cci_rc = rc;
+		upa->upa_comp_cb(&comp_info);
+	}
+
+	crt_grp_priv_decref(grp_priv);
+	D_FREE(upa);
+}
+
+int
+crt_group_uri_prefetch(crt_context_t ctx, crt_group_t *grp,
+		       d_rank_t contact_rank, d_rank_t rank_start,
+		       uint32_t rank_nr, crt_cb_t complete_cb, void *arg)
+{
+	struct crt_grp_priv		*grp_priv;
+	struct crt_uri_prefetch_cb_arg	*upa = NULL;
+	int				 rc;
+
+	if (ctx == CRT_CONTEXT_NULL || rank_nr == 0 ||
+	    (uint64_t)rank_start + rank_nr > CRT_NO_RANK) {
+		D_ERROR("invalid parameter, ctx %p, ranks [%u, +%u)\n",
+			ctx, rank_start, rank_nr);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	grp_priv = crt_grp_pub2priv(grp);
+	if (!grp_priv->gp_primary) {
+		D_ERROR("Only available for primary groups\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	D_ALLOC_PTR(upa);
+	if (upa == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	crt_grp_priv_addref(grp_priv);
+	upa->upa_grp_priv = grp_priv;
+	upa->upa_rank_end = (uint64_t)rank_start + rank_nr;
+	upa->upa_comp_cb = complete_cb;
+	upa->upa_arg = arg;
+
+	rc = uri_prefetch_send(ctx, contact_rank, upa, rank_start);
+	if (rc != 0) {
+		crt_grp_priv_decref(grp_priv);
+		D_GOTO(out, rc);
+	}
+
+	return 0;
+
+out:
+	D_FREE(upa);
+	return rc;
+}
+
+/* Header of the URI cache file, bump the format on incompatible changes */
+#define CRT_URI_CACHE_MAGIC	"crt_uri_cache"
+#define CRT_URI_CACHE_FORMAT	2
+
+struct crt_uri_cache_save_arg {
+	FILE	*usa_fp;
+	int	 usa_rc;
+};
+
+static int
+crt_uri_cache_save_cb(d_list_t *rlink, void *arg)
+{
+	struct crt_uri_cache_save_arg	*usa = arg;
+	struct crt_uri_item		*ui;
+	crt_phy_addr_t			 uri;
+	int				 i;
+
+	ui = crt_ui_link2ptr(rlink);
+	for (i = 0; i < CRT_SRV_CONTEXT_NUM; i++) {
+		uri = atomic_load_relaxed(&ui->ui_uri[i]);
+		if (uri == NULL)
+			continue;
+
+		if (fprintf(usa->usa_fp, "%u %d %zu %s\n", ui->ui_rank, i,
+			    strlen(uri), uri) < 0) {
+			usa->usa_rc = d_errno2der(errno);
+			return usa->usa_rc;
+		}
+	}
+
+	return 0;
+}
+
+static int
+crt_uri_cache_count_cb(d_list_t *rlink, void *arg)
+{
+	struct crt_uri_item	*ui = crt_ui_link2ptr(rlink);
+	uint32_t		*nr = arg;
+	int			 i;
+
+	for (i = 0; i < CRT_SRV_CONTEXT_NUM; i++)
+		if (atomic_load_relaxed(&ui->ui_uri[i]) != NULL)
+			(*nr)++;
+
+	return 0;
+}
+
+/*
+ * Persist the URI lookup cache of a primary group to \a path.
+ * The format of the file is:
+ * line 1: crt_uri_cache <format> <version>
+ * line 2 ~ N: <rank> <tag> <uri length> <uri>
+ *
+ * URIs are stored verbatim behind their length so any character is allowed.
+ * Nothing is written if the cache did not change since it was last loaded from
+ * or saved to a file, a group is expected to use a single cache file. Otherwise
+ * the file is written to a temporary file first, synced and renamed into place
+ * so a concurrent reader or a crash never leaves a partial cache behind.
+ */
+int
+crt_group_uri_cache_save(crt_group_t *grp, const char *path, uint64_t version)
+{
+	struct crt_grp_priv		*grp_priv;
+	struct crt_uri_cache_save_arg	 usa = {0};
+	char				*tmp_name = NULL;
+	mode_t				 old_mode;
+	uint32_t			 gen;
+	bool				 synced;
+	int				 fd;
+	int				 rc;
+
+	if (path == NULL) {
+		D_ERROR("path can't be NULL.\n");
+		return -DER_INVAL;
+	}
+
+	grp_priv = crt_grp_pub2priv(grp);
+	if (!grp_priv->gp_primary) {
+		D_ERROR("Only available for primary groups\n");
+		return -DER_INVAL;
+	}
+
+	gen = atomic_load_relaxed(&grp_priv->gp_uri_cache_gen);
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	synced = (gen == grp_priv->gp_uri_cache_synced_gen);
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+	if (synced) {
+		D_DEBUG(DB_TRACE, "URI cache unchanged, not rewriting %s\n",
+			path);
+		return 0;
+	}
+
+	D_ASPRINTF(tmp_name, "%s.XXXXXX", path);
+	if (tmp_name == NULL)
+		return -DER_NOMEM;
+
+	old_mode = umask(S_IWGRP | S_IWOTH);
+	fd = mkstemp(tmp_name);
+	umask(old_mode);
+	if (fd == -1) {
+		D_ERROR("mkstemp() failed on %s, error: %s.\n",
+			tmp_name, strerror(errno));
+		D_GOTO(out, rc = d_errno2der(errno));
+	}
+
+	usa.usa_fp = fdopen(fd, "w");
+	if (usa.usa_fp == NULL) {
+		D_ERROR("fdopen() failed on %s, error: %s\n",
+			tmp_name, strerror(errno));
+		rc = d_errno2der(errno);
+		close(fd);
+		D_GOTO(out_unlink, rc);
+	}
+
+	if (fprintf(usa.usa_fp, CRT_URI_CACHE_MAGIC" %d "DF_U64"\n",
+		    CRT_URI_CACHE_FORMAT, version) < 0) {
+		D_ERROR("write to file %s failed (%s).\n",
+			tmp_name, strerror(errno));
+		rc = d_errno2der(errno);
+		fclose(usa.usa_fp);
+		D_GOTO(out_unlink, rc);
+	}
+
+	D_RWLOCK_RDLOCK(&grp_priv->gp_rwlock);
+	rc = d_hash_table_traverse(&grp_priv->gp_uri_lookup_cache,
+				   crt_uri_cache_save_cb, &usa);
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+	if (rc == 0)
+		rc = usa.usa_rc;
+
+	if (rc == 0 && (fflush(usa.usa_fp) != 0 || fsync(fd) != 0))
+		rc = d_errno2der(errno);
+	if (fclose(usa.usa_fp) != 0 && rc == 0)
+		rc = d_errno2der(errno);
+	if (rc != 0) {
+		D_ERROR("write to file %s failed, "DF_RC"\n", tmp_name,
+			DP_RC(rc));
+		D_GOTO(out_unlink, rc);
+	}
+
+	if (rename(tmp_name, path) != 0) {
+		D_ERROR("rename %s to %s failed (%s).\n",
+			tmp_name, path, strerror(errno));
+		D_GOTO(out_unlink, rc = d_errno2der(errno));
+	}
+
+	/* URIs inserted while writing keep the cache dirty */
+	D_RWLOCK_WRLOCK(&grp_priv->gp_rwlock);
+	grp_priv->gp_uri_cache_synced_gen = gen;
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+	D_GOTO(out, rc = 0);
+
+out_unlink:
+	unlink(tmp_name);
+out:
+	D_FREE(tmp_name);
+	return rc;
+}
+
+/*
+ * Load a URI cache written by crt_group_uri_cache_save() into the lookup cache
+ * of a primary group. Entries for ranks that are not members of the group are
+ * ignored, so the group membership should be populated first. Returns
+ * -DER_STALE without touching the group if the file was saved with another
+ * version, and -DER_INVAL if it has another format or is corrupted.
+ */
+int
+crt_group_uri_cache_load(crt_group_t *grp, const char *path, uint64_t version)
+{
+	struct crt_grp_priv	*grp_priv;
+	FILE			*fp;
+	char			 uri[CRT_ADDR_STR_MAX_LEN];
+	uint64_t		 file_version;
+	d_rank_t		 rank;
+	uint32_t		 tag;
+	uint32_t		 len;
+	int			 format;
+	uint32_t		 gen;
+	uint32_t		 nr_entries = 0;
+	uint32_t		 nr_cached = 0;
+	int			 rc = 0;
+
+	if (path == NULL) {
+		D_ERROR("path can't be NULL.\n");
+		return -DER_INVAL;
+	}
+
+	grp_priv = crt_grp_pub2priv(grp);
+	if (!grp_priv->gp_primary) {
+		D_ERROR("Only available for primary groups\n");
+		return -DER_INVAL;
+	}
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		rc = d_errno2der(errno);
+		D_DEBUG(DB_TRACE, "open %s failed (%s).\n", path,
+			strerror(errno));
+		return rc;
+	}
+
+	if (fscanf(fp, CRT_URI_CACHE_MAGIC" %d "DF_U64, &format,
+		   &file_version) != 2 || fgetc(fp) != '\n' ||
+	    format != CRT_URI_CACHE_FORMAT) {
+		D_ERROR("%s is not a URI cache file of format %d.\n", path,
+			CRT_URI_CACHE_FORMAT);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	if (file_version != version) {
+		D_DEBUG(DB_TRACE, "%s has version "DF_U64", expected "DF_U64
+			"\n", path, file_version, version);
+		D_GOTO(out, rc = -DER_STALE);
+	}
+
+	while ((rc = fscanf(fp, "%u %u %u", &rank, &tag, &len)) == 3) {
+		/* The URI follows a single separator and ends the line */
+		if (tag >= CRT_SRV_CONTEXT_NUM || len == 0 ||
+		    len >= CRT_ADDR_STR_MAX_LEN || fgetc(fp) != ' ' ||
+		    fread(uri, 1, len, fp) != len || fgetc(fp) != '\n') {
+			D_ERROR("%s: corrupted entry for rank %u tag %u\n",
+				path, rank, tag);
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+		uri[len] = '\0';
+		nr_entries++;
+
+		if (!crt_grp_rank_is_member(grp_priv, rank))
+			continue;
+
+		rc = crt_grp_lc_uri_insert(grp_priv, rank, tag, uri);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+	if (rc != EOF) {
+		D_ERROR("%s: corrupted entry after %u URIs\n", path,
+			nr_entries);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+	rc = 0;
+
+	/*
+	 * Every entry of the file is now cached, so the file is up to date if
+	 * the cache holds no other URI.
+	 */
+	gen = atomic_load_relaxed(&grp_priv->gp_uri_cache_gen);
+	D_RWLOCK_WRLOCK(&grp_priv->gp_rwlock);
+	d_hash_table_traverse(&grp_priv->gp_uri_lookup_cache,
+			      crt_uri_cache_count_cb, &nr_cached);
+	if (nr_cached == nr_entries)
+		grp_priv->gp_uri_cache_synced_gen = gen;
+	D_RWLOCK_UNLOCK(&grp_priv->gp_rwlock);
+
+	D_DEBUG(DB_TRACE, "loaded %u URIs for group %s from %s, %u cached\n",
+		nr_entries, grp_priv->gp_pub.cg_grpid, path, nr_cached);
+
+out:
+	fclose(fp);
+	return rc;
+}
+
 /*
  * Load psr from singleton config file.
  * If psr_rank set as "-1", will mod the group rank with group size as psr rank.
@@ -2660,6 +3216,7 @@ crt_group_rank_remove_internal(struct crt_grp_priv *grp_priv, d_rank_t rank)
 
 		d_hash_rec_delete(&grp_priv->gp_uri_lookup_cache,
 				  &rank, sizeof(d_rank_t));
+		atomic_fetch_add(&grp_priv->gp_uri_cache_gen, 1);
 	} else {
 		d_rank_t prim_rank;
 
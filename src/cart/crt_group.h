@@ -95,6 +95,10 @@ struct crt_grp_priv {
 
 	/* uri lookup cache, only valid for primary group */
 	struct d_hash_table	 gp_uri_lookup_cache;
+	/* bumped whenever a URI is added to or removed from the cache */
+	ATOMIC uint32_t		 gp_uri_cache_gen;
+	/* gp_uri_cache_gen when the cache was last loaded from or saved to file */
+	uint32_t		 gp_uri_cache_synced_gen;
 
 	/* Primary to secondary rank mapping table */
 	struct d_hash_table	 gp_p2s_table;
@@ -233,6 +237,7 @@ struct crt_grp_gdata {
 };
 
 void crt_hdlr_uri_lookup(crt_rpc_t *rpc_req);
+void crt_hdlr_uri_bulk_lookup(crt_rpc_t *rpc_req);
 int crt_grp_detach(crt_group_t *attached_grp);
 void crt_grp_lc_lookup(struct crt_grp_priv *grp_priv, int ctx_idx,
 		      d_rank_t rank, uint32_t tag, crt_phy_addr_t *base_addr,
@@ -806,6 +806,14 @@ crt_hg_class_init(int provider, int idx, bool primary, hg_class_t **ret_hg_class
 	if (prov_data->cpg_max_unexp_size > 0)
 		init_info.na_init_info.max_unexpected_size = prov_data->cpg_max_unexp_size;
 
+	/*
+	 * Let mercury route RPCs and bulk transfers to peers on the same node
+	 * through its shared memory plugin, the self address then carries an
+	 * extra "na+sm://" part (see crt_hg_parse_uri()).
+	 */
+	if (crt_gdata.cg_auto_sm && provider != CRT_PROV_SM)
+		init_info.auto_sm = HG_TRUE;
+
 	hg_class = HG_Init_opt(info_string, crt_is_service(), &init_info);
 	if (hg_class == NULL) {
 		D_ERROR("Could not initialize HG class.\n");
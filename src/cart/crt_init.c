@@ -34,6 +34,10 @@ crt_lib_init(void)
 	rc = D_RWLOCK_INIT(&crt_gdata.cg_rwlock, NULL);
 	D_ASSERT(rc == 0);
 
+	rc = D_MUTEX_INIT(&crt_gdata.cg_bulk_region_mutex, NULL);
+	D_ASSERT(rc == 0);
+	D_INIT_LIST_HEAD(&crt_gdata.cg_bulk_regions);
+
 	/*
 	 * avoid size mis-matching between client/server side
 	 * /see crt_proc_uuid_t().
@@ -55,6 +59,7 @@ crt_lib_init(void)
 static void
 crt_lib_fini(void)
 {
+	D_MUTEX_DESTROY(&crt_gdata.cg_bulk_region_mutex);
 	D_RWLOCK_DESTROY(&crt_gdata.cg_rwlock);
 }
 
@@ -71,7 +76,8 @@ dump_envariables(void)
 		"CRT_CTX_SHARE_ADDR", "CRT_CTX_NUM", "D_FI_CONFIG",
 		"FI_UNIVERSE_SIZE", "CRT_ENABLE_MEM_PIN",
 		"FI_OFI_RXM_USE_SRX", "D_LOG_FLUSH", "CRT_MRC_ENABLE",
-		"CRT_SECONDARY_PROVIDER", "D_PROVIDER_AUTH_KEY", "D_PORT_AUTO_ADJUST"};
+		"CRT_SECONDARY_PROVIDER", "D_PROVIDER_AUTH_KEY", "D_PORT_AUTO_ADJUST",
+		"CRT_BULK_CACHE_SIZE", "D_AUTO_SM"};
 
 	D_INFO("-- ENVARS: --\n");
 	for (i = 0; i < ARRAY_SIZE(envars); i++) {
@@ -238,6 +244,8 @@ static int data_init(int server, crt_init_options_t *opt)
 {
 	uint32_t	timeout;
 	uint32_t	credits;
+	uint32_t	bulk_cache_size = 0;
+	bool		auto_sm = false;
 	uint32_t	fi_univ_size = 0;
 	uint32_t	mem_pin_enable = 0;
 	uint32_t	is_secondary;
@@ -329,6 +337,19 @@ static int data_init(int server, crt_init_options_t *opt)
 	crt_gdata.cg_credit_ep_ctx = credits;
 	D_ASSERT(crt_gdata.cg_credit_ep_ctx <= CRT_MAX_CREDITS_PER_EP_CTX);
 
+	d_getenv_int("CRT_BULK_CACHE_SIZE", &bulk_cache_size);
+	if (bulk_cache_size > CRT_BULK_CACHE_SIZE_MAX) {
+		D_WARN("CRT_BULK_CACHE_SIZE %u exceeds max, use %u.\n",
+		       bulk_cache_size, CRT_BULK_CACHE_SIZE_MAX);
+		bulk_cache_size = CRT_BULK_CACHE_SIZE_MAX;
+	}
+	crt_gdata.cg_bulk_cache_size = bulk_cache_size;
+
+	d_getenv_bool("D_AUTO_SM", &auto_sm);
+	crt_gdata.cg_auto_sm = auto_sm ? 1 : 0;
+	if (auto_sm)
+		D_INFO("Shared memory enabled for peers on the same node\n");
+
 	/** Enable statistics only for the server side and if requested */
 	if (opt && opt->cio_use_sensors && server) {
 		int	ret;
@@ -934,6 +955,8 @@ crt_finalize(void)
 
 		D_RWLOCK_UNLOCK(&crt_gdata.cg_rwlock);
 
+		crt_bulk_region_fini();
+
 		/* allow the same program to re-initialize */
 		crt_gdata.cg_refcount = 0;
 		crt_gdata.cg_inited = 0;
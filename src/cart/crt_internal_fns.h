@@ -41,6 +41,11 @@ int crt_req_timeout_track(struct crt_rpc_priv *rpc_priv);
 void crt_req_timeout_untrack(struct crt_rpc_priv *rpc_priv);
 void crt_req_force_timeout(struct crt_rpc_priv *rpc_priv);
 
+/** crt_bulk.c */
+int crt_bulk_cache_init(struct crt_context *ctx);
+void crt_bulk_cache_fini(struct crt_context *ctx);
+void crt_bulk_region_fini(void);
+
 /** some simple helper functions */
 
 static inline bool
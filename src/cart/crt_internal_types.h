@@ -78,6 +78,21 @@ struct crt_prov_gdata {
 
 #define MAX_NUM_SECONDARY_PROVS 2
 
+/** Per-context cache of registered bulk handles, see crt_bulk.c */
+struct crt_bulk_cache {
+	/** cached handles keyed by the permission and iovs */
+	struct d_hash_table		 bc_htable;
+	/** LRU list of cached handles, most recently used first */
+	d_list_t			 bc_lru;
+	/** protects all fields */
+	pthread_mutex_t			 bc_mutex;
+	/** number of cached handles */
+	uint32_t			 bc_nr;
+	/** max number of cached handles, 0 means disabled */
+	uint32_t			 bc_max;
+	struct crt_bulk_cache_stats	 bc_stats;
+};
+
 /* CaRT global data */
 struct crt_gdata {
 	/** Providers iinitialized at crt_init() time */
@@ -100,6 +115,13 @@ struct crt_gdata {
 	/** credits limitation for #inflight RPCs per target EP CTX */
 	uint32_t		cg_credit_ep_ctx;
 
+	/** max number of cached bulk handles per context, 0 to disable */
+	uint32_t		cg_bulk_cache_size;
+	/** buffers registered for bulk caching, see crt_bulk.c */
+	d_list_t		cg_bulk_regions;
+	/** protects cg_bulk_regions */
+	pthread_mutex_t		cg_bulk_region_mutex;
+
 	/** the global opcode map */
 	struct crt_opc_map	*cg_opc_map;
 	/** HG level global data */
@@ -120,7 +142,9 @@ struct crt_gdata {
 				/** whether scalable endpoint is enabled */
 				cg_use_sensors		: 1,
 				/** whether we are on a primary provider */
-				cg_provider_is_primary	: 1;
+				cg_provider_is_primary	: 1,
+				/** whether to use shared memory for local peers */
+				cg_auto_sm		: 1;
 
 	ATOMIC uint64_t		cg_rpcid; /* rpc id */
 
@@ -183,6 +207,11 @@ extern struct crt_plugin_gdata		crt_plugin_gdata;
 #define CRT_EPI_TABLE_BITS		(3)
 #define CRT_DEFAULT_CREDITS_PER_EP_CTX	(32)
 #define CRT_MAX_CREDITS_PER_EP_CTX	(256)
+/* (1 << CRT_BULK_CACHE_BITS) is the number of buckets of bulk cache table */
+#define CRT_BULK_CACHE_BITS		(8)
+#define CRT_BULK_CACHE_SIZE_MAX		(65536)
+/* sgls with more iovs than this bypass the bulk cache */
+#define CRT_BULK_CACHE_IOV_MAX		(16)
 
 /* crt_context */
 struct crt_context {
@@ -222,6 +251,9 @@ struct crt_context {
 
 	/** Stores self uri for the current context */
 	char			 cc_self_uri[CRT_ADDR_STR_MAX_LEN];
+
+	/** bulk registration cache */
+	struct crt_bulk_cache	 cc_bulk_cache;
 };
 
 /* in-flight RPC req list, be tracked per endpoint for every crt_context */
@@ -157,6 +157,9 @@ crt_proc_struct_crt_grp_cache(crt_proc_t proc, crt_proc_op_t proc_op,
 	return crt_proc_crt_grp_cache(proc, data);
 }
 
+CRT_RPC_DEFINE(crt_uri_bulk_lookup, CRT_ISEQ_URI_BULK_LOOKUP,
+	       CRT_OSEQ_URI_BULK_LOOKUP)
+
 /* !! All of the following 4 RPC definition should have the same input fields !!
  * All of them are verified in one function:
  * int verify_ctl_in_args(struct crt_ctl_ep_ls_in *in_args)
@@ -231,6 +231,9 @@ crt_rpc_unlock(struct crt_rpc_priv *rpc_priv)
 	X(CRT_OPC_CTL_LS,						\
 		0, &CQF_crt_ctl_ep_ls,					\
 		crt_hdlr_ctl_ls, NULL)					\
+	X(CRT_OPC_URI_BULK_LOOKUP,					\
+		0, &CQF_crt_uri_bulk_lookup,				\
+		crt_hdlr_uri_bulk_lookup, NULL)				\
 
 #define CRT_FI_RPCS_LIST						\
 	X(CRT_OPC_CTL_FI_TOGGLE,					\
@@ -375,6 +378,28 @@ CRT_GEN_STRUCT(crt_grp_cache, CRT_SEQ_GRP_CACHE)
 
 CRT_RPC_DECLARE(crt_uri_lookup, CRT_ISEQ_URI_LOOKUP, CRT_OSEQ_URI_LOOKUP)
 
+/*
+ * Fetch the URIs of a range of ranks known to the target in one round trip.
+ * A reply carries at most CRT_URI_BULK_LOOKUP_MAX URIs, ubl_rank_next is the
+ * first rank of the range that was not covered, or CRT_NO_RANK if the whole
+ * range was.
+ */
+#define CRT_URI_BULK_LOOKUP_MAX		(1024)
+
+#define CRT_ISEQ_URI_BULK_LOOKUP	/* input fields */	 \
+	((crt_group_id_t)	(ubl_grp_id)		CRT_VAR) \
+	((d_rank_t)		(ubl_rank_start)	CRT_VAR) \
+	((uint32_t)		(ubl_rank_nr)		CRT_VAR)
+
+#define CRT_OSEQ_URI_BULK_LOOKUP	/* output fields */	 \
+	((struct crt_grp_cache)	(ubl_uris)		CRT_ARRAY) \
+	((d_rank_t)		(ubl_rank_next)		CRT_VAR) \
+	((uint32_t)		(ubl_version)		CRT_VAR) \
+	((int32_t)		(ubl_rc)		CRT_VAR)
+
+CRT_RPC_DECLARE(crt_uri_bulk_lookup, CRT_ISEQ_URI_BULK_LOOKUP,
+		CRT_OSEQ_URI_BULK_LOOKUP)
+
 #define CRT_ISEQ_ST_SEND_ID	/* input fields */		 \
 	((uint64_t)		(unused1)		CRT_VAR)
 
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -8,6 +8,7 @@
  */
 #define D_LOGFAC	DD_FAC(client)
 
+#include <daos.h>
 #include <daos/agent.h>
 #include <daos/common.h>
 #include <daos/event.h>
@@ -126,6 +127,10 @@ const struct daos_task_api dc_funcs[] = {
 
 	{dc_pool_filter_cont, sizeof(daos_pool_filter_cont_t)},
 	{dc_obj_key2anchor, sizeof(daos_obj_key2anchor_t)},
+
+	{dc_kv_put_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_get_multi, sizeof(daos_kv_multi_t)},
+	{dc_kv_remove_multi, sizeof(daos_kv_multi_t)},
 };
 
 /**
@@ -310,3 +315,36 @@ unlock:
 	D_MUTEX_UNLOCK(&module_lock);
 	return rc;
 }
+
+int
+daos_mem_register(void *buf, size_t len)
+{
+	return crt_bulk_cache_register(buf, len);
+}
+
+int
+daos_mem_deregister(void *buf, size_t len)
+{
+	return crt_bulk_cache_deregister(buf, len);
+}
+
+int
+daos_mem_cache_query(struct daos_mem_cache_stats *stats)
+{
+	struct crt_bulk_cache_stats	bcs;
+	int				rc;
+
+	if (stats == NULL)
+		return -DER_INVAL;
+
+	rc = crt_bulk_cache_stats_get(NULL, &bcs);
+	if (rc != 0)
+		return rc;
+
+	stats->dmcs_hits = bcs.bcs_hits;
+	stats->dmcs_misses = bcs.bcs_misses;
+	stats->dmcs_bypasses = bcs.bcs_bypasses;
+	stats->dmcs_evictions = bcs.bcs_evictions;
+	stats->dmcs_invalidations = bcs.bcs_invalidations;
+	return 0;
+}
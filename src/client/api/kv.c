@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2021 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -138,6 +138,49 @@ daos_kv_remove(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 	return dc_task_schedule(task, true);
 }
 
+static int
+kv_multi(tse_task_func_t func, daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+	 daos_kv_entry_t *kves, daos_event_t *ev)
+{
+	daos_kv_multi_t	*args;
+	tse_task_t	*task;
+	int		 rc;
+
+	rc = dc_task_create(func, NULL, ev, &task);
+	if (rc)
+		return rc;
+
+	args = dc_task_get_args(task);
+	args->oh	= oh;
+	args->th	= th;
+	args->flags	= flags;
+	args->nr	= nr;
+	args->kves	= kves;
+
+	return dc_task_schedule(task, true);
+}
+
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  daos_kv_entry_t *kves, daos_event_t *ev)
+{
+	return kv_multi(dc_kv_put_multi, oh, th, flags, nr, kves, ev);
+}
+
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  daos_kv_entry_t *kves, daos_event_t *ev)
+{
+	return kv_multi(dc_kv_get_multi, oh, th, flags, nr, kves, ev);
+}
+
+int
+daos_kv_remove_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		     daos_kv_entry_t *kves, daos_event_t *ev)
+{
+	return kv_multi(dc_kv_remove_multi, oh, th, flags, nr, kves, ev);
+}
+
 int
 daos_kv_list(daos_handle_t oh, daos_handle_t th, uint32_t *nr,
 	     daos_key_desc_t *kds, d_sg_list_t *sgl, daos_anchor_t *anchor,
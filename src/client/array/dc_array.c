@@ -1388,6 +1388,313 @@ out:
 	return rc;
 }
 
+/** insert in decreasing dkey order, for easier short fetch detection */
+static void
+io_params_insert(struct io_params **head, struct io_params *params)
+{
+	struct io_params	*prev = NULL;
+	struct io_params	*current = *head;
+
+	while (current != NULL && current->dkey_val > params->dkey_val) {
+		prev = current;
+		current = current->next;
+	}
+
+	params->next = current;
+	if (prev)
+		prev->next = params;
+	else
+		*head = params;
+}
+
+static void
+io_params_init(struct io_params *params, struct dc_array *array, uint64_t dkey_val,
+	       daos_opc_t op_type)
+{
+	daos_iod_t	*iod = &params->iod;
+	daos_iom_t	*iom = &params->iom;
+
+	params->dkey_val	= dkey_val;
+	params->akey_val	= '0';
+	params->user_sgl_used	= false;
+	params->cell_size	= array->cell_size;
+	params->chunk_size	= array->chunk_size;
+
+	/** Set integer dkey descriptor */
+	d_iov_set(&params->dkey, &params->dkey_val, sizeof(uint64_t));
+	/** Set character akey descriptor - TODO: should be NULL*/
+	d_iov_set(&iod->iod_name, &params->akey_val, 1);
+	/** Initialize the rest of the IOD fields */
+	iod->iod_nr	= 0;
+	iod->iod_recxs	= NULL;
+	iod->iod_type	= DAOS_IOD_ARRAY;
+	if (op_type == DAOS_OPC_ARRAY_PUNCH)
+		iod->iod_size = 0;
+	else
+		iod->iod_size = array->cell_size;
+
+	/* Initialize the IOM - used for fetch */
+	iom->iom_type	= DAOS_IOD_ARRAY;
+	iom->iom_nr	= 0;
+}
+
+/** Create the Fetch or Update task of a dkey, the array task depends on it */
+static int
+io_task_create(tse_task_t *task, daos_handle_t th, daos_opc_t op_type, struct dc_array *array,
+	       struct io_params *params, d_sg_list_t *sgl, tse_task_t *stask,
+	       d_list_t *io_task_list)
+{
+	tse_task_t	*io_task = NULL;
+	int		rc;
+
+	if (op_type == DAOS_OPC_ARRAY_READ) {
+		daos_obj_fetch_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH, tse_task2sched(task), 0, NULL, &io_task);
+		if (rc != 0) {
+			D_ERROR("Fetch dkey "DF_U64" failed "DF_RC"\n", params->dkey_val,
+				DP_RC(rc));
+			return rc;
+		}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= array->daos_oh;
+		io_arg->th	= th;
+		io_arg->dkey	= &params->dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= &params->iod;
+		io_arg->sgls	= sgl;
+
+		/** if this is a byte array, add ioms for hole mgmt */
+		if (array->byte_array) {
+			params->iom.iom_nr = 0;
+			params->iom.iom_recxs = NULL;
+			params->iom.iom_flags = DAOS_IOMF_DETAIL;
+			io_arg->ioms = &params->iom;
+			rc = tse_task_register_deps(stask, 1, &io_task);
+		} else {
+			io_arg->ioms = NULL;
+			rc = tse_task_register_deps(task, 1, &io_task);
+		}
+		if (rc) {
+			tse_task_complete(io_task, rc);
+			return rc;
+		}
+	} else if (op_type == DAOS_OPC_ARRAY_WRITE || op_type == DAOS_OPC_ARRAY_PUNCH) {
+		daos_obj_update_t *io_arg;
+
+		rc = daos_task_create(DAOS_OPC_OBJ_UPDATE, tse_task2sched(task), 0, NULL, &io_task);
+		if (rc != 0) {
+			D_ERROR("Update dkey "DF_U64" failed "DF_RC"\n", params->dkey_val,
+				DP_RC(rc));
+			return rc;
+		}
+		io_arg = daos_task_get_args(io_task);
+		io_arg->oh	= array->daos_oh;
+		io_arg->th	= th;
+		io_arg->dkey	= &params->dkey;
+		io_arg->nr	= 1;
+		io_arg->iods	= &params->iod;
+		io_arg->sgls	= sgl;
+		rc = tse_task_register_deps(task, 1, &io_task);
+		if (rc) {
+			tse_task_complete(io_task, rc);
+			return rc;
+		}
+	} else {
+		D_ASSERTF(0, "Invalid array operation.\n");
+	}
+
+	tse_task_list_add(io_task, io_task_list);
+	return 0;
+}
+
+/** A range of a list read, split at chunk boundaries */
+struct io_piece {
+	uint64_t	ip_dkey;
+	/** record index in the dkey */
+	daos_off_t	ip_idx;
+	daos_size_t	ip_nr;
+	/** where the range lands in the user sgl */
+	daos_size_t	ip_sgl_i;
+	daos_off_t	ip_sgl_off;
+};
+
+static int
+io_piece_cmp(const void *a, const void *b)
+{
+	const struct io_piece	*pa = a;
+	const struct io_piece	*pb = b;
+
+	if (pa->ip_dkey != pb->ip_dkey)
+		return pa->ip_dkey < pb->ip_dkey ? -1 : 1;
+	if (pa->ip_idx != pb->ip_idx)
+		return pa->ip_idx < pb->ip_idx ? -1 : 1;
+	return 0;
+}
+
+static void
+sgl_advance(d_sg_list_t *sgl, daos_size_t bytes, daos_size_t *sgl_i, daos_off_t *sgl_off)
+{
+	while (bytes > 0) {
+		daos_size_t left = sgl->sg_iovs[*sgl_i].iov_len - *sgl_off;
+
+		if (bytes < left) {
+			*sgl_off += bytes;
+			return;
+		}
+		bytes -= left;
+		(*sgl_i)++;
+		*sgl_off = 0;
+	}
+}
+
+/** add the user buffers of num_records, starting at sgl_i/sgl_off, to the dkey sgl */
+static int
+append_sgl(d_sg_list_t *user_sgl, daos_size_t cell_size, daos_size_t num_records,
+	   daos_size_t sgl_i, daos_off_t sgl_off, d_sg_list_t *sgl, uint32_t *sgl_cap)
+{
+	daos_size_t	rem = num_records * cell_size;
+
+	while (rem > 0) {
+		d_iov_t		*iov;
+		daos_size_t	len;
+
+		D_ASSERT(user_sgl->sg_nr > sgl_i);
+		len = min(user_sgl->sg_iovs[sgl_i].iov_len - sgl_off, rem);
+		if (len == 0) {
+			sgl_i++;
+			sgl_off = 0;
+			continue;
+		}
+
+		if (sgl->sg_nr == *sgl_cap) {
+			d_iov_t		*new_sg_iovs;
+			uint32_t	new_cap = *sgl_cap ? *sgl_cap * 2 : 8;
+
+			D_REALLOC_ARRAY(new_sg_iovs, sgl->sg_iovs, *sgl_cap, new_cap);
+			if (new_sg_iovs == NULL)
+				return -DER_NOMEM;
+			sgl->sg_iovs = new_sg_iovs;
+			*sgl_cap = new_cap;
+		}
+
+		iov = &sgl->sg_iovs[sgl->sg_nr++];
+		iov->iov_buf = user_sgl->sg_iovs[sgl_i].iov_buf + sgl_off;
+		iov->iov_len = len;
+		iov->iov_buf_len = len;
+		rem -= len;
+		sgl_i++;
+		sgl_off = 0;
+	}
+
+	return 0;
+}
+
+/*
+ * List read: split all the ranges at chunk boundaries and sort the pieces by dkey, so that every
+ * dkey is fetched once with all of its recxs whatever the order of the ranges, and the data lands
+ * directly in the user buffers. Ranges overlapping within a dkey can't be described by a single
+ * iod and are left to the range by range path, \a grouped is false then.
+ */
+static int
+list_read_prep(tse_task_t *task, daos_handle_t th, struct dc_array *array,
+	       daos_array_iod_t *rg_iod, d_sg_list_t *user_sgl, tse_task_t *stask,
+	       struct io_params **head, d_list_t *io_task_list, bool *grouped)
+{
+	struct io_piece	*pieces;
+	daos_size_t	nr = 0;
+	daos_size_t	sgl_i = 0;
+	daos_off_t	sgl_off = 0;
+	daos_size_t	u, p, q;
+	int		rc = 0;
+
+	*grouped = false;
+	for (u = 0; u < rg_iod->arr_nr; u++) {
+		daos_range_t *rg = &rg_iod->arr_rgs[u];
+
+		if (rg->rg_len == 0)
+			continue;
+		nr += (rg->rg_idx + rg->rg_len - 1) / array->chunk_size -
+			rg->rg_idx / array->chunk_size + 1;
+	}
+	if (nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(pieces, nr);
+	if (pieces == NULL)
+		return -DER_NOMEM;
+
+	for (p = 0, u = 0; u < rg_iod->arr_nr; u++) {
+		daos_off_t	idx = rg_iod->arr_rgs[u].rg_idx;
+		daos_size_t	len = rg_iod->arr_rgs[u].rg_len;
+
+		while (len > 0) {
+			struct io_piece	*piece = &pieces[p++];
+			daos_size_t	dkey_records;
+
+			compute_dkey(array, idx, &dkey_records, &piece->ip_idx, &piece->ip_dkey);
+			piece->ip_nr = min(len, dkey_records);
+			piece->ip_sgl_i = sgl_i;
+			piece->ip_sgl_off = sgl_off;
+			sgl_advance(user_sgl, piece->ip_nr * array->cell_size, &sgl_i, &sgl_off);
+			idx += piece->ip_nr;
+			len -= piece->ip_nr;
+		}
+	}
+	D_ASSERT(p == nr);
+
+	qsort(pieces, nr, sizeof(*pieces), io_piece_cmp);
+
+	for (p = 1; p < nr; p++) {
+		if (pieces[p].ip_dkey == pieces[p - 1].ip_dkey &&
+		    pieces[p - 1].ip_idx + pieces[p - 1].ip_nr > pieces[p].ip_idx)
+			D_GOTO(out, rc = 0);
+	}
+
+	for (p = 0; p < nr; p = q) {
+		struct io_params	*params;
+		uint32_t		sgl_cap = 0;
+
+		for (q = p; q < nr && pieces[q].ip_dkey == pieces[p].ip_dkey; q++)
+			;
+
+		D_ALLOC_PTR(params);
+		if (params == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		io_params_init(params, array, pieces[p].ip_dkey, DAOS_OPC_ARRAY_READ);
+		io_params_insert(head, params);
+
+		D_ALLOC_ARRAY(params->iod.iod_recxs, q - p);
+		if (params->iod.iod_recxs == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		params->iod.iod_nr = q - p;
+
+		for (u = p; u < q; u++) {
+			params->iod.iod_recxs[u - p].rx_idx = pieces[u].ip_idx;
+			params->iod.iod_recxs[u - p].rx_nr = pieces[u].ip_nr;
+			params->num_records += pieces[u].ip_nr;
+			rc = append_sgl(user_sgl, array->cell_size, pieces[u].ip_nr,
+					pieces[u].ip_sgl_i, pieces[u].ip_sgl_off, &params->sgl,
+					&sgl_cap);
+			if (rc)
+				D_GOTO(out, rc);
+		}
+
+		D_DEBUG(DB_IO, "DKEY IOD "DF_U64": %u recxs, %zu records\n", params->dkey_val,
+			params->iod.iod_nr, params->num_records);
+
+		rc = io_task_create(task, th, DAOS_OPC_ARRAY_READ, array, params, &params->sgl,
+				    stask, io_task_list);
+		if (rc)
+			D_GOTO(out, rc);
+	}
+	*grouped = true;
+
+out:
+	D_FREE(pieces);
+	return rc;
+}
+
 static int
 dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	    daos_array_iod_t *rg_iod, d_sg_list_t *user_sgl,
@@ -1404,7 +1711,7 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	daos_off_t	record_i;
 	struct io_params *head = NULL;
 	bool		head_cb_registered = false;
-	daos_size_t	num_ios;
+	bool		grouped;
 	d_list_t	io_task_list;
 	daos_size_t	tot_num_records = 0;
 	tse_task_t	*stask; /* task for short read and hole mgmt */
@@ -1435,7 +1742,6 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	cur_off = 0;
 	cur_i = 0;
 	u = 0;
-	num_ios = 0;
 	records = rg_iod->arr_rgs[0].rg_len;
 	array_idx = rg_iod->arr_rgs[0].rg_idx;
 
@@ -1456,6 +1762,16 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 			D_GOTO(err_task, rc);
 	}
 
+	/** reads of many ranges are grouped by dkey up front */
+	if (op_type == DAOS_OPC_ARRAY_READ && rg_iod->arr_nr > 1) {
+		rc = list_read_prep(task, th, array, rg_iod, user_sgl, stask, &head,
+				    &io_task_list, &grouped);
+		if (rc)
+			D_GOTO(err_iotask, rc);
+		if (grouped)
+			u = rg_iod->arr_nr;
+	}
+
 	/*
 	 * Loop over every range, but at the same time combine consecutive
 	 * ranges that belong to the same dkey. If the user gives ranges that
@@ -1464,12 +1780,9 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 	 */
 	while (u < rg_iod->arr_nr) {
 		daos_iod_t	*iod;
-		daos_iom_t	*iom;
 		d_sg_list_t	*sgl;
-		daos_key_t	*dkey;
 		uint64_t	dkey_val;
 		daos_size_t	dkey_records;
-		tse_task_t	*io_task = NULL;
 		struct io_params *params;
 		daos_size_t	i; /* index for iod recx */
 
@@ -1498,68 +1811,17 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 		D_ALLOC_PTR(params);
 		if (params == NULL)
 			D_GOTO(err_iotask, rc = -DER_NOMEM);
-		params->dkey_val = dkey_val;
 
 		/*
 		 * since we probably have multiple dkey ios, put them in linked
-		 * list to free later. Insert in decreasing order for easier
-		 * short fetch detection.
+		 * list to free later.
 		 */
-		if (num_ios == 0) {
-			head = params;
-		} else {
-			struct io_params *prev, *current;
-
-			current = head;
-			prev = NULL;
-			while (1) {
-				D_ASSERT(current);
-				if (current->dkey_val <= params->dkey_val) {
-					params->next = current;
-					if (prev)
-						prev->next = params;
-					else
-						head = params;
-					break;
-				}
-				if (current->next == NULL) {
-					current->next = params;
-					break;
-				}
-
-				prev = current;
-				current = current->next;
-			}
-		}
+		io_params_init(params, array, dkey_val, op_type);
+		io_params_insert(&head, params);
 
 		/** Object IO params for the fetch/update */
 		iod	= &params->iod;
-		iom	= &params->iom;
 		sgl	= &params->sgl;
-		dkey	= &params->dkey;
-
-		params->akey_val	= '0';
-		params->user_sgl_used	= false;
-		params->cell_size	= array->cell_size;
-		params->chunk_size	= array->chunk_size;
-		num_ios++;
-
-		/** Set integer dkey descriptor */
-		d_iov_set(dkey, &params->dkey_val, sizeof(uint64_t));
-		/** Set character akey descriptor - TODO: should be NULL*/
-		d_iov_set(&iod->iod_name, &params->akey_val, 1);
-		/** Initialize the rest of the IOD fields */
-		iod->iod_nr	= 0;
-		iod->iod_recxs	= NULL;
-		iod->iod_type	= DAOS_IOD_ARRAY;
-		if (op_type == DAOS_OPC_ARRAY_PUNCH)
-			iod->iod_size = 0;
-		else
-			iod->iod_size = array->cell_size;
-
-		/* Initialize the IOM - used for fetch */
-		iom->iom_type	= DAOS_IOD_ARRAY;
-		iom->iom_nr	= 0;
 
 		i = 0;
 		dkey_records = 0;
@@ -1675,73 +1937,9 @@ dc_array_io(daos_handle_t array_oh, daos_handle_t th,
 
 		params->num_records = dkey_records;
 
-		/* Create the Fetch or Update task */
-		if (op_type == DAOS_OPC_ARRAY_READ) {
-			daos_obj_fetch_t *io_arg;
-
-			rc = daos_task_create(DAOS_OPC_OBJ_FETCH,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Fetch dkey "DF_U64" failed "DF_RC"\n",
-					params->dkey_val, DP_RC(rc));
-				D_GOTO(err_iotask, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-
-			/** if this is a byte array, add ioms for hole mgmt */
-			if (array->byte_array) {
-				iom->iom_nr = 0;
-				iom->iom_recxs = NULL;
-				iom->iom_flags = DAOS_IOMF_DETAIL;
-				io_arg->ioms = iom;
-				rc = tse_task_register_deps(stask, 1, &io_task);
-				if (rc) {
-					tse_task_complete(io_task, rc);
-					D_GOTO(err_iotask, rc);
-				}
-			} else {
-				io_arg->ioms = NULL;
-				rc = tse_task_register_deps(task, 1, &io_task);
-				if (rc) {
-					tse_task_complete(io_task, rc);
-					D_GOTO(err_iotask, rc);
-				}
-			}
-		} else if (op_type == DAOS_OPC_ARRAY_WRITE ||
-			   op_type == DAOS_OPC_ARRAY_PUNCH) {
-			daos_obj_update_t *io_arg;
-
-			rc = daos_task_create(DAOS_OPC_OBJ_UPDATE,
-					      tse_task2sched(task),
-					      0, NULL, &io_task);
-			if (rc != 0) {
-				D_ERROR("Update dkey "DF_U64" failed "DF_RC"\n",
-					params->dkey_val, DP_RC(rc));
-				D_GOTO(err_iotask, rc);
-			}
-			io_arg = daos_task_get_args(io_task);
-			io_arg->oh	= oh;
-			io_arg->th	= th;
-			io_arg->dkey	= dkey;
-			io_arg->nr	= 1;
-			io_arg->iods	= iod;
-			io_arg->sgls	= sgl;
-			rc = tse_task_register_deps(task, 1, &io_task);
-			if (rc) {
-				tse_task_complete(io_task, rc);
-				D_GOTO(err_iotask, rc);
-			}
-		} else {
-			D_ASSERTF(0, "Invalid array operation.\n");
-		}
-		tse_task_list_add(io_task, &io_task_list);
+		rc = io_task_create(task, th, op_type, array, params, sgl, stask, &io_task_list);
+		if (rc)
+			D_GOTO(err_iotask, rc);
 	} /* end while */
 
 	rc = tse_task_register_comp_cb(task, free_io_params_cb, &head, sizeof(head));
@@ -76,6 +76,8 @@
 #define INODE_AKEYS	12
 #define INODE_AKEY_NAME	"DFS_INODE"
 #define SLINK_AKEY_NAME	"DFS_SLINK"
+/** A-key name of the size hint of a file, a struct dfs_size_hint single value */
+#define SIZE_HINT_AKEY_NAME	"DFS_SIZE_HINT"
 #define MODE_IDX	0
 #define OID_IDX		(sizeof(mode_t))
 #define MTIME_IDX	(OID_IDX + sizeof(daos_obj_id_t))
@@ -139,6 +141,10 @@ struct dfs_obj {
 			/** Default chunk size for all entries in dir */
 			daos_size_t             chunk_size;
 		} d;
+		struct {
+			/** mount to publish the size hint on at release, set once modified */
+			dfs_t			*hint_dfs;
+		} f;
 	};
 };
 
@@ -195,6 +201,12 @@ struct dfs {
 	struct dfs_mnt_hdls	*cont_hdl;
 	/** the root dir stat buf */
 	struct stat		root_stbuf;
+	/** dentry cache, allocated on mount and disabled until it has a timeout */
+	struct dfs_dcache	*dcache;
+	/** max operations in flight for dfs_remove with force, 0 to remove serially */
+	unsigned int		rm_inflight;
+	/** maintain and use the size hint of files instead of querying the array size */
+	bool			size_hint;
 };
 
 struct dfs_entry {
@@ -557,10 +569,82 @@ concat(const char *s1, const char *s2)
 	return result;
 }
 
+/*
+ * Size hint of a file, stored next to its inode in the parent directory so that a stat does not
+ * have to query the size of the array from all the shards of the file. Every open handle that
+ * modifies the file increments the writer count of the hint in a transaction before its first
+ * modification, and decrements it when it is released. The last handle to be released publishes
+ * the size and max epoch of the file. The hint is only used while there are no writers, so a
+ * client that exits without releasing its handles leaves the size to be queried from the file.
+ * The hint is enabled for all the clients of a container by the SIZE_HINT_CONT_ATTR attribute.
+ */
+#define SIZE_HINT_CONT_ATTR	"dfs-size-hint"
+
+struct dfs_size_hint {
+	/** the entry might have been replaced since the hint was published */
+	daos_obj_id_t	sh_oid;
+	daos_size_t	sh_size;
+	/** max epoch of the file when the size was published */
+	daos_epoch_t	sh_epoch;
+	/** number of open handles modifying the file */
+	uint32_t	sh_writers;
+};
+
+static void
+size_hint_prep(const char *name, size_t len, struct dfs_size_hint *hint, daos_key_t *dkey,
+	       daos_iod_t *iod, d_sg_list_t *sgl, d_iov_t *sg_iov)
+{
+	d_iov_set(dkey, (void *)name, len);
+	d_iov_set(&iod->iod_name, SIZE_HINT_AKEY_NAME, sizeof(SIZE_HINT_AKEY_NAME) - 1);
+	iod->iod_nr	= 1;
+	iod->iod_recxs	= NULL;
+	iod->iod_type	= DAOS_IOD_SINGLE;
+	iod->iod_size	= sizeof(*hint);
+	d_iov_set(sg_iov, hint, sizeof(*hint));
+	sgl->sg_nr	= 1;
+	sgl->sg_nr_out	= 0;
+	sgl->sg_iovs	= sg_iov;
+}
+
+/** return true if a hint of \a size bytes can be used as the size of the file with \a oid */
+static inline bool
+size_hint_valid(struct dfs_size_hint *hint, daos_size_t size, daos_obj_id_t oid)
+{
+	return size == sizeof(*hint) && hint->sh_writers == 0 &&
+	       daos_oid_cmp(hint->sh_oid, oid) == 0;
+}
+
+/** the size hint is enabled if the container attribute is set to true, on or 1 */
+static bool
+size_hint_enabled(daos_handle_t coh)
+{
+	const char	*name = SIZE_HINT_CONT_ATTR;
+	char		value[8] = {0};
+	void		*buf = value;
+	size_t		size = sizeof(value) - 1;
+	int		rc;
+
+	rc = daos_cont_get_attr(coh, 1, &name, &buf, &size, NULL);
+	if (rc) {
+		if (rc != -DER_NONEXIST)
+			D_WARN("Failed to read %s attribute: "DF_RC"\n", name, DP_RC(rc));
+		return false;
+	}
+	value[min(size, sizeof(value) - 1)] = '\0';
+
+	return strcasecmp(value, "true") == 0 || strcasecmp(value, "on") == 0 ||
+	       strcmp(value, "1") == 0;
+}
+
+/*
+ * Fetch the entry \a name, and optionally \a xnr extended attributes and the size hint of the
+ * file in the same RPC. \a hint_valid is only set if the entry is a regular file.
+ */
 static int
-fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
-	    bool fetch_sym, bool *exists, struct dfs_entry *entry, int xnr, char *xnames[],
-	    void *xvals[], daos_size_t *xsizes)
+fetch_entry_ext(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name,
+		size_t len, bool fetch_sym, bool *exists, struct dfs_entry *entry, int xnr,
+		char *xnames[], void *xvals[], daos_size_t *xsizes, struct dfs_size_hint *hint,
+		bool *hint_valid)
 {
 	d_sg_list_t	l_sgl, *sgl;
 	d_iov_t		sg_iovs[INODE_AKEYS];
@@ -572,6 +656,7 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 	d_iov_t		*sg_iovx = NULL;
 	d_sg_list_t	*sgls = NULL;
 	daos_iod_t	*iods = NULL;
+	unsigned int	nr = xnr + (hint ? 1 : 0);
 	int		rc;
 
 	D_ASSERT(name);
@@ -580,20 +665,24 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 	if (strcmp(name, ".") == 0)
 		D_ASSERT(0);
 
-	if (xnr) {
-		D_ALLOC_ARRAY(pxnames, xnr);
-		if (pxnames == NULL)
-			D_GOTO(out, rc = ENOMEM);
+	d_iov_set(&dkey, (void *)name, len);
+
+	if (nr) {
+		if (xnr) {
+			D_ALLOC_ARRAY(pxnames, xnr);
+			if (pxnames == NULL)
+				D_GOTO(out, rc = ENOMEM);
+		}
 
-		D_ALLOC_ARRAY(sg_iovx, xnr);
+		D_ALLOC_ARRAY(sg_iovx, nr);
 		if (sg_iovx == NULL)
 			D_GOTO(out, rc = ENOMEM);
 
-		D_ALLOC_ARRAY(sgls, xnr + 1);
+		D_ALLOC_ARRAY(sgls, nr + 1);
 		if (sgls == NULL)
 			D_GOTO(out, rc = ENOMEM);
 
-		D_ALLOC_ARRAY(iods, xnr + 1);
+		D_ALLOC_ARRAY(iods, nr + 1);
 		if (iods == NULL)
 			D_GOTO(out, rc = ENOMEM);
 
@@ -615,14 +704,17 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 			sgls[i].sg_iovs		= &sg_iovx[i];
 		}
 
-		sgl = &sgls[xnr];
-		iod = &iods[xnr];
+		if (hint)
+			size_hint_prep(name, len, hint, &dkey, &iods[xnr], &sgls[xnr],
+				       &sg_iovx[xnr]);
+
+		sgl = &sgls[nr];
+		iod = &iods[nr];
 	} else {
 		sgl = &l_sgl;
 		iod = &l_iod;
 	}
 
-	d_iov_set(&dkey, (void *)name, len);
 	d_iov_set(&iod->iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
 	iod->iod_nr	= 1;
 	recx.rx_idx	= 0;
@@ -657,7 +749,7 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 	sgl->sg_nr_out	= 0;
 	sgl->sg_iovs	= sg_iovs;
 
-	rc = daos_obj_fetch(oh, th, DAOS_COND_DKEY_FETCH, &dkey, xnr + 1, iods ? iods : iod,
+	rc = daos_obj_fetch(oh, th, DAOS_COND_DKEY_FETCH, &dkey, nr + 1, iods ? iods : iod,
 			    sgls ? sgls : sgl, NULL, NULL);
 	if (rc == -DER_NONEXIST) {
 		*exists = false;
@@ -670,6 +762,9 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 	for (i = 0; i < xnr; i++)
 		xsizes[i] = iods[i].iod_size;
 
+	if (hint && S_ISREG(entry->mode))
+		*hint_valid = size_hint_valid(hint, iods[xnr].iod_size, entry->oid);
+
 	if (fetch_sym && S_ISLNK(entry->mode)) {
 		char		*value;
 		daos_size_t	val_len;
@@ -747,7 +842,7 @@ fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char
 	else
 		*exists = true;
 out:
-	if (xnr) {
+	if (nr) {
 		if (pxnames) {
 			for (i = 0; i < xnr; i++)
 				D_FREE(pxnames[i]);
@@ -760,6 +855,362 @@ out:
 	return rc;
 }
 
+static inline int
+fetch_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
+	    bool fetch_sym, bool *exists, struct dfs_entry *entry, int xnr, char *xnames[],
+	    void *xvals[], daos_size_t *xsizes)
+{
+	return fetch_entry_ext(ver, oh, th, name, len, fetch_sym, exists, entry, xnr, xnames,
+			       xvals, xsizes, NULL, NULL);
+}
+
+/** Max entries in the dentry cache of a mount, the least recently used are evicted beyond */
+#define DCACHE_MAX		(64 * 1024)
+
+/** dentry cache of a DFS mount */
+struct dfs_dcache {
+	/** protect the table, the LRU list and the stats */
+	pthread_mutex_t		dc_lock;
+	struct d_hash_table	*dc_htable;
+	/** LRU list of the cached entries, the most recently used first */
+	d_list_t		dc_lru;
+	/** ns an existing entry is cached for */
+	uint64_t		dc_timeout;
+	/** ns a non-existent entry is cached for */
+	uint64_t		dc_neg_timeout;
+	/** bumped by every eviction, entries fetched before one are not cached */
+	uint64_t		dc_gen;
+	dfs_dcache_stats_t	dc_stats;
+};
+
+/** dentry cache record, keyed by the parent directory OID and the entry name */
+struct dcache_rec {
+	d_list_t		dr_hlink;
+	d_list_t		dr_lru;
+	/** daos_get_ntime() after which the record is stale */
+	uint64_t		dr_expire;
+	bool			dr_exists;
+	/** cached entry, value is only set for a symlink fetched with its value */
+	struct dfs_entry	dr_entry;
+	unsigned int		dr_key_len;
+	char			dr_key[0];
+};
+
+struct dcache_key {
+	daos_obj_id_t		dk_parent;
+	char			dk_name[DFS_MAX_NAME + 1];
+};
+
+static inline struct dcache_rec *
+dcache_rlink2rec(d_list_t *rlink)
+{
+	return container_of(rlink, struct dcache_rec, dr_hlink);
+}
+
+static bool
+dcache_key_cmp(struct d_hash_table *htable, d_list_t *rlink, const void *key, unsigned int ksize)
+{
+	struct dcache_rec *rec = dcache_rlink2rec(rlink);
+
+	return rec->dr_key_len == ksize && memcmp(rec->dr_key, key, ksize) == 0;
+}
+
+static uint32_t
+dcache_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	return d_hash_string_u32(key, ksize);
+}
+
+static uint32_t
+dcache_rec_hash(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct dcache_rec *rec = dcache_rlink2rec(rlink);
+
+	return d_hash_string_u32(rec->dr_key, rec->dr_key_len);
+}
+
+/** records are owned by the table, they are freed once removed */
+static bool
+dcache_rec_decref(struct d_hash_table *htable, d_list_t *rlink)
+{
+	return true;
+}
+
+static void
+dcache_rec_free(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct dcache_rec *rec = dcache_rlink2rec(rlink);
+
+	d_list_del(&rec->dr_lru);
+	D_FREE(rec->dr_entry.value);
+	D_FREE(rec);
+}
+
+static d_hash_table_ops_t dcache_hash_ops = {
+	.hop_key_cmp	= dcache_key_cmp,
+	.hop_key_hash	= dcache_key_hash,
+	.hop_rec_hash	= dcache_rec_hash,
+	.hop_rec_decref	= dcache_rec_decref,
+	.hop_rec_free	= dcache_rec_free,
+};
+
+static void
+dcache_fini(dfs_t *dfs)
+{
+	struct dfs_dcache *dcache = dfs->dcache;
+
+	if (dcache == NULL)
+		return;
+
+	D_DEBUG(DB_TRACE, "dentry cache: "DF_U64" hits, "DF_U64" negative hits, "DF_U64" misses, "
+		DF_U64" evicts\n", dcache->dc_stats.dcs_hits, dcache->dc_stats.dcs_neg_hits,
+		dcache->dc_stats.dcs_misses, dcache->dc_stats.dcs_evicts);
+	d_hash_table_destroy(dcache->dc_htable, true);
+	D_MUTEX_DESTROY(&dcache->dc_lock);
+	D_FREE(dcache);
+	dfs->dcache = NULL;
+}
+
+static int
+dcache_init(dfs_t *dfs, double timeout, double neg_timeout)
+{
+	struct dfs_dcache	*dcache;
+	int			rc;
+
+	D_ALLOC_PTR(dcache);
+	if (dcache == NULL)
+		return ENOMEM;
+
+	rc = D_MUTEX_INIT(&dcache->dc_lock, NULL);
+	if (rc)
+		D_GOTO(err_free, rc = daos_der2errno(rc));
+
+	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 12, NULL, &dcache_hash_ops,
+				 &dcache->dc_htable);
+	if (rc) {
+		D_ERROR("Failed to create dentry cache "DF_RC"\n", DP_RC(rc));
+		D_GOTO(err_lock, rc = daos_der2errno(rc));
+	}
+
+	D_INIT_LIST_HEAD(&dcache->dc_lru);
+	dcache->dc_timeout = timeout * NSEC_PER_SEC;
+	dcache->dc_neg_timeout = neg_timeout * NSEC_PER_SEC;
+	dfs->dcache = dcache;
+	return 0;
+
+err_lock:
+	D_MUTEX_DESTROY(&dcache->dc_lock);
+err_free:
+	D_FREE(dcache);
+	return rc;
+}
+
+/** timeouts are read without the lock, a racing dfs_dcache_set() only delays its effect */
+static inline bool
+dcache_enabled(struct dfs_dcache *dcache)
+{
+	return dcache != NULL && (dcache->dc_timeout != 0 || dcache->dc_neg_timeout != 0);
+}
+
+/** build the cache key, return 0 if the entry can't be cached */
+static inline unsigned int
+dcache_key_init(struct dcache_key *key, const daos_obj_id_t *parent, const char *name, size_t len)
+{
+	if (len > DFS_MAX_NAME)
+		return 0;
+
+	oid_cp(&key->dk_parent, *parent);
+	memcpy(key->dk_name, name, len);
+	return sizeof(key->dk_parent) + len;
+}
+
+/**
+ * Drop the cached entry of \a name in \a parent, called once a local change to it is done,
+ * successful or not.  Bumping the generation keeps a lookup which fetched the entry before the
+ * change landed from caching it after this.
+ */
+static void
+dcache_evict(dfs_t *dfs, const daos_obj_id_t *parent, const char *name, size_t len)
+{
+	struct dfs_dcache	*dcache = dfs->dcache;
+	struct dcache_key	key;
+	unsigned int		ksize;
+
+	if (!dcache_enabled(dcache))
+		return;
+
+	ksize = dcache_key_init(&key, parent, name, len);
+	if (ksize == 0)
+		return;
+
+	D_MUTEX_LOCK(&dcache->dc_lock);
+	dcache->dc_gen++;
+	if (d_hash_rec_delete(dcache->dc_htable, &key, ksize)) {
+		dcache->dc_stats.dcs_evicts++;
+		dcache->dc_stats.dcs_nr--;
+	}
+	D_MUTEX_UNLOCK(&dcache->dc_lock);
+}
+
+/** drop all the cached entries and clear the stats, lock held */
+static void
+dcache_flush(struct dfs_dcache *dcache)
+{
+	struct dcache_rec	*rec;
+	struct dcache_rec	*tmp;
+
+	dcache->dc_gen++;
+	d_list_for_each_entry_safe(rec, tmp, &dcache->dc_lru, dr_lru)
+		d_hash_rec_delete_at(dcache->dc_htable, &rec->dr_hlink);
+	memset(&dcache->dc_stats, 0, sizeof(dcache->dc_stats));
+}
+
+static void
+dcache_insert(struct dfs_dcache *dcache, struct dcache_key *key, unsigned int ksize,
+	      uint64_t gen, bool exists, struct dfs_entry *entry)
+{
+	struct dcache_rec	*rec;
+	d_list_t		*rlink;
+	uint64_t		timeout;
+
+	timeout = exists ? dcache->dc_timeout : dcache->dc_neg_timeout;
+	if (timeout == 0)
+		return;
+
+	D_ALLOC(rec, sizeof(*rec) + ksize);
+	if (rec == NULL)
+		return;
+
+	if (exists) {
+		rec->dr_entry = *entry;
+		if (entry->value != NULL) {
+			D_STRNDUP(rec->dr_entry.value, entry->value, entry->value_len);
+			if (rec->dr_entry.value == NULL) {
+				D_FREE(rec);
+				return;
+			}
+		}
+	}
+	rec->dr_exists = exists;
+	rec->dr_expire = daos_get_ntime() + timeout;
+	rec->dr_key_len = ksize;
+	memcpy(rec->dr_key, key, ksize);
+
+	D_MUTEX_LOCK(&dcache->dc_lock);
+	/** an eviction since the fetch, the entry may have changed after it */
+	if (dcache->dc_gen != gen) {
+		D_MUTEX_UNLOCK(&dcache->dc_lock);
+		D_FREE(rec->dr_entry.value);
+		D_FREE(rec);
+		return;
+	}
+
+	/** another thread may have cached it meanwhile, keep the latest */
+	if (d_hash_rec_delete(dcache->dc_htable, key, ksize))
+		dcache->dc_stats.dcs_nr--;
+
+	if (dcache->dc_stats.dcs_nr >= DCACHE_MAX) {
+		struct dcache_rec *lru;
+
+		lru = d_list_entry(dcache->dc_lru.prev, struct dcache_rec, dr_lru);
+		d_hash_rec_delete_at(dcache->dc_htable, &lru->dr_hlink);
+		dcache->dc_stats.dcs_evicts++;
+		dcache->dc_stats.dcs_nr--;
+	}
+
+	rlink = d_hash_rec_find_insert(dcache->dc_htable, rec->dr_key, ksize, &rec->dr_hlink);
+	D_ASSERT(rlink == &rec->dr_hlink);
+	d_list_add(&rec->dr_lru, &dcache->dc_lru);
+	dcache->dc_stats.dcs_nr++;
+	D_MUTEX_UNLOCK(&dcache->dc_lock);
+}
+
+/**
+ * Same as fetch_entry() outside of a transaction, but answered from the dentry cache of the
+ * mount when the entry of \a name in the directory \a parent is cached and has not expired.
+ */
+static int
+lookup_entry(dfs_t *dfs, const daos_obj_id_t *parent, daos_handle_t oh, const char *name,
+	     size_t len, bool fetch_sym, bool *exists, struct dfs_entry *entry)
+{
+	struct dfs_dcache	*dcache = dfs->dcache;
+	struct dcache_key	key;
+	struct dcache_rec	*rec;
+	d_list_t		*rlink;
+	unsigned int		ksize = 0;
+	uint64_t		gen;
+	int			rc;
+
+	if (dcache_enabled(dcache))
+		ksize = dcache_key_init(&key, parent, name, len);
+	if (ksize == 0)
+		return fetch_entry(dfs->layout_v, oh, DAOS_TX_NONE, name, len, fetch_sym, exists,
+				   entry, 0, NULL, NULL, NULL);
+
+	D_MUTEX_LOCK(&dcache->dc_lock);
+	rlink = d_hash_rec_find(dcache->dc_htable, &key, ksize);
+	if (rlink != NULL) {
+		rec = dcache_rlink2rec(rlink);
+		if (rec->dr_expire < daos_get_ntime()) {
+			d_hash_rec_delete_at(dcache->dc_htable, rlink);
+			dcache->dc_stats.dcs_nr--;
+		} else if (!rec->dr_exists) {
+			dcache->dc_stats.dcs_neg_hits++;
+			D_MUTEX_UNLOCK(&dcache->dc_lock);
+			*exists = false;
+			return 0;
+		} else if (!fetch_sym || !S_ISLNK(rec->dr_entry.mode) ||
+			   rec->dr_entry.value != NULL) {
+			*entry = rec->dr_entry;
+			entry->value = NULL;
+			if (fetch_sym && rec->dr_entry.value != NULL) {
+				D_STRNDUP(entry->value, rec->dr_entry.value,
+					  rec->dr_entry.value_len);
+				if (entry->value == NULL) {
+					D_MUTEX_UNLOCK(&dcache->dc_lock);
+					return ENOMEM;
+				}
+			}
+			d_list_move(&rec->dr_lru, &dcache->dc_lru);
+			dcache->dc_stats.dcs_hits++;
+			D_MUTEX_UNLOCK(&dcache->dc_lock);
+			*exists = true;
+			return 0;
+		}
+	}
+	dcache->dc_stats.dcs_misses++;
+	gen = dcache->dc_gen;
+	D_MUTEX_UNLOCK(&dcache->dc_lock);
+
+	rc = fetch_entry(dfs->layout_v, oh, DAOS_TX_NONE, name, len, fetch_sym, exists, entry, 0,
+			 NULL, NULL, NULL);
+	if (rc == 0)
+		dcache_insert(dcache, &key, ksize, gen, *exists, entry);
+	return rc;
+}
+
+/**
+ * Allocate the dentry cache on mount, so that it stays valid for other threads until umount
+ * whatever dfs_dcache_set() does.  It is enabled if requested through the environment.
+ */
+static void
+dcache_mount(dfs_t *dfs)
+{
+	unsigned int	timeout = 0;
+	unsigned int	neg_timeout = 0;
+	int		rc;
+
+	d_getenv_int("DFS_DENTRY_TIMEOUT", &timeout);
+	d_getenv_int("DFS_NDENTRY_TIMEOUT", &neg_timeout);
+
+	rc = dcache_init(dfs, timeout, neg_timeout);
+	if (rc)
+		D_WARN("Failed to allocate dentry cache: %d (%s)\n", rc, strerror(rc));
+	else if (timeout != 0 || neg_timeout != 0)
+		D_DEBUG(DB_ALL, "dentry cache enabled, timeout %us, negative timeout %us\n",
+			timeout, neg_timeout);
+}
+
 static int
 remove_entry(dfs_t *dfs, daos_handle_t th, daos_handle_t parent_oh,
 	     const char *name, size_t len, struct dfs_entry entry)
@@ -793,26 +1244,32 @@ punch_entry:
 	return daos_der2errno(rc);
 }
 
-static int
-insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
-	     uint64_t flags, struct dfs_entry *entry)
-{
+/** update or fetch descriptors of an entry, kept together for the multi-entry operations */
+struct entry_io {
+	daos_key_t	dkey;
+	daos_iod_t	iods[2];
 	d_sg_list_t	sgls[2];
 	d_iov_t		sg_iovs[INODE_AKEYS];
 	d_iov_t		sym_iov;
-	daos_iod_t	iods[2];
 	daos_recx_t	recx;
-	daos_key_t	dkey;
-	unsigned int	i;
 	unsigned int	nr_iods;
-	int		rc;
+};
 
-	d_iov_set(&dkey, (void *)name, len);
+static void
+insert_entry_prep(dfs_layout_ver_t ver, const char *name, size_t len, struct dfs_entry *entry,
+		  struct entry_io *io)
+{
+	daos_iod_t	*iods = io->iods;
+	d_sg_list_t	*sgls = io->sgls;
+	d_iov_t		*sg_iovs = io->sg_iovs;
+	unsigned int	i;
+
+	d_iov_set(&io->dkey, (void *)name, len);
 	d_iov_set(&iods[0].iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
 	iods[0].iod_nr		= 1;
-	recx.rx_idx		= 0;
-	recx.rx_nr		= END_IDX;
-	iods[0].iod_recxs	= &recx;
+	io->recx.rx_idx		= 0;
+	io->recx.rx_nr		= END_IDX;
+	iods[0].iod_recxs	= &io->recx;
 	iods[0].iod_type	= DAOS_IOD_ARRAY;
 	iods[0].iod_size	= 1;
 
@@ -827,18 +1284,18 @@ insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const cha
 	d_iov_set(&sg_iovs[i++], &entry->chunk_size, sizeof(daos_size_t));
 	d_iov_set(&sg_iovs[i++], &entry->oclass, sizeof(daos_oclass_id_t));
 
-	nr_iods = 1;
+	io->nr_iods = 1;
 	/*
 	 * if we are writing to a layout ver 2 or older container, don't add the uid, gid, internal
 	 * mtime, nsec granularity for times, and put symlink value in the same akey.
 	 */
 	if (ver <= 2) {
-		recx.rx_nr = END_L2_IDX;
+		io->recx.rx_nr = END_L2_IDX;
 
 		/** Add symlink value to the array */
 		if (S_ISLNK(entry->mode)) {
 			d_iov_set(&sg_iovs[i++], entry->value, entry->value_len);
-			recx.rx_nr += entry->value_len;
+			io->recx.rx_nr += entry->value_len;
 		}
 	} else {
 		d_iov_set(&sg_iovs[i++], &entry->mtime_nano, sizeof(uint64_t));
@@ -851,25 +1308,35 @@ insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const cha
 
 		/** add the symlink as a separate akey */
 		if (S_ISLNK(entry->mode)) {
-			nr_iods = 2;
+			io->nr_iods = 2;
 			d_iov_set(&iods[1].iod_name, SLINK_AKEY_NAME, sizeof(SLINK_AKEY_NAME) - 1);
 			iods[1].iod_nr		= 1;
 			iods[1].iod_recxs	= NULL;
 			iods[1].iod_type	= DAOS_IOD_SINGLE;
 			iods[1].iod_size	= entry->value_len;
 
-			d_iov_set(&sym_iov, entry->value, entry->value_len);
+			d_iov_set(&io->sym_iov, entry->value, entry->value_len);
 			sgls[1].sg_nr = 1;
 			sgls[1].sg_nr_out = 0;
-			sgls[1].sg_iovs = &sym_iov;
+			sgls[1].sg_iovs = &io->sym_iov;
 		}
 	}
 
 	sgls[0].sg_nr		= i;
 	sgls[0].sg_nr_out	= 0;
 	sgls[0].sg_iovs		= sg_iovs;
+}
 
-	rc = daos_obj_update(oh, th, flags, &dkey, nr_iods, iods, sgls, NULL);
+static int
+insert_entry(dfs_layout_ver_t ver, daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
+	     uint64_t flags, struct dfs_entry *entry)
+{
+	struct entry_io	io;
+	int		rc;
+
+	insert_entry_prep(ver, name, len, entry, &io);
+
+	rc = daos_obj_update(oh, th, flags, &io.dkey, io.nr_iods, io.iods, io.sgls, NULL);
 	if (rc) {
 		/** don't log error if conditional failed */
 		if (rc != -DER_EXIST && rc != -DER_NO_PERM)
@@ -982,11 +1449,147 @@ update_stbuf_times(struct dfs_entry entry, daos_epoch_t max_epoch, struct stat *
 	return 0;
 }
 
+/**
+ * Add \a delta to the writer count of the size hint of \a obj in a transaction, so that concurrent
+ * handles, on this client or others, are serialized. The size of the file is published when the
+ * count drops to 0.
+ */
+static int
+size_hint_writers(dfs_t *dfs, dfs_obj_t *obj, int delta)
+{
+	daos_array_stbuf_t	array_stbuf = {0};
+	struct dfs_size_hint	hint;
+	daos_handle_t		oh;
+	daos_handle_t		th;
+	daos_key_t		dkey;
+	daos_iod_t		iod;
+	d_sg_list_t		sgl;
+	d_iov_t			sg_iov;
+	int			rc, rc2;
+
+	rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RW, &oh, NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	rc = daos_tx_open(dfs->coh, &th, 0, NULL);
+	if (rc) {
+		D_ERROR("daos_tx_open() failed, "DF_RC"\n", DP_RC(rc));
+		D_GOTO(out_obj, rc);
+	}
+
+restart:
+	memset(&hint, 0, sizeof(hint));
+	size_hint_prep(obj->name, strlen(obj->name), &hint, &dkey, &iod, &sgl, &sg_iov);
+	/** never recreate the entry of a file that was removed or renamed */
+	rc = daos_obj_fetch(oh, th, DAOS_COND_DKEY_FETCH, &dkey, 1, &iod, &sgl, NULL, NULL);
+	if (rc == -DER_NONEXIST)
+		D_GOTO(out_tx, rc = 0);
+	if (rc)
+		D_GOTO(out_tx, rc);
+
+	/** no hint yet, or the hint of a previous file with the same name */
+	if (iod.iod_size != sizeof(hint) || daos_oid_cmp(hint.sh_oid, obj->oid) != 0) {
+		memset(&hint, 0, sizeof(hint));
+		oid_cp(&hint.sh_oid, obj->oid);
+	}
+
+	if (delta > 0)
+		hint.sh_writers++;
+	else if (hint.sh_writers > 0)
+		hint.sh_writers--;
+
+	if (hint.sh_writers == 0) {
+		rc = daos_array_stat(obj->oh, DAOS_TX_NONE, &array_stbuf, NULL);
+		if (rc)
+			D_GOTO(out_tx, rc);
+		hint.sh_size = array_stbuf.st_size;
+		hint.sh_epoch = array_stbuf.st_max_epoch;
+	}
+
+	iod.iod_size = sizeof(hint);
+	rc = daos_obj_update(oh, th, DAOS_COND_DKEY_UPDATE, &dkey, 1, &iod, &sgl, NULL);
+	if (rc)
+		D_GOTO(out_tx, rc);
+
+	rc = daos_tx_commit(th, NULL);
+	if (rc == -DER_TX_RESTART) {
+		rc = daos_tx_restart(th, NULL);
+		if (rc == 0)
+			goto restart;
+	}
+
+out_tx:
+	rc2 = daos_tx_close(th, NULL);
+	if (rc == 0)
+		rc = rc2;
+out_obj:
+	daos_obj_close(oh, NULL);
+	return daos_der2errno(rc);
+}
+
+/** called before the size of the file is modified through \a obj */
+static int
+size_hint_mark(dfs_t *dfs, dfs_obj_t *obj)
+{
+	int rc;
+
+	if (!dfs->size_hint || obj->f.hint_dfs != NULL)
+		return 0;
+
+	rc = size_hint_writers(dfs, obj, 1);
+	if (rc) {
+		D_ERROR("Failed to mark size hint of %s stale: %d (%s)\n", obj->name, rc,
+			strerror(rc));
+		return rc;
+	}
+
+	obj->f.hint_dfs = dfs;
+	return 0;
+}
+
+/** on failure the hint stays stale, and the size is queried from the file */
+static void
+size_hint_publish(dfs_obj_t *obj)
+{
+	int rc;
+
+	rc = size_hint_writers(obj->f.hint_dfs, obj, -1);
+	if (rc)
+		D_WARN("Failed to publish size hint of %s: %d (%s)\n", obj->name, rc,
+		       strerror(rc));
+	obj->f.hint_dfs = NULL;
+}
+
+/** return true if the size hint of the file with \a oid can be used */
+static bool
+size_hint_fetch(daos_handle_t oh, daos_handle_t th, const char *name, size_t len,
+		daos_obj_id_t oid, struct dfs_size_hint *hint)
+{
+	daos_key_t	dkey;
+	daos_iod_t	iod;
+	d_sg_list_t	sgl;
+	d_iov_t		sg_iov;
+	int		rc;
+
+	size_hint_prep(name, len, hint, &dkey, &iod, &sgl, &sg_iov);
+	rc = daos_obj_fetch(oh, th, 0, &dkey, 1, &iod, &sgl, NULL, NULL);
+	if (rc) {
+		D_DEBUG(DB_TRACE, "Failed to fetch size hint of %.*s: "DF_RC"\n", (int)len, name,
+			DP_RC(rc));
+		return false;
+	}
+
+	return size_hint_valid(hint, iod.iod_size, oid);
+}
+
 static int
-entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, size_t len,
-	   struct dfs_obj *obj, bool get_size, struct stat *stbuf, uint64_t *obj_hlc)
+entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const daos_obj_id_t *parent,
+	   const char *name, size_t len, struct dfs_obj *obj, bool get_size, struct stat *stbuf,
+	   uint64_t *obj_hlc)
 {
 	struct dfs_entry	entry = {0};
+	struct dfs_size_hint	hint;
+	bool			hint_valid = false;
 	bool			exists;
 	daos_size_t		size;
 	int			rc;
@@ -996,9 +1599,17 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, siz
 	/*
 	 * Check if parent has the entry. In older layout version, we need to fetch the symlink to
 	 * determine the size, but in current version, the size is stored in the inode akey, so no
-	 * need to fetch the symlink.
+	 * need to fetch the symlink. Outside of a transaction, the entry can come from the dentry
+	 * cache if the parent is known. If the size hint is used, it is fetched with the entry
+	 * instead, which costs the same single RPC as a dentry cache miss.
 	 */
-	if (dfs->layout_v > 2)
+	if (dfs->size_hint && get_size)
+		rc = fetch_entry_ext(dfs->layout_v, oh, th, name, len, dfs->layout_v <= 2, &exists,
+				     &entry, 0, NULL, NULL, NULL, &hint, &hint_valid);
+	else if (parent != NULL && daos_handle_is_inval(th))
+		rc = lookup_entry(dfs, parent, oh, name, len, dfs->layout_v <= 2, &exists,
+				  &entry);
+	else if (dfs->layout_v > 2)
 		rc = fetch_entry(dfs->layout_v, oh, th, name, len, false, &exists, &entry, 0,
 				 NULL, NULL, NULL);
 	else
@@ -1058,7 +1669,10 @@ entry_stat(dfs_t *dfs, daos_handle_t th, daos_handle_t oh, const char *name, siz
 			break;
 		}
 
-		if (obj) {
+		if (hint_valid) {
+			array_stbuf.st_size = hint.sh_size;
+			array_stbuf.st_max_epoch = hint.sh_epoch;
+		} else if (obj) {
 			rc = daos_array_stat(obj->oh, th, &array_stbuf, NULL);
 			if (rc)
 				return daos_der2errno(rc);
@@ -1251,6 +1865,7 @@ open_file(dfs_t *dfs, dfs_obj_t *parent, int flags, daos_oclass_id_t cid,
 
 		rc = insert_entry(dfs->layout_v, parent->oh, DAOS_TX_NONE, file->name, len,
 				  DAOS_COND_DKEY_INSERT, entry);
+		dcache_evict(dfs, &parent->oid, file->name, len);
 		if (rc == EEXIST && !oexcl) {
 			/** just try fetching entry to open the file */
 			daos_array_close(file->oh, NULL);
@@ -1296,9 +1911,18 @@ open_file(dfs_t *dfs, dfs_obj_t *parent, int flags, daos_oclass_id_t cid,
 	}
 
 	if (flags & O_TRUNC) {
+		oid_cp(&file->oid, entry->oid);
+		rc = size_hint_mark(dfs, file);
+		if (rc) {
+			daos_array_close(file->oh, NULL);
+			return rc;
+		}
+
 		rc = daos_array_set_size(file->oh, DAOS_TX_NONE, 0, NULL);
 		if (rc) {
 			D_ERROR("Failed to truncate file "DF_RC"\n", DP_RC(rc));
+			if (file->f.hint_dfs != NULL)
+				size_hint_publish(file);
 			daos_array_close(file->oh, NULL);
 			return daos_der2errno(rc);
 		}
@@ -1386,6 +2010,7 @@ open_dir(dfs_t *dfs, dfs_obj_t *parent, int flags, daos_oclass_id_t cid,
 		/** since it's a single conditional op, we don't need a DTX */
 		rc = insert_entry(dfs->layout_v, parent->oh, DAOS_TX_NONE, dir->name, len,
 				  DAOS_COND_DKEY_INSERT, entry);
+		dcache_evict(dfs, &parent->oid, dir->name, len);
 		if (rc == EEXIST && !oexcl) {
 			/** just try fetching entry to open the file */
 			daos_obj_close(dir->oh, NULL);
@@ -1484,6 +2109,7 @@ open_symlink(dfs_t *dfs, dfs_obj_t *parent, int flags, daos_oclass_id_t cid,
 
 		rc = insert_entry(dfs->layout_v, parent->oh, DAOS_TX_NONE, sym->name, len,
 				  DAOS_COND_DKEY_INSERT, entry);
+		dcache_evict(dfs, &parent->oid, sym->name, len);
 		if (rc == EEXIST) {
 			D_FREE(sym->value);
 		} else if (rc != 0) {
@@ -2423,6 +3049,9 @@ dfs_mount(daos_handle_t poh, daos_handle_t coh, int flags, dfs_t **_dfs)
 			dfs->oid.hi = 0;
 	}
 
+	dcache_mount(dfs);
+	d_getenv_int("DFS_REMOVE_INFLIGHT", &dfs->rm_inflight);
+	dfs->size_hint = size_hint_enabled(coh);
 	dfs->mounted = DFS_MOUNT;
 	*_dfs = dfs;
 	daos_prop_free(prop);
@@ -2465,6 +3094,7 @@ dfs_umount(dfs_t *dfs)
 	daos_obj_close(dfs->root.oh, NULL);
 	daos_obj_close(dfs->super_oh, NULL);
 
+	dcache_fini(dfs);
 	D_FREE(dfs->prefix);
 	D_MUTEX_DESTROY(&dfs->lock);
 	D_FREE(dfs);
@@ -2572,6 +3202,7 @@ struct dfs_glob {
 	uuid_t			coh_uuid;
 	daos_obj_id_t		super_oid;
 	daos_obj_id_t		root_oid;
+	bool			size_hint;
 };
 
 static inline void
@@ -2660,6 +3291,7 @@ dfs_local2global(dfs_t *dfs, d_iov_t *glob)
 	dfs_params->oclass	= dfs->attr.da_oclass_id;
 	dfs_params->dir_oclass	= dfs->attr.da_dir_oclass_id;
 	dfs_params->file_oclass	= dfs->attr.da_file_oclass_id;
+	dfs_params->size_hint	= dfs->size_hint;
 	uuid_copy(dfs_params->coh_uuid, coh_uuid);
 	uuid_copy(dfs_params->cont_uuid, cont_uuid);
 
@@ -2769,6 +3401,9 @@ dfs_global2local(daos_handle_t poh, daos_handle_t coh, int flags, d_iov_t glob,
 		D_GOTO(err_dfs, rc = daos_der2errno(rc));
 	}
 
+	dcache_mount(dfs);
+	d_getenv_int("DFS_REMOVE_INFLIGHT", &dfs->rm_inflight);
+	dfs->size_hint = dfs_params->size_hint;
 	dfs->mounted = DFS_MOUNT;
 	*_dfs = dfs;
 
@@ -2996,6 +3631,53 @@ dfs_set_prefix(dfs_t *dfs, const char *prefix)
 	return 0;
 }
 
+int
+dfs_dcache_set(dfs_t *dfs, double dentry_timeout, double ndentry_timeout)
+{
+	struct dfs_dcache *dcache;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dentry_timeout < 0 || ndentry_timeout < 0)
+		return EINVAL;
+
+	/** failed to allocate on mount */
+	dcache = dfs->dcache;
+	if (dcache == NULL)
+		return ENOMEM;
+
+	/** entries already cached keep their expiration time, unless the cache is disabled */
+	D_MUTEX_LOCK(&dcache->dc_lock);
+	dcache->dc_timeout = dentry_timeout * NSEC_PER_SEC;
+	dcache->dc_neg_timeout = ndentry_timeout * NSEC_PER_SEC;
+	if (dentry_timeout == 0 && ndentry_timeout == 0)
+		dcache_flush(dcache);
+	D_MUTEX_UNLOCK(&dcache->dc_lock);
+	return 0;
+}
+
+int
+dfs_dcache_query(dfs_t *dfs, dfs_dcache_stats_t *stats)
+{
+	struct dfs_dcache *dcache;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (stats == NULL)
+		return EINVAL;
+
+	dcache = dfs->dcache;
+	if (dcache == NULL) {
+		memset(stats, 0, sizeof(*stats));
+		return 0;
+	}
+
+	D_MUTEX_LOCK(&dcache->dc_lock);
+	*stats = dcache->dc_stats;
+	D_MUTEX_UNLOCK(&dcache->dc_lock);
+	return 0;
+}
+
 int
 dfs_get_file_oh(dfs_obj_t *obj, daos_handle_t *oh)
 {
@@ -3136,6 +3818,7 @@ dfs_obj_set_oclass(dfs_t *dfs, dfs_obj_t *obj, int flags, daos_oclass_id_t cid)
 
 	rc = daos_obj_update(oh, DAOS_TX_NONE, DAOS_COND_DKEY_UPDATE, &dkey, 1,
 			     &iod, &sgl, NULL);
+	dcache_evict(dfs, &obj->parent_oid, obj->name, strlen(obj->name));
 	if (rc) {
 		D_ERROR("Failed to update object class ("DF_RC")\n", DP_RC(rc));
 		D_GOTO(out, rc = daos_der2errno(rc));
@@ -3193,6 +3876,7 @@ dfs_obj_set_chunk_size(dfs_t *dfs, dfs_obj_t *obj, int flags, daos_size_t csize)
 
 	rc = daos_obj_update(oh, DAOS_TX_NONE, DAOS_COND_DKEY_UPDATE, &dkey, 1,
 			     &iod, &sgl, NULL);
+	dcache_evict(dfs, &obj->parent_oid, obj->name, strlen(obj->name));
 	if (rc) {
 		D_ERROR("Failed to update chunk size ("DF_RC")\n", DP_RC(rc));
 		D_GOTO(out, rc = daos_der2errno(rc));
@@ -3207,6 +3891,314 @@ out:
 	return rc;
 }
 
+/** per-entry state of dfs_create_multi() and dfs_stat_multi() */
+struct multi_entry {
+	struct dfs_entry	me_entry;
+	struct entry_io		me_io;
+	/** errno code of the entry, reported to the caller on completion */
+	int			me_rc;
+	/** array open handle, size and epoch of a regular file for dfs_stat_multi() */
+	daos_handle_t		me_oh;
+	daos_size_t		me_cell_size;
+	daos_size_t		me_chunk_size;
+	daos_array_stbuf_t	me_array_stbuf;
+};
+
+struct multi_params {
+	dfs_t			*mp_dfs;
+	int			mp_nr;
+	int			*mp_rcs;
+	/** NULL for dfs_create_multi() */
+	struct stat		*mp_stbufs;
+	/** parent of the entries created by dfs_create_multi(), evicted on completion */
+	daos_obj_id_t		mp_parent;
+	bool			mp_evict;
+	struct multi_entry	mp_ents[0];
+};
+
+/** record the first failure of the sub tasks of an entry */
+static int
+multi_entry_comp_cb(tse_task_t *task, void *data)
+{
+	struct multi_entry *me = *(struct multi_entry **)data;
+
+	if (task->dt_result != 0 && me->me_rc == 0)
+		me->me_rc = daos_der2errno(task->dt_result);
+	return 0;
+}
+
+static void
+multi_fill_stat(dfs_t *dfs, struct multi_entry *me, struct stat *stbuf)
+{
+	struct dfs_entry	*entry = &me->me_entry;
+	daos_size_t		size;
+
+	memset(stbuf, 0, sizeof(struct stat));
+
+	switch (entry->mode & S_IFMT) {
+	case S_IFDIR:
+		size = sizeof(*entry);
+		stbuf->st_mtim.tv_sec = entry->mtime;
+		stbuf->st_mtim.tv_nsec = entry->mtime_nano;
+		stbuf->st_ctim.tv_sec = entry->ctime;
+		stbuf->st_ctim.tv_nsec = entry->ctime_nano;
+		break;
+	case S_IFREG:
+		stbuf->st_blksize = entry->chunk_size ? entry->chunk_size :
+			dfs->attr.da_chunk_size;
+		size = me->me_array_stbuf.st_size;
+		me->me_rc = update_stbuf_times(*entry, me->me_array_stbuf.st_max_epoch, stbuf,
+					       NULL);
+		stbuf->st_blocks = (size + (1 << 9) - 1) >> 9;
+		break;
+	case S_IFLNK:
+		size = entry->value_len;
+		stbuf->st_mtim.tv_sec = entry->mtime;
+		stbuf->st_mtim.tv_nsec = entry->mtime_nano;
+		stbuf->st_ctim.tv_sec = entry->ctime;
+		stbuf->st_ctim.tv_nsec = entry->ctime_nano;
+		break;
+	default:
+		D_ERROR("Invalid entry type (not a dir, file, symlink).\n");
+		me->me_rc = EINVAL;
+		return;
+	}
+
+	stbuf->st_nlink = 1;
+	stbuf->st_size = size;
+	stbuf->st_mode = entry->mode;
+	stbuf->st_uid = entry->uid;
+	stbuf->st_gid = entry->gid;
+	if (tspec_gt(stbuf->st_ctim, stbuf->st_mtim)) {
+		stbuf->st_atim.tv_sec = stbuf->st_ctim.tv_sec;
+		stbuf->st_atim.tv_nsec = stbuf->st_ctim.tv_nsec;
+	} else {
+		stbuf->st_atim.tv_sec = stbuf->st_mtim.tv_sec;
+		stbuf->st_atim.tv_nsec = stbuf->st_mtim.tv_nsec;
+	}
+}
+
+/** completion of a multi-entry operation, report the per-entry results */
+static int
+multi_comp_cb(tse_task_t *task, void *data)
+{
+	struct multi_params	*params = daos_task_get_priv(task);
+	int			i;
+
+	for (i = 0; i < params->mp_nr; i++) {
+		struct multi_entry *me = &params->mp_ents[i];
+
+		if (task->dt_result == 0 && me->me_rc == 0 && params->mp_stbufs != NULL)
+			multi_fill_stat(params->mp_dfs, me, &params->mp_stbufs[i]);
+		if (params->mp_evict && me->me_io.dkey.iov_buf != NULL)
+			dcache_evict(params->mp_dfs, &params->mp_parent, me->me_io.dkey.iov_buf,
+				     me->me_io.dkey.iov_len);
+		params->mp_rcs[i] = task->dt_result ? daos_der2errno(task->dt_result) : me->me_rc;
+	}
+
+	D_FREE(params);
+	return 0;
+}
+
+/** all the updates of dfs_create_multi() are done once this runs */
+static int
+create_multi_body(tse_task_t *task)
+{
+	tse_task_complete(task, 0);
+	return 0;
+}
+
+static int
+array_stat_prep_cb(tse_task_t *task, void *data)
+{
+	struct multi_entry	*me = *(struct multi_entry **)data;
+	daos_array_stat_t	*args = daos_task_get_args(task);
+
+	args->oh = me->me_oh;
+	return 0;
+}
+
+static int
+array_close_prep_cb(tse_task_t *task, void *data)
+{
+	struct multi_entry	*me = *(struct multi_entry **)data;
+	daos_array_close_t	*args = daos_task_get_args(task);
+
+	args->oh = me->me_oh;
+	return 0;
+}
+
+/**
+ * All the entries of dfs_stat_multi() are fetched once this runs, query the size and epoch of
+ * the regular files. The task completes when those queries are done.
+ */
+static int
+stat_multi_body(tse_task_t *task)
+{
+	struct multi_params	*params = daos_task_get_priv(task);
+	dfs_t			*dfs = params->mp_dfs;
+	tse_sched_t		*sched = tse_task2sched(task);
+	d_list_t		task_list;
+	int			i;
+	int			rc = 0;
+
+	D_INIT_LIST_HEAD(&task_list);
+	for (i = 0; i < params->mp_nr; i++) {
+		struct multi_entry	*me = &params->mp_ents[i];
+		tse_task_t		*open_task;
+		tse_task_t		*stat_task;
+		tse_task_t		*close_task;
+		daos_array_open_t	*open_args;
+		daos_array_stat_t	*stat_args;
+
+		if (me->me_rc != 0)
+			continue;
+		if (me->me_io.sgls[0].sg_nr_out == 0) {
+			me->me_rc = ENOENT;
+			continue;
+		}
+		if (!S_ISREG(me->me_entry.mode))
+			continue;
+
+		me->me_cell_size = 1;
+		me->me_chunk_size = me->me_entry.chunk_size ? me->me_entry.chunk_size :
+			dfs->attr.da_chunk_size;
+
+		rc = daos_task_create(DAOS_OPC_ARRAY_OPEN, sched, 0, NULL, &open_task);
+		if (rc)
+			D_GOTO(err, rc);
+		open_args = daos_task_get_args(open_task);
+		open_args->coh			= dfs->coh;
+		open_args->oid			= me->me_entry.oid;
+		open_args->th			= DAOS_TX_NONE;
+		open_args->mode			= DAOS_OO_RO;
+		open_args->open_with_attr	= 1;
+		open_args->cell_size		= &me->me_cell_size;
+		open_args->chunk_size		= &me->me_chunk_size;
+		open_args->oh			= &me->me_oh;
+		rc = tse_task_register_comp_cb(open_task, multi_entry_comp_cb, &me, sizeof(me));
+		if (rc) {
+			tse_task_complete(open_task, rc);
+			D_GOTO(err, rc);
+		}
+		tse_task_list_add(open_task, &task_list);
+
+		/** the handle is only known once opened, set it from the prep callback */
+		rc = daos_task_create(DAOS_OPC_ARRAY_STAT, sched, 1, &open_task, &stat_task);
+		if (rc)
+			D_GOTO(err, rc);
+		stat_args = daos_task_get_args(stat_task);
+		stat_args->th		= DAOS_TX_NONE;
+		stat_args->stbuf	= &me->me_array_stbuf;
+		rc = tse_task_register_cbs(stat_task, array_stat_prep_cb, &me, sizeof(me),
+					   multi_entry_comp_cb, &me, sizeof(me));
+		if (rc) {
+			tse_task_complete(stat_task, rc);
+			D_GOTO(err, rc);
+		}
+		tse_task_list_add(stat_task, &task_list);
+
+		rc = daos_task_create(DAOS_OPC_ARRAY_CLOSE, sched, 1, &stat_task, &close_task);
+		if (rc)
+			D_GOTO(err, rc);
+		rc = tse_task_register_cbs(close_task, array_close_prep_cb, &me, sizeof(me),
+					   NULL, NULL, 0);
+		if (rc) {
+			tse_task_complete(close_task, rc);
+			D_GOTO(err, rc);
+		}
+		tse_task_list_add(close_task, &task_list);
+
+		rc = tse_task_register_deps(task, 1, &close_task);
+		if (rc)
+			D_GOTO(err, rc);
+	}
+
+	/** nothing to query, otherwise the task completes with the queries it depends on */
+	if (d_list_empty(&task_list)) {
+		tse_task_complete(task, 0);
+		return 0;
+	}
+
+	tse_task_list_sched(&task_list, false);
+	return 0;
+
+err:
+	tse_task_list_abort(&task_list, rc);
+	tse_task_complete(task, rc);
+	return rc;
+}
+
+/** create the main task of a multi-entry operation, its body runs after all the entry I/Os */
+static int
+multi_task_create(dfs_t *dfs, int nr, int *rcs, struct stat *stbufs, tse_task_func_t body,
+		  daos_event_t *ev, tse_task_t **taskp)
+{
+	struct multi_params	*params;
+	tse_task_t		*task;
+	int			rc;
+
+	D_ALLOC(params, sizeof(*params) + nr * sizeof(params->mp_ents[0]));
+	if (params == NULL)
+		return ENOMEM;
+	params->mp_dfs = dfs;
+	params->mp_nr = nr;
+	params->mp_rcs = rcs;
+	params->mp_stbufs = stbufs;
+
+	rc = dc_task_create(body, NULL, ev, &task);
+	if (rc) {
+		D_FREE(params);
+		return daos_der2errno(rc);
+	}
+
+	daos_task_set_priv(task, params);
+	/** entries fail individually, they don't fail the whole operation */
+	tse_disable_propagate(task);
+	rc = tse_task_register_comp_cb(task, multi_comp_cb, NULL, 0);
+	if (rc) {
+		D_FREE(params);
+		tse_task_complete(task, rc);
+		return daos_der2errno(rc);
+	}
+
+	*taskp = task;
+	return 0;
+}
+
+/** add the I/O task of an entry to a multi-entry operation */
+static int
+multi_task_add(tse_task_t *task, tse_task_t *io_task, struct multi_entry *me, d_list_t *task_list)
+{
+	int rc;
+
+	rc = tse_task_register_comp_cb(io_task, multi_entry_comp_cb, &me, sizeof(me));
+	if (rc == 0)
+		rc = tse_task_register_deps(task, 1, &io_task);
+	if (rc) {
+		tse_task_complete(io_task, rc);
+		return rc;
+	}
+
+	tse_task_list_add(io_task, task_list);
+	return 0;
+}
+
+static int
+multi_task_sched(tse_task_t *task, d_list_t *task_list)
+{
+	tse_task_list_sched(task_list, false);
+	return daos_der2errno(dc_task_schedule(task, true));
+}
+
+static int
+multi_task_abort(tse_task_t *task, d_list_t *task_list, int rc)
+{
+	tse_task_list_abort(task_list, rc);
+	tse_task_complete(task, rc);
+	return daos_der2errno(rc);
+}
+
 int
 dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	  daos_oclass_id_t cid)
@@ -3250,18 +4242,119 @@ dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	entry.uid = geteuid();
 	entry.gid = getegid();
 
-	rc = insert_entry(dfs->layout_v, parent->oh, th, name, len, DAOS_COND_DKEY_INSERT,
-			  &entry);
-	if (rc != 0) {
-		daos_obj_close(new_dir.oh, NULL);
+	rc = insert_entry(dfs->layout_v, parent->oh, th, name, len, DAOS_COND_DKEY_INSERT,
+			  &entry);
+	dcache_evict(dfs, &parent->oid, name, len);
+	if (rc != 0) {
+		daos_obj_close(new_dir.oh, NULL);
+		return rc;
+	}
+
+	rc = daos_obj_close(new_dir.oh, NULL);
+	if (rc != 0)
+		return daos_der2errno(rc);
+
+	return rc;
+}
+
+int
+dfs_create_multi(dfs_t *dfs, dfs_obj_t *parent, int nr, const char *names[], mode_t mode,
+		 daos_oclass_id_t cid, daos_size_t chunk_size, int *rcs, daos_event_t *ev)
+{
+	struct multi_params	*params;
+	tse_task_t		*task;
+	d_list_t		task_list;
+	struct timespec		now;
+	bool			file = S_ISREG(mode);
+	int			i;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (dfs->amode != O_RDWR)
+		return EPERM;
+	if (nr <= 0 || names == NULL || rcs == NULL)
+		return EINVAL;
+	if (!file && !S_ISDIR(mode))
+		return EINVAL;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+
+	/** set oclass and chunk size. order: API, parent dir, cont default */
+	if (cid == 0) {
+		if (parent->d.oclass != 0)
+			cid = parent->d.oclass;
+		else if (file)
+			cid = dfs->attr.da_file_oclass_id;
+		else
+			cid = dfs->attr.da_dir_oclass_id;
+	}
+	if (!file)
+		chunk_size = parent->d.chunk_size;
+	else if (chunk_size == 0)
+		chunk_size = parent->d.chunk_size ? parent->d.chunk_size : dfs->attr.da_chunk_size;
+
+	rc = clock_gettime(CLOCK_REALTIME, &now);
+	if (rc)
+		return errno;
+
+	rc = multi_task_create(dfs, nr, rcs, NULL, create_multi_body, ev, &task);
+	if (rc)
 		return rc;
-	}
+	params = daos_task_get_priv(task);
+	oid_cp(&params->mp_parent, parent->oid);
+	params->mp_evict = true;
+
+	D_INIT_LIST_HEAD(&task_list);
+	for (i = 0; i < nr; i++) {
+		struct multi_entry	*me = &params->mp_ents[i];
+		struct dfs_entry	*entry = &me->me_entry;
+		daos_obj_update_t	*args;
+		tse_task_t		*io_task;
+		size_t			len;
+
+		me->me_rc = check_name(names[i], &len);
+		if (me->me_rc)
+			continue;
 
-	rc = daos_obj_close(new_dir.oh, NULL);
-	if (rc != 0)
-		return daos_der2errno(rc);
+		/** Allocate an OID for the entry - local operation */
+		me->me_rc = oid_gen(dfs, cid, file, &entry->oid);
+		if (me->me_rc)
+			continue;
 
-	return rc;
+		entry->mode = mode;
+		entry->atime = entry->mtime = entry->ctime = now.tv_sec;
+		entry->atime_nano = entry->mtime_nano = entry->ctime_nano = now.tv_nsec;
+		entry->chunk_size = chunk_size;
+		if (!file)
+			entry->oclass = parent->d.oclass;
+		entry->uid = geteuid();
+		entry->gid = getegid();
+
+		insert_entry_prep(dfs->layout_v, names[i], len, entry, &me->me_io);
+
+		rc = daos_task_create(DAOS_OPC_OBJ_UPDATE, tse_task2sched(task), 0, NULL,
+				      &io_task);
+		if (rc)
+			return multi_task_abort(task, &task_list, rc);
+
+		args		= daos_task_get_args(io_task);
+		args->oh	= parent->oh;
+		args->th	= DAOS_TX_NONE;
+		args->flags	= DAOS_COND_DKEY_INSERT;
+		args->dkey	= &me->me_io.dkey;
+		args->nr	= me->me_io.nr_iods;
+		args->iods	= me->me_io.iods;
+		args->sgls	= me->me_io.sgls;
+
+		rc = multi_task_add(task, io_task, me, &task_list);
+		if (rc)
+			return multi_task_abort(task, &task_list, rc);
+	}
+
+	return multi_task_sched(task, &task_list);
 }
 
 static int
@@ -3301,11 +4394,12 @@ remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
 
 		for (ptr = enum_buf, i = 0; i < number; i++) {
 			struct dfs_entry child_entry = {0};
+			char *name = ptr;
 			bool exists;
 
 			ptr += kds[i].kd_key_len;
 
-			rc = fetch_entry(dfs->layout_v, oh, th, ptr, kds[i].kd_key_len, false,
+			rc = fetch_entry(dfs->layout_v, oh, th, name, kds[i].kd_key_len, false,
 					 &exists, &child_entry, 0, NULL, NULL, NULL);
 			if (rc)
 				D_GOTO(out, rc);
@@ -3319,8 +4413,9 @@ remove_dir_contents(dfs_t *dfs, daos_handle_t th, struct dfs_entry entry)
 					D_GOTO(out, rc);
 			}
 
-			rc = remove_entry(dfs, th, oh, ptr, kds[i].kd_key_len,
+			rc = remove_entry(dfs, th, oh, name, kds[i].kd_key_len,
 					  child_entry);
+			dcache_evict(dfs, &entry.oid, name, kds[i].kd_key_len);
 			if (rc)
 				D_GOTO(out, rc);
 		}
@@ -3331,9 +4426,460 @@ out:
 	return rc;
 }
 
-int
-dfs_remove(dfs_t *dfs, dfs_obj_t *parent, const char *name, bool force,
-	   daos_obj_id_t *oid)
+/*
+ * Parallel removal of a directory tree. Every directory is enumerated and every entry removed with
+ * asynchronous operations on a private EQ, with up to rc_max of them in flight. An entry is removed
+ * by fetching its mode and oid, punching its object and then its dkey in the parent directory. A
+ * sub-directory found on the way is enumerated the same way, and its own entry is removed once
+ * all the entries it contains are gone.
+ */
+#define RM_ENUM_NR	64
+#define RM_POLL_NR	64
+
+enum rm_op_type {
+	RM_LIST,
+	RM_FETCH,
+	RM_PUNCH_OBJ,
+	RM_PUNCH_DKEY,
+};
+
+struct rm_dir;
+
+struct rm_op {
+	d_list_t		ro_link;
+	daos_event_t		ro_ev;
+	enum rm_op_type		ro_type;
+	/** directory being enumerated, or the one holding the entry */
+	struct rm_dir		*ro_dir;
+	/** object of the entry, open while it is being punched */
+	daos_handle_t		ro_oh;
+	mode_t			ro_mode;
+	daos_obj_id_t		ro_oid;
+	daos_key_t		ro_dkey;
+	daos_iod_t		ro_iod;
+	daos_recx_t		ro_recx;
+	d_sg_list_t		ro_sgl;
+	d_iov_t			ro_iovs[2];
+	char			ro_name[DFS_MAX_NAME + 1];
+};
+
+struct rm_dir {
+	/** on rc_dirs */
+	d_list_t		rd_link;
+	/** removes the entry of the directory once it is empty, NULL for the top directory */
+	struct rm_op		*rd_op;
+	struct rm_op		rd_list;
+	daos_handle_t		rd_oh;
+	daos_obj_id_t		rd_oid;
+	/** entries not removed yet, plus one until the enumeration is done */
+	uint64_t		rd_pending;
+	daos_anchor_t		rd_anchor;
+	uint32_t		rd_nr;
+	daos_key_desc_t		rd_kds[RM_ENUM_NR];
+	d_iov_t			rd_iov;
+	d_sg_list_t		rd_sgl;
+	/** enumeration buffer, only allocated while the directory is being enumerated */
+	char			*rd_buf;
+};
+
+struct rm_ctx {
+	dfs_t			*rc_dfs;
+	daos_handle_t		rc_eq;
+	uint32_t		rc_max;
+	/** ready punches, issued first since they release memory */
+	d_list_t		rc_punch;
+	/** ready entry fetches */
+	d_list_t		rc_fetch;
+	uint32_t		rc_fetch_nr;
+	/** ready enumerations, LIFO so that started directories are finished first */
+	d_list_t		rc_list;
+	/** directories not removed yet */
+	d_list_t		rc_dirs;
+	dfs_remove_stats_t	rc_stats;
+	dfs_remove_cb_t		rc_cb;
+	void			*rc_cb_arg;
+	/** first error, nothing new is issued once set */
+	int			rc_rc;
+};
+
+static void
+rm_op_free(struct rm_op *op)
+{
+	/** enumerations are embedded in their directory */
+	if (op->ro_type == RM_LIST)
+		return;
+	if (daos_handle_is_valid(op->ro_oh))
+		daos_obj_close(op->ro_oh, NULL);
+	D_FREE(op);
+}
+
+static void
+rm_dir_free(struct rm_dir *dir)
+{
+	if (daos_handle_is_valid(dir->rd_oh))
+		daos_obj_close(dir->rd_oh, NULL);
+	D_FREE(dir->rd_buf);
+	D_FREE(dir);
+}
+
+static int
+rm_dir_add(struct rm_ctx *ctx, struct rm_op *op, daos_obj_id_t oid)
+{
+	struct rm_dir	*dir;
+
+	D_ALLOC_PTR(dir);
+	if (dir == NULL)
+		return ENOMEM;
+
+	dir->rd_op = op;
+	dir->rd_oid = oid;
+	dir->rd_oh = DAOS_HDL_INVAL;
+	dir->rd_pending = 1;
+	dir->rd_list.ro_type = RM_LIST;
+	dir->rd_list.ro_dir = dir;
+	dir->rd_list.ro_oh = DAOS_HDL_INVAL;
+	d_list_add_tail(&dir->rd_link, &ctx->rc_dirs);
+	d_list_add(&dir->rd_list.ro_link, &ctx->rc_list);
+	return 0;
+}
+
+static int
+rm_entry_add(struct rm_ctx *ctx, struct rm_dir *dir, const char *name, size_t len)
+{
+	struct rm_op	*op;
+
+	D_ALLOC_PTR(op);
+	if (op == NULL)
+		return ENOMEM;
+
+	op->ro_type = RM_FETCH;
+	op->ro_dir = dir;
+	op->ro_oh = DAOS_HDL_INVAL;
+	memcpy(op->ro_name, name, len);
+	d_iov_set(&op->ro_dkey, op->ro_name, len);
+
+	/** only the mode and the oid are needed, they are at the same offset in all layouts */
+	d_iov_set(&op->ro_iod.iod_name, INODE_AKEY_NAME, sizeof(INODE_AKEY_NAME) - 1);
+	op->ro_iod.iod_nr	= 1;
+	op->ro_recx.rx_idx	= MODE_IDX;
+	op->ro_recx.rx_nr	= sizeof(mode_t) + sizeof(daos_obj_id_t);
+	op->ro_iod.iod_recxs	= &op->ro_recx;
+	op->ro_iod.iod_type	= DAOS_IOD_ARRAY;
+	op->ro_iod.iod_size	= 1;
+	d_iov_set(&op->ro_iovs[0], &op->ro_mode, sizeof(mode_t));
+	d_iov_set(&op->ro_iovs[1], &op->ro_oid, sizeof(daos_obj_id_t));
+	op->ro_sgl.sg_nr	= 2;
+	op->ro_sgl.sg_nr_out	= 0;
+	op->ro_sgl.sg_iovs	= op->ro_iovs;
+
+	dir->rd_pending++;
+	d_list_add_tail(&op->ro_link, &ctx->rc_fetch);
+	ctx->rc_fetch_nr++;
+	return 0;
+}
+
+/** the directory is empty, queue the removal of its own entry */
+static void
+rm_dir_check(struct rm_ctx *ctx, struct rm_dir *dir)
+{
+	struct rm_op	*op = dir->rd_op;
+
+	if (dir->rd_pending != 0)
+		return;
+
+	d_list_del(&dir->rd_link);
+	if (op != NULL) {
+		/** the object punch of the directory reuses its handle */
+		op->ro_oh = dir->rd_oh;
+		dir->rd_oh = DAOS_HDL_INVAL;
+		op->ro_type = RM_PUNCH_OBJ;
+		d_list_add_tail(&op->ro_link, &ctx->rc_punch);
+	}
+	rm_dir_free(dir);
+}
+
+static int
+rm_op_launch(struct rm_ctx *ctx, struct rm_op *op)
+{
+	struct rm_dir	*dir = op->ro_dir;
+	int		rc;
+
+	if (op->ro_type == RM_LIST && dir->rd_buf == NULL) {
+		if (daos_handle_is_inval(dir->rd_oh)) {
+			rc = daos_obj_open(ctx->rc_dfs->coh, dir->rd_oid, DAOS_OO_RW, &dir->rd_oh,
+					   NULL);
+			if (rc)
+				return daos_der2errno(rc);
+		}
+		D_ALLOC(dir->rd_buf, RM_ENUM_NR * DFS_MAX_NAME);
+		if (dir->rd_buf == NULL)
+			return ENOMEM;
+		d_iov_set(&dir->rd_iov, dir->rd_buf, RM_ENUM_NR * DFS_MAX_NAME);
+		dir->rd_sgl.sg_nr = 1;
+		dir->rd_sgl.sg_nr_out = 0;
+		dir->rd_sgl.sg_iovs = &dir->rd_iov;
+	}
+
+	rc = daos_event_init(&op->ro_ev, ctx->rc_eq, NULL);
+	if (rc)
+		return daos_der2errno(rc);
+
+	switch (op->ro_type) {
+	case RM_LIST:
+		dir->rd_nr = RM_ENUM_NR;
+		rc = daos_obj_list_dkey(dir->rd_oh, DAOS_TX_NONE, &dir->rd_nr, dir->rd_kds,
+					&dir->rd_sgl, &dir->rd_anchor, &op->ro_ev);
+		break;
+	case RM_FETCH:
+		rc = daos_obj_fetch(dir->rd_oh, DAOS_TX_NONE, DAOS_COND_DKEY_FETCH, &op->ro_dkey, 1,
+				    &op->ro_iod, &op->ro_sgl, NULL, &op->ro_ev);
+		break;
+	case RM_PUNCH_OBJ:
+		rc = daos_obj_punch(op->ro_oh, DAOS_TX_NONE, 0, &op->ro_ev);
+		break;
+	case RM_PUNCH_DKEY:
+		rc = daos_obj_punch_dkeys(dir->rd_oh, DAOS_TX_NONE, DAOS_COND_PUNCH, 1,
+					  &op->ro_dkey, &op->ro_ev);
+		break;
+	}
+	/** an error returned here means the event was never launched */
+	if (rc) {
+		daos_event_fini(&op->ro_ev);
+		return daos_der2errno(rc);
+	}
+	return 0;
+}
+
+static void
+rm_launch(struct rm_ctx *ctx)
+{
+	struct rm_op	*op;
+	int		rc;
+
+	while (ctx->rc_rc == 0 && ctx->rc_stats.drs_inflight < ctx->rc_max) {
+		op = d_list_pop_entry(&ctx->rc_punch, struct rm_op, ro_link);
+		/** keep enumerating ahead, as long as the entries found are dispatched quickly */
+		if (op == NULL && ctx->rc_fetch_nr < ctx->rc_max)
+			op = d_list_pop_entry(&ctx->rc_list, struct rm_op, ro_link);
+		if (op == NULL) {
+			op = d_list_pop_entry(&ctx->rc_fetch, struct rm_op, ro_link);
+			if (op != NULL)
+				ctx->rc_fetch_nr--;
+		}
+		if (op == NULL)
+			op = d_list_pop_entry(&ctx->rc_list, struct rm_op, ro_link);
+		if (op == NULL)
+			break;
+
+		rc = rm_op_launch(ctx, op);
+		if (rc) {
+			rm_op_free(op);
+			ctx->rc_rc = rc;
+			break;
+		}
+		ctx->rc_stats.drs_inflight++;
+	}
+}
+
+static int
+rm_list_done(struct rm_ctx *ctx, struct rm_dir *dir)
+{
+	char		*ptr = dir->rd_buf;
+	uint32_t	i;
+	int		rc;
+
+	for (i = 0; i < dir->rd_nr; i++) {
+		rc = rm_entry_add(ctx, dir, ptr, dir->rd_kds[i].kd_key_len);
+		if (rc)
+			return rc;
+		ptr += dir->rd_kds[i].kd_key_len;
+	}
+
+	if (!daos_anchor_is_eof(&dir->rd_anchor)) {
+		d_list_add(&dir->rd_list.ro_link, &ctx->rc_list);
+		return 0;
+	}
+
+	D_FREE(dir->rd_buf);
+	dir->rd_pending--;
+	rm_dir_check(ctx, dir);
+	return 0;
+}
+
+static int
+rm_fetch_done(struct rm_ctx *ctx, struct rm_op *op)
+{
+	int	rc;
+
+	if (S_ISDIR(op->ro_mode))
+		return rm_dir_add(ctx, op, op->ro_oid);
+
+	if (S_ISLNK(op->ro_mode)) {
+		op->ro_type = RM_PUNCH_DKEY;
+	} else {
+		rc = daos_obj_open(ctx->rc_dfs->coh, op->ro_oid, DAOS_OO_RW, &op->ro_oh, NULL);
+		if (rc)
+			return daos_der2errno(rc);
+		op->ro_type = RM_PUNCH_OBJ;
+	}
+	d_list_add_tail(&op->ro_link, &ctx->rc_punch);
+	return 0;
+}
+
+/** the entry is gone, account for it in its parent directory */
+static void
+rm_entry_done(struct rm_ctx *ctx, struct rm_op *op)
+{
+	struct rm_dir	*dir = op->ro_dir;
+
+	dcache_evict(ctx->rc_dfs, &dir->rd_oid, op->ro_name, op->ro_dkey.iov_len);
+	if (S_ISDIR(op->ro_mode))
+		ctx->rc_stats.drs_dirs++;
+	else if (op->ro_type != RM_FETCH)
+		ctx->rc_stats.drs_files++;
+	rm_op_free(op);
+
+	dir->rd_pending--;
+	rm_dir_check(ctx, dir);
+}
+
+static void
+rm_op_done(struct rm_ctx *ctx, struct rm_op *op, int err)
+{
+	int	rc = 0;
+
+	/** drain what is in flight on failure */
+	if (ctx->rc_rc) {
+		rm_op_free(op);
+		return;
+	}
+
+	/** the entry was removed by someone else */
+	if (err == -DER_NONEXIST && (op->ro_type == RM_FETCH || op->ro_type == RM_PUNCH_DKEY)) {
+		rm_entry_done(ctx, op);
+		return;
+	}
+	if (err) {
+		D_ERROR("Failed to remove entry, op %d: "DF_RC"\n", op->ro_type, DP_RC(err));
+		rm_op_free(op);
+		ctx->rc_rc = daos_der2errno(err);
+		return;
+	}
+
+	switch (op->ro_type) {
+	case RM_LIST:
+		rc = rm_list_done(ctx, op->ro_dir);
+		break;
+	case RM_FETCH:
+		if (op->ro_iod.iod_size == 0) {
+			rm_entry_done(ctx, op);
+			return;
+		}
+		rc = rm_fetch_done(ctx, op);
+		if (rc)
+			rm_op_free(op);
+		break;
+	case RM_PUNCH_OBJ:
+		rc = daos_obj_close(op->ro_oh, NULL);
+		op->ro_oh = DAOS_HDL_INVAL;
+		if (rc) {
+			rm_op_free(op);
+			rc = daos_der2errno(rc);
+			break;
+		}
+		op->ro_type = RM_PUNCH_DKEY;
+		d_list_add_tail(&op->ro_link, &ctx->rc_punch);
+		break;
+	case RM_PUNCH_DKEY:
+		rm_entry_done(ctx, op);
+		break;
+	}
+	if (rc)
+		ctx->rc_rc = rc;
+}
+
+static void
+rm_ctx_fini(struct rm_ctx *ctx)
+{
+	struct rm_op	*op;
+	struct rm_dir	*dir;
+
+	while ((op = d_list_pop_entry(&ctx->rc_punch, struct rm_op, ro_link)) != NULL)
+		rm_op_free(op);
+	while ((op = d_list_pop_entry(&ctx->rc_fetch, struct rm_op, ro_link)) != NULL)
+		rm_op_free(op);
+	while ((op = d_list_pop_entry(&ctx->rc_list, struct rm_op, ro_link)) != NULL)
+		;
+	while ((dir = d_list_pop_entry(&ctx->rc_dirs, struct rm_dir, rd_link)) != NULL) {
+		if (dir->rd_op != NULL)
+			rm_op_free(dir->rd_op);
+		rm_dir_free(dir);
+	}
+}
+
+static int
+remove_dir_contents_par(dfs_t *dfs, struct dfs_entry entry, uint32_t max_inflight,
+			dfs_remove_cb_t cb, void *arg)
+{
+	struct rm_ctx	ctx = {0};
+	daos_event_t	*evs[RM_POLL_NR];
+	int		i;
+	int		rc;
+
+	D_ASSERT(S_ISDIR(entry.mode));
+
+	ctx.rc_dfs = dfs;
+	ctx.rc_max = max_inflight;
+	ctx.rc_cb = cb;
+	ctx.rc_cb_arg = arg;
+	D_INIT_LIST_HEAD(&ctx.rc_punch);
+	D_INIT_LIST_HEAD(&ctx.rc_fetch);
+	D_INIT_LIST_HEAD(&ctx.rc_list);
+	D_INIT_LIST_HEAD(&ctx.rc_dirs);
+
+	rc = daos_eq_create(&ctx.rc_eq);
+	if (rc)
+		return daos_der2errno(rc);
+
+	rc = rm_dir_add(&ctx, NULL, entry.oid);
+	if (rc)
+		D_GOTO(out, rc);
+
+	while (1) {
+		rm_launch(&ctx);
+		if (ctx.rc_stats.drs_inflight == 0)
+			break;
+
+		rc = daos_eq_poll(ctx.rc_eq, 0, DAOS_EQ_WAIT, RM_POLL_NR, evs);
+		if (rc < 0) {
+			D_ERROR("daos_eq_poll() failed, "DF_RC"\n", DP_RC(rc));
+			D_GOTO(out, rc = daos_der2errno(rc));
+		}
+
+		for (i = 0; i < rc; i++) {
+			struct rm_op	*op = container_of(evs[i], struct rm_op, ro_ev);
+			int		err = evs[i]->ev_error;
+
+			daos_event_fini(evs[i]);
+			ctx.rc_stats.drs_inflight--;
+			rm_op_done(&ctx, op, err);
+		}
+
+		if (ctx.rc_cb != NULL && ctx.rc_rc == 0)
+			ctx.rc_rc = ctx.rc_cb(&ctx.rc_stats, ctx.rc_cb_arg);
+	}
+	rc = ctx.rc_rc;
+
+out:
+	/** events can only be left behind if polling failed, abort them before freeing */
+	daos_eq_destroy(ctx.rc_eq, rc ? DAOS_EQ_DESTROY_FORCE : 0);
+	rm_ctx_fini(&ctx);
+	return rc;
+}
+
+static int
+remove_int(dfs_t *dfs, dfs_obj_t *parent, const char *name, bool force, uint32_t max_inflight,
+	   dfs_remove_cb_t cb, void *arg, daos_obj_id_t *oid)
 {
 	struct dfs_entry	entry = {0};
 	daos_handle_t		th = DAOS_TX_NONE;
@@ -3397,7 +4943,11 @@ restart:
 			D_GOTO(out, rc = ENOTEMPTY);
 
 		if (force && nr != 0) {
-			rc = remove_dir_contents(dfs, th, entry);
+			/** transactions are not parallelized, all updates go out at commit */
+			if (max_inflight > 0 && !dfs->use_dtx)
+				rc = remove_dir_contents_par(dfs, entry, max_inflight, cb, arg);
+			else
+				rc = remove_dir_contents(dfs, th, entry);
 			if (rc)
 				D_GOTO(out, rc);
 		}
@@ -3423,9 +4973,28 @@ out:
 	rc = check_tx(th, rc);
 	if (rc == ERESTART)
 		goto restart;
+	/** the removal is committed, or failed */
+	dcache_evict(dfs, &parent->oid, name, len);
 	return rc;
 }
 
+int
+dfs_remove(dfs_t *dfs, dfs_obj_t *parent, const char *name, bool force,
+	   daos_obj_id_t *oid)
+{
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+
+	return remove_int(dfs, parent, name, force, dfs->rm_inflight, NULL, NULL, oid);
+}
+
+int
+dfs_remove_tree(dfs_t *dfs, dfs_obj_t *parent, const char *name, uint32_t max_inflight,
+		dfs_remove_cb_t cb, void *arg, daos_obj_id_t *oid)
+{
+	return remove_int(dfs, parent, name, true, max_inflight, cb, arg, oid);
+}
+
 static int
 lookup_rel_path(dfs_t *dfs, dfs_obj_t *root, const char *path, int flags,
 		dfs_obj_t **_obj, mode_t *mode, struct stat *stbuf,
@@ -3534,8 +5103,7 @@ lookup_rel_path_loop:
 		len = strlen(token);
 
 		entry.chunk_size = 0;
-		rc = fetch_entry(dfs->layout_v, parent.oh, DAOS_TX_NONE, token, len, true,
-				 &exists, &entry, 0, NULL, NULL, NULL);
+		rc = lookup_entry(dfs, &parent.oid, parent.oh, token, len, true, &exists, &entry);
 		if (rc)
 			D_GOTO(err_obj, rc);
 
@@ -3816,9 +5384,9 @@ readdir_int(dfs_t *dfs, dfs_obj_t *obj, daos_anchor_t *anchor, uint32_t *nr,
 
 			/** stat the entry if requested */
 			if (stbufs) {
-				rc = entry_stat(dfs, DAOS_TX_NONE, obj->oh, dirs[key_nr].d_name,
-						kds[i].kd_key_len, NULL, true, &stbufs[key_nr],
-						NULL);
+				rc = entry_stat(dfs, DAOS_TX_NONE, obj->oh, &obj->oid,
+						dirs[key_nr].d_name, kds[i].kd_key_len, NULL, true,
+						&stbufs[key_nr], NULL);
 				if (rc) {
 					D_ERROR("Failed to stat entry %s: %d (%s)\n",
 						dirs[key_nr].d_name, rc, strerror(rc));
@@ -3968,8 +5536,13 @@ dfs_lookup_rel_int(dfs_t *dfs, dfs_obj_t *parent, const char *name, int flags,
 	if (daos_mode == -1)
 		return EINVAL;
 
-	rc = fetch_entry(dfs->layout_v, parent->oh, DAOS_TX_NONE, name, len, true, &exists,
-			 &entry, xnr, xnames, xvals, xsizes);
+	/** xattrs are fetched along with the entry, they are not cached */
+	if (xnr == 0)
+		rc = lookup_entry(dfs, &parent->oid, parent->oh, name, len, true, &exists,
+				  &entry);
+	else
+		rc = fetch_entry(dfs->layout_v, parent->oh, DAOS_TX_NONE, name, len, true,
+				 &exists, &entry, xnr, xnames, xvals, xsizes);
 	if (rc)
 		return rc;
 
@@ -4512,6 +6085,8 @@ dfs_release(dfs_obj_t *obj)
 		rc = daos_obj_close(obj->oh, NULL);
 		break;
 	case S_IFREG:
+		if (obj->f.hint_dfs != NULL)
+			size_hint_publish(obj);
 		rc = daos_array_close(obj->oh, NULL);
 		break;
 	case S_IFLNK:
@@ -4745,6 +6320,10 @@ dfs_write(dfs_t *dfs, dfs_obj_t *obj, d_sg_list_t *sgl, daos_off_t off,
 
 	D_DEBUG(DB_TRACE, "DFS Write: Off %"PRIu64", Len %zu\n", off, buf_size);
 
+	rc = size_hint_mark(dfs, obj);
+	if (rc)
+		return rc;
+
 	if (ev)
 		daos_event_errno_rc(ev);
 
@@ -4785,6 +6364,10 @@ dfs_writex(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl,
 	arr_iod.arr_nr = iod->iod_nr;
 	arr_iod.arr_rgs = iod->iod_rgs;
 
+	rc = size_hint_mark(dfs, obj);
+	if (rc)
+		return rc;
+
 	if (ev)
 		daos_event_errno_rc(ev);
 
@@ -4825,6 +6408,7 @@ int
 dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 {
 	daos_handle_t	oh;
+	daos_obj_id_t	*parent_oid;
 	size_t		len;
 	int		rc;
 
@@ -4843,14 +6427,16 @@ dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name, struct stat *stbuf)
 		name = parent->name;
 		len = strlen(parent->name);
 		oh = dfs->super_oh;
+		parent_oid = &dfs->super_oid;
 	} else {
 		rc = check_name(name, &len);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		parent_oid = &parent->oid;
 	}
 
-	return entry_stat(dfs, DAOS_TX_NONE, oh, name, len, NULL, true, stbuf, NULL);
+	return entry_stat(dfs, DAOS_TX_NONE, oh, parent_oid, name, len, NULL, true, stbuf, NULL);
 }
 
 int
@@ -4869,8 +6455,8 @@ dfs_ostat(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf)
 	if (rc)
 		return daos_der2errno(rc);
 
-	rc = entry_stat(dfs, DAOS_TX_NONE, oh, obj->name, strlen(obj->name), obj, true, stbuf,
-			NULL);
+	rc = entry_stat(dfs, DAOS_TX_NONE, oh, &obj->parent_oid, obj->name, strlen(obj->name), obj,
+			true, stbuf, NULL);
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -4879,10 +6465,74 @@ out:
 	return rc;
 }
 
+int
+dfs_stat_multi(dfs_t *dfs, dfs_obj_t *parent, int nr, const char *names[],
+	       struct stat *stbufs, int *rcs, daos_event_t *ev)
+{
+	struct multi_params	*params;
+	tse_task_t		*task;
+	d_list_t		task_list;
+	int			i;
+	int			rc;
+
+	if (dfs == NULL || !dfs->mounted)
+		return EINVAL;
+	if (nr <= 0 || names == NULL || stbufs == NULL || rcs == NULL)
+		return EINVAL;
+	/** older layouts need the symlink value for its size, not worth it */
+	if (dfs->layout_v <= 2)
+		return ENOTSUP;
+	if (parent == NULL)
+		parent = &dfs->root;
+	else if (!S_ISDIR(parent->mode))
+		return ENOTDIR;
+
+	rc = multi_task_create(dfs, nr, rcs, stbufs, stat_multi_body, ev, &task);
+	if (rc)
+		return rc;
+	params = daos_task_get_priv(task);
+
+	D_INIT_LIST_HEAD(&task_list);
+	for (i = 0; i < nr; i++) {
+		struct multi_entry	*me = &params->mp_ents[i];
+		daos_obj_fetch_t	*args;
+		tse_task_t		*io_task;
+		size_t			len;
+
+		me->me_rc = check_name(names[i], &len);
+		if (me->me_rc)
+			continue;
+
+		/** the inode akey is fetched with the same layout it is inserted with */
+		insert_entry_prep(dfs->layout_v, names[i], len, &me->me_entry, &me->me_io);
+
+		rc = daos_task_create(DAOS_OPC_OBJ_FETCH, tse_task2sched(task), 0, NULL,
+				      &io_task);
+		if (rc)
+			return multi_task_abort(task, &task_list, rc);
+
+		args		= daos_task_get_args(io_task);
+		args->oh	= parent->oh;
+		args->th	= DAOS_TX_NONE;
+		args->flags	= DAOS_COND_DKEY_FETCH;
+		args->dkey	= &me->me_io.dkey;
+		args->nr	= 1;
+		args->iods	= me->me_io.iods;
+		args->sgls	= me->me_io.sgls;
+
+		rc = multi_task_add(task, io_task, me, &task_list);
+		if (rc)
+			return multi_task_abort(task, &task_list, rc);
+	}
+
+	return multi_task_sched(task, &task_list);
+}
+
 int
 dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask)
 {
 	daos_handle_t		oh;
+	daos_obj_id_t		*parent_oid;
 	bool			exists;
 	struct dfs_entry	entry = {0};
 	size_t			len;
@@ -4906,16 +6556,17 @@ dfs_access(dfs_t *dfs, dfs_obj_t *parent, const char *name, int mask)
 		name = parent->name;
 		len = strlen(name);
 		oh = dfs->super_oh;
+		parent_oid = &dfs->super_oid;
 	} else {
 		rc = check_name(name, &len);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		parent_oid = &parent->oid;
 	}
 
 	/* Check if parent has the entry */
-	rc = fetch_entry(dfs->layout_v, oh, DAOS_TX_NONE, name, len, true, &exists, &entry,
-			 0, NULL, NULL, NULL);
+	rc = lookup_entry(dfs, parent_oid, oh, name, len, true, &exists, &entry);
 	if (rc)
 		return rc;
 
@@ -4973,6 +6624,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 	dfs_obj_t		*sym;
 	mode_t			orig_mode;
 	const char		*entry_name;
+	const daos_obj_id_t	*entry_parent;
 	struct timespec		now;
 	int			rc;
 
@@ -4993,11 +6645,13 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 		name = parent->name;
 		len = strlen(name);
 		oh = dfs->super_oh;
+		entry_parent = &dfs->super_oid;
 	} else {
 		rc = check_name(name, &len);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		entry_parent = &parent->oid;
 	}
 
 	/** sticky bit, set-user-id and set-group-id, are not supported */
@@ -5035,6 +6689,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 
 		orig_mode = sym->mode;
 		entry_name = sym->name;
+		entry_parent = &sym->parent_oid;
 		len = strlen(entry_name);
 	} else {
 		orig_mode = entry.mode;
@@ -5076,6 +6731,7 @@ dfs_chmod(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode)
 	d_iov_set(&sg_iovs[2], &now.tv_nsec, sizeof(uint64_t));
 
 	rc = daos_obj_update(oh, th, DAOS_COND_DKEY_UPDATE, &dkey, 1, &iod, &sgl, NULL);
+	dcache_evict(dfs, entry_parent, entry_name, len);
 	if (rc) {
 		D_ERROR("Failed to update mode, "DF_RC"\n", DP_RC(rc));
 		D_GOTO(out, rc = daos_der2errno(rc));
@@ -5104,6 +6760,7 @@ dfs_chown(dfs_t *dfs, dfs_obj_t *parent, const char *name, uid_t uid, gid_t gid,
 	size_t			len;
 	dfs_obj_t		*sym;
 	const char		*entry_name;
+	const daos_obj_id_t	*entry_parent;
 	int			i;
 	struct timespec		now;
 	int			rc;
@@ -5129,11 +6786,13 @@ dfs_chown(dfs_t *dfs, dfs_obj_t *parent, const char *name, uid_t uid, gid_t gid,
 		name = parent->name;
 		len = strlen(name);
 		oh = dfs->super_oh;
+		entry_parent = &dfs->super_oid;
 	} else {
 		rc = check_name(name, &len);
 		if (rc)
 			return rc;
 		oh = parent->oh;
+		entry_parent = &parent->oid;
 	}
 
 	/* Check if parent has the entry */
@@ -5166,6 +6825,7 @@ dfs_chown(dfs_t *dfs, dfs_obj_t *parent, const char *name, uid_t uid, gid_t gid,
 			return daos_der2errno(rc);
 		}
 		entry_name = sym->name;
+		entry_parent = &sym->parent_oid;
 		len = strlen(entry_name);
 	} else {
 		if (S_ISLNK(entry.mode))
@@ -5216,6 +6876,7 @@ dfs_chown(dfs_t *dfs, dfs_obj_t *parent, const char *name, uid_t uid, gid_t gid,
 	sgl.sg_iovs	= &sg_iovs[0];
 
 	rc = daos_obj_update(oh, th, DAOS_COND_DKEY_UPDATE, &dkey, 1, &iod, &sgl, NULL);
+	dcache_evict(dfs, entry_parent, entry_name, len);
 	if (rc) {
 		D_ERROR("Failed to update owner/group, "DF_RC"\n", DP_RC(rc));
 		D_GOTO(out, rc = daos_der2errno(rc));
@@ -5280,9 +6941,9 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 	 * been updated. If we are setting the file size, there is no need to query it.
 	 */
 	if (flags & DFS_SET_ATTR_SIZE)
-		rc = entry_stat(dfs, th, oh, obj->name, len, obj, false, &rstat, &obj_hlc);
+		rc = entry_stat(dfs, th, oh, NULL, obj->name, len, obj, false, &rstat, &obj_hlc);
 	else
-		rc = entry_stat(dfs, th, oh, obj->name, len, obj, true, &rstat, &obj_hlc);
+		rc = entry_stat(dfs, th, oh, NULL, obj->name, len, obj, true, &rstat, &obj_hlc);
 	if (rc)
 		D_GOTO(out_obj, rc);
 
@@ -5384,6 +7045,10 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 		D_GOTO(out_obj, rc = EINVAL);
 
 	if (set_size) {
+		rc = size_hint_mark(dfs, obj);
+		if (rc)
+			D_GOTO(out_obj, rc);
+
 		rc = daos_array_set_size(obj->oh, th, stbuf->st_size, NULL);
 		if (rc)
 			D_GOTO(out_obj, rc = daos_der2errno(rc));
@@ -5429,6 +7094,7 @@ dfs_osetattr(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf, int flags)
 	sgl.sg_iovs	= &sg_iovs[0];
 
 	rc = daos_obj_update(oh, th, DAOS_COND_DKEY_UPDATE, &dkey, 1, &iod, &sgl, NULL);
+	dcache_evict(dfs, &obj->parent_oid, obj->name, len);
 	if (rc) {
 		D_ERROR("Failed to update attr "DF_RC"\n", DP_RC(rc));
 		D_GOTO(out_obj, rc = daos_der2errno(rc));
@@ -5451,6 +7117,23 @@ dfs_get_size(dfs_t *dfs, dfs_obj_t *obj, daos_size_t *size)
 	if (obj == NULL || !S_ISREG(obj->mode))
 		return EINVAL;
 
+	if (dfs->size_hint) {
+		struct dfs_size_hint	hint;
+		daos_handle_t		oh;
+		bool			valid;
+
+		rc = daos_obj_open(dfs->coh, obj->parent_oid, DAOS_OO_RO, &oh, NULL);
+		if (rc)
+			return daos_der2errno(rc);
+		valid = size_hint_fetch(oh, DAOS_TX_NONE, obj->name, strlen(obj->name), obj->oid,
+					&hint);
+		daos_obj_close(oh, NULL);
+		if (valid) {
+			*size = hint.sh_size;
+			return 0;
+		}
+	}
+
 	rc = daos_array_get_size(obj->oh, DAOS_TX_NONE, size, NULL);
 	return daos_der2errno(rc);
 }
@@ -5473,6 +7156,10 @@ dfs_punch(dfs_t *dfs, dfs_obj_t *obj, daos_off_t offset, daos_size_t len)
 	if ((obj->flags & O_ACCMODE) == O_RDONLY)
 		return EPERM;
 
+	rc = size_hint_mark(dfs, obj);
+	if (rc)
+		return rc;
+
 	/** simple truncate */
 	if (len == DFS_MAX_FSIZE) {
 		rc = daos_array_set_size(obj->oh, DAOS_TX_NONE, offset, NULL);
@@ -5841,6 +7528,10 @@ out:
 	if (rc == ERESTART)
 		goto restart;
 
+	/** the move is committed, or failed */
+	dcache_evict(dfs, &parent->oid, name, len);
+	dcache_evict(dfs, &new_parent->oid, new_name, new_len);
+
 	if (entry.value) {
 		D_ASSERT(S_ISLNK(entry.mode));
 		D_FREE(entry.value);
@@ -5977,6 +7668,10 @@ out:
 	if (rc == ERESTART)
 		goto restart;
 
+	/** the exchange is committed, or failed */
+	dcache_evict(dfs, &parent1->oid, name1, len1);
+	dcache_evict(dfs, &parent2->oid, name2, len2);
+
 	if (entry1.value) {
 		D_ASSERT(S_ISLNK(entry1.mode));
 		D_FREE(entry1.value);
@@ -6107,6 +7802,7 @@ dfs_setxattr(dfs_t *dfs, dfs_obj_t *obj, const char *name,
 	}
 
 out:
+	dcache_evict(dfs, &obj->parent_oid, obj->name, strlen(obj->name));
 	daos_obj_close(oh, NULL);
 free:
 	D_FREE(xname);
@@ -6260,6 +7956,7 @@ dfs_removexattr(dfs_t *dfs, dfs_obj_t *obj, const char *name)
 	}
 
 out:
+	dcache_evict(dfs, &obj->parent_oid, obj->name, strlen(obj->name));
 	daos_obj_close(oh, NULL);
 free:
 	D_FREE(xname);
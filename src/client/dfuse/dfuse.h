@@ -8,6 +8,7 @@
 #define __DFUSE_H__
 
 #include <semaphore.h>
+#include <sched.h>
 
 #include <fuse3/fuse.h>
 #include <fuse3/fuse_lowlevel.h>
@@ -23,6 +24,10 @@
 #include "dfs_internal.h"
 
 #include "dfuse_common.h"
+#include "dfuse_ioctl.h"
+
+/* Cap on the number of event queues, with --eq-per-core cores share queues beyond this */
+#define DFUSE_EQ_MAX DFUSE_IOCTL_EQ_MAX
 
 struct dfuse_info {
 	struct fuse_session *di_session;
@@ -31,6 +36,7 @@ struct dfuse_info {
 	uint32_t             di_thread_count;
 	uint32_t             di_equeue_count;
 	bool                 di_threaded;
+	bool                 di_eq_per_core;
 	bool                 di_foreground;
 	bool                 di_caching;
 	bool                 di_multi_user;
@@ -53,6 +59,46 @@ struct dfuse_projection_info {
 	struct dfuse_eq    *dpi_eqt;
 	int                 dpi_eqt_count;
 	ATOMIC uint64_t     dpi_eqt_idx;
+
+	/* Array of progress threads, each one draining every dpi_progress_count'th eq */
+	struct dfuse_progress *dpi_progress;
+	int                    dpi_progress_count;
+
+	/* Map of cpu number to index in dpi_eqt when there are per-core eqs, NULL otherwise */
+	int                   *dpi_cpu_eqt;
+	int                    dpi_cpu_count;
+
+	/* Protects ie_rdc for all inodes and dpi_rdc_list, held only whilst attaching or
+	 * detaching a cache
+	 */
+	pthread_mutex_t        dpi_rdc_lock;
+	/* Listings attached to inodes, oldest first */
+	d_list_t               dpi_rdc_list;
+	/* Number of entries held by all listings, attached or not */
+	ATOMIC uint64_t        dpi_rdc_entries;
+
+	/* Thread reading ahead on directory listings after readdir has replied, requests are
+	 * queued on dpi_rdp_list under dpi_rdp_lock and dpi_rdp_sem is posted once for each.
+	 */
+	pthread_t              dpi_rdp_thread;
+	pthread_mutex_t        dpi_rdp_lock;
+	d_list_t               dpi_rdp_list;
+	sem_t                  dpi_rdp_sem;
+};
+
+struct dfuse_progress {
+	struct dfuse_projection_info *dp_handle;
+
+	/* Semaphore to signal event waiting for async thread */
+	sem_t                         dp_sem;
+
+	pthread_t                     dp_thread;
+
+	/* Index of the first eq drained by this thread */
+	int                           dp_idx;
+
+	/* Cores using the eqs drained by this thread, the thread is bound to these */
+	cpu_set_t                     dp_cpus;
 };
 
 struct dfuse_eq {
@@ -60,15 +106,30 @@ struct dfuse_eq {
 
 	/* Event queue for async events */
 	daos_handle_t                 de_eq;
-	/* Semaphore to signal event waiting for async thread */
-	sem_t                         de_sem;
 
-	pthread_t                     de_thread;
+	/* Thread which polls this eq */
+	struct dfuse_progress        *de_prog;
+
+	/* Queue depth, the number of events launched and not yet completed, as well as the
+	 * highest depth seen and the total number of events.  Reported at shutdown and by
+	 * DFUSE_IOCTL_EQ_STATS.
+	 */
+	ATOMIC int64_t                de_depth;
+	ATOMIC int64_t                de_max_depth;
+	ATOMIC uint64_t               de_events;
 
 	struct d_slab_type           *de_read_slab;
 	struct d_slab_type           *de_write_slab;
 };
 
+/* Select an event queue for a new request, the one for the current core if there is one */
+struct dfuse_eq *
+dfuse_eq_pick(struct dfuse_projection_info *fs_handle);
+
+/* Account for an event launched on eqt, and wake up the thread that polls it */
+void
+dfuse_eq_submit(struct dfuse_eq *eqt);
+
 /* Maximum size dfuse expects for read requests, this is not a limit but rather what is expected */
 #define DFUSE_MAX_READ (1024 * 1024)
 
@@ -104,6 +165,11 @@ struct dfuse_obj_hdl {
 	/** readdir handle. */
 	struct dfuse_readdir_hdl *doh_rd;
 
+	/** Shared directory listing, used instead of doh_rd if readdir caching is enabled */
+	struct dfuse_readdir_cache *doh_rdc;
+	/** Offset expected for the next readdir call on doh_rdc */
+	off_t                     doh_rdc_offset;
+
 	ATOMIC uint32_t           doh_il_calls;
 
 	/** Number of active readdir operations */
@@ -162,6 +228,57 @@ struct dfuse_readdir_hdl {
 	uint32_t                   drh_anchor_index;
 };
 
+/* An entry in a cached directory listing */
+struct dfuse_readdir_centry {
+	/** stat data, mode and inode number are always set, the rest only if dce_stat_valid */
+	struct stat  dce_stbuf;
+	/** Open object, duplicated for each readdirplus reply that creates an inode */
+	dfs_obj_t   *dce_obj;
+	/** UNS xattr for directories, if one exists */
+	char        *dce_attr;
+	daos_size_t  dce_attr_len;
+	/** Full stat data and xattr have been read */
+	bool         dce_stat_valid;
+	/** Entry was removed between the listing and the lookup */
+	bool         dce_gone;
+	char         dce_name[NAME_MAX + 1];
+};
+
+/* Directory listing shared between all open handles of a directory.
+ *
+ * The listing is read from DAOS on demand and kept for dfc_readdir_timeout seconds from the
+ * time it was started, so opendir calls within that window and any number of concurrent
+ * handles are served from memory.  The offset reported to the kernel is the index into
+ * drc_ents so seekdir works across handles.  Local changes to the directory detach the cache
+ * from the inode so new handles start a fresh listing, whilst existing handles keep reading
+ * the listing they started with.
+ */
+struct dfuse_readdir_cache {
+	pthread_mutex_t               drc_lock;
+	/** References from the inode, open handles and in-progress prefetch */
+	ATOMIC uint32_t               drc_ref;
+	/** Link in dpi_rdc_list and the inode, set whilst attached, protected by dpi_rdc_lock */
+	d_list_t                      drc_list;
+	struct dfuse_inode_entry     *drc_ie;
+	struct dfuse_projection_info *drc_handle;
+	daos_anchor_t                 drc_anchor;
+	/** Entries from index drc_base to drc_count, earlier ones have been dropped */
+	struct dfuse_readdir_centry  *drc_ents;
+	uint32_t                      drc_base;
+	/** Number of entries read so far */
+	uint32_t                      drc_count;
+	/** Allocated size of drc_ents */
+	uint32_t                      drc_size;
+	/** Incremented each time the listing is restarted from the beginning */
+	uint32_t                      drc_gen;
+	/** Time the listing was started */
+	struct timespec               drc_time;
+	/** The whole directory has been read */
+	bool                          drc_eof;
+	/** A prefetch is queued for this listing, protected by dpi_rdp_lock */
+	bool                          drc_prefetch;
+};
+
 /*
  * Set required initial state in dfuse_obj_hdl.
  */
@@ -282,6 +399,7 @@ struct dfuse_cont {
 	double			dfc_dentry_timeout;
 	double			dfc_dentry_dir_timeout;
 	double			dfc_ndentry_timeout;
+	double			dfc_readdir_timeout;
 	double			dfc_data_timeout;
 	bool			dfc_direct_io_disable;
 };
@@ -645,6 +763,9 @@ struct dfuse_inode_entry {
 	/** Number of active readdir operations */
 	ATOMIC uint32_t          ie_readir_number;
 
+	/** Cached directory listing, protected by dpi_rdc_lock */
+	struct dfuse_readdir_cache *ie_rdc;
+
 	/** file was truncated from 0 to a certain size */
 	bool                     ie_truncated;
 
@@ -683,6 +804,32 @@ dfuse_compute_inode(struct dfuse_cont *dfs,
 void
 dfuse_cache_evict_dir(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie);
 
+/* Drop any cached listing of the parent directory.  Called when the attributes of an entry
+ * change so that readdirplus does not report stale data for it.
+ */
+void
+dfuse_cache_evict_parent(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie);
+
+/* Drop a reference on a cached directory listing, freeing it on last use */
+void
+dfuse_readdir_cache_decref(struct dfuse_readdir_cache *rdc);
+
+/* Thread function for reading ahead on cached directory listings */
+void *
+dfuse_readdir_prefetch_thread(void *arg);
+
+/* Drop any prefetch requests still queued at shutdown */
+void
+dfuse_readdir_prefetch_drain(struct dfuse_projection_info *fs_handle);
+
+/* Detach the cached listing from a directory inode, if there is one */
+void
+dfuse_readdir_cache_detach(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie);
+
+/* Release the listing of a directory handle on close, and drop expired listings */
+void
+dfuse_readdir_cache_release(struct dfuse_projection_info *fs_handle, struct dfuse_obj_hdl *oh);
+
 /* Mark the cache as up-to-date from now */
 void
 dfuse_cache_set_time(struct dfuse_inode_entry *ie);
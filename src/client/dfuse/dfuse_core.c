@@ -9,29 +9,68 @@
 #include "dfuse_common.h"
 #include "dfuse.h"
 
+/* Time to block polling one eq when a pass over all the eqs of a thread found nothing, in
+ * microseconds.  Events completing on the other eqs of the thread wait for up to this long.
+ */
+#define DFUSE_PROGRESS_WAIT 1000
+
+/* Poll an eq and run the completion callbacks, returns the number of events completed */
+static int
+dfuse_eq_progress(struct dfuse_eq *eqt, int64_t timeout, daos_event_t **dev, int nr)
+{
+	int rc;
+	int i;
+
+	rc = daos_eq_poll(eqt->de_eq, 1, timeout, nr, dev);
+	if (rc < 0) {
+		DFUSE_TRA_WARNING(eqt, "Error from daos_eq_poll, " DF_RC, DP_RC(rc));
+		return 0;
+	}
+	for (i = 0; i < rc; i++) {
+		struct dfuse_event *ev;
+
+		ev = container_of(dev[i], struct dfuse_event, de_ev);
+		atomic_fetch_sub_relaxed(&eqt->de_depth, 1);
+		ev->de_complete_cb(ev);
+	}
+	return rc;
+}
+
 /* Async progress thread.
  *
- * A number of threads are created at launch, each thread having its own event queue with a
- * semaphore to wakeup, posted for each entry added to the event queue and once for shutdown.
- * When there are no entries on the eq then the thread will yield in the semaphore, when there
- * are pending events it'll spin in eq_poll() for completion.  All pending events should be
- * completed before thread exit, should exit be called with pending events.
+ * A number of threads are created at launch, each thread polling one or more event queues, with a
+ * semaphore to wakeup, posted for each entry added to any of its event queues and once for
+ * shutdown.  When there are no entries on the eqs then the thread will yield in the semaphore,
+ * when there are pending events it'll block in eq_poll() for completion if there is only one eq,
+ * or poll each busy eq in turn otherwise.  If a pass over the busy eqs completes nothing then the
+ * last one is polled with a timeout rather than spinning.  All pending events should be completed
+ * before thread exit, should exit be called with pending events.
  */
 static void *
 dfuse_progress_thread(void *arg)
 {
-	struct dfuse_eq *eqt = arg;
-	daos_event_t    *dev[128];
-	int              to_consume = 1;
+	struct dfuse_progress        *prog      = arg;
+	struct dfuse_projection_info *fs_handle = prog->dp_handle;
+	int                           stride    = fs_handle->dpi_progress_count;
+	int64_t                       timeout   = 0;
+	daos_event_t                 *dev[128];
+	int                           to_consume = 1;
+
+	/* Only one eq to poll so block on it */
+	if (prog->dp_idx + stride >= fs_handle->dpi_eqt_count)
+		timeout = DAOS_EQ_WAIT;
 
 	while (1) {
-		int rc;
-		int i;
+		struct dfuse_eq *eqt;
+		struct dfuse_eq *busy;
+		int              rc;
+		int              i;
+		int              j;
 
 		for (i = 0; i < to_consume; i++) {
 cont:
 			errno = 0;
-			rc    = sem_wait(&eqt->de_sem);
+			rc    = sem_wait(&prog->dp_sem);
 
 			if (rc != 0) {
 				rc = errno;
@@ -39,39 +78,74 @@ cont:
 				if (rc == EINTR)
 					D_GOTO(cont, 0);
 
-				DFUSE_TRA_ERROR(eqt, "Error from sem_wait: %d", rc);
+				DFUSE_TRA_ERROR(prog, "Error from sem_wait: %d", rc);
 			}
 		}
 
-		if (eqt->de_handle->dpi_shutdown) {
-			int pending;
+		if (fs_handle->dpi_shutdown) {
+			int pending = 0;
 
-			pending = daos_eq_query(eqt->de_eq, DAOS_EQR_ALL, 0, NULL);
-			DFUSE_TRA_INFO(eqt, "There are %d events pending", pending);
+			for (j = prog->dp_idx; j < fs_handle->dpi_eqt_count; j += stride)
+				pending += daos_eq_query(fs_handle->dpi_eqt[j].de_eq, DAOS_EQR_ALL, 0,
+							 NULL);
+			DFUSE_TRA_INFO(prog, "There are %d events pending", pending);
 
 			if (pending == 0)
 				return NULL;
 		}
 
-		rc = daos_eq_poll(eqt->de_eq, 1, DAOS_EQ_WAIT, 128, &dev[0]);
-		if (rc >= 1) {
-			for (i = 0; i < rc; i++) {
-				struct dfuse_event *ev;
+		to_consume = 0;
+		busy       = NULL;
+		for (j = prog->dp_idx; j < fs_handle->dpi_eqt_count; j += stride) {
+			eqt = &fs_handle->dpi_eqt[j];
 
-				ev = container_of(dev[i], struct dfuse_event, de_ev);
-				ev->de_complete_cb(ev);
-			}
-			to_consume = rc;
-		} else if (rc < 0) {
-			DFUSE_TRA_WARNING(eqt, "Error from daos_eq_poll, " DF_RC, DP_RC(rc));
-			to_consume = 0;
-		} else {
-			to_consume = 0;
+			if (timeout == 0 && atomic_load_relaxed(&eqt->de_depth) <= 0)
+				continue;
+
+			busy = eqt;
+			to_consume += dfuse_eq_progress(eqt, timeout, dev, ARRAY_SIZE(dev));
 		}
+
+		/* Nothing completed but events are in flight, wait on the last busy eq */
+		if (to_consume == 0 && timeout == 0 && busy != NULL)
+			to_consume = dfuse_eq_progress(busy, DFUSE_PROGRESS_WAIT, dev,
+						       ARRAY_SIZE(dev));
 	}
 	return NULL;
 }
 
+struct dfuse_eq *
+dfuse_eq_pick(struct dfuse_projection_info *fs_handle)
+{
+	uint64_t eqt_idx;
+	int      cpu;
+
+	if (fs_handle->dpi_cpu_eqt != NULL) {
+		cpu = sched_getcpu();
+		if (cpu >= 0 && cpu < fs_handle->dpi_cpu_count && fs_handle->dpi_cpu_eqt[cpu] >= 0)
+			return &fs_handle->dpi_eqt[fs_handle->dpi_cpu_eqt[cpu]];
+	}
+
+	eqt_idx = atomic_fetch_add_relaxed(&fs_handle->dpi_eqt_idx, 1);
+
+	return &fs_handle->dpi_eqt[eqt_idx % fs_handle->dpi_eqt_count];
+}
+
+void
+dfuse_eq_submit(struct dfuse_eq *eqt)
+{
+	int64_t depth;
+	int64_t max_depth;
+
+	atomic_fetch_add_relaxed(&eqt->de_events, 1);
+	depth     = atomic_fetch_add_relaxed(&eqt->de_depth, 1) + 1;
+	max_depth = atomic_load_relaxed(&eqt->de_max_depth);
+	while (depth > max_depth && !atomic_compare_exchange(&eqt->de_max_depth, max_depth, depth))
+		;
+
+	sem_post(&eqt->de_prog->dp_sem);
+}
+
 /* Parse a string to a time, used for reading container attributes info
  * timeouts.
  */
@@ -488,11 +562,12 @@ dfuse_pool_get_handle(struct dfuse_projection_info *fs_handle, uuid_t pool,
 	return dfuse_pool_connect(fs_handle, uuid_str, _dfp);
 }
 
-#define ATTR_COUNT 6
+#define ATTR_COUNT 7
 
 char const *const cont_attr_names[ATTR_COUNT] = {
     "dfuse-attr-time",    "dfuse-dentry-time", "dfuse-dentry-dir-time",
-    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable"};
+    "dfuse-ndentry-time", "dfuse-data-cache",  "dfuse-direct-io-disable",
+    "dfuse-readdir-time"};
 
 #define ATTR_TIME_INDEX              0
 #define ATTR_DENTRY_INDEX            1
@@ -500,6 +575,7 @@ char const *const cont_attr_names[ATTR_COUNT] = {
 #define ATTR_NDENTRY_INDEX           3
 #define ATTR_DATA_CACHE_INDEX        4
 #define ATTR_DIRECT_IO_DISABLE_INDEX 5
+#define ATTR_READDIR_INDEX           6
 
 /* Attribute values are of the form "120M", so the buffer does not need to be
  * large.
@@ -546,6 +622,7 @@ dfuse_cont_get_cache(struct dfuse_cont *dfc)
 	unsigned int value;
 	bool         have_dentry     = false;
 	bool         have_dentry_dir = false;
+	bool         have_readdir    = false;
 	bool         have_dio        = false;
 	bool         have_cache_off  = false;
 
@@ -639,6 +716,9 @@ dfuse_cont_get_cache(struct dfuse_cont *dfc)
 			dfc->dfc_dentry_dir_timeout = value;
 		} else if (i == ATTR_NDENTRY_INDEX) {
 			dfc->dfc_ndentry_timeout = value;
+		} else if (i == ATTR_READDIR_INDEX) {
+			have_readdir             = true;
+			dfc->dfc_readdir_timeout = value;
 		}
 	}
 
@@ -654,6 +734,8 @@ dfuse_cont_get_cache(struct dfuse_cont *dfc)
 
 	if (have_dentry && !have_dentry_dir)
 		dfc->dfc_dentry_dir_timeout = dfc->dfc_dentry_timeout;
+	if (have_dentry && !have_readdir)
+		dfc->dfc_readdir_timeout = dfc->dfc_dentry_timeout;
 	rc = 0;
 out:
 	D_FREE(buff);
@@ -671,7 +753,9 @@ out:
  *
  * One second is used for attributes, dentries and negative dentries, however
  * dentries which represent directories and are therefore referenced much
- * more often during path-walk activities are set to five seconds.
+ * more often during path-walk activities are set to five seconds.  Directory listings
+ * are kept for five seconds as well so that repeated or concurrent listings of
+ * the same directory do not re-read it.
  */
 void
 dfuse_set_default_cont_cache_values(struct dfuse_cont *dfc)
@@ -680,6 +764,7 @@ dfuse_set_default_cont_cache_values(struct dfuse_cont *dfc)
 	dfc->dfc_dentry_timeout     = 1;
 	dfc->dfc_dentry_dir_timeout = 5;
 	dfc->dfc_ndentry_timeout    = 1;
+	dfc->dfc_readdir_timeout    = 5;
 	dfc->dfc_data_timeout       = 60 * 10;
 	dfc->dfc_direct_io_disable  = false;
 }
@@ -964,6 +1049,54 @@ dfuse_cache_get_valid(struct dfuse_inode_entry *ie, double max_age, double *time
 	return use;
 }
 
+/* Setup one event queue for each core dfuse is allowed to run on, up to DFUSE_EQ_MAX queues
+ * with cores sharing queues beyond that, and record which progress thread polls the eq for
+ * each core so the thread can be bound to them.
+ */
+static int
+dfuse_cpu_map_init(struct dfuse_projection_info *fs_handle)
+{
+	cpu_set_t cpuset;
+	int       cpu;
+	int       eq_count;
+	int       count = 0;
+	int       rc;
+
+	rc = sched_getaffinity(0, sizeof(cpuset), &cpuset);
+	if (rc != 0)
+		return daos_errno2der(errno);
+
+	/* Never have fewer eqs than progress threads */
+	eq_count = min(CPU_COUNT(&cpuset), DFUSE_EQ_MAX);
+	eq_count = max(eq_count, fs_handle->dpi_progress_count);
+
+	fs_handle->dpi_cpu_count = CPU_SETSIZE;
+	D_ALLOC_ARRAY(fs_handle->dpi_cpu_eqt, fs_handle->dpi_cpu_count);
+	if (fs_handle->dpi_cpu_eqt == NULL)
+		return -DER_NOMEM;
+
+	for (cpu = 0; cpu < fs_handle->dpi_cpu_count; cpu++) {
+		struct dfuse_progress *prog;
+		int                    eq_idx;
+
+		if (!CPU_ISSET(cpu, &cpuset)) {
+			fs_handle->dpi_cpu_eqt[cpu] = -1;
+			continue;
+		}
+
+		eq_idx = count++ % eq_count;
+		prog   = &fs_handle->dpi_progress[eq_idx % fs_handle->dpi_progress_count];
+		CPU_SET(cpu, &prog->dp_cpus);
+
+		fs_handle->dpi_cpu_eqt[cpu] = eq_idx;
+	}
+
+	fs_handle->dpi_eqt_count = eq_count;
+
+	DFUSE_TRA_INFO(fs_handle, "Using %d event queues for %d cores", eq_count, count);
+	return -DER_SUCCESS;
+}
+
 int
 dfuse_fs_init(struct dfuse_info *dfuse_info, struct dfuse_projection_info **_fsh)
 {
@@ -975,7 +1108,18 @@ dfuse_fs_init(struct dfuse_info *dfuse_info, struct dfuse_projection_info **_fsh
 	if (fs_handle == NULL)
 		return -DER_NOMEM;
 
-	fs_handle->dpi_eqt_count = dfuse_info->di_equeue_count;
+	fs_handle->dpi_progress_count = dfuse_info->di_equeue_count;
+	fs_handle->dpi_eqt_count      = dfuse_info->di_equeue_count;
+
+	D_ALLOC_ARRAY(fs_handle->dpi_progress, fs_handle->dpi_progress_count);
+	if (fs_handle->dpi_progress == NULL)
+		D_GOTO(err, rc = -DER_NOMEM);
+
+	if (dfuse_info->di_eq_per_core) {
+		rc = dfuse_cpu_map_init(fs_handle);
+		if (rc != -DER_SUCCESS)
+			D_GOTO(err, rc);
+	}
 
 	D_ALLOC_ARRAY(fs_handle->dpi_eqt, fs_handle->dpi_eqt_count);
 	if (fs_handle->dpi_eqt == NULL)
@@ -996,28 +1140,52 @@ dfuse_fs_init(struct dfuse_info *dfuse_info, struct dfuse_projection_info **_fsh
 	if (rc != 0)
 		D_GOTO(err_pt, rc);
 
+	rc = D_MUTEX_INIT(&fs_handle->dpi_rdc_lock, NULL);
+	if (rc != -DER_SUCCESS)
+		D_GOTO(err_iet, rc);
+	D_INIT_LIST_HEAD(&fs_handle->dpi_rdc_list);
+	atomic_init(&fs_handle->dpi_rdc_entries, 0);
+
+	rc = D_MUTEX_INIT(&fs_handle->dpi_rdp_lock, NULL);
+	if (rc != -DER_SUCCESS)
+		D_GOTO(err_rdc, rc);
+	D_INIT_LIST_HEAD(&fs_handle->dpi_rdp_list);
+
+	rc = sem_init(&fs_handle->dpi_rdp_sem, 0, 0);
+	if (rc != 0)
+		D_GOTO(err_rdp, rc = daos_errno2der(errno));
+
 	atomic_init(&fs_handle->dpi_ino_next, 2);
 	atomic_init(&fs_handle->dpi_eqt_idx, 0);
 
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
+
+		prog->dp_handle = fs_handle;
+		prog->dp_idx    = i;
+
+		/* Mark the semaphore as created by setting dp_handle so that it is only destroyed
+		 * if sem_init() has been called, as it's invalid to call sem_destroy otherwise.
+		 */
+		rc = sem_init(&prog->dp_sem, 0, 0);
+		if (rc != 0) {
+			prog->dp_handle = NULL;
+			D_GOTO(err_eq, rc = daos_errno2der(errno));
+		}
+
+		DFUSE_TRA_UP(prog, fs_handle, "progress");
+	}
+
 	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
 		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
 
 		eqt->de_handle = fs_handle;
+		eqt->de_prog   = &fs_handle->dpi_progress[i % fs_handle->dpi_progress_count];
 
 		DFUSE_TRA_UP(eqt, fs_handle, "event_queue");
 
-		/* Create the semaphore before the eq as there's no way to check if sem_init()
-		 * has been called or not and it's invalid to call sem_destroy if it hasn't.  This
-		 * way we can avoid adding additional memory for tracking status of the semaphore.
-		 */
-		rc = sem_init(&eqt->de_sem, 0, 0);
-		if (rc != 0)
-			D_GOTO(err_eq, rc = daos_errno2der(errno));
-
 		rc = daos_eq_create(&eqt->de_eq);
 		if (rc != -DER_SUCCESS) {
-			sem_destroy(&eqt->de_sem);
-
 			DFUSE_TRA_DOWN(eqt);
 			D_GOTO(err_eq, rc);
 		}
@@ -1039,14 +1207,30 @@ err_eq:
 		if (rc2 != -DER_SUCCESS)
 			DFUSE_TRA_ERROR(eqt, "Failed to destroy event queue:" DF_RC, DP_RC(rc2));
 
-		sem_destroy(&eqt->de_sem);
 		DFUSE_TRA_DOWN(eqt);
 	}
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
+
+		if (prog->dp_handle == NULL)
+			continue;
+
+		sem_destroy(&prog->dp_sem);
+		DFUSE_TRA_DOWN(prog);
+	}
+	sem_destroy(&fs_handle->dpi_rdp_sem);
+err_rdp:
+	D_MUTEX_DESTROY(&fs_handle->dpi_rdp_lock);
+err_rdc:
+	D_MUTEX_DESTROY(&fs_handle->dpi_rdc_lock);
+err_iet:
 	d_hash_table_destroy_inplace(&fs_handle->dpi_iet, false);
 err_pt:
 	d_hash_table_destroy_inplace(&fs_handle->dpi_pool_table, false);
 err:
 	D_FREE(fs_handle->dpi_eqt);
+	D_FREE(fs_handle->dpi_cpu_eqt);
+	D_FREE(fs_handle->dpi_progress);
 	D_FREE(fs_handle);
 	return rc;
 }
@@ -1083,6 +1267,8 @@ dfuse_ie_close(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry
 	D_ASSERT(atomic_load_relaxed(&ie->ie_il_count) == 0);
 	D_ASSERT(atomic_load_relaxed(&ie->ie_open_count) == 0);
 
+	dfuse_readdir_cache_detach(fs_handle, ie);
+
 	if (ie->ie_obj) {
 		rc = dfs_release(ie->ie_obj);
 		if (rc == ENOMEM)
@@ -1127,6 +1313,9 @@ dfuse_read_event_reset(void *arg)
 		ev->de_iov.iov_buf_len = DFUSE_MAX_READ;
 		ev->de_sgl.sg_iovs     = &ev->de_iov;
 		ev->de_sgl.sg_nr       = 1;
+
+		/* Pool buffers live until released so can keep their bulk registration */
+		daos_mem_register(ev->de_iov.iov_buf, ev->de_iov.iov_buf_len);
 	}
 
 	rc = daos_event_init(&ev->de_ev, ev->de_eqt->de_eq, NULL);
@@ -1151,6 +1340,9 @@ dfuse_write_event_reset(void *arg)
 		ev->de_iov.iov_buf_len = DFUSE_MAX_READ;
 		ev->de_sgl.sg_iovs     = &ev->de_iov;
 		ev->de_sgl.sg_nr       = 1;
+
+		/* Pool buffers live until released so can keep their bulk registration */
+		daos_mem_register(ev->de_iov.iov_buf, ev->de_iov.iov_buf_len);
 	}
 
 	rc = daos_event_init(&ev->de_ev, ev->de_eqt->de_eq, NULL);
@@ -1166,6 +1358,8 @@ dfuse_event_release(void *arg)
 {
 	struct dfuse_event *ev = arg;
 
+	if (ev->de_iov.iov_buf != NULL)
+		daos_mem_deregister(ev->de_iov.iov_buf, ev->de_iov.iov_buf_len);
 	D_FREE(ev->de_iov.iov_buf);
 }
 
@@ -1271,14 +1465,34 @@ dfuse_fs_start(struct dfuse_projection_info *fs_handle, struct dfuse_cont *dfs)
 		rc = d_slab_register(&fs_handle->dpi_slab, &write_slab, eqt, &eqt->de_write_slab);
 		if (rc != -DER_SUCCESS)
 			D_GOTO(err_threads, rc);
+	}
+
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
 
-		rc = pthread_create(&eqt->de_thread, NULL, dfuse_progress_thread, eqt);
+		rc = pthread_create(&prog->dp_thread, NULL, dfuse_progress_thread, prog);
 		if (rc != 0)
 			D_GOTO(err_threads, rc = daos_errno2der(rc));
 
-		pthread_setname_np(eqt->de_thread, "dfuse_progress");
+		pthread_setname_np(prog->dp_thread, "dfuse_progress");
+
+		/* Keep polling on the cores that submit to these eqs, this is best effort */
+		if (fs_handle->dpi_cpu_eqt != NULL && CPU_COUNT(&prog->dp_cpus) > 0) {
+			rc = pthread_setaffinity_np(prog->dp_thread, sizeof(prog->dp_cpus),
+						    &prog->dp_cpus);
+			if (rc != 0)
+				DFUSE_TRA_WARNING(prog, "Failed to set affinity: %d (%s)", rc,
+						  strerror(rc));
+		}
 	}
 
+	rc = pthread_create(&fs_handle->dpi_rdp_thread, NULL, dfuse_readdir_prefetch_thread,
+			    fs_handle);
+	if (rc != 0)
+		D_GOTO(err_threads, rc = daos_errno2der(rc));
+
+	pthread_setname_np(fs_handle->dpi_rdp_thread, "dfuse_readdir");
+
 	rc = dfuse_launch_fuse(fs_handle, &args);
 	if (rc == -DER_SUCCESS) {
 		fuse_opt_free_args(&args);
@@ -1286,15 +1500,20 @@ dfuse_fs_start(struct dfuse_projection_info *fs_handle, struct dfuse_cont *dfs)
 	}
 
 err_threads:
-	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
-		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
 
-		if (!eqt->de_thread)
+		if (!prog->dp_thread)
 			continue;
 
-		sem_post(&eqt->de_sem);
-		pthread_join(eqt->de_thread, NULL);
-		sem_destroy(&eqt->de_sem);
+		sem_post(&prog->dp_sem);
+		pthread_join(prog->dp_thread, NULL);
+		sem_destroy(&prog->dp_sem);
+	}
+
+	if (fs_handle->dpi_rdp_thread) {
+		sem_post(&fs_handle->dpi_rdp_sem);
+		pthread_join(fs_handle->dpi_rdp_thread, NULL);
 	}
 
 	d_slab_destroy(&fs_handle->dpi_slab);
@@ -1414,18 +1633,33 @@ dfuse_fs_stop(struct dfuse_projection_info *fs_handle)
 
 	fs_handle->dpi_shutdown = true;
 
-	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
-		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
 
-		sem_post(&eqt->de_sem);
+		sem_post(&prog->dp_sem);
 	}
 
+	for (i = 0; i < fs_handle->dpi_progress_count; i++) {
+		struct dfuse_progress *prog = &fs_handle->dpi_progress[i];
+
+		pthread_join(prog->dp_thread, NULL);
+
+		sem_destroy(&prog->dp_sem);
+	}
+
+	/* Stop the prefetch thread and drop the references held by queued requests before the
+	 * inode table is drained.
+	 */
+	sem_post(&fs_handle->dpi_rdp_sem);
+	pthread_join(fs_handle->dpi_rdp_thread, NULL);
+	dfuse_readdir_prefetch_drain(fs_handle);
+
 	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
 		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
 
-		pthread_join(eqt->de_thread, NULL);
-
-		sem_destroy(&eqt->de_sem);
+		DFUSE_TRA_INFO(eqt, "eq %d: %" PRIu64 " events, max depth %" PRId64, i,
+			       atomic_load_relaxed(&eqt->de_events),
+			       atomic_load_relaxed(&eqt->de_max_depth));
 	}
 
 	rc = d_hash_table_traverse(&fs_handle->dpi_iet, ino_flush, fs_handle);
@@ -1488,7 +1722,12 @@ dfuse_fs_fini(struct dfuse_projection_info *fs_handle)
 		DFUSE_TRA_DOWN(eqt);
 	}
 
+	for (i = 0; i < fs_handle->dpi_progress_count; i++)
+		DFUSE_TRA_DOWN(&fs_handle->dpi_progress[i]);
+
 	D_FREE(fs_handle->dpi_eqt);
+	D_FREE(fs_handle->dpi_cpu_eqt);
+	D_FREE(fs_handle->dpi_progress);
 
 	rc2 = d_hash_table_destroy_inplace(&fs_handle->dpi_iet, false);
 	if (rc2) {
@@ -1504,5 +1743,9 @@ dfuse_fs_fini(struct dfuse_projection_info *fs_handle)
 			rc = rc2;
 	}
 
+	D_MUTEX_DESTROY(&fs_handle->dpi_rdc_lock);
+	D_MUTEX_DESTROY(&fs_handle->dpi_rdp_lock);
+	sem_destroy(&fs_handle->dpi_rdp_sem);
+
 	return rc;
 }
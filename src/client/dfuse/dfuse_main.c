@@ -262,6 +262,7 @@ show_help(char *name)
 	    "	-S --singlethread	Single threaded\n"
 	    "	-t --thread-count=count	Number of threads to use\n"
 	    "   -e --eq-count=count     Number of event queues to use\n"
+	    "	   --eq-per-core	Use one event queue per core\n"
 	    "	-f --foreground		Run in foreground\n"
 	    "	   --enable-caching	Enable all caching (default)\n"
 	    "	   --enable-wb-cache	Use write-back cache rather than write-through (default)\n"
@@ -288,7 +289,11 @@ show_help(char *name)
 	    "operations.  Each asynchronous thread will have one daos event queue so consume\n"
 	    "additional network resources.  The --thread-count option will control the total\n"
 	    "number of threads, increasing the --eq-count option will reduce the number of\n"
-	    "fuse threads accordingly.  The default value for eq-count is 1.\n"
+	    "fuse threads accordingly.  The default value for eq-count is 1, the maximum is 64.\n"
+	    "With --eq-per-core each core that dfuse runs on is given its own event queue,\n"
+	    "so that concurrent requests do not share a queue, and each of the eq-count\n"
+	    "progress threads polls a subset of these queues on the cores that use them.\n"
+	    "At most 64 queues are created, beyond that cores share queues.\n"
 	    "As all metadata operations are blocking the level of concurrency is limited by the\n"
 	    "number of fuse threads."
 	    "Singlethreaded mode will use one thread for handling fuse requests and a second\n"
@@ -341,6 +346,7 @@ main(int argc, char **argv)
 							{"singlethread", no_argument, 0, 'S'},
 							{"thread-count", required_argument, 0, 't'},
 							{"eq-count", required_argument, 0, 'e'},
+							{"eq-per-core", no_argument, 0, 'C'},
 							{"foreground", no_argument, 0, 'f'},
 							{"enable-caching", no_argument, 0, 'E'},
 							{"enable-wb-cache", no_argument, 0, 'F'},
@@ -413,6 +419,9 @@ main(int argc, char **argv)
 		case 'e':
 			dfuse_info->di_equeue_count = atoi(optarg);
 			break;
+		case 'C':
+			dfuse_info->di_eq_per_core = true;
+			break;
 		case 't':
 			dfuse_info->di_thread_count = atoi(optarg);
 			have_thread_count           = true;
@@ -486,6 +495,11 @@ main(int argc, char **argv)
 		dfuse_info->di_thread_count = CPU_COUNT(&cpuset);
 	}
 
+	if (dfuse_info->di_equeue_count < 1 || dfuse_info->di_equeue_count > DFUSE_EQ_MAX) {
+		printf("Event queue count must be between 1 and %d.\n", DFUSE_EQ_MAX);
+		D_GOTO(out_debug, rc = -DER_INVAL);
+	}
+
 	/* Reserve one thread for each daos event queue */
 	dfuse_info->di_thread_count -= dfuse_info->di_equeue_count;
 
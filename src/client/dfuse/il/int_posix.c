@@ -56,8 +56,21 @@ struct ioil_global {
 	uint64_t	iog_read_count;		/**< Number of read operations intercepted */
 	uint64_t	iog_write_count;	/**< Number of write operations intercepted */
 	uint64_t	iog_fstat_count;	/**< Number of fstat operations intercepted */
+
+	size_t		iog_ra_size;		/**< Read-ahead window size, 0 to disable */
+	size_t		iog_wb_size;		/**< Write-behind window size, 0 to disable */
+	d_list_t	iog_bufs_head;		/**< Buffers of open files, flushed at exit */
+
+	uint64_t	iog_ra_hits;		/**< Reads served from read-ahead */
+	uint64_t	iog_ra_misses;		/**< Reads that waited on DAOS */
+	uint64_t	iog_ra_count;		/**< Number of read-ahead windows fetched */
+	uint64_t	iog_wb_bytes;		/**< Bytes written behind */
+	uint64_t	iog_wb_count;		/**< Number of write-behind windows sent */
 };
 
+/* Upper bound for the read-ahead and write-behind windows, each file uses up to two of each */
+#define IOIL_BUF_MAX	(64 * 1024 * 1024)
+
 static vector_t	fd_table;
 
 static struct ioil_global ioil_iog;
@@ -146,11 +159,107 @@ ioil_shrink_cont(struct ioil_cont *cont, bool shrink_pool, bool force)
 	return ioil_shrink_pool(pool);
 }
 
+/* Allocate the read-ahead and write-behind buffers for a file, called with iog_lock held.
+ * Failure is not fatal, I/O is simply done synchronously.
+ */
+static void
+ioil_buf_alloc(struct fd_entry *entry)
+{
+	struct ioil_buf *buf;
+	int              accmode = entry->fd_flags & O_ACCMODE;
+	int              i;
+	int              rc;
+
+	if (ioil_iog.iog_ra_size == 0 && ioil_iog.iog_wb_size == 0)
+		return;
+
+	D_ALLOC_PTR(buf);
+	if (buf == NULL)
+		return;
+
+	rc = D_MUTEX_INIT(&buf->ib_lock, NULL);
+	if (rc != 0) {
+		D_FREE(buf);
+		return;
+	}
+
+	if (accmode != O_WRONLY)
+		buf->ib_ra_size = ioil_iog.iog_ra_size;
+	if (accmode != O_RDONLY)
+		buf->ib_wb_size = ioil_iog.iog_wb_size;
+
+	for (i = 0; i < ARRAY_SIZE(buf->ib_ra); i++) {
+		if (buf->ib_ra_size != 0) {
+			D_ALLOC(buf->ib_ra[i].iw_buf, buf->ib_ra_size);
+			if (buf->ib_ra[i].iw_buf == NULL)
+				goto free;
+		}
+		if (buf->ib_wb_size != 0) {
+			D_ALLOC(buf->ib_wb[i].iw_buf, buf->ib_wb_size);
+			if (buf->ib_wb[i].iw_buf == NULL)
+				goto free;
+		}
+	}
+
+	buf->ib_cont  = entry->fd_cont;
+	buf->ib_obj   = entry->fd_dfsoh;
+	entry->fd_buf = buf;
+	d_list_add(&buf->ib_list, &ioil_iog.iog_bufs_head);
+	return;
+
+free:
+	for (i = 0; i < ARRAY_SIZE(buf->ib_ra); i++) {
+		D_FREE(buf->ib_ra[i].iw_buf);
+		D_FREE(buf->ib_wb[i].iw_buf);
+	}
+	D_MUTEX_DESTROY(&buf->ib_lock);
+	D_FREE(buf);
+}
+
+/* Flush and free the buffers for a file, called with iog_lock held */
+static void
+ioil_buf_free(struct fd_entry *entry)
+{
+	struct ioil_buf *buf = entry->fd_buf;
+	int              i;
+	int              rc;
+
+	if (buf == NULL)
+		return;
+
+	rc = ioil_do_flush(entry, true);
+	if (rc != 0)
+		DFUSE_TRA_ERROR(entry->fd_dfsoh, "Write-behind failed at close: %d (%s)", rc,
+				strerror(rc));
+	ioil_do_invalidate(entry);
+
+	ioil_iog.iog_ra_hits += buf->ib_ra_hits;
+	ioil_iog.iog_ra_misses += buf->ib_ra_misses;
+	ioil_iog.iog_ra_count += buf->ib_ra_count;
+	ioil_iog.iog_wb_bytes += buf->ib_wb_bytes;
+	ioil_iog.iog_wb_count += buf->ib_wb_count;
+
+	d_list_del(&buf->ib_list);
+	for (i = 0; i < ARRAY_SIZE(buf->ib_ra); i++) {
+		D_FREE(buf->ib_ra[i].iw_buf);
+		D_FREE(buf->ib_wb[i].iw_buf);
+	}
+	D_MUTEX_DESTROY(&buf->ib_lock);
+	D_FREE(buf);
+	entry->fd_buf = NULL;
+}
+
 static void
 entry_array_close(void *arg) {
 	struct fd_entry *entry = arg;
 	int              rc;
 
+	if (entry->fd_buf != NULL) {
+		D_MUTEX_LOCK(&ioil_iog.iog_lock);
+		ioil_buf_free(entry);
+		D_MUTEX_UNLOCK(&ioil_iog.iog_lock);
+	}
+
 	DFUSE_TRA_DOWN(entry->fd_dfsoh);
 	rc = dfs_release(entry->fd_dfsoh);
 	if (rc == ENOMEM)
@@ -285,6 +394,7 @@ ioil_init(void)
 	pthread_once(&init_links_flag, init_links);
 
 	D_INIT_LIST_HEAD(&ioil_iog.iog_pools_head);
+	D_INIT_LIST_HEAD(&ioil_iog.iog_bufs_head);
 
 	rc = daos_debug_init(DAOS_LOG_DEFAULT);
 	if (rc)
@@ -311,6 +421,12 @@ ioil_init(void)
 		ioil_iog.iog_report_count = report_count;
 	}
 
+	/* Optional read-ahead and write-behind window sizes, in bytes */
+	d_getenv_uint64_t("D_IL_READAHEAD", &ioil_iog.iog_ra_size);
+	d_getenv_uint64_t("D_IL_WRITEBEHIND", &ioil_iog.iog_wb_size);
+	ioil_iog.iog_ra_size = min(ioil_iog.iog_ra_size, IOIL_BUF_MAX);
+	ioil_iog.iog_wb_size = min(ioil_iog.iog_wb_size, IOIL_BUF_MAX);
+
 	rc = ioil_initialize_fd_table(rlimit.rlim_max);
 	if (rc != 0) {
 		DFUSE_LOG_ERROR("Could not create fd_table, "
@@ -339,6 +455,18 @@ ioil_show_summary()
 		       "[libioil] Performed %" PRIu64 " reads and %" PRIu64 " writes from %" PRIu64
 		       " files\n",
 		       ioil_iog.iog_read_count, ioil_iog.iog_write_count, ioil_iog.iog_file_count);
+
+	if (ioil_iog.iog_ra_size != 0)
+		__real_fprintf(stderr,
+			       "[libioil] Read-ahead: %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64
+			       " windows fetched\n",
+			       ioil_iog.iog_ra_hits, ioil_iog.iog_ra_misses, ioil_iog.iog_ra_count);
+
+	if (ioil_iog.iog_wb_size != 0)
+		__real_fprintf(stderr,
+			       "[libioil] Write-behind: %" PRIu64 " bytes in %" PRIu64
+			       " windows sent\n",
+			       ioil_iog.iog_wb_bytes, ioil_iog.iog_wb_count);
 }
 
 static __attribute__((destructor)) void
@@ -346,6 +474,7 @@ ioil_fini(void)
 {
 	struct ioil_pool *pool, *pnext;
 	struct ioil_cont *cont, *cnext;
+	struct ioil_buf  *buf, *bnext;
 	int               rc;
 	pid_t             tid = syscall(SYS_gettid);
 
@@ -356,6 +485,14 @@ ioil_fini(void)
 
 	ioil_iog.iog_initialized = false;
 
+	/* Files still open at exit may have data written behind */
+	d_list_for_each_entry_safe(buf, bnext, &ioil_iog.iog_bufs_head, ib_list) {
+		struct fd_entry entry = {
+		    .fd_cont = buf->ib_cont, .fd_dfsoh = buf->ib_obj, .fd_buf = buf};
+
+		ioil_buf_free(&entry);
+	}
+
 	DFUSE_TRA_DOWN(&ioil_iog);
 	vector_destroy(&fd_table);
 
@@ -795,6 +932,8 @@ get_file:
 	else if (rc)
 		D_GOTO(shrink, rc);
 
+	ioil_buf_alloc(entry);
+
 	DFUSE_LOG_DEBUG("fd:%d flags %#lx fstat %s", fd, il_reply.fir_flags,
 			entry->fd_fstat ? "yes" : "no");
 
@@ -816,6 +955,7 @@ get_file:
 	return true;
 
 obj_close:
+	ioil_buf_free(entry);
 	dfs_release(entry->fd_dfsoh);
 
 shrink:
@@ -833,6 +973,9 @@ drop_reference_if_disabled(struct fd_entry *entry)
 	if (entry->fd_status == DFUSE_IO_BYPASS)
 		return false;
 
+	/* Anything written behind has to reach DAOS before the kernel handles the file */
+	ioil_do_flush(entry, false);
+
 	vector_decref(&fd_table, entry);
 
 	return true;
@@ -1102,11 +1245,20 @@ dfuse_close(int fd)
 	DFUSE_LOG_DEBUG("close(fd=%d) intercepted, bypass=%s",
 			fd, bypass_status[entry->fd_status]);
 
+	/* Report any error from data written behind, the fd is closed regardless */
+	rc = ioil_do_flush(entry, true);
+
 	/* This will drop a reference which will cause the array to be closed
 	 * when the last duplicated fd is closed
 	 */
 	vector_decref(&fd_table, entry);
 
+	if (rc != 0) {
+		__real_close(fd);
+		errno = rc;
+		return -1;
+	}
+
 do_real_close:
 	return __real_close(fd);
 }
@@ -1277,6 +1429,8 @@ dfuse_lseek(int fd, off_t offset, int whence)
 	if (drop_reference_if_disabled(entry))
 		goto do_real_lseek;
 
+	ioil_do_flush(entry, false);
+
 	if (whence == SEEK_SET) {
 		new_offset = offset;
 	} else if (whence == SEEK_CUR) {
@@ -1334,6 +1488,8 @@ dfuse_fseek(FILE *stream, long offset, int whence)
 	if (drop_reference_if_disabled(entry))
 		goto do_real_fseek;
 
+	ioil_do_flush(entry, false);
+
 	if (whence == SEEK_SET) {
 		new_offset    = offset;
 		entry->fd_eof = false;
@@ -1403,6 +1559,8 @@ dfuse_fseeko(FILE *stream, off_t offset, int whence)
 	if (drop_reference_if_disabled(entry))
 		goto do_real_fseeko;
 
+	ioil_do_flush(entry, false);
+
 	if (whence == SEEK_SET) {
 		new_offset    = offset;
 		entry->fd_eof = false;
@@ -1620,6 +1778,8 @@ dfuse_mmap(void *address, size_t length, int prot, int flags, int fd,
 				"intercepted, disabling kernel bypass ", address,
 				length, prot, flags, fd, offset);
 
+		ioil_do_flush(entry, false);
+
 		if (entry->fd_pos != 0)
 			__real_lseek(fd, entry->fd_pos, SEEK_SET);
 		/* Disable kernel bypass */
@@ -1644,6 +1804,10 @@ dfuse_ftruncate(int fd, off_t length)
 	DFUSE_LOG_DEBUG("ftuncate(fd=%d) intercepted, bypass=%s offset %#lx", fd,
 			bypass_status[entry->fd_status], length);
 
+	/* Written behind data past the new size must not land after the punch */
+	ioil_do_flush(entry, false);
+	ioil_do_invalidate(entry);
+
 	rc = dfs_punch(entry->fd_cont->ioc_dfs, entry->fd_dfsoh, length, DFS_MAX_FSIZE);
 
 	vector_decref(&fd_table, entry);
@@ -1671,8 +1835,15 @@ dfuse_fsync(int fd)
 	DFUSE_LOG_DEBUG("fsync(fd=%d) intercepted, bypass=%s",
 			fd, bypass_status[entry->fd_status]);
 
+	rc = ioil_do_flush(entry, true);
+
 	vector_decref(&fd_table, entry);
 
+	if (rc != 0) {
+		errno = rc;
+		return -1;
+	}
+
 do_real_fsync:
 	return __real_fsync(fd);
 }
@@ -1690,8 +1861,15 @@ dfuse_fdatasync(int fd)
 	DFUSE_LOG_DEBUG("fdatasync(fd=%d) intercepted, bypass=%s",
 			fd, bypass_status[entry->fd_status]);
 
+	rc = ioil_do_flush(entry, true);
+
 	vector_decref(&fd_table, entry);
 
+	if (rc != 0) {
+		errno = rc;
+		return -1;
+	}
+
 do_real_fdatasync:
 	return __real_fdatasync(fd);
 }
@@ -1991,8 +2169,16 @@ dfuse_fclose(FILE *stream)
 	DFUSE_LOG_DEBUG("fclose(stream=%p(fd=%d)) intercepted, bypass=%s", stream, fd,
 			bypass_status[entry->fd_status]);
 
+	rc = ioil_do_flush(entry, true);
+
 	vector_decref(&fd_table, entry);
 
+	if (rc != 0) {
+		__real_fclose(stream);
+		errno = rc;
+		return EOF;
+	}
+
 do_real_fclose:
 	return __real_fclose(stream);
 }
@@ -2770,6 +2956,9 @@ dfuse___fxstat(int ver, int fd, struct stat *buf)
 	if (rc != 0)
 		goto do_real_fstat;
 
+	/* The size has to include anything written behind */
+	ioil_do_flush(entry, false);
+
 	/* Turn off this feature if the kernel is doing metadata caching, in this case it's better
 	 * to use the kernel cache and keep it up-to-date than query the severs each time.
 	 */
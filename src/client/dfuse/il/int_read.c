@@ -34,10 +34,191 @@ read_bulk(char *buff, size_t len, off_t position, struct fd_entry *entry, int *e
 	return read_size;
 }
 
+/* Wait for an in-flight read-ahead, the window is only valid if the read succeeded */
+static int
+ra_wait(struct ioil_window *win)
+{
+	bool flag = false;
+	int  rc;
+
+	if (!win->iw_inflight)
+		return 0;
+
+	rc = daos_event_test(&win->iw_ev, DAOS_EQ_WAIT, &flag);
+	if (rc == 0)
+		rc = win->iw_ev.ev_error;
+	else
+		rc = daos_der2errno(rc);
+	daos_event_fini(&win->iw_ev);
+	win->iw_inflight = false;
+	win->iw_valid    = (rc == 0);
+	return rc;
+}
+
+/* Start reading a full window at offset, without waiting for it */
+static int
+ra_launch(struct fd_entry *entry, struct ioil_window *win, off_t offset)
+{
+	struct ioil_buf *buf = entry->fd_buf;
+	int              rc;
+
+	rc = daos_event_init(&win->iw_ev, DAOS_HDL_INVAL, NULL);
+	if (rc != 0)
+		return daos_der2errno(rc);
+
+	win->iw_off   = offset;
+	win->iw_len   = 0;
+	win->iw_valid = false;
+	d_iov_set(&win->iw_iov, win->iw_buf, buf->ib_ra_size);
+	win->iw_sgl.sg_nr   = 1;
+	win->iw_sgl.sg_iovs = &win->iw_iov;
+
+	rc = dfs_read(entry->fd_cont->ioc_dfs, entry->fd_dfsoh, &win->iw_sgl, offset, &win->iw_len,
+		      &win->iw_ev);
+	if (rc != 0) {
+		daos_event_fini(&win->iw_ev);
+		return rc;
+	}
+	win->iw_inflight = true;
+	buf->ib_ra_count++;
+	return 0;
+}
+
+void
+ioil_ra_drop_locked(struct ioil_buf *buf)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(buf->ib_ra); i++) {
+		ra_wait(&buf->ib_ra[i]);
+		buf->ib_ra[i].iw_valid = false;
+	}
+}
+
+/* Find the window holding offset, waiting for it if it is still being read */
+static struct ioil_window *
+ra_lookup(struct ioil_buf *buf, off_t offset)
+{
+	struct ioil_window *win;
+	int                 i;
+
+	for (i = 0; i < ARRAY_SIZE(buf->ib_ra); i++) {
+		win = &buf->ib_ra[i];
+
+		if (win->iw_inflight) {
+			if (offset < win->iw_off || offset >= win->iw_off + buf->ib_ra_size)
+				continue;
+			ra_wait(win);
+		}
+		if (win->iw_valid && offset >= win->iw_off && offset < win->iw_off + win->iw_len)
+			return win;
+	}
+	return NULL;
+}
+
+/* Serve a read from the read-ahead windows.  Sequential reads are served from memory and the
+ * window following the one being consumed is read in the background, any other access pattern
+ * goes straight to DAOS.
+ */
+static ssize_t
+read_ahead(char *buff, size_t len, off_t position, struct fd_entry *entry, int *errcode)
+{
+	struct ioil_buf    *buf  = entry->fd_buf;
+	struct ioil_window *win;
+	struct ioil_window *next;
+	size_t              done = 0;
+	size_t              count;
+	off_t               offset;
+	bool                hit = true;
+	ssize_t             rc;
+
+	while (done < len) {
+		offset = position + done;
+
+		win = ra_lookup(buf, offset);
+		if (win == NULL) {
+			hit = false;
+			if (offset != buf->ib_ra_next) {
+				/* Random access, do not pollute the windows */
+				rc = read_bulk(buff + done, len - done, offset, entry, errcode);
+				if (rc < 0)
+					goto out;
+				done += rc;
+				break;
+			}
+			ioil_ra_drop_locked(buf);
+			win = &buf->ib_ra[0];
+			rc  = ra_launch(entry, win, offset);
+			if (rc == 0)
+				rc = ra_wait(win);
+			if (rc != 0) {
+				/* Let the synchronous path report the error */
+				rc = read_bulk(buff + done, len - done, offset, entry, errcode);
+				if (rc < 0)
+					goto out;
+				done += rc;
+				break;
+			}
+			if (win->iw_len == 0)
+				break;
+		}
+
+		count = min(len - done, win->iw_off + win->iw_len - offset);
+		memcpy(buff + done, win->iw_buf + (offset - win->iw_off), count);
+		done += count;
+
+		/* A short window means the end of file was reached */
+		if (win->iw_len < buf->ib_ra_size)
+			break;
+
+		next = (win == &buf->ib_ra[0]) ? &buf->ib_ra[1] : &buf->ib_ra[0];
+		if ((next->iw_inflight || next->iw_valid) &&
+		    next->iw_off == win->iw_off + buf->ib_ra_size)
+			continue;
+		ra_wait(next);
+		ra_launch(entry, next, win->iw_off + buf->ib_ra_size);
+	}
+	rc = done;
+
+out:
+	if (rc < 0 && done > 0)
+		rc = done;
+	if (rc >= 0) {
+		buf->ib_ra_next = position + done;
+		if (hit)
+			buf->ib_ra_hits++;
+		else
+			buf->ib_ra_misses++;
+	}
+	return rc;
+}
+
 ssize_t
 ioil_do_pread(char *buff, size_t len, off_t position, struct fd_entry *entry, int *errcode)
 {
-	return read_bulk(buff, len, position, entry, errcode);
+	struct ioil_buf *buf = entry->fd_buf;
+	ssize_t          bytes_read;
+	int              rc;
+
+	if (buf == NULL)
+		return read_bulk(buff, len, position, entry, errcode);
+
+	D_MUTEX_LOCK(&buf->ib_lock);
+
+	/* Make sure any data written behind is visible to the read */
+	rc = ioil_wb_flush_locked(entry);
+	if (rc != 0) {
+		buf->ib_wb_err = 0;
+		*errcode       = rc;
+		bytes_read     = -1;
+	} else if (buf->ib_ra_size == 0 || len >= buf->ib_ra_size) {
+		bytes_read = read_bulk(buff, len, position, entry, errcode);
+	} else {
+		bytes_read = read_ahead(buff, len, position, entry, errcode);
+	}
+
+	D_MUTEX_UNLOCK(&buf->ib_lock);
+	return bytes_read;
 }
 
 ssize_t
@@ -49,7 +230,8 @@ ioil_do_preadv(const struct iovec *iov, int count, off_t position, struct fd_ent
 	int     i;
 
 	for (i = 0; i < count; i++) {
-		bytes_read = read_bulk(iov[i].iov_base, iov[i].iov_len, position, entry, errcode);
+		bytes_read = ioil_do_pread(iov[i].iov_base, iov[i].iov_len, position, entry,
+					   errcode);
 
 		if (bytes_read == -1)
 			return (ssize_t)-1;
@@ -63,3 +245,16 @@ ioil_do_preadv(const struct iovec *iov, int count, off_t position, struct fd_ent
 
 	return total_read;
 }
+
+void
+ioil_do_invalidate(struct fd_entry *entry)
+{
+	struct ioil_buf *buf = entry->fd_buf;
+
+	if (buf == NULL)
+		return;
+
+	D_MUTEX_LOCK(&buf->ib_lock);
+	ioil_ra_drop_locked(buf);
+	D_MUTEX_UNLOCK(&buf->ib_lock);
+}
@@ -12,8 +12,8 @@
 
 #include "ioil.h"
 
-ssize_t
-ioil_do_writex(const char *buff, size_t len, off_t position, struct fd_entry *entry, int *errcode)
+static ssize_t
+write_bulk(const char *buff, size_t len, off_t position, struct fd_entry *entry, int *errcode)
 {
 	d_iov_t     iov = {};
 	d_sg_list_t sgl = {};
@@ -34,6 +34,162 @@ ioil_do_writex(const char *buff, size_t len, off_t position, struct fd_entry *en
 	return len;
 }
 
+/* Wait for the write-behind window in flight, if any, and return its error */
+static int
+wb_wait(struct fd_entry *entry)
+{
+	struct ioil_buf    *buf  = entry->fd_buf;
+	struct ioil_window *win  = &buf->ib_wb[buf->ib_wb_cur ^ 1];
+	bool                flag = false;
+	int                 rc;
+
+	if (!win->iw_inflight)
+		return 0;
+
+	rc = daos_event_test(&win->iw_ev, DAOS_EQ_WAIT, &flag);
+	if (rc == 0)
+		rc = win->iw_ev.ev_error;
+	else
+		rc = daos_der2errno(rc);
+	daos_event_fini(&win->iw_ev);
+	win->iw_inflight = false;
+	win->iw_len      = 0;
+	if (rc) {
+		DFUSE_TRA_ERROR(entry->fd_dfsoh, "dfs_write() failed: %d (%s)", rc, strerror(rc));
+		if (buf->ib_wb_err == 0)
+			buf->ib_wb_err = rc;
+	}
+	return rc;
+}
+
+/* Send the window being filled in the background and start filling the other one.  Only one
+ * window is ever in flight so the memory used is bounded to twice the window size.
+ */
+static int
+wb_launch(struct fd_entry *entry)
+{
+	struct ioil_buf    *buf = entry->fd_buf;
+	struct ioil_window *win = &buf->ib_wb[buf->ib_wb_cur];
+	int                 rc;
+
+	if (win->iw_len == 0)
+		return 0;
+
+	rc = wb_wait(entry);
+	if (rc != 0)
+		return rc;
+
+	rc = daos_event_init(&win->iw_ev, DAOS_HDL_INVAL, NULL);
+	if (rc != 0)
+		return daos_der2errno(rc);
+
+	DFUSE_TRA_DEBUG(entry->fd_dfsoh, "%#zx-%#zx", win->iw_off, win->iw_off + win->iw_len - 1);
+
+	d_iov_set(&win->iw_iov, win->iw_buf, win->iw_len);
+	win->iw_sgl.sg_nr   = 1;
+	win->iw_sgl.sg_iovs = &win->iw_iov;
+
+	rc = dfs_write(entry->fd_cont->ioc_dfs, entry->fd_dfsoh, &win->iw_sgl, win->iw_off,
+		       &win->iw_ev);
+	if (rc != 0) {
+		daos_event_fini(&win->iw_ev);
+		return rc;
+	}
+	win->iw_inflight = true;
+	buf->ib_wb_count++;
+	buf->ib_wb_cur ^= 1;
+	return 0;
+}
+
+int
+ioil_wb_flush_locked(struct fd_entry *entry)
+{
+	int rc;
+
+	if (entry->fd_buf->ib_wb_size == 0)
+		return 0;
+
+	rc = wb_launch(entry);
+	if (rc != 0)
+		return rc;
+
+	return wb_wait(entry);
+}
+
+/* Write out any data held behind.  Errors are kept until reported, which only fsync and close
+ * do as other callers such as lseek have no way to return them.
+ */
+int
+ioil_do_flush(struct fd_entry *entry, bool report)
+{
+	struct ioil_buf *buf = entry->fd_buf;
+	int              rc  = 0;
+
+	if (buf == NULL)
+		return 0;
+
+	D_MUTEX_LOCK(&buf->ib_lock);
+	ioil_wb_flush_locked(entry);
+	if (report) {
+		rc             = buf->ib_wb_err;
+		buf->ib_wb_err = 0;
+	}
+	D_MUTEX_UNLOCK(&buf->ib_lock);
+	return rc;
+}
+
+/* Writes smaller than the window are copied and acknowledged immediately, errors from writing
+ * them are returned by a later write, fsync or close as with kernel write-back.
+ */
+ssize_t
+ioil_do_writex(const char *buff, size_t len, off_t position, struct fd_entry *entry, int *errcode)
+{
+	struct ioil_buf    *buf = entry->fd_buf;
+	struct ioil_window *win;
+	ssize_t             bytes_written;
+	int                 rc;
+
+	if (buf == NULL)
+		return write_bulk(buff, len, position, entry, errcode);
+
+	D_MUTEX_LOCK(&buf->ib_lock);
+
+	ioil_ra_drop_locked(buf);
+
+	if (len >= buf->ib_wb_size) {
+		rc = ioil_wb_flush_locked(entry);
+		if (rc != 0)
+			D_GOTO(err, rc);
+		bytes_written = write_bulk(buff, len, position, entry, errcode);
+		goto out;
+	}
+
+	win = &buf->ib_wb[buf->ib_wb_cur];
+	if (win->iw_len != 0 &&
+	    (position != win->iw_off + win->iw_len || win->iw_len + len > buf->ib_wb_size)) {
+		rc = wb_launch(entry);
+		if (rc != 0)
+			D_GOTO(err, rc);
+		win = &buf->ib_wb[buf->ib_wb_cur];
+	}
+
+	if (win->iw_len == 0)
+		win->iw_off = position;
+	memcpy(win->iw_buf + win->iw_len, buff, len);
+	win->iw_len += len;
+	buf->ib_wb_bytes += len;
+	bytes_written = len;
+
+out:
+	D_MUTEX_UNLOCK(&buf->ib_lock);
+	return bytes_written;
+err:
+	buf->ib_wb_err = 0;
+	D_MUTEX_UNLOCK(&buf->ib_lock);
+	*errcode = rc;
+	return -1;
+}
+
 ssize_t
 ioil_do_pwritev(const struct iovec *iov, int count, off_t position, struct fd_entry *entry,
 		int *errcode)
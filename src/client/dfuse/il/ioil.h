@@ -10,6 +10,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <pthread.h>
 
 #include "daos_fs.h"
 
@@ -28,6 +29,51 @@ struct ioil_cont {
 	int               ioc_open_count;
 };
 
+/* A file range buffered in memory, either read ahead of the application or written behind it */
+struct ioil_window {
+	char        *iw_buf;
+	/* File offset of the first byte in the buffer */
+	off_t        iw_off;
+	/* Number of valid bytes in the buffer */
+	daos_size_t  iw_len;
+	d_iov_t      iw_iov;
+	d_sg_list_t  iw_sgl;
+	daos_event_t iw_ev;
+	/* I/O to or from the buffer has been launched but not waited for */
+	bool         iw_inflight;
+	/* Read-ahead data is valid */
+	bool         iw_valid;
+};
+
+/* Per-file read-ahead and write-behind state, only allocated if enabled in the environment.
+ * Each side has two windows so that one can be in flight while the other is being consumed
+ * or filled by the application.
+ */
+struct ioil_buf {
+	pthread_mutex_t    ib_lock;
+	/* Entry in the global list of buffers, used to flush at exit */
+	d_list_t           ib_list;
+	struct ioil_cont  *ib_cont;
+	dfs_obj_t         *ib_obj;
+	size_t             ib_ra_size;
+	size_t             ib_wb_size;
+	/* Offset after the last read, used to detect sequential access */
+	off_t              ib_ra_next;
+	struct ioil_window ib_ra[2];
+	struct ioil_window ib_wb[2];
+	/* Index of the write-behind window currently being filled */
+	int                ib_wb_cur;
+	/* First write-behind error not yet returned to the application */
+	int                ib_wb_err;
+
+	/* Statistics */
+	uint64_t           ib_ra_hits;
+	uint64_t           ib_ra_misses;
+	uint64_t           ib_ra_count;
+	uint64_t           ib_wb_bytes;
+	uint64_t           ib_wb_count;
+};
+
 struct fd_entry {
 	struct ioil_cont *fd_cont;
 	dfs_obj_t        *fd_dfsoh;
@@ -37,6 +83,7 @@ struct fd_entry {
 	int               fd_flags;
 	int               fd_status;
 	bool              fd_fstat;
+	struct ioil_buf  *fd_buf;
 
 	/* Used for streaming I/O only */
 	bool              fd_eof;
@@ -53,5 +100,15 @@ ioil_do_writex(const char *buff, size_t len, off_t position, struct fd_entry *en
 ssize_t
 ioil_do_pwritev(const struct iovec *iov, int count, off_t position, struct fd_entry *entry,
 		int *errcode);
+int
+ioil_do_flush(struct fd_entry *entry, bool report);
+void
+ioil_do_invalidate(struct fd_entry *entry);
+
+/* Internal to the read-ahead and write-behind code, called with ib_lock held */
+int
+ioil_wb_flush_locked(struct fd_entry *entry);
+void
+ioil_ra_drop_locked(struct ioil_buf *buf);
 
 #endif /* __IOIL_H__ */
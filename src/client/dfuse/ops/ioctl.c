@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -24,6 +24,28 @@ handle_user_ioctl(struct dfuse_obj_hdl *oh, fuse_req_t req)
 	DFUSE_REPLY_IOCTL(oh, req, dur);
 }
 
+static void
+handle_eq_stats_ioctl(struct dfuse_obj_hdl *oh, fuse_req_t req)
+{
+	struct dfuse_projection_info *fs_handle = fuse_req_userdata(req);
+	struct dfuse_eq_stats_reply   reply     = {};
+	int                           i;
+
+	D_ASSERT(fs_handle->dpi_eqt_count <= DFUSE_IOCTL_EQ_MAX);
+
+	reply.eqr_version = DFUSE_IOCTL_VERSION;
+	reply.eqr_count   = fs_handle->dpi_eqt_count;
+	for (i = 0; i < fs_handle->dpi_eqt_count; i++) {
+		struct dfuse_eq *eqt = &fs_handle->dpi_eqt[i];
+
+		reply.eqr_eqs[i].des_depth     = atomic_load_relaxed(&eqt->de_depth);
+		reply.eqr_eqs[i].des_max_depth = atomic_load_relaxed(&eqt->de_max_depth);
+		reply.eqr_eqs[i].des_events    = atomic_load_relaxed(&eqt->de_events);
+	}
+
+	DFUSE_REPLY_IOCTL(oh, req, reply);
+}
+
 static void
 handle_il_ioctl(struct dfuse_obj_hdl *oh, fuse_req_t req)
 {
@@ -386,6 +408,10 @@ void dfuse_cb_ioctl(fuse_req_t req, fuse_ino_t ino, unsigned int cmd, void *arg,
 		if (out_bufsz < sizeof(struct dfuse_hs_reply))
 			D_GOTO(out_err, rc = EIO);
 		handle_size_ioctl(oh, req);
+	} else if (cmd == DFUSE_IOCTL_EQ_STATS) {
+		if (out_bufsz < sizeof(struct dfuse_eq_stats_reply))
+			D_GOTO(out_err, rc = EIO);
+		handle_eq_stats_ioctl(oh, req);
 	} else if (_IOC_NR(cmd) == DFUSE_IOCTL_REPLY_POH) {
 		size_t size = _IOC_SIZE(cmd);
 
@@ -39,6 +39,8 @@ dfuse_cb_mknod(fuse_req_t req, struct dfuse_inode_entry *parent, const char *nam
 	if (rc)
 		D_GOTO(err, rc);
 
+	dfuse_cache_evict_dir(fs_handle, parent);
+
 	strncpy(ie->ie_name, name, NAME_MAX);
 	ie->ie_parent    = parent->ie_stat.st_ino;
 	ie->ie_dfs       = parent->ie_dfs;
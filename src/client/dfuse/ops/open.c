@@ -102,9 +102,10 @@ err:
 void
 dfuse_cb_release(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
 {
-	struct dfuse_obj_hdl *oh = (struct dfuse_obj_hdl *)fi->fh;
-	int                   rc;
-	uint32_t              il_calls;
+	struct dfuse_projection_info *fs_handle = fuse_req_userdata(req);
+	struct dfuse_obj_hdl         *oh        = (struct dfuse_obj_hdl *)fi->fh;
+	int                           rc;
+	uint32_t                      il_calls;
 
 	/* Perform the opposite of what the ioctl call does, always change the open handle count
 	 * but the inode only tracks number of open handles with non-zero ioctl counts
@@ -122,12 +123,16 @@ dfuse_cb_release(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
 	 *
 	 * Additionally, with caching enabled then dfuse may see create(), release(), open() calls
 	 * and neither release nor open update the cache, so do not set it valid on read.
+	 *
+	 * Writes also change the size reported by readdirplus so drop any cached listing of
+	 * the parent directory.
 	 */
 	if (atomic_load_relaxed(&oh->doh_write_count) != 0) {
 		if (oh->doh_caching) {
 			DFUSE_TRA_DEBUG(oh, "Evicting cache");
 			dfuse_cache_evict(oh->doh_ie);
 		}
+		dfuse_cache_evict_parent(fs_handle, oh->doh_ie);
 		atomic_fetch_sub_relaxed(&oh->doh_ie->ie_open_write_count, 1);
 	}
 	il_calls = atomic_load_relaxed(&oh->doh_il_calls);
@@ -137,6 +142,7 @@ dfuse_cb_release(fuse_req_t req, fuse_ino_t ino, struct fuse_file_info *fi)
 			DFUSE_TRA_DEBUG(oh, "Evicting cache");
 			dfuse_cache_evict(oh->doh_ie);
 		}
+		dfuse_cache_evict_parent(fs_handle, oh->doh_ie);
 		atomic_fetch_sub_relaxed(&oh->doh_ie->ie_il_count, 1);
 	}
 	atomic_fetch_sub_relaxed(&oh->doh_ie->ie_open_count, 1);
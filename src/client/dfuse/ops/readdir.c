@@ -23,12 +23,84 @@
 /* Offset of the first file, allow two entries for . and .. */
 #define OFFSET_BASE        2
 
+/* Maximum number of entries held by one cached listing, older entries are dropped and
+ * re-read if a handle seeks back to them
+ */
+#define READDIR_CACHE_WINDOW (8 * READDIR_MAX_COUNT)
+
+/* Maximum number of entries held by the cached listings attached to inodes, the oldest
+ * listings are detached beyond this
+ */
+#define READDIR_CACHE_MAX    (64 * READDIR_MAX_COUNT)
+
 struct iterate_data {
 	off_t                     id_base_offset;
 	int                       id_index;
 	struct dfuse_readdir_hdl *id_hdl;
 };
 
+/* Release the entries from index start to end of a listing, called with drc_lock held or on the
+ * last reference
+ */
+static void
+readdir_cache_release_ents(struct dfuse_readdir_cache *rdc, uint32_t start, uint32_t end)
+{
+	uint32_t i;
+
+	for (i = start; i < end; i++) {
+		struct dfuse_readdir_centry *dce = &rdc->drc_ents[i - rdc->drc_base];
+
+		if (dce->dce_obj)
+			dfs_release(dce->dce_obj);
+		D_FREE(dce->dce_attr);
+	}
+	atomic_fetch_sub_relaxed(&rdc->drc_handle->dpi_rdc_entries, end - start);
+}
+
+void
+dfuse_readdir_cache_decref(struct dfuse_readdir_cache *rdc)
+{
+	if (atomic_fetch_sub_relaxed(&rdc->drc_ref, 1) != 1)
+		return;
+
+	DFUSE_TRA_DEBUG(rdc, "Freeing listing of %u entries", rdc->drc_count - rdc->drc_base);
+
+	readdir_cache_release_ents(rdc, rdc->drc_base, rdc->drc_count);
+	D_FREE(rdc->drc_ents);
+	D_MUTEX_DESTROY(&rdc->drc_lock);
+	DFUSE_TRA_DOWN(rdc);
+	D_FREE(rdc);
+}
+
+/* Detach a listing from its inode, called with dpi_rdc_lock held.  The caller drops the
+ * reference the inode held.
+ */
+static void
+readdir_cache_unlink(struct dfuse_readdir_cache *rdc)
+{
+	rdc->drc_ie->ie_rdc = NULL;
+	rdc->drc_ie         = NULL;
+	d_list_del_init(&rdc->drc_list);
+}
+
+/* Detach the cached listing from a directory so the next reader starts a new one */
+void
+dfuse_readdir_cache_detach(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie)
+{
+	struct dfuse_readdir_cache *rdc;
+
+	D_MUTEX_LOCK(&fs_handle->dpi_rdc_lock);
+	rdc = ie->ie_rdc;
+	if (rdc)
+		readdir_cache_unlink(rdc);
+	D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+
+	if (rdc) {
+		DFUSE_TRA_DEBUG(ie, "Dropping cached listing");
+		dfuse_readdir_cache_decref(rdc);
+	}
+}
+
 /* Mark a directory change so that any cache can be evicted.  The kernel pagecache is already
  * wiped on unlink if the directory isn't open, if it is then already open handles will return
  * the unlinked file, and a inval() call here does not change that.
@@ -43,9 +115,28 @@ dfuse_cache_evict_dir(struct dfuse_projection_info *fs_handle, struct dfuse_inod
 	if (open_count != 0)
 		DFUSE_TRA_DEBUG(ie, "Directory change whilst open");
 
+	dfuse_readdir_cache_detach(fs_handle, ie);
+
 	dfuse_cache_evict(ie);
 }
 
+void
+dfuse_cache_evict_parent(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie)
+{
+	struct dfuse_inode_entry *parent;
+	d_list_t                 *rlink;
+
+	rlink = d_hash_rec_find(&fs_handle->dpi_iet, &ie->ie_parent, sizeof(ie->ie_parent));
+	if (!rlink)
+		return;
+
+	parent = container_of(rlink, struct dfuse_inode_entry, ie_htl);
+
+	dfuse_readdir_cache_detach(fs_handle, parent);
+
+	d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
+}
+
 static int
 filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
 {
@@ -207,6 +298,633 @@ dfuse_readdir_reset(struct dfuse_readdir_hdl *hdl)
 #define FADP fuse_add_direntry_plus
 #define FAD  fuse_add_direntry
 
+struct cache_fill_data {
+	char     (*cfd_names)[NAME_MAX + 1];
+	uint32_t cfd_index;
+};
+
+static int
+cache_filler_cb(dfs_t *dfs, dfs_obj_t *dir, const char name[], void *arg)
+{
+	struct cache_fill_data *cfd = arg;
+
+	strncpy(cfd->cfd_names[cfd->cfd_index++], name, NAME_MAX);
+
+	return 0;
+}
+
+/* Number of entries to read at once, matching the sizes used for uncached readdir */
+static uint32_t
+readdir_cache_batch(uint32_t idx, bool plus)
+{
+	if (idx >= READDIR_MAX_COUNT)
+		return READDIR_MAX_COUNT;
+	if (plus)
+		return READDIR_PLUS_COUNT;
+	return READDIR_BASE_COUNT;
+}
+
+static bool
+readdir_cache_current(struct dfuse_readdir_cache *rdc, double max_age)
+{
+	struct timespec now;
+	double          age;
+
+	if (max_age == -1)
+		return true;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+	age = (now.tv_sec - rdc->drc_time.tv_sec) +
+	      ((double)(now.tv_nsec - rdc->drc_time.tv_nsec) / 1000000000);
+
+	return age < max_age;
+}
+
+/* Detach listings that have expired, and the oldest ones whilst the total number of entries
+ * is over READDIR_CACHE_MAX.  Called with dpi_rdc_lock held, the detached listings are moved
+ * to the reclaim list for the caller to release once the lock is dropped.  Listings still in
+ * use by open handles are only freed when the last handle is released.
+ */
+static void
+readdir_cache_sweep(struct dfuse_projection_info *fs_handle, d_list_t *reclaim)
+{
+	struct dfuse_readdir_cache *rdc;
+	struct dfuse_readdir_cache *next;
+	uint64_t                    total;
+
+	total = atomic_load_relaxed(&fs_handle->dpi_rdc_entries);
+
+	d_list_for_each_entry_safe(rdc, next, &fs_handle->dpi_rdc_list, drc_list) {
+		uint32_t held;
+
+		if (readdir_cache_current(rdc, rdc->drc_ie->ie_dfs->dfc_readdir_timeout) &&
+		    total <= READDIR_CACHE_MAX)
+			continue;
+
+		/* Read without drc_lock, this is only used to decide when to stop */
+		held  = rdc->drc_count - rdc->drc_base;
+		total = total > held ? total - held : 0;
+
+		readdir_cache_unlink(rdc);
+		d_list_add_tail(&rdc->drc_list, reclaim);
+	}
+}
+
+static void
+readdir_cache_reclaim(d_list_t *reclaim)
+{
+	struct dfuse_readdir_cache *rdc;
+
+	while ((rdc = d_list_pop_entry(reclaim, struct dfuse_readdir_cache, drc_list))) {
+		DFUSE_TRA_DEBUG(rdc, "Dropping expired listing");
+		dfuse_readdir_cache_decref(rdc);
+	}
+}
+
+void
+dfuse_readdir_cache_release(struct dfuse_projection_info *fs_handle, struct dfuse_obj_hdl *oh)
+{
+	d_list_t reclaim = D_LIST_HEAD_INIT(reclaim);
+
+	if (oh->doh_rdc == NULL)
+		return;
+
+	dfuse_readdir_cache_decref(oh->doh_rdc);
+	oh->doh_rdc = NULL;
+
+	D_MUTEX_LOCK(&fs_handle->dpi_rdc_lock);
+	readdir_cache_sweep(fs_handle, &reclaim);
+	D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+
+	readdir_cache_reclaim(&reclaim);
+}
+
+/* Attach an open handle to the cached listing of its directory, starting a new listing if
+ * there is no current one.
+ */
+static int
+readdir_cache_attach(struct dfuse_projection_info *fs_handle, struct dfuse_obj_hdl *oh)
+{
+	struct dfuse_inode_entry   *ie      = oh->doh_ie;
+	d_list_t                    reclaim = D_LIST_HEAD_INIT(reclaim);
+	struct dfuse_readdir_cache *rdc;
+	int                         rc;
+
+	D_MUTEX_LOCK(&fs_handle->dpi_rdc_lock);
+	readdir_cache_sweep(fs_handle, &reclaim);
+	rdc = ie->ie_rdc;
+	if (rdc) {
+		if (rdc == oh->doh_rdc) {
+			D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+			D_GOTO(out_reclaim, rc = 0);
+		}
+		atomic_fetch_add_relaxed(&rdc->drc_ref, 1);
+		D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+		DFUSE_TRA_DEBUG(oh, "Using cached listing");
+		D_GOTO(out, rc = 0);
+	}
+
+	D_ALLOC_PTR(rdc);
+	if (rdc == NULL) {
+		D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+		D_GOTO(out_reclaim, rc = ENOMEM);
+	}
+
+	rc = D_MUTEX_INIT(&rdc->drc_lock, NULL);
+	if (rc != -DER_SUCCESS) {
+		D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+		D_FREE(rdc);
+		D_GOTO(out_reclaim, rc = daos_der2errno(rc));
+	}
+
+	DFUSE_TRA_UP(rdc, ie, "readdir_cache");
+
+	/* One reference for the inode and one for the open handle */
+	atomic_init(&rdc->drc_ref, 2);
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &rdc->drc_time);
+	rdc->drc_handle = fs_handle;
+	rdc->drc_ie     = ie;
+	ie->ie_rdc      = rdc;
+	d_list_add_tail(&rdc->drc_list, &fs_handle->dpi_rdc_list);
+	D_MUTEX_UNLOCK(&fs_handle->dpi_rdc_lock);
+out:
+	if (oh->doh_rdc)
+		dfuse_readdir_cache_decref(oh->doh_rdc);
+	oh->doh_rdc = rdc;
+out_reclaim:
+	readdir_cache_reclaim(&reclaim);
+	return rc;
+}
+
+/* Start the listing again from the beginning, called with drc_lock held when a handle needs
+ * entries that have been dropped from the window.
+ */
+static void
+readdir_cache_restart(struct dfuse_readdir_cache *rdc)
+{
+	DFUSE_TRA_DEBUG(rdc, "Restarting listing at index %u", rdc->drc_base);
+
+	readdir_cache_release_ents(rdc, rdc->drc_base, rdc->drc_count);
+	if (rdc->drc_ents)
+		memset(rdc->drc_ents, 0, sizeof(*rdc->drc_ents) * rdc->drc_size);
+	memset(&rdc->drc_anchor, 0, sizeof(rdc->drc_anchor));
+	rdc->drc_base  = 0;
+	rdc->drc_count = 0;
+	rdc->drc_eof   = false;
+	rdc->drc_gen++;
+}
+
+/* Read the names of up to count more entries into the listing.  Called with drc_lock held, the
+ * lock is dropped whilst reading so other handles are not blocked, if the listing has moved on
+ * in the meantime the names read here are discarded and the caller tries again.
+ */
+static int
+readdir_cache_fill(struct dfuse_inode_entry *ie, struct dfuse_readdir_cache *rdc, uint32_t count)
+{
+	struct cache_fill_data cfd   = {};
+	uint32_t               start = rdc->drc_count;
+	uint32_t               gen   = rdc->drc_gen;
+	daos_anchor_t          anchor;
+	uint32_t               held;
+	uint32_t               i;
+	int                    rc;
+
+	if (count > READDIR_MAX_COUNT)
+		count = READDIR_MAX_COUNT;
+
+	anchor = rdc->drc_anchor;
+	D_MUTEX_UNLOCK(&rdc->drc_lock);
+
+	D_ALLOC_ARRAY(cfd.cfd_names, count);
+	if (cfd.cfd_names == NULL) {
+		D_MUTEX_LOCK(&rdc->drc_lock);
+		return ENOMEM;
+	}
+
+	rc = dfs_iterate(ie->ie_dfs->dfs_ns, ie->ie_obj, &anchor, &count, (NAME_MAX + 1) * count,
+			 cache_filler_cb, &cfd);
+
+	D_MUTEX_LOCK(&rdc->drc_lock);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (rdc->drc_count != start || rdc->drc_gen != gen) {
+		DFUSE_TRA_DEBUG(rdc, "Listing extended concurrently, discarding %u entries", count);
+		D_GOTO(out, rc = 0);
+	}
+
+	/* Drop the oldest entries to keep within the window */
+	held = rdc->drc_count - rdc->drc_base;
+	if (held + count > READDIR_CACHE_WINDOW) {
+		uint32_t drop = held + count - READDIR_CACHE_WINDOW;
+
+		readdir_cache_release_ents(rdc, rdc->drc_base, rdc->drc_base + drop);
+		memmove(rdc->drc_ents, &rdc->drc_ents[drop], sizeof(*rdc->drc_ents) * (held - drop));
+		memset(&rdc->drc_ents[held - drop], 0, sizeof(*rdc->drc_ents) * drop);
+		rdc->drc_base += drop;
+		held -= drop;
+	}
+
+	if (held + count > rdc->drc_size) {
+		struct dfuse_readdir_centry *ents;
+		uint32_t                     size;
+
+		size = min(max(rdc->drc_size * 2, held + count), READDIR_CACHE_WINDOW);
+
+		D_REALLOC_ARRAY(ents, rdc->drc_ents, rdc->drc_size, size);
+		if (ents == NULL)
+			D_GOTO(out, rc = ENOMEM);
+		rdc->drc_ents = ents;
+		rdc->drc_size = size;
+	}
+
+	for (i = 0; i < count; i++)
+		strncpy(rdc->drc_ents[held + i].dce_name, cfd.cfd_names[i], NAME_MAX);
+
+	DFUSE_TRA_DEBUG(rdc, "Added %u entries at index %u", count, rdc->drc_count);
+
+	atomic_fetch_add_relaxed(&rdc->drc_handle->dpi_rdc_entries, count);
+	rdc->drc_anchor = anchor;
+	rdc->drc_count += count;
+	if (count == 0 || daos_anchor_is_eof(&rdc->drc_anchor))
+		rdc->drc_eof = true;
+out:
+	D_FREE(cfd.cfd_names);
+	return rc;
+}
+
+/* Look up listed entry idx, reading the full stat and xattr data as well if plus is set.  Called
+ * with drc_lock held, the lock is dropped for the lookup itself.  Returns ENOENT for entries
+ * which have been removed since being listed and EAGAIN if the entry was dropped from the
+ * listing whilst unlocked.
+ */
+static int
+readdir_cache_lookup(struct dfuse_inode_entry *ie, struct dfuse_readdir_cache *rdc, uint32_t idx,
+		     bool plus)
+{
+	struct dfuse_readdir_centry *dce = &rdc->drc_ents[idx - rdc->drc_base];
+	uint32_t                     gen = rdc->drc_gen;
+	struct stat                  stbuf = {0};
+	daos_obj_id_t                oid;
+	dfs_obj_t                   *obj;
+	char                         name[NAME_MAX + 1];
+	char                         out[DUNS_MAX_XATTR_LEN];
+	char                        *outp     = &out[0];
+	daos_size_t                  attr_len = DUNS_MAX_XATTR_LEN;
+	char                        *attr     = NULL;
+	int                          rc;
+
+	if (dce->dce_gone)
+		return ENOENT;
+
+	if (dce->dce_stat_valid || (dce->dce_obj && !plus))
+		return 0;
+
+	strncpy(name, dce->dce_name, NAME_MAX + 1);
+	D_MUTEX_UNLOCK(&rdc->drc_lock);
+
+	if (plus)
+		rc = dfs_lookupx(ie->ie_dfs->dfs_ns, ie->ie_obj, name, O_RDWR | O_NOFOLLOW, &obj,
+				 &stbuf.st_mode, &stbuf, 1, &duns_xattr_name, (void **)&outp,
+				 &attr_len);
+	else
+		rc = dfs_lookup_rel(ie->ie_dfs->dfs_ns, ie->ie_obj, name, O_RDONLY | O_NOFOLLOW,
+				    &obj, &stbuf.st_mode, NULL);
+	if (rc == 0 && plus && attr_len != 0) {
+		D_ALLOC(attr, attr_len);
+		if (attr == NULL) {
+			dfs_release(obj);
+			rc = ENOMEM;
+		} else {
+			memcpy(attr, out, attr_len);
+		}
+	}
+
+	D_MUTEX_LOCK(&rdc->drc_lock);
+
+	if (rdc->drc_gen != gen || idx < rdc->drc_base) {
+		DFUSE_TRA_DEBUG(rdc, "Entry %u dropped during lookup", idx);
+		if (rc == 0) {
+			dfs_release(obj);
+			D_FREE(attr);
+		}
+		return EAGAIN;
+	}
+	dce = &rdc->drc_ents[idx - rdc->drc_base];
+
+	if (rc == ENOENT) {
+		DFUSE_TRA_DEBUG(ie, "File '%s' does not exist", name);
+		dce->dce_gone = true;
+		return rc;
+	} else if (rc != 0) {
+		DFUSE_TRA_DEBUG(ie, "Problem finding file %d", rc);
+		return rc;
+	}
+
+	/* Another handle looked the entry up concurrently */
+	if (dce->dce_stat_valid || (dce->dce_obj && !plus)) {
+		dfs_release(obj);
+		D_FREE(attr);
+		return 0;
+	}
+
+	dfs_obj2id(obj, &oid);
+	dfuse_compute_inode(ie->ie_dfs, &oid, &stbuf.st_ino);
+
+	if (dce->dce_obj)
+		dfs_release(dce->dce_obj);
+	dce->dce_obj        = obj;
+	dce->dce_stbuf      = stbuf;
+	dce->dce_stat_valid = plus;
+	if (attr) {
+		dce->dce_attr     = attr;
+		dce->dce_attr_len = attr_len;
+	}
+
+	return 0;
+}
+
+/* Read and look up the entries that the next readdir call on a handle is expected to need.
+ * This runs on the prefetch thread so that the kernel processes one batch whilst dfuse is
+ * fetching the next one, errors are ignored as the entries will be looked up again on use.
+ */
+static void
+readdir_cache_prefetch(struct dfuse_inode_entry *ie, struct dfuse_readdir_cache *rdc,
+		       uint32_t idx, bool plus)
+{
+	uint32_t end = idx + readdir_cache_batch(idx, plus);
+	uint32_t gen;
+	int      rc = 0;
+
+	D_MUTEX_LOCK(&rdc->drc_lock);
+	gen = rdc->drc_gen;
+	while (!rdc->drc_eof && rdc->drc_count < end) {
+		rc = readdir_cache_fill(ie, rdc, end - rdc->drc_count);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		if (rdc->drc_gen != gen)
+			D_GOTO(out, rc = EAGAIN);
+	}
+
+	for (; idx < end && idx < rdc->drc_count; idx++) {
+		if (idx < rdc->drc_base)
+			D_GOTO(out, rc = EAGAIN);
+		rc = readdir_cache_lookup(ie, rdc, idx, plus);
+		if (rc == ENOENT)
+			rc = 0;
+		if (rc != 0)
+			break;
+	}
+out:
+	D_MUTEX_UNLOCK(&rdc->drc_lock);
+	if (rc != 0)
+		DFUSE_TRA_DEBUG(rdc, "Prefetch stopped at index %u: %d", idx, rc);
+}
+
+struct dfuse_readdir_prefetch {
+	d_list_t                    drp_list;
+	struct dfuse_inode_entry   *drp_ie;
+	struct dfuse_readdir_cache *drp_rdc;
+	uint32_t                    drp_idx;
+	bool                        drp_plus;
+};
+
+static void
+readdir_prefetch_free(struct dfuse_projection_info *fs_handle, struct dfuse_readdir_prefetch *drp)
+{
+	dfuse_readdir_cache_decref(drp->drp_rdc);
+	d_hash_rec_decref(&fs_handle->dpi_iet, &drp->drp_ie->ie_htl);
+	D_FREE(drp);
+}
+
+/* Queue a prefetch for the prefetch thread, taking references on the listing and the inode as
+ * the handle may be closed as soon as the reply is sent.  Only one request is queued per
+ * listing, if one is already waiting then the next readdir call will queue another.
+ */
+static void
+readdir_prefetch_queue(struct dfuse_projection_info *fs_handle, struct dfuse_inode_entry *ie,
+		       struct dfuse_readdir_cache *rdc, uint32_t idx, bool plus)
+{
+	struct dfuse_readdir_prefetch *drp;
+
+	D_ALLOC_PTR(drp);
+	if (drp == NULL)
+		return;
+
+	D_MUTEX_LOCK(&fs_handle->dpi_rdp_lock);
+	if (rdc->drc_prefetch || fs_handle->dpi_shutdown) {
+		D_MUTEX_UNLOCK(&fs_handle->dpi_rdp_lock);
+		D_FREE(drp);
+		return;
+	}
+	rdc->drc_prefetch = true;
+
+	atomic_fetch_add_relaxed(&rdc->drc_ref, 1);
+	d_hash_rec_addref(&fs_handle->dpi_iet, &ie->ie_htl);
+	drp->drp_ie   = ie;
+	drp->drp_rdc  = rdc;
+	drp->drp_idx  = idx;
+	drp->drp_plus = plus;
+	d_list_add_tail(&drp->drp_list, &fs_handle->dpi_rdp_list);
+	D_MUTEX_UNLOCK(&fs_handle->dpi_rdp_lock);
+
+	sem_post(&fs_handle->dpi_rdp_sem);
+}
+
+void *
+dfuse_readdir_prefetch_thread(void *arg)
+{
+	struct dfuse_projection_info  *fs_handle = arg;
+	struct dfuse_readdir_prefetch *drp;
+
+	while (1) {
+		errno = 0;
+		if (sem_wait(&fs_handle->dpi_rdp_sem) != 0) {
+			if (errno == EINTR)
+				continue;
+			DFUSE_TRA_ERROR(fs_handle, "Error from sem_wait: %d", errno);
+		}
+
+		if (fs_handle->dpi_shutdown)
+			break;
+
+		D_MUTEX_LOCK(&fs_handle->dpi_rdp_lock);
+		drp = d_list_pop_entry(&fs_handle->dpi_rdp_list, struct dfuse_readdir_prefetch,
+				       drp_list);
+		if (drp != NULL)
+			drp->drp_rdc->drc_prefetch = false;
+		D_MUTEX_UNLOCK(&fs_handle->dpi_rdp_lock);
+
+		if (drp == NULL)
+			continue;
+
+		readdir_cache_prefetch(drp->drp_ie, drp->drp_rdc, drp->drp_idx, drp->drp_plus);
+		readdir_prefetch_free(fs_handle, drp);
+	}
+	return NULL;
+}
+
+void
+dfuse_readdir_prefetch_drain(struct dfuse_projection_info *fs_handle)
+{
+	struct dfuse_readdir_prefetch *drp;
+	d_list_t                       pending;
+
+	D_INIT_LIST_HEAD(&pending);
+	D_MUTEX_LOCK(&fs_handle->dpi_rdp_lock);
+	d_list_splice_init(&fs_handle->dpi_rdp_list, &pending);
+	D_MUTEX_UNLOCK(&fs_handle->dpi_rdp_lock);
+
+	while ((drp = d_list_pop_entry(&pending, struct dfuse_readdir_prefetch, drp_list)) != NULL)
+		readdir_prefetch_free(fs_handle, drp);
+}
+
+/* Serve readdir from the listing shared between handles of the directory.  Offsets are the
+ * index into the listing, plus OFFSET_BASE.
+ */
+static void
+readdir_from_cache(struct dfuse_projection_info *fs_handle, fuse_req_t req,
+		   struct dfuse_obj_hdl *oh, char *reply_buff, size_t size, off_t offset, bool plus)
+{
+	struct dfuse_inode_entry   *ie          = oh->doh_ie;
+	struct dfuse_readdir_cache *rdc;
+	off_t                       buff_offset = 0;
+	int                         added       = 0;
+	int                         rc          = 0;
+	bool                        eod         = false;
+	uint32_t                    idx;
+
+	if (offset == 0 || oh->doh_rdc == NULL) {
+		if (oh->doh_kreaddir_started)
+			oh->doh_kreaddir_invalid = true;
+		oh->doh_kreaddir_started = true;
+
+		rc = readdir_cache_attach(fs_handle, oh);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	} else if (offset != oh->doh_rdc_offset) {
+		DFUSE_TRA_DEBUG(oh, "Seeking from offset %#lx to %#lx", oh->doh_rdc_offset,
+				offset);
+		oh->doh_kreaddir_invalid = true;
+	}
+
+	if (offset == 0)
+		offset = OFFSET_BASE;
+
+	rdc = oh->doh_rdc;
+	idx = offset - OFFSET_BASE;
+
+	DFUSE_TRA_DEBUG(oh, "plus %d offset %#lx", plus, offset);
+
+	D_MUTEX_LOCK(&rdc->drc_lock);
+	do {
+		struct dfuse_readdir_centry *dce;
+		off_t                        next_offset;
+		size_t                       written;
+
+		/* The entry was dropped from the window, read the listing again */
+		if (idx < rdc->drc_base) {
+			readdir_cache_restart(rdc);
+			continue;
+		}
+
+		if (idx >= rdc->drc_count) {
+			if (rdc->drc_eof) {
+				eod = true;
+				break;
+			}
+			rc = readdir_cache_fill(ie, rdc,
+						max(readdir_cache_batch(idx, plus),
+						    idx + 1 - rdc->drc_count));
+			if (rc != 0)
+				break;
+			continue;
+		}
+
+		rc = readdir_cache_lookup(ie, rdc, idx, plus);
+		if (rc == EAGAIN) {
+			rc = 0;
+			continue;
+		} else if (rc == ENOENT) {
+			rc = 0;
+			idx++;
+			continue;
+		} else if (rc != 0) {
+			break;
+		}
+
+		dce = &rdc->drc_ents[idx - rdc->drc_base];
+
+		if (idx + 1 == rdc->drc_count && rdc->drc_eof)
+			next_offset = READDIR_EOD;
+		else
+			next_offset = idx + 1 + OFFSET_BASE;
+
+		if (plus) {
+			struct fuse_entry_param entry = {0};
+			d_list_t               *rlink;
+			dfs_obj_t              *obj;
+
+			/* The inode takes ownership of the object so give it a copy */
+			rc = dfs_dup(oh->doh_dfs, dce->dce_obj, O_RDWR, &obj);
+			if (rc != 0)
+				break;
+
+			entry.attr = dce->dce_stbuf;
+
+			rc = create_entry(fs_handle, ie, &entry, obj, dce->dce_name, dce->dce_attr,
+					  dce->dce_attr_len, &rlink);
+			if (rc != 0)
+				break;
+
+			written = FADP(req, &reply_buff[buff_offset], size - buff_offset,
+				       dce->dce_name, &entry, next_offset);
+			if (written > size - buff_offset)
+				d_hash_rec_decref(&fs_handle->dpi_iet, rlink);
+		} else {
+			written = FAD(req, &reply_buff[buff_offset], size - buff_offset,
+				      dce->dce_name, &dce->dce_stbuf, next_offset);
+		}
+		if (written > size - buff_offset) {
+			DFUSE_TRA_DEBUG(oh, "Buffer is full");
+			break;
+		}
+
+		buff_offset += written;
+		added++;
+		idx++;
+		oh->doh_rdc_offset = next_offset;
+
+		if (next_offset == READDIR_EOD) {
+			DFUSE_TRA_DEBUG(oh, "Reached end of directory");
+			eod = true;
+		}
+	} while (!eod);
+	D_MUTEX_UNLOCK(&rdc->drc_lock);
+
+	if (rc != 0)
+		DFUSE_TRA_DEBUG(oh, "Replying with %d entries, rc %d", added, rc);
+
+	if (added == 0 && rc != 0)
+		D_GOTO(out, rc);
+
+	if (!eod)
+		readdir_prefetch_queue(fs_handle, ie, rdc, idx, plus);
+
+	atomic_fetch_sub_relaxed(&oh->doh_readir_number, 1);
+	atomic_fetch_sub_relaxed(&ie->ie_readir_number, 1);
+
+	DFUSE_REPLY_BUF(oh, req, reply_buff, buff_offset);
+	D_FREE(reply_buff);
+	return;
+out:
+	atomic_fetch_sub_relaxed(&oh->doh_readir_number, 1);
+	atomic_fetch_sub_relaxed(&ie->ie_readir_number, 1);
+	DFUSE_REPLY_ERR_RAW(oh, req, rc);
+	D_FREE(reply_buff);
+}
+
 void
 dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh, size_t size, off_t offset, bool plus)
 {
@@ -239,6 +957,11 @@ dfuse_cb_readdir(fuse_req_t req, struct dfuse_obj_hdl *oh, size_t size, off_t of
 	if (reply_buff == NULL)
 		D_GOTO(out, rc = ENOMEM);
 
+	if (oh->doh_ie->ie_dfs->dfc_readdir_timeout != 0) {
+		readdir_from_cache(fs_handle, req, oh, reply_buff, size, offset, plus);
+		return;
+	}
+
 	if (oh->doh_rd == NULL) {
 		D_ALLOC_PTR(oh->doh_rd);
 		if (oh->doh_rd == NULL)
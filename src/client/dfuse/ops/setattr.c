@@ -10,8 +10,9 @@
 void
 dfuse_cb_setattr(fuse_req_t req, struct dfuse_inode_entry *ie, struct stat *attr, int to_set)
 {
-	int dfs_flags = 0;
-	int rc;
+	struct dfuse_projection_info *fs_handle = fuse_req_userdata(req);
+	int                           dfs_flags = 0;
+	int                           rc;
 
 	DFUSE_TRA_DEBUG(ie, "flags %#x", to_set);
 
@@ -109,6 +110,8 @@ dfuse_cb_setattr(fuse_req_t req, struct dfuse_inode_entry *ie, struct stat *attr
 	if (rc)
 		D_GOTO(err, rc);
 
+	dfuse_cache_evict_parent(fs_handle, ie);
+
 	attr->st_ino = ie->ie_stat.st_ino;
 
 	ie->ie_stat = *attr;
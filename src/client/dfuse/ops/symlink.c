@@ -32,6 +32,8 @@ dfuse_cb_symlink(fuse_req_t req, const char *link, struct dfuse_inode_entry *par
 	if (rc != 0)
 		D_GOTO(err, rc);
 
+	dfuse_cache_evict_dir(fs_handle, parent);
+
 	DFUSE_TRA_DEBUG(ie, "obj is %p", ie->ie_obj);
 
 	strncpy(ie->ie_name, name, NAME_MAX);
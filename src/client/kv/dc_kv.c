@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2017-2022 Intel Corporation.
+ * (C) Copyright 2017-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -640,3 +640,183 @@ err_task:
 		kv_decref(kv);
 	return rc;
 }
+
+static int
+set_entry_result_cb(tse_task_t *task, void *data)
+{
+	daos_kv_entry_t *kve = *((daos_kv_entry_t **)data);
+
+	kve->kve_rc = task->dt_result;
+	return 0;
+}
+
+static int
+set_entry_size_cb(tse_task_t *task, void *data)
+{
+	daos_kv_entry_t *kve = *((daos_kv_entry_t **)data);
+	daos_obj_fetch_t *args = daos_task_get_args(task);
+
+	kve->kve_size = args->iods[0].iod_size;
+	return 0;
+}
+
+/**
+ * Common part of the multi-key operations, create one object task per key and make the upper
+ * task depend on all of them so that they are in flight at the same time.  Each object task
+ * records its own result in the entry, the upper task fails with the error of any of them.
+ * An error before the object tasks are scheduled is set in every entry.
+ *
+ * This sends one RPC per key: an object RPC carries a single dkey, and same-shard keys could
+ * only share an RPC through a distributed transaction, which would turn the per-key results
+ * into all-or-nothing.  It saves the per-key events and round trips of the caller, not RPCs.
+ */
+static int
+kv_multi_io(tse_task_t *task, daos_opc_t opc)
+{
+	daos_kv_multi_t		*args = daos_task_get_args(task);
+	struct dc_kv		*kv = NULL;
+	struct io_params	*params = NULL;
+	tse_task_t		**io_tasks = NULL;
+	uint32_t		created = 0;
+	uint32_t		i;
+	int			rc;
+
+	if (args->nr == 0 || args->kves == NULL)
+		D_GOTO(err_task, rc = -DER_INVAL);
+
+	for (i = 0; i < args->nr; i++) {
+		daos_kv_entry_t *kve = &args->kves[i];
+
+		if (kve->kve_key == NULL)
+			D_GOTO(err_task, rc = -DER_INVAL);
+		if (opc == DAOS_OPC_OBJ_UPDATE && (kve->kve_size == 0 || kve->kve_buf == NULL))
+			D_GOTO(err_task, rc = -DER_INVAL);
+		kve->kve_rc = 0;
+	}
+
+	kv = kv_hdl2ptr(args->oh);
+	if (kv == NULL)
+		D_GOTO(err_task, rc = -DER_NO_HDL);
+
+	D_ALLOC_ARRAY(params, args->nr);
+	if (params == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(io_tasks, args->nr);
+	if (io_tasks == NULL)
+		D_GOTO(err_task, rc = -DER_NOMEM);
+
+	for (i = 0; i < args->nr; i++) {
+		daos_kv_entry_t		*kve = &args->kves[i];
+		struct io_params	*p = &params[i];
+
+		/** init dkey */
+		d_iov_set(&p->dkey, (void *)kve->kve_key, strlen(kve->kve_key));
+
+		rc = daos_task_create(opc, tse_task2sched(task), 0, NULL, &io_tasks[i]);
+		if (rc != 0)
+			D_GOTO(err_task, rc);
+		created++;
+
+		if (opc == DAOS_OPC_OBJ_PUNCH_DKEYS) {
+			daos_obj_punch_t *punch_args = daos_task_get_args(io_tasks[i]);
+
+			punch_args->oh		= kv->daos_oh;
+			punch_args->th		= args->th;
+			punch_args->flags	= args->flags;
+			punch_args->dkey	= &p->dkey;
+			punch_args->akeys	= NULL;
+			punch_args->akey_nr	= 0;
+		} else {
+			daos_obj_rw_t *rw_args = daos_task_get_args(io_tasks[i]);
+
+			/** init iod. */
+			p->akey_val = '0';
+			d_iov_set(&p->iod.iod_name, &p->akey_val, 1);
+			p->iod.iod_nr		= 1;
+			p->iod.iod_recxs	= NULL;
+			p->iod.iod_size		= kve->kve_size;
+			p->iod.iod_type		= DAOS_IOD_SINGLE;
+
+			rw_args->oh	= kv->daos_oh;
+			rw_args->th	= args->th;
+			rw_args->flags	= args->flags;
+			rw_args->dkey	= &p->dkey;
+			rw_args->nr	= 1;
+			rw_args->iods	= &p->iod;
+
+			/** init sgl */
+			if (kve->kve_buf && kve->kve_size) {
+				d_iov_set(&p->iov, kve->kve_buf, kve->kve_size);
+				p->sgl.sg_iovs	= &p->iov;
+				p->sgl.sg_nr	= 1;
+				rw_args->sgls	= &p->sgl;
+			}
+
+			if (opc == DAOS_OPC_OBJ_FETCH) {
+				rc = tse_task_register_comp_cb(io_tasks[i], set_entry_size_cb,
+							       &kve, sizeof(kve));
+				if (rc != 0)
+					D_GOTO(err_task, rc);
+			}
+		}
+
+		rc = tse_task_register_comp_cb(io_tasks[i], set_entry_result_cb, &kve,
+					       sizeof(kve));
+		if (rc != 0)
+			D_GOTO(err_task, rc);
+	}
+
+	rc = tse_task_register_comp_cb(task, free_io_params_cb, &params,
+				       sizeof(params));
+	if (rc != 0)
+		D_GOTO(err_task, rc);
+
+	rc = tse_task_register_deps(task, args->nr, io_tasks);
+	if (rc != 0) {
+		/** params is freed by the completion callback from here on */
+		params = NULL;
+		D_GOTO(err_task, rc);
+	}
+
+	for (i = 0; i < args->nr; i++)
+		tse_task_schedule(io_tasks[i], false);
+
+	D_FREE(io_tasks);
+	tse_sched_progress(tse_task2sched(task));
+	kv_decref(kv);
+	return 0;
+
+err_task:
+	for (i = 0; i < created; i++)
+		tse_task_complete(io_tasks[i], rc);
+	D_FREE(io_tasks);
+	D_FREE(params);
+	/** the per-key results may not be set yet, callers check them rather than the event */
+	if (args->kves != NULL) {
+		for (i = 0; i < args->nr; i++)
+			args->kves[i].kve_rc = rc;
+	}
+	tse_task_complete(task, rc);
+	if (kv)
+		kv_decref(kv);
+	return rc;
+}
+
+int
+dc_kv_put_multi(tse_task_t *task)
+{
+	return kv_multi_io(task, DAOS_OPC_OBJ_UPDATE);
+}
+
+int
+dc_kv_get_multi(tse_task_t *task)
+{
+	return kv_multi_io(task, DAOS_OPC_OBJ_FETCH);
+}
+
+int
+dc_kv_remove_multi(tse_task_t *task)
+{
+	return kv_multi_io(task, DAOS_OPC_OBJ_PUNCH_DKEYS);
+}
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -625,33 +625,43 @@ __shim_handle__kv_close(PyObject *self, PyObject *args)
 /** max number of concurrent put/get requests */
 #define MAX_INFLIGHT 16
 
-struct kv_op {
+/** max number of keys in each put/get request */
+#define KV_BATCH_SIZE 64
+
+/**
+ * A batch of keys submitted as a single daos_kv_{put,get,remove}_multi() call, with one event.
+ * The library still sends one RPC per key.
+ */
+struct kv_batch {
 	daos_event_t	 ev;
-	PyObject	*key_obj;
-	char		*key;
-	char		*buf;
-	daos_size_t	 size;
-	daos_size_t	buf_size;
+	uint32_t	 nr;
+	/** For kv_put, true if this is a batch of keys to remove */
+	bool		 remove;
+	daos_kv_entry_t	 kves[KV_BATCH_SIZE];
+	PyObject	*key_objs[KV_BATCH_SIZE];
+	/** For kv_get, value buffers and their allocated sizes */
+	char		*bufs[KV_BATCH_SIZE];
+	daos_size_t	 buf_sizes[KV_BATCH_SIZE];
 };
 
 static inline int
-kv_get_comp(struct kv_op *op, PyObject *daos_dict)
+kv_get_comp(PyObject *key_obj, char *buf, daos_size_t size, PyObject *daos_dict)
 {
 	PyObject	*val;
 	int		 rc;
 
 	/** insert value in python dict */
-	if (op->size == 0) {
+	if (size == 0) {
 		Py_INCREF(Py_None);
 		val = Py_None;
 	} else {
-		val = PyBytes_FromStringAndSize(op->buf, op->size);
+		val = PyBytes_FromStringAndSize(buf, size);
 	}
 
 	if (val == NULL)
 		return -DER_IO;
 
-	rc = PyDict_SetItem(daos_dict, op->key_obj, val);
+	rc = PyDict_SetItem(daos_dict, key_obj, val);
 	if (rc < 0)
 		rc = -DER_IO;
 	else
@@ -662,6 +672,51 @@ kv_get_comp(struct kv_op *op, PyObject *daos_dict)
 	return rc;
 }
 
+/**
+ * Insert the values of a completed get batch into the python dict.  Values which did not fit
+ * in the buffer are fetched again on their own after growing the buffer.  Sets py_err if the
+ * failure was from python, in which case an exception is already set.
+ */
+static int
+kv_get_batch_comp(daos_handle_t oh, struct kv_batch *batch, PyObject *daos_dict, bool *py_err)
+{
+	uint32_t	i;
+	int		rc;
+
+	/** any other error may have failed the batch before the per-key results were set */
+	rc = batch->ev.ev_error;
+	if (rc != -DER_SUCCESS && rc != -DER_REC2BIG)
+		return rc;
+
+	for (i = 0; i < batch->nr; i++) {
+		daos_kv_entry_t *kve = &batch->kves[i];
+
+		if (kve->kve_rc == -DER_REC2BIG) {
+			char *new_buff;
+
+			D_REALLOC_NZ(new_buff, batch->bufs[i], kve->kve_size);
+			if (new_buff == NULL)
+				return -DER_NOMEM;
+			batch->bufs[i]      = new_buff;
+			batch->buf_sizes[i] = kve->kve_size;
+
+			rc = daos_kv_get(oh, DAOS_TX_NONE, 0, kve->kve_key, &kve->kve_size,
+					 new_buff, NULL);
+			if (rc != -DER_SUCCESS)
+				return rc;
+		} else if (kve->kve_rc != -DER_SUCCESS) {
+			return kve->kve_rc;
+		}
+
+		rc = kv_get_comp(batch->key_objs[i], batch->bufs[i], kve->kve_size, daos_dict);
+		if (rc != DER_SUCCESS) {
+			*py_err = true;
+			return rc;
+		}
+	}
+	return DER_SUCCESS;
+}
+
 static PyObject *
 __shim_handle__kv_get(PyObject *self, PyObject *args)
 {
@@ -670,10 +725,12 @@ __shim_handle__kv_get(PyObject *self, PyObject *args)
 	PyObject	*key;
 	Py_ssize_t	 pos = 0;
 	daos_handle_t	 eq;
-	struct kv_op	*kv_array = NULL;
-	struct kv_op	*op;
+	struct kv_batch	*batches = NULL;
+	struct kv_batch	*batch = NULL;
 	daos_event_t	*evp;
-	int		 i = 0;
+	bool		 py_err = false;
+	int		 used = 0;
+	int		 i;
 	int		 rc = 0;
 	int		 ret;
 	size_t		 v_size;
@@ -690,148 +747,111 @@ __shim_handle__kv_get(PyObject *self, PyObject *args)
 		eq = glob_eq;
 	}
 
-	D_ALLOC_ARRAY(kv_array, MAX_INFLIGHT);
-	if (kv_array == NULL) {
+	D_ALLOC_ARRAY(batches, MAX_INFLIGHT);
+	if (batches == NULL) {
 		rc = -DER_NOMEM;
 		goto out;
 	}
 
 	while (PyDict_Next(daos_dict, &pos, &key, NULL)) {
-		if (i < MAX_INFLIGHT) {
-			/** haven't reached max request in flight yet */
-			op = &kv_array[i];
-			evp = &op->ev;
-			rc = daos_event_init(evp, eq, NULL);
-			if (rc)
-				break;
-			op->buf_size = v_size;
-			op->size = op->buf_size;
-			D_ALLOC(op->buf, op->buf_size);
-			if (op->buf == NULL) {
-				rc = -DER_NOMEM;
-				break;
-			}
-
-			i++;
-		} else {
-			/**
-			 * max request request in flight reached, wait
-			 * for one i/o to complete to reuse the slot
-			 */
-rewait:
-			rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
-			if (rc < 0)
-				break;
-			if (rc == 0) {
-				rc = -DER_IO;
-				break;
-			}
-
-			op = container_of(evp, struct kv_op, ev);
-
-			/** check result of completed operation */
-			if (evp->ev_error == DER_SUCCESS) {
-				rc = kv_get_comp(op, daos_dict);
-				if (rc != DER_SUCCESS)
-					D_GOTO(err, rc);
-				/* Reset the size of the request */
-				op->size = op->buf_size;
-				evp->ev_error = 0;
-			} else if (evp->ev_error == -DER_REC2BIG) {
-				char *new_buff;
+		daos_kv_entry_t	*kve;
+		char		*key_str;
 
-				D_REALLOC_NZ(new_buff, op->buf, op->size);
-				if (new_buff == NULL) {
-					rc = -DER_NOMEM;
+		if (batch == NULL) {
+			if (used < MAX_INFLIGHT) {
+				/** haven't reached max request in flight yet */
+				batch = &batches[used];
+				rc = daos_event_init(&batch->ev, eq, NULL);
+				if (rc)
 					break;
-				}
-				op->buf_size = op->size;
-				op->buf = new_buff;
-
-				daos_event_fini(evp);
-				rc = daos_event_init(evp, eq, NULL);
-				if (rc != -DER_SUCCESS)
+				used++;
+			} else {
+				/**
+				 * max request request in flight reached, wait
+				 * for one batch to complete to reuse the slot
+				 */
+				rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+				if (rc < 0)
+					break;
+				if (rc == 0) {
+					rc = -DER_IO;
 					break;
+				}
 
-				rc = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key,
-						&op->size, op->buf, evp);
-				if (rc != -DER_SUCCESS)
+				batch = container_of(evp, struct kv_batch, ev);
+				rc = kv_get_batch_comp(oh, batch, daos_dict, &py_err);
+				if (rc != DER_SUCCESS)
 					break;
-				D_GOTO(rewait, rc);
-			} else {
-				rc = evp->ev_error;
-				break;
+				evp->ev_error = 0;
 			}
+			batch->nr = 0;
 		}
 
-		/** submit get request */
-		op->key_obj = key;
-
 		if (PyUnicode_Check(key)) {
-			op->key = (char *)PyUnicode_AsUTF8(key);
+			key_str = (char *)PyUnicode_AsUTF8(key);
 		} else {
-			op->key = PyString_AsString(key);
+			key_str = PyString_AsString(key);
 		}
-		if (!op->key)
-			D_GOTO(err, rc = 0);
-		rc = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key, &op->size,
-				 op->buf, evp);
-		if (rc) {
+		if (!key_str) {
+			py_err = true;
+			rc     = -DER_INVAL;
 			break;
 		}
+
+		if (batch->bufs[batch->nr] == NULL) {
+			D_ALLOC(batch->bufs[batch->nr], v_size);
+			if (batch->bufs[batch->nr] == NULL) {
+				rc = -DER_NOMEM;
+				batch = NULL;
+				break;
+			}
+			batch->buf_sizes[batch->nr] = v_size;
+		}
+
+		kve = &batch->kves[batch->nr];
+		kve->kve_key  = key_str;
+		kve->kve_buf  = batch->bufs[batch->nr];
+		kve->kve_size = batch->buf_sizes[batch->nr];
+		batch->key_objs[batch->nr] = key;
+		batch->nr++;
+
+		/** submit get request once the batch is full */
+		if (batch->nr == KV_BATCH_SIZE) {
+			rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, batch->nr, batch->kves,
+					       &batch->ev);
+			batch = NULL;
+			if (rc)
+				break;
+		}
 	}
 
+	/** submit the last partial batch */
+	if (batch != NULL && batch->nr != 0 && rc == DER_SUCCESS)
+		rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, batch->nr, batch->kves,
+				       &batch->ev);
+
 	/** wait for completion of all in-flight requests */
 	do {
 		ret = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
-		if (ret == 1) {
-			int rc2;
-
-			op = container_of(evp, struct kv_op, ev);
-
-			/** check result of completed operation */
-			if (evp->ev_error == DER_SUCCESS) {
-				rc2 = kv_get_comp(op, daos_dict);
-				if (rc == DER_SUCCESS && rc2 != DER_SUCCESS)
-					D_GOTO(err, rc = rc2);
-				continue;
-			} else if (evp->ev_error == -DER_REC2BIG) {
-				char *new_buff;
-
-				daos_event_fini(evp);
-				rc2 = daos_event_init(evp, eq, NULL);
-
-				D_REALLOC_NZ(new_buff, op->buf, op->size);
-				if (new_buff == NULL)
-					D_GOTO(out, rc = -DER_NOMEM);
-
-				op->buf_size = op->size;
-				op->buf = new_buff;
-
-				rc2 = daos_kv_get(oh, DAOS_TX_NONE, 0, op->key,
-						&op->size, op->buf, evp);
-				if (rc2 != -DER_SUCCESS)
-					D_GOTO(out, rc = rc2);
-			} else {
-				if (rc == DER_SUCCESS)
-					rc = evp->ev_error;
-			}
+		if (ret == 1 && rc == DER_SUCCESS) {
+			batch = container_of(evp, struct kv_batch, ev);
+			rc = kv_get_batch_comp(oh, batch, daos_dict, &py_err);
 		}
-		if (rc == DER_SUCCESS && ret == 1)
-			rc = evp->ev_error;
 	} while (ret == 1);
 
 	if (rc == DER_SUCCESS && ret < 0)
 		rc = ret;
 
 	/** free up all buffers */
-	for (i = 0; i < MAX_INFLIGHT; i++) {
-		op = &kv_array[i];
-		D_FREE(op->buf);
+	for (i = 0; i < used; i++) {
+		uint32_t j;
+
+		for (j = 0; j < KV_BATCH_SIZE; j++)
+			D_FREE(batches[i].bufs[j]);
 	}
 
 out:
-	D_FREE(kv_array);
+	D_FREE(batches);
 
 	/** destroy event queue */
 	if (!use_glob_eq) {
@@ -840,15 +860,20 @@ out:
 			rc = ret;
 	}
 
+	if (py_err)
+		return NULL;
+
 	/* Populate return list */
 	return PyInt_FromLong(rc);
+}
 
-err:
-	if (!use_glob_eq)
-		daos_eq_destroy(eq, DAOS_EQ_DESTROY_FORCE);
-	D_FREE(kv_array);
-
-	return NULL;
+static int
+kv_put_submit(daos_handle_t oh, struct kv_batch *batch)
+{
+	if (batch->remove)
+		return daos_kv_remove_multi(oh, DAOS_TX_NONE, 0, batch->nr, batch->kves,
+					    &batch->ev);
+	return daos_kv_put_multi(oh, DAOS_TX_NONE, 0, batch->nr, batch->kves, &batch->ev);
 }
 
 static PyObject *
@@ -860,9 +885,12 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 	PyObject	*value;
 	Py_ssize_t	 pos = 0;
 	daos_handle_t	 eq;
-	daos_event_t	 ev_array[MAX_INFLIGHT];
+	struct kv_batch	*batches = NULL;
+	/** batches being filled, one for keys to insert and one for keys to remove */
+	struct kv_batch	*open[2] = {NULL, NULL};
 	daos_event_t	*evp;
-	int		 i = 0;
+	int		 used = 0;
+	int		 i;
 	int		 rc = 0;
 	int		 ret;
 
@@ -878,38 +906,19 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 		eq = glob_eq;
 	}
 
-	while (PyDict_Next(daos_dict, &pos, &key, &value)) {
-		char		*buf;
-		daos_size_t	 size;
-		char		*key_str;
-
-		if (i < MAX_INFLIGHT) {
-			/** haven't reached max request in flight yet */
-			evp = &ev_array[i];
-			rc = daos_event_init(evp, eq, NULL);
-			if (rc)
-				break;
-			i++;
-		} else {
-			/**
-			 * max request request in flight reached, wait
-			 * for one i/o to complete to reuse the slot
-			 */
-			rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
-			if (rc < 0)
-				break;
-			if (rc == 0) {
-				rc = -DER_IO;
-				break;
-			}
+	D_ALLOC_ARRAY(batches, MAX_INFLIGHT);
+	if (batches == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
 
-			/** check if completed operation failed */
-			if (evp->ev_error != DER_SUCCESS) {
-				rc = evp->ev_error;
-				break;
-			}
-			evp->ev_error = 0;
-		}
+	while (PyDict_Next(daos_dict, &pos, &key, &value)) {
+		struct kv_batch	**batchp;
+		struct kv_batch	 *batch;
+		daos_kv_entry_t	 *kve;
+		char		 *buf = NULL;
+		daos_size_t	  size;
+		char		 *key_str;
 
 		/** XXX: Interpret all values as strings for now */
 		if (value == Py_None) {
@@ -938,13 +947,59 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 			D_GOTO(err, rc = 0);
 
 		/** insert or delete kv pair */
-		if (size == 0)
-			rc = daos_kv_remove(oh, DAOS_TX_NONE, 0, key_str, evp);
-		else
-			rc = daos_kv_put(oh, DAOS_TX_NONE, 0, key_str, size,
-					 buf, evp);
-		if (rc)
-			break;
+		batchp = &open[size == 0];
+		if (*batchp == NULL) {
+			if (used < MAX_INFLIGHT) {
+				/** haven't reached max request in flight yet */
+				batch = &batches[used];
+				rc = daos_event_init(&batch->ev, eq, NULL);
+				if (rc)
+					break;
+				used++;
+			} else {
+				/**
+				 * max request request in flight reached, wait
+				 * for one batch to complete to reuse the slot
+				 */
+				rc = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+				if (rc < 0)
+					break;
+				if (rc == 0) {
+					rc = -DER_IO;
+					break;
+				}
+
+				/** check if completed operation failed */
+				if (evp->ev_error != DER_SUCCESS) {
+					rc = evp->ev_error;
+					break;
+				}
+				evp->ev_error = 0;
+				batch = container_of(evp, struct kv_batch, ev);
+			}
+			batch->nr     = 0;
+			batch->remove = (size == 0);
+			*batchp       = batch;
+		}
+		batch = *batchp;
+
+		kve = &batch->kves[batch->nr++];
+		kve->kve_key  = key_str;
+		kve->kve_buf  = buf;
+		kve->kve_size = size;
+
+		if (batch->nr == KV_BATCH_SIZE) {
+			*batchp = NULL;
+			rc = kv_put_submit(oh, batch);
+			if (rc)
+				break;
+		}
+	}
+
+	/** submit any partial batches */
+	for (i = 0; i < 2; i++) {
+		if (open[i] != NULL && open[i]->nr != 0 && rc == DER_SUCCESS)
+			rc = kv_put_submit(oh, open[i]);
 	}
 
 	/** wait for completion of all in-flight requests */
@@ -957,6 +1012,9 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 	if (rc == DER_SUCCESS && ret < 0)
 		rc = ret;
 
+out:
+	D_FREE(batches);
+
 	/** destroy event queue */
 	if (!use_glob_eq) {
 		ret = daos_eq_destroy(eq, 0);
@@ -966,6 +1024,11 @@ __shim_handle__kv_put(PyObject *self, PyObject *args)
 
 	return PyInt_FromLong(rc);
 err:
+	/** wait for the batches already submitted before returning */
+	do {
+		ret = daos_eq_poll(eq, 1, DAOS_EQ_WAIT, 1, &evp);
+	} while (ret == 1);
+	D_FREE(batches);
 	if (!use_glob_eq)
 		daos_eq_destroy(eq, 0);
 	return NULL;
@@ -149,11 +149,17 @@ credits_init(struct credit_context *tsc)
 		struct io_credit *cred = &tsc->tsc_cred_buf[i];
 
 		memset(cred, 0, sizeof(*cred));
-		D_ALLOC(cred->tc_vbuf, tsc->tsc_cred_vsize);
+		if (tsc->tsc_cred_vbuf_shared && i > 0)
+			cred->tc_vbuf = tsc->tsc_cred_buf[0].tc_vbuf;
+		else
+			D_ALLOC(cred->tc_vbuf, tsc->tsc_cred_vsize);
 		if (!cred->tc_vbuf) {
 			fprintf(stderr, "Cannot allocate buffer size=%d\n", tsc->tsc_cred_vsize);
 			return -1;
 		}
+		/* the shared buffer lives until credits_fini(), cache its registration */
+		if (tsc->tsc_cred_vbuf_shared && i == 0)
+			daos_mem_register(cred->tc_vbuf, tsc->tsc_cred_vsize);
 
 		if (daos_handle_is_valid(tsc->tsc_eqh)) {
 			rc = daos_event_init(&cred->tc_ev, tsc->tsc_eqh, NULL);
@@ -176,6 +182,11 @@ credits_fini(struct credit_context *tsc)
 		if (daos_handle_is_valid(tsc->tsc_eqh))
 			daos_event_fini(&tsc->tsc_cred_buf[i].tc_ev);
 
+		if (tsc->tsc_cred_vbuf_shared && i > 0)
+			continue;
+
+		if (tsc->tsc_cred_vbuf_shared && tsc->tsc_cred_buf[i].tc_vbuf != NULL)
+			daos_mem_deregister(tsc->tsc_cred_buf[i].tc_vbuf, tsc->tsc_cred_vsize);
 		D_FREE(tsc->tsc_cred_buf[i].tc_vbuf);
 	}
 
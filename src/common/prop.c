@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -373,6 +373,19 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 		case DAOS_PROP_PO_SCRUB_THRESH:
 			/* accepting any number for threshold for now */
 			break;
+		case DAOS_PROP_PO_QOS_CLASS:
+			val = prop->dpp_entries[i].dpe_val;
+			if (val >= DAOS_QOS_CLASS_INVALID) {
+				D_ERROR("invalid QoS class: "DF_U64"\n", val);
+				return false;
+			}
+			break;
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
+			/* any value, 0 falls back to the engine-wide limit */
+			break;
 		case DAOS_PROP_PO_SVC_REDUN_FAC:
 			val = prop->dpp_entries[i].dpe_val;
 			if (!daos_svc_rf_is_valid(val)) {
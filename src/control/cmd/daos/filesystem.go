@@ -1,5 +1,5 @@
 //
-// (C) Copyright 2021-2022 Intel Corporation.
+// (C) Copyright 2021-2023 Intel Corporation.
 //
 // SPDX-License-Identifier: BSD-2-Clause-Patent
 //
@@ -14,6 +14,7 @@ import "C"
 import (
 	"fmt"
 
+	"github.com/dustin/go-humanize"
 	"github.com/pkg/errors"
 )
 
@@ -35,15 +36,34 @@ type fsCmd struct {
 	ResetObjClass  fsResetOclassCmd    `command:"reset-oclass" description:"reset fs obj class"`
 }
 
+const (
+	// fsCopyMaxThreads and the buffer size bounds match the limits of
+	// the copy thread pool in daos_hdlr.c.
+	fsCopyMaxThreads = 64
+	fsCopyMinBufSize = 64 * humanize.KiByte
+	fsCopyMaxBufSize = humanize.GiByte
+)
+
 type fsCopyCmd struct {
 	daosCmd
 
-	Source   string `long:"src" short:"s" description:"copy source" required:"1"`
-	Dest     string `long:"dst" short:"d" description:"copy destination" required:"1"`
-	Preserve string `long:"preserve-props" short:"m" description:"preserve container properties, requires HDF5 library" required:"0"`
+	Source   string        `long:"src" short:"s" description:"copy source" required:"1"`
+	Dest     string        `long:"dst" short:"d" description:"copy destination" required:"1"`
+	Preserve string        `long:"preserve-props" short:"m" description:"preserve container properties, requires HDF5 library" required:"0"`
+	Threads  uint32        `long:"threads" short:"t" description:"number of threads copying files (default 4, max 64)" required:"0"`
+	BufSize  ChunkSizeFlag `long:"buffer-size" short:"b" description:"size of the buffer of each copy thread (default 16MiB, 64KiB to 1GiB)" required:"0"`
 }
 
 func (cmd *fsCopyCmd) Execute(_ []string) error {
+	if cmd.Threads > fsCopyMaxThreads {
+		return errors.Errorf("--threads must be at most %d", fsCopyMaxThreads)
+	}
+	if cmd.BufSize.Set &&
+		(cmd.BufSize.Size < fsCopyMinBufSize || cmd.BufSize.Size > fsCopyMaxBufSize) {
+		return errors.Errorf("--buffer-size must be between %s and %s",
+			humanize.IBytes(fsCopyMinBufSize), humanize.IBytes(fsCopyMaxBufSize))
+	}
+
 	ap, deallocCmdArgs, err := allocCmdArgs(cmd.Logger)
 	if err != nil {
 		return err
@@ -58,6 +78,10 @@ func (cmd *fsCopyCmd) Execute(_ []string) error {
 		ap.preserve_props = C.CString(cmd.Preserve)
 		defer freeString(ap.preserve_props)
 	}
+	ap.copy_threads = C.uint32_t(cmd.Threads)
+	if cmd.BufSize.Set {
+		ap.copy_buf_size = cmd.BufSize.Size
+	}
 
 	ap.fs_op = C.FS_COPY
 	rc := C.fs_copy_hdlr(ap)
@@ -1,5 +1,5 @@
 //
-// (C) Copyright 2019-2022 Intel Corporation.
+// (C) Copyright 2019-2023 Intel Corporation.
 //
 // SPDX-License-Identifier: BSD-2-Clause-Patent
 //
@@ -116,6 +116,16 @@ const (
 	PoolPropertySvcRedunFac = C.DAOS_PROP_PO_SVC_REDUN_FAC
 	// PoolPropertySvcList is the list of pool service replicas.
 	PoolPropertySvcList = C.DAOS_PROP_PO_SVC_LIST
+	// PoolPropertyQosClass is the QoS class of the pool IO in the engine scheduler.
+	PoolPropertyQosClass = C.DAOS_PROP_PO_QOS_CLASS
+	// PoolPropertyReadBwLimit is the read bandwidth limit of each pool target.
+	PoolPropertyReadBwLimit = C.DAOS_PROP_PO_READ_BW_LIMIT
+	// PoolPropertyWriteBwLimit is the write bandwidth limit of each pool target.
+	PoolPropertyWriteBwLimit = C.DAOS_PROP_PO_WRITE_BW_LIMIT
+	// PoolPropertyReadIopsLimit is the read IOPS limit of each pool target.
+	PoolPropertyReadIopsLimit = C.DAOS_PROP_PO_READ_IOPS_LIMIT
+	// PoolPropertyWriteIopsLimit is the write IOPS limit of each pool target.
+	PoolPropertyWriteIopsLimit = C.DAOS_PROP_PO_WRITE_IOPS_LIMIT
 )
 
 const (
@@ -246,3 +256,9 @@ const (
 	PoolScrubModeLazy  = C.DAOS_SCRUB_MODE_LAZY
 	PoolScrubModeTimed = C.DAOS_SCRUB_MODE_TIMED
 )
+
+const (
+	PoolQosClassNormal  = C.DAOS_QOS_CLASS_NORMAL
+	PoolQosClassLatency = C.DAOS_QOS_CLASS_LATENCY
+	PoolQosClassBatch   = C.DAOS_QOS_CLASS_BATCH
+)
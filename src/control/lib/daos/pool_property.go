@@ -1,5 +1,5 @@
 //
-// (C) Copyright 2021-2022 Intel Corporation.
+// (C) Copyright 2021-2023 Intel Corporation.
 //
 // SPDX-License-Identifier: BSD-2-Clause-Patent
 //
@@ -27,6 +27,45 @@ func numericMarshaler(v *PoolPropertyValue) ([]byte, error) {
 	return json.Marshal(n)
 }
 
+// ioLimitProperty returns a handler of the per-target IO limit properties, where 0
+// falls back to the engine-wide limit. Bandwidth limits accept human-readable sizes.
+func ioLimitProperty(number uint32, desc string, bytes bool) *PoolPropHandler {
+	return &PoolPropHandler{
+		Property: PoolProperty{
+			Number:      number,
+			Description: desc,
+			valueHandler: func(s string) (*PoolPropertyValue, error) {
+				var n uint64
+				var err error
+
+				if bytes {
+					n, err = humanize.ParseBytes(s)
+				} else {
+					n, err = strconv.ParseUint(s, 10, 64)
+				}
+				if err != nil {
+					return nil, errors.Errorf("invalid %s %q", strings.ToLower(desc), s)
+				}
+				return &PoolPropertyValue{n}, nil
+			},
+			valueStringer: func(v *PoolPropertyValue) string {
+				n, err := v.GetNumber()
+				if err != nil {
+					return "not set"
+				}
+				if n == 0 {
+					return "engine default"
+				}
+				if bytes {
+					return humanize.IBytes(n) + "/s"
+				}
+				return fmt.Sprintf("%d", n)
+			},
+			valueMarshaler: numericMarshaler,
+		},
+	}
+}
+
 // PoolProperties returns a map of property names to handlers
 // for processing property values.
 func PoolProperties() PoolPropertyMap {
@@ -296,6 +335,21 @@ func PoolProperties() PoolPropertyMap {
 				valueMarshaler: numericMarshaler,
 			},
 		},
+		"qos_class": {
+			Property: PoolProperty{
+				Number:      PoolPropertyQosClass,
+				Description: "IO QoS class",
+			},
+			values: map[string]uint64{
+				"normal":  PoolQosClassNormal,
+				"latency": PoolQosClassLatency,
+				"batch":   PoolQosClassBatch,
+			},
+		},
+		"read_bw_limit":    ioLimitProperty(PoolPropertyReadBwLimit, "Read bandwidth limit", true),
+		"write_bw_limit":   ioLimitProperty(PoolPropertyWriteBwLimit, "Write bandwidth limit", true),
+		"read_iops_limit":  ioLimitProperty(PoolPropertyReadIopsLimit, "Read IOPS limit", false),
+		"write_iops_limit": ioLimitProperty(PoolPropertyWriteIopsLimit, "Write IOPS limit", false),
 		"svc_rf": {
 			Property: PoolProperty{
 				Number:      PoolPropertySvcRedunFac,
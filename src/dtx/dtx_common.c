@@ -1590,7 +1590,10 @@ dtx_reindex_ult(void *arg)
 	       DP_CONT(NULL, cont->sc_uuid), dmi->dmi_tgt_id, dtx_cont2ver(cont));
 
 	while (!cont->sc_dtx_reindex_abort && !dss_xstream_exiting(dmi->dmi_xstream)) {
-		rc = vos_dtx_cmt_reindex(cont->sc_hdl);
+		/* The active DTX table may have been left to index after container open */
+		rc = vos_dtx_act_reindex_next(cont->sc_hdl);
+		if (rc > 0)
+			rc = vos_dtx_cmt_reindex(cont->sc_hdl);
 		if (rc != 0)
 			break;
 
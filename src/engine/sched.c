@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -123,6 +123,16 @@ struct sched_req_info {
 	uint32_t		sri_req_limit;
 };
 
+/* Token bucket for per-pool IO bandwidth & IOPS limit */
+struct sched_token_bucket {
+	/* Available tokens, could be negative when expired request is kicked off */
+	int64_t			tb_tokens;
+	/* Last refill time, in msecs */
+	uint64_t		tb_ts;
+	/* Effective limit of current cycle, 0 means unlimited */
+	uint64_t		tb_limit;
+};
+
 struct sched_pool_info {
 	/* Link to 'sched_info->si_pool_hash' */
 	d_list_t		spi_hash_link;
@@ -138,6 +148,17 @@ struct sched_pool_info {
 	int			spi_ref;
 	uint32_t		spi_req_cnt;
 	struct stats_window	spi_stats_window;
+	struct sched_token_bucket spi_tbs[SCHED_TB_MAX];
+	/* Pool IO limits, see DAOS_PROP_PO_*_LIMIT, 0 to use sched_io_limits */
+	uint64_t		spi_limits[SCHED_TB_MAX];
+	/* Available tokens, under sched/io_limit/xs_<id>/<pool>, see spi_tokens_init() */
+	struct d_tm_node_t	*spi_tokens[SCHED_TB_MAX];
+	uint32_t		spi_xs_id;
+	/* Telemetry dir of the tokens created, or creation already failed */
+	uint32_t		spi_tokens_dir:1,
+				spi_tokens_tried:1;
+	/* See DAOS_PROP_PO_QOS_CLASS */
+	uint32_t		spi_qos_class;
 };
 
 struct sched_request {
@@ -156,9 +177,13 @@ struct sched_request {
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
 	uint64_t		 sr_enqueue_ts;
+	/* Deadline for IO request in SCHED_POLICY_DEADLINE, in msecs */
+	uint64_t		 sr_deadline;
 	unsigned int		 sr_abort:1,
 				 /* sr_ult is sched_request-owned */
-				 sr_owned:1;
+				 sr_owned:1,
+				 /* Delayed by per-pool IO limits */
+				 sr_throttled:1;
 };
 
 bool		sched_prio_disabled;
@@ -166,24 +191,52 @@ unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
+unsigned int	sched_policy = SCHED_POLICY_FIFO;
+/* CPU percentage reserved for fetch against background ULTs */
+unsigned int	sched_fetch_reserve = SCHED_FETCH_RESERVE_DEFAULT;
+/*
+ * Engine-wide default of per-pool & per-target IO limits (bytes/sec or IOPS), 0 means
+ * unlimited. It's updated by dss_parameters_set() while the schedulers are running.
+ */
+ATOMIC uint64_t	sched_io_limits[SCHED_TB_MAX];
 
-enum {
-	/* All requests for various pools are processed in FIFO */
-	SCHED_POLICY_FIFO	= 0,
-	/*
-	 * All requests are processed in RR based on certain ID (Client ID,
-	 * Pool ID, Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_RR,
-	/*
-	 * Request priority is based on certain ID (Client ID, Pool ID,
-	 * Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_PRIO,
-	SCHED_POLICY_MAX
+static char *sched_tb_names[SCHED_TB_MAX] = {
+	"read_bw",
+	"write_bw",
+	"read_iops",
+	"write_iops",
+};
+
+/*
+ * Queue latency target of foreground IO requests in SCHED_POLICY_DEADLINE,
+ * IO requests are kicked off in earliest deadline first order.
+ */
+unsigned int	sched_deadline_msecs[SCHED_REQ_MAX] = {
+	200,	/* SCHED_REQ_UPDATE */
+	20,	/* SCHED_REQ_FETCH */
+	0,	/* SCHED_REQ_GC */
+	0,	/* SCHED_REQ_SCRUB */
+	0,	/* SCHED_REQ_MIGRATE */
 };
 
-static int	sched_policy;
+static char *sched_qos_names[SCHED_QOS_MAX] = {
+	"fetch",
+	"update",
+	"background",
+};
+
+static inline unsigned int
+req_type2qos(unsigned int req_type)
+{
+	switch (req_type) {
+	case SCHED_REQ_FETCH:
+		return SCHED_QOS_FETCH;
+	case SCHED_REQ_UPDATE:
+		return SCHED_QOS_UPDATE;
+	default:
+		return SCHED_QOS_BG;
+	}
+}
 
 /*
  * Time threshold for giving IO up throttling. If space pressure stays in the
@@ -196,6 +249,15 @@ static int	sched_policy;
  */
 #define SCHED_DELAY_THRESH	40000	/* msecs */
 
+/*
+ * Maximum milli-seconds an IO request can be delayed by the per-pool IO limits, it
+ * should be shorter than the RPC timeout.
+ */
+#define SCHED_TB_DELAY_MAX	20000	/* msecs */
+
+/* Token bucket size, tokens generated in this period can be accumulated for bursts */
+#define SCHED_TB_BURST_MSECS	1000	/* msecs */
+
 /* Maximum milli-seconds a ULT can be delayed */
 static unsigned int max_delay_msecs[SCHED_REQ_MAX] = {
 	12000,	/* SCHED_REQ_UPDATE */
@@ -346,6 +408,9 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
 
+	if (spi->spi_tokens_dir)
+		d_tm_del_ephemeral_dir("sched/io_limit/xs_%u/"DF_UUIDF,
+				       spi->spi_xs_id, DP_UUID(spi->spi_pool_id));
 	D_FREE(spi);
 }
 
@@ -450,6 +515,7 @@ sched_info_fini(struct dss_xstream *dx)
 	D_ASSERT(info->si_req_cnt == 0);
 	D_ASSERT(d_list_empty(&info->si_sleep_list));
 	D_ASSERT(d_list_empty(&info->si_fifo_list));
+	D_ASSERT(d_list_empty(&info->si_edf_list));
 
 	prune_purge_list(dx);
 
@@ -492,7 +558,7 @@ sched_metrics_init(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_stats	*stats = &info->si_stats;
-	int			 rc;
+	int			 i, rc;
 
 	stats->ss_busy_ts = info->si_cur_ts;
 	stats->ss_watchdog_ts = 0;
@@ -527,6 +593,46 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	/* Requests are queued on main xstream only, see should_enqueue_req() */
+	if (!dx->dx_main_xs)
+		return;
+
+	rc = d_tm_add_metric(&stats->ss_throttled, D_TM_COUNTER,
+			     "IO requests delayed by pool IO limits", "req",
+			     "sched/io_limit/throttled/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create throttled telemetry: "DF_RC"\n", DP_RC(rc));
+
+	for (i = 0; i < SCHED_QOS_BG; i++) {
+		rc = d_tm_add_metric(&stats->ss_missed[i], D_TM_COUNTER,
+				     "IO requests kicked off after their deadline", "req",
+				     "sched/deadline_missed/%s/xs_%u", sched_qos_names[i],
+				     dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create %s deadline_missed telemetry: "DF_RC"\n",
+			       sched_qos_names[i], DP_RC(rc));
+	}
+
+	for (i = 0; i < SCHED_QOS_MAX; i++) {
+		char	path[D_TM_MAX_NAME_LEN];
+
+		snprintf(path, sizeof(path), "sched/queue_latency/%s/xs_%u", sched_qos_names[i],
+			 dx->dx_xs_id);
+		rc = d_tm_add_metric(&stats->ss_queue_lat[i], D_TM_STATS_GAUGE,
+				     "Request queue latency", "ms", "%s", path);
+		if (rc) {
+			D_WARN("Failed to create %s queue_latency telemetry: "DF_RC"\n",
+			       sched_qos_names[i], DP_RC(rc));
+			continue;
+		}
+
+		rc = d_tm_init_histogram(stats->ss_queue_lat[i], path, SCHED_LAT_BUCKETS,
+					 SCHED_LAT_BUCKET_WIDTH, SCHED_LAT_BUCKET_MULT);
+		if (rc)
+			D_WARN("Failed to init %s queue_latency histogram: "DF_RC"\n",
+			       sched_qos_names[i], DP_RC(rc));
+	}
 }
 
 static int
@@ -541,6 +647,7 @@ sched_info_init(struct dss_xstream *dx)
 	D_INIT_LIST_HEAD(&info->si_idle_list);
 	D_INIT_LIST_HEAD(&info->si_sleep_list);
 	D_INIT_LIST_HEAD(&info->si_fifo_list);
+	D_INIT_LIST_HEAD(&info->si_edf_list);
 	D_INIT_LIST_HEAD(&info->si_purge_list);
 	info->si_req_cnt = 0;
 	info->si_sleep_cnt = 0;
@@ -566,6 +673,47 @@ sched_info_init(struct dss_xstream *dx)
 	return rc;
 }
 
+/* Room of the per-pool tokens telemetry dir, a few stats gauges */
+#define SCHED_TB_METRICS_SIZE	(16 * 1024)
+
+/*
+ * The token gauges are per pool and per xstream, they are created once the pool
+ * gets limited on this xstream and removed along with the sched_pool_info. The
+ * pool dir is under the xstream dir so that no empty dir is left behind.
+ */
+static void
+spi_tokens_init(struct sched_info *info, struct sched_pool_info *spi)
+{
+	struct dss_xstream	*dx = container_of(info, struct dss_xstream, dx_sched_info);
+	int			 i;
+	int			 rc;
+
+	spi->spi_tokens_tried = 1;
+	spi->spi_xs_id = dx->dx_xs_id;
+
+	rc = d_tm_add_ephemeral_dir(NULL, SCHED_TB_METRICS_SIZE,
+				    "sched/io_limit/xs_%u/"DF_UUIDF,
+				    spi->spi_xs_id, DP_UUID(spi->spi_pool_id));
+	if (rc) {
+		D_WARN("Failed to create "DF_UUID" io_limit telemetry: "DF_RC"\n",
+		       DP_UUID(spi->spi_pool_id), DP_RC(rc));
+		return;
+	}
+	spi->spi_tokens_dir = 1;
+
+	for (i = 0; i < SCHED_TB_MAX; i++) {
+		rc = d_tm_add_metric(&spi->spi_tokens[i], D_TM_STATS_GAUGE,
+				     "Available tokens of the pool",
+				     i < SCHED_TB_READ_IOPS ? "bytes" : "ops",
+				     "sched/io_limit/xs_%u/"DF_UUIDF"/%s_tokens",
+				     spi->spi_xs_id, DP_UUID(spi->spi_pool_id),
+				     sched_tb_names[i]);
+		if (rc)
+			D_WARN("Failed to create %s tokens telemetry: "DF_RC"\n",
+			       sched_tb_names[i], DP_RC(rc));
+	}
+}
+
 static struct sched_pool_info *
 cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 {
@@ -646,6 +794,7 @@ req_get(struct dss_xstream *dx, struct sched_req_attr *attr,
 	req->sr_ult	= ult;
 	req->sr_abort	= 0;
 	req->sr_owned	= (owned ? 1 : 0);
+	req->sr_throttled = 0;
 	req->sr_pool_info = spi;
 
 	return req;
@@ -680,6 +829,7 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_pool_info	*spi = req->sr_pool_info;
 	struct sched_req_info	*sri;
+	unsigned int		 qos;
 	int			 rc;
 
 	if (req->sr_ult != ABT_THREAD_NULL) {
@@ -702,6 +852,17 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	info->si_req_cnt--;
 	sw_cycle_update(&spi->spi_stats_window, req->sr_attr.sra_type);
 
+	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+	qos = req_type2qos(req->sr_attr.sra_type);
+	/* Sample the queue latency, the telemetry update is too costly per request */
+	if (sched_lat_sampled(info->si_lat_cnt[qos]++))
+		d_tm_set_gauge(info->si_stats.ss_queue_lat[qos],
+			       info->si_cur_ts - req->sr_enqueue_ts);
+	/* Reported once per schedule cycle, see sched_start_cycle() */
+	if (sched_policy == SCHED_POLICY_DEADLINE && qos < SCHED_QOS_BG &&
+	    info->si_cur_ts > req->sr_deadline)
+		info->si_missed_cnt[qos]++;
+
 	d_list_del_init(&req->sr_link);
 	req_put(dx, req);
 
@@ -778,6 +939,95 @@ out:
 	return spi->spi_space_pressure;
 }
 
+static void
+tb_refill(struct sched_info *info, struct sched_pool_info *spi)
+{
+	struct sched_token_bucket	*tb;
+	uint64_t			 limit, elapsed;
+	int64_t				 burst;
+	int				 i;
+
+	if (!spi->spi_tokens_tried) {
+		for (i = 0; i < SCHED_TB_MAX; i++) {
+			if (spi->spi_limits[i] != 0 ||
+			    atomic_load_relaxed(&sched_io_limits[i]) != 0) {
+				spi_tokens_init(info, spi);
+				break;
+			}
+		}
+	}
+
+	for (i = 0; i < SCHED_TB_MAX; i++) {
+		tb = &spi->spi_tbs[i];
+		limit = spi->spi_limits[i];
+		if (limit == 0)
+			limit = atomic_load_relaxed(&sched_io_limits[i]);
+		tb->tb_limit = limit;
+
+		if (limit == 0) {
+			tb->tb_tokens = 0;
+			tb->tb_ts = info->si_cur_ts;
+			d_tm_set_gauge(spi->spi_tokens[i], 0);
+			continue;
+		}
+
+		D_ASSERT(info->si_cur_ts >= tb->tb_ts);
+		elapsed = min(info->si_cur_ts - tb->tb_ts, SCHED_TB_BURST_MSECS);
+		burst = limit * SCHED_TB_BURST_MSECS / 1000;
+
+		tb->tb_tokens += elapsed * limit / 1000;
+		if (tb->tb_tokens > burst)
+			tb->tb_tokens = burst;
+		/* Don't lose the fraction of tokens generated in less than 1 msec */
+		if (elapsed * limit >= 1000)
+			tb->tb_ts = info->si_cur_ts;
+
+		d_tm_set_gauge(spi->spi_tokens[i], tb->tb_tokens > 0 ? tb->tb_tokens : 0);
+	}
+}
+
+static inline void
+req2tb_types(struct sched_request *req, int *bw, int *iops)
+{
+	if (req->sr_attr.sra_type == SCHED_REQ_FETCH) {
+		*bw = SCHED_TB_READ_BW;
+		*iops = SCHED_TB_READ_IOPS;
+	} else {
+		D_ASSERT(req->sr_attr.sra_type == SCHED_REQ_UPDATE);
+		*bw = SCHED_TB_WRITE_BW;
+		*iops = SCHED_TB_WRITE_IOPS;
+	}
+}
+
+/* Is the IO request exceeded the per-pool bandwidth or IOPS limit? */
+static bool
+tb_exceeded(struct sched_pool_info *spi, struct sched_request *req)
+{
+	int	bw, iops;
+
+	req2tb_types(req, &bw, &iops);
+
+	if (spi->spi_tbs[bw].tb_limit != 0 && spi->spi_tbs[bw].tb_tokens <= 0)
+		return true;
+	if (spi->spi_tbs[iops].tb_limit != 0 && spi->spi_tbs[iops].tb_tokens <= 0)
+		return true;
+
+	return false;
+}
+
+static void
+tb_consume(struct sched_pool_info *spi, struct sched_request *req)
+{
+	int	bw, iops;
+
+	req2tb_types(req, &bw, &iops);
+
+	if (spi->spi_tbs[bw].tb_limit != 0)
+		spi->spi_tbs[bw].tb_tokens -= req->sr_attr.sra_size;
+	if (spi->spi_tbs[iops].tb_limit != 0)
+		spi->spi_tbs[iops].tb_tokens -= 1;
+}
+
 static int
 process_req(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -796,10 +1046,33 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	if (info->si_stop)
 		goto kickoff;
 
+	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
+		goto kickoff;
+
+	/*
+	 * Pool IO limits are enforced even when there isn't space pressure, the request
+	 * will be kicked off anyway (overdraws tokens) once it's delayed for too long.
+	 */
+	if ((req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH) &&
+	    tb_exceeded(spi, req)) {
+		D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+		if ((info->si_cur_ts - req->sr_enqueue_ts) <= SCHED_TB_DELAY_MAX) {
+			if (!req->sr_throttled) {
+				req->sr_throttled = 1;
+				d_tm_inc_counter(info->si_stats.ss_throttled, 1);
+			}
+			return 1;
+		}
+		goto kickoff;
+	}
+
 	if (sri->sri_req_kicked < sri->sri_req_limit)
 		goto kickoff;
 
-	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
+	if (sched_policy == SCHED_POLICY_DEADLINE &&
+	    (req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH) &&
+	    sched_deadline_expired(info->si_cur_ts, req->sr_deadline, req_type,
+				   spi->spi_space_pressure))
 		goto kickoff;
 
 	if (req_type == SCHED_REQ_UPDATE) {
@@ -819,6 +1092,8 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	/* Remaining requests are not expired */
 	return 1;
 kickoff:
+	if (req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH)
+		tb_consume(spi, req);
 	sri->sri_req_kicked++;
 	req_kickoff(dx, req);
 	return 0;
@@ -1042,6 +1317,54 @@ throttle_sys(struct stats_window *sw, uint32_t *kick, struct pressure_ratio *pr)
 		apportion_wts(avail_wts, kick, SCHED_REQ_SCRUB);
 }
 
+/*
+ * When foreground reads are pending, background ULTs are throttled to make sure the
+ * fetch requests get at least 'sched_fetch_reserve' percent of CPU in the stats window.
+ * Background requests won't be starved, they'll still be kicked off once expired.
+ */
+static void
+throttle_bg(struct stats_window *sw, uint32_t *kick)
+{
+	uint64_t	*kicked_wts, fetch_wts, bg_wts, bg_wts_max, avail_wts;
+
+	if (kick[SCHED_REQ_FETCH] == 0 || sched_fetch_reserve == 0)
+		return;
+
+	kicked_wts = &sw->sw_kicked_wts[0];
+
+	fetch_wts = kicked_wts[SCHED_REQ_FETCH];
+	fetch_wts += (uint64_t)kick[SCHED_REQ_FETCH] * req_weights[SCHED_REQ_FETCH];
+	bg_wts = kicked_wts[SCHED_REQ_GC] + kicked_wts[SCHED_REQ_SCRUB] +
+		 kicked_wts[SCHED_REQ_MIGRATE];
+
+	bg_wts_max = sched_bg_wts_max(fetch_wts, sched_fetch_reserve);
+	if (bg_wts >= bg_wts_max) {
+		kick[SCHED_REQ_GC] = 0;
+		kick[SCHED_REQ_MIGRATE] = 0;
+		kick[SCHED_REQ_SCRUB] = 0;
+		return;
+	}
+
+	avail_wts = bg_wts_max - bg_wts;
+	/* Satisfy rebuild/reintegration ULTs first when 'sw_gen' is odd */
+	if (sw->sw_gen & 0x1) {
+		avail_wts = apportion_wts(avail_wts, kick, SCHED_REQ_MIGRATE);
+		avail_wts = apportion_wts(avail_wts, kick, SCHED_REQ_GC);
+	} else {
+		avail_wts = apportion_wts(avail_wts, kick, SCHED_REQ_GC);
+		avail_wts = apportion_wts(avail_wts, kick, SCHED_REQ_MIGRATE);
+	}
+	apportion_wts(avail_wts, kick, SCHED_REQ_SCRUB);
+}
+
+static void
+process_pool_bg(struct dss_xstream *dx, struct sched_pool_info *spi)
+{
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
+	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+}
+
 static int
 process_pool_cb(d_list_t *rlink, void *arg)
 {
@@ -1056,6 +1379,7 @@ process_pool_cb(d_list_t *rlink, void *arg)
 
 	/* Update stats window no matter if any pending ULT or not */
 	sw_window_update(&spi->spi_stats_window);
+	tb_refill(info, spi);
 	if (spi->spi_req_cnt == 0)
 		return 0;
 
@@ -1065,17 +1389,32 @@ process_pool_cb(d_list_t *rlink, void *arg)
 	press = check_space_pressure(dx, spi);
 	pr = &pressure_gauge[press];
 
-	if (press == SCHED_SPACE_PRESS_NONE)
+	if (press == SCHED_SPACE_PRESS_NONE) {
 		throttle_sys(&spi->spi_stats_window, &kick[SCHED_REQ_UPDATE], pr);
-	else
+		if (sched_policy == SCHED_POLICY_DEADLINE)
+			throttle_bg(&spi->spi_stats_window, &kick[SCHED_REQ_UPDATE]);
+	} else {
 		throttle_io(info, spi, &kick[SCHED_REQ_UPDATE], pr);
+	}
 
 	for (i = SCHED_REQ_UPDATE; i < SCHED_REQ_MAX; i++)
 		set_req_limit(dx, spi, i, kick[i]);
 
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_GC), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_SCRUB), true);
-	process_req_list(dx, pool2req_list(spi, SCHED_REQ_MIGRATE), true);
+	/* Background requests are kicked off after IO requests, see process_all() */
+	if (sched_policy != SCHED_POLICY_DEADLINE)
+		process_pool_bg(dx, spi);
+
+	return 0;
+}
+
+static int
+process_pool_bg_cb(d_list_t *rlink, void *arg)
+{
+	struct dss_xstream	*dx = (struct dss_xstream *)arg;
+	struct sched_pool_info	*spi = sched_rlink2spi(rlink);
+
+	if (spi->spi_req_cnt != 0)
+		process_pool_bg(dx, spi);
 
 	return 0;
 }
@@ -1097,6 +1436,30 @@ policy_fifo_process(struct dss_xstream *dx)
 	process_req_list(dx, &info->si_fifo_list, false);
 }
 
+static void
+policy_deadline_enqueue(struct dss_xstream *dx, struct sched_request *req,
+			void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	unsigned int		 req_type = req->sr_attr.sra_type;
+
+	D_ASSERT(req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH);
+	D_ASSERT(req->sr_pool_info != NULL);
+	req->sr_deadline = info->si_cur_ts +
+			   sched_qos_deadline(sched_deadline_msecs[req_type],
+					      req->sr_pool_info->spi_qos_class);
+
+	sched_edf_insert(req, &info->si_edf_list, sr_link, sr_deadline);
+}
+
+static void
+policy_deadline_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+
+	process_req_list(dx, &info->si_edf_list, false);
+}
+
 struct sched_policy_ops {
 	void (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -1115,6 +1478,10 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
 		.process_io = NULL,
+	},
+	{	/* SCHED_POLICY_DEADLINE */
+		.enqueue_io = policy_deadline_enqueue,
+		.process_io = policy_deadline_process,
 	}
 };
 
@@ -1131,6 +1498,16 @@ process_all(struct dss_xstream *dx)
 
 	D_ASSERT(policy_ops[sched_policy].process_io != NULL);
 	policy_ops[sched_policy].process_io(dx);
+
+	/*
+	 * Kick off foreground IO requests ahead of background requests in deadline
+	 * policy, so that they'll be executed earlier in this schedule cycle.
+	 */
+	if (sched_policy == SCHED_POLICY_DEADLINE) {
+		rc = d_hash_table_traverse(info->si_pool_hash, process_pool_bg_cb, dx);
+		if (rc)
+			D_ERROR("Traverse pool hash error. "DF_RC"\n", DP_RC(rc));
+	}
 }
 
 static inline bool
@@ -1328,6 +1705,58 @@ sched_req_is_aborted(struct sched_request *req)
 	return req->sr_abort != 0;
 }
 
+int
+sched_pool_prop_set(uuid_t pool_id, struct sched_pool_prop *prop)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_pool_info	*spi;
+
+	D_ASSERT(prop != NULL);
+	/* Requests are queued on main xstream only, see should_enqueue_req() */
+	if (!dx->dx_main_xs)
+		return 0;
+
+	if (prop->spp_qos_class >= DAOS_QOS_CLASS_INVALID) {
+		D_ERROR("Invalid QoS class %u for pool "DF_UUID"\n",
+			prop->spp_qos_class, DP_UUID(pool_id));
+		return -DER_INVAL;
+	}
+
+	spi = cur_pool_info(&dx->dx_sched_info, pool_id);
+	if (spi == NULL)
+		return -DER_NOMEM;
+
+	/* Applies to requests enqueued from now on */
+	spi->spi_qos_class = prop->spp_qos_class;
+	/* Applies from the next scheduling cycle, see tb_refill() */
+	spi->spi_limits[SCHED_TB_READ_BW] = prop->spp_read_bw;
+	spi->spi_limits[SCHED_TB_WRITE_BW] = prop->spp_write_bw;
+	spi->spi_limits[SCHED_TB_READ_IOPS] = prop->spp_read_iops;
+	spi->spi_limits[SCHED_TB_WRITE_IOPS] = prop->spp_write_iops;
+	return 0;
+}
+
+void
+sched_pool_io_charge(uuid_t pool_id, unsigned int req_type, uint64_t size)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+	struct sched_pool_info	*spi;
+	int			 bw;
+
+	D_ASSERT(req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH);
+	if (!dx->dx_main_xs || size == 0)
+		return;
+
+	spi = cur_pool_info(&dx->dx_sched_info, pool_id);
+	if (spi == NULL)
+		return;
+
+	bw = req_type == SCHED_REQ_FETCH ? SCHED_TB_READ_BW : SCHED_TB_WRITE_BW;
+	/* Overdraw the tokens, following requests will be held until they are refilled */
+	if (spi->spi_tbs[bw].tb_limit != 0)
+		spi->spi_tbs[bw].tb_tokens -= size;
+}
+
 int
 sched_req_space_check(struct sched_request *req)
 {
@@ -1827,7 +2256,7 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_cycle	*cycle = &data->sd_cycle;
 	size_t			 cnt;
-	int			 ret;
+	int			 ret, i;
 	uint64_t		 cur_ts, duration;
 
 	D_ASSERT(cycle->sc_new_cycle == 1);
@@ -1867,6 +2296,12 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 	d_tm_inc_counter(info->si_stats.ss_total_time, duration);
 	d_tm_set_gauge(info->si_stats.ss_wq_len, info->si_req_cnt);
 	d_tm_set_gauge(info->si_stats.ss_sq_len, info->si_sleep_cnt);
+	for (i = 0; i < SCHED_QOS_BG; i++) {
+		if (info->si_missed_cnt[i] != 0) {
+			d_tm_inc_counter(info->si_stats.ss_missed[i], info->si_missed_cnt[i]);
+			info->si_missed_cnt[i] = 0;
+		}
+	}
 	if (cycle->sc_ults_tot) {
 		d_tm_set_gauge(info->si_stats.ss_cycle_duration, duration);
 		d_tm_set_gauge(info->si_stats.ss_cycle_size, cycle->sc_ults_tot);
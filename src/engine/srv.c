@@ -92,6 +92,9 @@ bool		dss_helper_pool;
 /** Bypass for the nvme health check */
 bool		dss_nvme_bypass_health_check;
 
+/** Incremental reintegration, can be changed at runtime by DMG_KEY_REBUILD_INCREMENTAL */
+bool		dss_incr_reint;
+
 static daos_epoch_t	dss_start_epoch;
 
 unsigned int
@@ -946,12 +949,17 @@ dss_start_xs_id(int xs_id)
 static int
 dss_xstreams_init(void)
 {
-	char	*env;
-	int	rc = 0;
-	int	i, xs_id;
+	char		*env;
+	uint64_t	 io_limits[SCHED_TB_MAX] = { 0 };
+	int		 rc = 0;
+	int		 i, xs_id;
 
 	D_ASSERT(dss_tgt_nr >= 1);
 
+	d_getenv_bool("DAOS_REBUILD_INCREMENTAL", &dss_incr_reint);
+	if (dss_incr_reint)
+		D_INFO("Incremental reintegration is enabled.\n");
+
 	d_getenv_bool("DAOS_SCHED_PRIO_DISABLED", &sched_prio_disabled);
 	if (sched_prio_disabled)
 		D_INFO("ULT prioritizing is disabled.\n");
@@ -987,6 +995,49 @@ dss_xstreams_init(void)
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
 
+	/* Engine-wide defaults, overridden by the DAOS_PROP_PO_*_LIMIT pool properties */
+	d_getenv_uint64_t("DAOS_SCHED_POOL_READ_BW", &io_limits[SCHED_TB_READ_BW]);
+	d_getenv_uint64_t("DAOS_SCHED_POOL_WRITE_BW", &io_limits[SCHED_TB_WRITE_BW]);
+	d_getenv_uint64_t("DAOS_SCHED_POOL_READ_IOPS", &io_limits[SCHED_TB_READ_IOPS]);
+	d_getenv_uint64_t("DAOS_SCHED_POOL_WRITE_IOPS", &io_limits[SCHED_TB_WRITE_IOPS]);
+	for (i = 0; i < SCHED_TB_MAX; i++)
+		atomic_store_relaxed(&sched_io_limits[i], io_limits[i]);
+	D_INFO("Pool IO limits: read "DF_U64" bytes/sec, "DF_U64" IOPS, write "DF_U64
+	       " bytes/sec, "DF_U64" IOPS\n", io_limits[SCHED_TB_READ_BW],
+	       io_limits[SCHED_TB_READ_IOPS], io_limits[SCHED_TB_WRITE_BW],
+	       io_limits[SCHED_TB_WRITE_IOPS]);
+
+	env = getenv("DAOS_SCHED_POLICY");
+	if (env) {
+		sched_policy = sched_str2policy(env);
+		if (sched_policy == SCHED_POLICY_INVALID) {
+			D_WARN("Invalid sched policy [%s]\n", env);
+			sched_policy = SCHED_POLICY_FIFO;
+		}
+	}
+	D_INFO("Sched policy is set to [%s]\n", sched_policy2str(sched_policy));
+
+	if (sched_policy == SCHED_POLICY_DEADLINE) {
+		d_getenv_int("DAOS_SCHED_FETCH_RESERVE", &sched_fetch_reserve);
+		if (sched_fetch_reserve > 100) {
+			D_WARN("Invalid fetch reserve %u, set to default %u percent.\n",
+			       sched_fetch_reserve, SCHED_FETCH_RESERVE_DEFAULT);
+			sched_fetch_reserve = SCHED_FETCH_RESERVE_DEFAULT;
+		}
+
+		d_getenv_int("DAOS_SCHED_FETCH_DEADLINE", &sched_deadline_msecs[SCHED_REQ_FETCH]);
+		d_getenv_int("DAOS_SCHED_UPDATE_DEADLINE",
+			     &sched_deadline_msecs[SCHED_REQ_UPDATE]);
+		if (sched_deadline_msecs[SCHED_REQ_FETCH] > SCHED_DEADLINE_MAX)
+			sched_deadline_msecs[SCHED_REQ_FETCH] = SCHED_DEADLINE_MAX;
+		if (sched_deadline_msecs[SCHED_REQ_UPDATE] > SCHED_DEADLINE_MAX)
+			sched_deadline_msecs[SCHED_REQ_UPDATE] = SCHED_DEADLINE_MAX;
+
+		D_INFO("Fetch reserve: %u%%, deadline: fetch %u msecs, update %u msecs\n",
+		       sched_fetch_reserve, sched_deadline_msecs[SCHED_REQ_FETCH],
+		       sched_deadline_msecs[SCHED_REQ_UPDATE]);
+	}
+
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
 		"%d cores total detected starting %d main xstreams\n",
@@ -1152,6 +1203,9 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 {
 	int rc = 0;
 
+	D_CASSERT(DMG_KEY_SCHED_WRITE_IOPS - DMG_KEY_SCHED_READ_BW ==
+		  SCHED_TB_WRITE_IOPS - SCHED_TB_READ_BW);
+
 	switch (key_id) {
 	case DMG_KEY_FAIL_LOC:
 		daos_fail_loc_set(value);
@@ -1162,6 +1216,21 @@ dss_parameters_set(unsigned int key_id, uint64_t value)
 	case DMG_KEY_FAIL_NUM:
 		daos_fail_num_set(value);
 		break;
+	case DMG_KEY_SCHED_READ_BW:
+	case DMG_KEY_SCHED_WRITE_BW:
+	case DMG_KEY_SCHED_READ_IOPS:
+	case DMG_KEY_SCHED_WRITE_IOPS:
+		/* Picked up by each scheduler on its next cycle, see tb_refill() */
+		atomic_store_relaxed(&sched_io_limits[key_id - DMG_KEY_SCHED_READ_BW +
+						      SCHED_TB_READ_BW], value);
+		D_INFO("Set pool IO limit key_id %u to "DF_U64"\n", key_id, value);
+		break;
+	case DMG_KEY_REBUILD_INCREMENTAL:
+		/* Only takes effect for reintegrations after the next pool map change */
+		dss_incr_reint = (value != 0);
+		D_INFO("Incremental reintegration is %s\n",
+		       dss_incr_reint ? "enabled" : "disabled");
+		break;
 	default:
 		D_ERROR("invalid key_id %d\n", key_id);
 		rc = -DER_INVAL;
@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -8,6 +8,7 @@
 
 #include <daos_srv/daos_engine.h>
 #include <daos/stack_mmap.h>
+#include <gurt/atomic.h>
 #include <gurt/telemetry_common.h>
 
 /**
@@ -25,6 +26,26 @@ enum {
 	DSS_POOL_CNT,
 };
 
+/* Number of buckets in queue latency histograms */
+#define SCHED_LAT_BUCKETS	9
+
+/* Classes for tracking the queue latency of requests */
+enum {
+	SCHED_QOS_FETCH		= 0,	/* Foreground read */
+	SCHED_QOS_UPDATE,		/* Foreground write */
+	SCHED_QOS_BG,			/* GC, scrub, rebuild, etc. */
+	SCHED_QOS_MAX,
+};
+
+/* Token buckets for per-pool IO limits */
+enum {
+	SCHED_TB_READ_BW	= 0,	/* Read bandwidth, bytes/sec */
+	SCHED_TB_WRITE_BW,		/* Write bandwidth, bytes/sec */
+	SCHED_TB_READ_IOPS,		/* Read IOPS */
+	SCHED_TB_WRITE_IOPS,		/* Write IOPS */
+	SCHED_TB_MAX,
+};
+
 struct sched_stats {
 	struct d_tm_node_t	*ss_total_time;		/* Total CPU time (ms) */
 	struct d_tm_node_t	*ss_relax_time;		/* CPU relax time (ms) */
@@ -32,6 +53,9 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_sq_len;		/* Sleep queue length */
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
+	struct d_tm_node_t	*ss_queue_lat[SCHED_QOS_MAX];	/* Queue latency (ms) */
+	struct d_tm_node_t	*ss_throttled;		/* Requests delayed by IO limits */
+	struct d_tm_node_t	*ss_missed[SCHED_QOS_BG];	/* Deadlines missed */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -46,11 +70,14 @@ struct sched_info {
 	d_list_t		 si_idle_list;	/* All unused requests */
 	d_list_t		 si_sleep_list;	/* All sleeping requests */
 	d_list_t		 si_fifo_list;	/* All IO requests in FIFO */
+	d_list_t		 si_edf_list;	/* All IO requests in deadline order */
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
 	int			 si_sleep_cnt;	/* Sleeping request count */
 	int			 si_wait_cnt;	/* Long wait request count */
+	uint32_t		 si_lat_cnt[SCHED_QOS_MAX];	/* Kicked requests */
+	uint32_t		 si_missed_cnt[SCHED_QOS_BG];	/* Unreported deadline misses */
 	unsigned int		 si_stop:1;
 };
 
@@ -194,12 +221,135 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_INVALID;
 }
 
+enum {
+	/* All requests for various pools are processed in FIFO */
+	SCHED_POLICY_FIFO	= 0,
+	/*
+	 * All requests are processed in RR based on certain ID (Client ID,
+	 * Pool ID, Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_RR,
+	/*
+	 * Request priority is based on certain ID (Client ID, Pool ID,
+	 * Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_PRIO,
+	/*
+	 * IO requests are processed in earliest deadline first order, foreground
+	 * IO requests are kicked off ahead of background requests.
+	 */
+	SCHED_POLICY_DEADLINE,
+	SCHED_POLICY_MAX,
+	SCHED_POLICY_INVALID = SCHED_POLICY_MAX,
+};
+
+static inline char *
+sched_policy2str(unsigned int policy)
+{
+	switch (policy) {
+	case SCHED_POLICY_FIFO:
+		return "fifo";
+	case SCHED_POLICY_DEADLINE:
+		return "deadline";
+	default:
+		return "invalid";
+	}
+}
+
+/* Only FIFO & deadline policies are implemented */
+static inline unsigned int
+sched_str2policy(char *str)
+{
+	if (strcasecmp(str, "fifo") == 0)
+		return SCHED_POLICY_FIFO;
+	else if (strcasecmp(str, "deadline") == 0)
+		return SCHED_POLICY_DEADLINE;
+	else
+		return SCHED_POLICY_INVALID;
+}
+
+#define SCHED_FETCH_RESERVE_DEFAULT	50 /* percent */
+#define SCHED_DEADLINE_MAX		60000 /* msecs */
+
+/* Queue latency of one in SCHED_LAT_SAMPLE_INTVL kicked off requests is recorded */
+#define SCHED_LAT_SAMPLE_INTVL		16
+/* Queue latency histogram buckets: 0, 1-2, 3-6, 7-14, ... 255+ msecs */
+#define SCHED_LAT_BUCKET_WIDTH		1
+#define SCHED_LAT_BUCKET_MULT		2
+
+static inline bool
+sched_lat_sampled(uint32_t kicked)
+{
+	return kicked % SCHED_LAT_SAMPLE_INTVL == 0;
+}
+
+/*
+ * Insert a request into the EDF list, the list is sorted in deadline ascending order,
+ * requests with same deadline are in FIFO. Newly enqueued request usually has the
+ * latest deadline, so the list is walked backwards.
+ */
+#define sched_edf_insert(req, head, member, deadline)				\
+	do {									\
+		__typeof__(req) __tmp;						\
+										\
+		d_list_for_each_entry_reverse(__tmp, head, member) {		\
+			if ((req)->deadline >= __tmp->deadline)			\
+				break;						\
+		}								\
+		/* Inserted at list head when no earlier deadline is found */	\
+		d_list_add(&(req)->member, &__tmp->member);			\
+	} while (0)
+
+/*
+ * Max weights of background requests allowed in the stats window, given the weights
+ * of fetch requests, to leave @reserve percent of CPU to the fetch requests.
+ */
+static inline uint64_t
+sched_bg_wts_max(uint64_t fetch_wts, unsigned int reserve)
+{
+	D_ASSERT(reserve > 0 && reserve <= 100);
+	return fetch_wts * (100 - reserve) / reserve;
+}
+
+/* Scale the queue latency target of an IO request by the QoS class of its pool */
+static inline unsigned int
+sched_qos_deadline(unsigned int deadline, unsigned int qos_class)
+{
+	switch (qos_class) {
+	case DAOS_QOS_CLASS_LATENCY:
+		return deadline > 4 ? deadline / 4 : min(deadline, 1);
+	case DAOS_QOS_CLASS_BATCH:
+		return min(deadline * 4, SCHED_DEADLINE_MAX);
+	default:
+		return deadline;
+	}
+}
+
+/*
+ * Should an IO request past its deadline be kicked off regardless of the request
+ * limit of its pool? Updates are still delayed when the pool is under space
+ * pressure, to give space reclaiming a chance.
+ */
+static inline bool
+sched_deadline_expired(uint64_t now, uint64_t deadline, unsigned int req_type,
+		       int space_pressure)
+{
+	if (now < deadline)
+		return false;
+
+	return req_type == SCHED_REQ_FETCH || space_pressure == SCHED_SPACE_PRESS_NONE;
+}
+
 extern bool sched_prio_disabled;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
 extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
+extern unsigned int sched_policy;
+extern unsigned int sched_fetch_reserve;
+extern unsigned int sched_deadline_msecs[SCHED_REQ_MAX];
+extern ATOMIC uint64_t sched_io_limits[SCHED_TB_MAX];
 
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
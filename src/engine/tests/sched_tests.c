@@ -0,0 +1,352 @@
+/*
+ * (C) Copyright 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the IO scheduling policy helpers
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <abt.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_producer.h>
+#include <gurt/telemetry_consumer.h>
+#include "../srv_internal.h"
+
+#define TEST_TM_IDX	(97)
+
+/* Context for checking the latency histograms as a telemetry client */
+static struct d_tm_context	*cli_ctx;
+
+static void
+test_qos_deadline_normal(void **state)
+{
+	assert_int_equal(sched_qos_deadline(0, DAOS_QOS_CLASS_NORMAL), 0);
+	assert_int_equal(sched_qos_deadline(20, DAOS_QOS_CLASS_NORMAL), 20);
+	assert_int_equal(sched_qos_deadline(SCHED_DEADLINE_MAX, DAOS_QOS_CLASS_NORMAL),
+			 SCHED_DEADLINE_MAX);
+}
+
+static void
+test_qos_deadline_latency(void **state)
+{
+	assert_int_equal(sched_qos_deadline(200, DAOS_QOS_CLASS_LATENCY), 50);
+	assert_int_equal(sched_qos_deadline(20, DAOS_QOS_CLASS_LATENCY), 5);
+	/* Never drop a latency target below 1 msec, nor create one */
+	assert_int_equal(sched_qos_deadline(3, DAOS_QOS_CLASS_LATENCY), 1);
+	assert_int_equal(sched_qos_deadline(1, DAOS_QOS_CLASS_LATENCY), 1);
+	assert_int_equal(sched_qos_deadline(0, DAOS_QOS_CLASS_LATENCY), 0);
+}
+
+static void
+test_qos_deadline_batch(void **state)
+{
+	assert_int_equal(sched_qos_deadline(20, DAOS_QOS_CLASS_BATCH), 80);
+	assert_int_equal(sched_qos_deadline(0, DAOS_QOS_CLASS_BATCH), 0);
+	assert_int_equal(sched_qos_deadline(SCHED_DEADLINE_MAX / 2, DAOS_QOS_CLASS_BATCH),
+			 SCHED_DEADLINE_MAX);
+}
+
+static void
+test_deadline_expired(void **state)
+{
+	/* Not expired yet */
+	assert_false(sched_deadline_expired(99, 100, SCHED_REQ_FETCH, SCHED_SPACE_PRESS_NONE));
+	assert_false(sched_deadline_expired(99, 100, SCHED_REQ_UPDATE, SCHED_SPACE_PRESS_NONE));
+
+	assert_true(sched_deadline_expired(100, 100, SCHED_REQ_FETCH, SCHED_SPACE_PRESS_NONE));
+	assert_true(sched_deadline_expired(150, 100, SCHED_REQ_UPDATE, SCHED_SPACE_PRESS_NONE));
+}
+
+static void
+test_deadline_expired_space_pressure(void **state)
+{
+	/* Expired updates are still held back under space pressure, fetches aren't */
+	assert_true(sched_deadline_expired(150, 100, SCHED_REQ_FETCH, SCHED_SPACE_PRESS_NONE + 1));
+	assert_false(sched_deadline_expired(150, 100, SCHED_REQ_UPDATE, SCHED_SPACE_PRESS_NONE + 1));
+}
+
+/*
+ * Mixed load model of the deadline policy: a backlog of updates and GC requests is
+ * queued at startup, fetches keep arriving every msec. Each schedule cycle (1 msec)
+ * can kick off TEST_CYCLE_WTS weights of requests, background requests are capped
+ * by the fetch reserve like throttle_bg() does, the rest is drained from the EDF list
+ * head. Same request weights & deadlines as req_weights[]/sched_deadline_msecs[].
+ */
+#define TEST_CYCLE_WTS		8
+#define TEST_CYCLES		300
+#define TEST_FETCH_PER_CYCLE	2
+#define TEST_UPDATE_BACKLOG	100
+#define TEST_GC_BACKLOG		100
+#define TEST_FETCH_WT		1
+#define TEST_UPDATE_WT		2
+#define TEST_GC_WT		4
+#define TEST_FETCH_DEADLINE	20
+#define TEST_UPDATE_DEADLINE	200
+
+struct test_req {
+	d_list_t	tr_link;
+	uint64_t	tr_deadline;
+	uint64_t	tr_enqueue_ts;
+	uint32_t	tr_seq;
+	unsigned int	tr_qos;
+};
+
+struct test_lat {
+	struct d_tm_node_t	*tl_node;
+	char			 tl_path[64];
+	uint32_t		 tl_kicked;
+	uint32_t		 tl_samples;
+	uint64_t		 tl_lat[TEST_CYCLES * TEST_FETCH_PER_CYCLE];
+};
+
+static const char *test_qos_names[SCHED_QOS_MAX] = { "fetch", "update", "bg" };
+
+static struct test_req *
+test_req_alloc(unsigned int qos, uint64_t now, unsigned int deadline, uint32_t seq)
+{
+	struct test_req	*req;
+
+	D_ALLOC_PTR(req);
+	assert_non_null(req);
+	D_INIT_LIST_HEAD(&req->tr_link);
+	req->tr_qos = qos;
+	req->tr_enqueue_ts = now;
+	req->tr_deadline = now + deadline;
+	req->tr_seq = seq;
+
+	return req;
+}
+
+static void
+test_lat_record(struct test_lat *tl, uint64_t lat)
+{
+	if (sched_lat_sampled(tl->tl_kicked++)) {
+		d_tm_set_gauge(tl->tl_node, lat);
+		assert_true(tl->tl_samples < ARRAY_SIZE(tl->tl_lat));
+		tl->tl_lat[tl->tl_samples++] = lat;
+	}
+}
+
+/* Verify every histogram bucket counts exactly the samples within its range */
+static void
+test_lat_check(struct test_lat *tl, uint64_t *max_bucket_min)
+{
+	struct d_tm_node_t	*node;
+	struct d_tm_histogram_t	 histogram;
+	struct d_tm_bucket_t	 bucket;
+	uint64_t		 val, exp, total = 0;
+	int			 i, j, rc;
+
+	node = d_tm_find_metric(cli_ctx, tl->tl_path);
+	assert_non_null(node);
+
+	rc = d_tm_get_num_buckets(cli_ctx, &histogram, node);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(histogram.dth_num_buckets, SCHED_LAT_BUCKETS);
+	assert_int_equal(histogram.dth_initial_width, SCHED_LAT_BUCKET_WIDTH);
+	assert_int_equal(histogram.dth_value_multiplier, SCHED_LAT_BUCKET_MULT);
+
+	*max_bucket_min = 0;
+	for (i = 0; i < histogram.dth_num_buckets; i++) {
+		rc = d_tm_get_bucket_range(cli_ctx, &bucket, i, node);
+		assert_rc_equal(rc, 0);
+		rc = d_tm_get_counter(cli_ctx, &val, bucket.dtb_bucket);
+		assert_rc_equal(rc, 0);
+
+		exp = 0;
+		for (j = 0; j < tl->tl_samples; j++) {
+			if (tl->tl_lat[j] >= bucket.dtb_min && tl->tl_lat[j] <= bucket.dtb_max)
+				exp++;
+		}
+		assert_int_equal(val, exp);
+
+		total += val;
+		if (val != 0)
+			*max_bucket_min = bucket.dtb_min;
+	}
+	assert_int_equal(total, tl->tl_samples);
+}
+
+static void
+run_mixed_load(unsigned int reserve)
+{
+	struct test_lat		*lats;
+	struct test_req		*req, *next;
+	d_list_t		 edf_list, bg_list;
+	uint64_t		 fetch_wts = 0, bg_wts = 0, bg_max, last_deadline;
+	uint64_t		 max_bucket_min;
+	uint32_t		 seq = 0, last_seq, kicked[SCHED_QOS_MAX] = { 0 };
+	int			 cycle_wts, now, i, rc;
+
+	D_INIT_LIST_HEAD(&edf_list);
+	D_INIT_LIST_HEAD(&bg_list);
+
+	D_ALLOC_ARRAY(lats, SCHED_QOS_MAX);
+	assert_non_null(lats);
+	for (i = 0; i < SCHED_QOS_MAX; i++) {
+		snprintf(lats[i].tl_path, sizeof(lats[i].tl_path),
+			 "sched/queue_latency/%s/reserve_%u", test_qos_names[i], reserve);
+		rc = d_tm_add_metric(&lats[i].tl_node, D_TM_STATS_GAUGE,
+				     "Request queue latency", "ms", "%s", lats[i].tl_path);
+		assert_rc_equal(rc, 0);
+		rc = d_tm_init_histogram(lats[i].tl_node, lats[i].tl_path, SCHED_LAT_BUCKETS,
+					 SCHED_LAT_BUCKET_WIDTH, SCHED_LAT_BUCKET_MULT);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < TEST_UPDATE_BACKLOG; i++) {
+		req = test_req_alloc(SCHED_QOS_UPDATE, 0, TEST_UPDATE_DEADLINE, seq++);
+		sched_edf_insert(req, &edf_list, tr_link, tr_deadline);
+	}
+	for (i = 0; i < TEST_GC_BACKLOG; i++) {
+		req = test_req_alloc(SCHED_QOS_BG, 0, 0, seq++);
+		d_list_add_tail(&req->tr_link, &bg_list);
+	}
+
+	for (now = 0; now < TEST_CYCLES; now++) {
+		for (i = 0; i < TEST_FETCH_PER_CYCLE; i++) {
+			req = test_req_alloc(SCHED_QOS_FETCH, now, TEST_FETCH_DEADLINE, seq++);
+			sched_edf_insert(req, &edf_list, tr_link, tr_deadline);
+		}
+
+		/* EDF list is in deadline ascending order, FIFO for same deadline */
+		last_deadline = 0;
+		last_seq = 0;
+		d_list_for_each_entry(req, &edf_list, tr_link) {
+			assert_true(req->tr_deadline >= last_deadline);
+			if (req->tr_deadline == last_deadline)
+				assert_true(req->tr_seq > last_seq);
+			last_deadline = req->tr_deadline;
+			last_seq = req->tr_seq;
+		}
+
+		cycle_wts = TEST_CYCLE_WTS;
+
+		/* Background requests get what the fetch reserve leaves */
+		bg_max = sched_bg_wts_max(fetch_wts + TEST_FETCH_PER_CYCLE * TEST_FETCH_WT,
+					  reserve);
+		d_list_for_each_entry_safe(req, next, &bg_list, tr_link) {
+			if (bg_wts >= bg_max || cycle_wts < TEST_GC_WT)
+				break;
+			d_list_del(&req->tr_link);
+			bg_wts += TEST_GC_WT;
+			cycle_wts -= TEST_GC_WT;
+			test_lat_record(&lats[SCHED_QOS_BG], now - req->tr_enqueue_ts);
+			kicked[SCHED_QOS_BG]++;
+			D_FREE(req);
+		}
+
+		/* Foreground requests are kicked off in deadline order */
+		d_list_for_each_entry_safe(req, next, &edf_list, tr_link) {
+			int	wt = req->tr_qos == SCHED_QOS_FETCH ? TEST_FETCH_WT : TEST_UPDATE_WT;
+
+			if (cycle_wts < wt)
+				break;
+			cycle_wts -= wt;
+			d_list_del(&req->tr_link);
+
+			/* The head always has the earliest deadline */
+			if (!d_list_empty(&edf_list))
+				assert_true(req->tr_deadline <=
+					    d_list_entry(edf_list.next, struct test_req,
+							 tr_link)->tr_deadline);
+			if (req->tr_qos == SCHED_QOS_FETCH) {
+				/* Fetches never wait behind the update backlog */
+				assert_true(now - req->tr_enqueue_ts <= TEST_FETCH_DEADLINE);
+				fetch_wts += wt;
+			} else {
+				assert_true(now <= req->tr_deadline);
+			}
+			test_lat_record(&lats[req->tr_qos], now - req->tr_enqueue_ts);
+			kicked[req->tr_qos]++;
+			D_FREE(req);
+		}
+
+		/* Fetches got at least their reserved share of the CPU */
+		assert_true(bg_wts <= sched_bg_wts_max(fetch_wts, reserve) + TEST_GC_WT);
+	}
+
+	/* Every fetch and the whole update backlog are done, GC isn't starved */
+	assert_int_equal(kicked[SCHED_QOS_FETCH], TEST_CYCLES * TEST_FETCH_PER_CYCLE);
+	assert_int_equal(kicked[SCHED_QOS_UPDATE], TEST_UPDATE_BACKLOG);
+	assert_true(kicked[SCHED_QOS_BG] > 0);
+	assert_true(d_list_empty(&edf_list));
+
+	/* Fetch latencies stay in the low buckets, GC backlog lands in higher ones */
+	for (i = 0; i < SCHED_QOS_MAX; i++)
+		assert_int_equal(lats[i].tl_samples,
+				 (kicked[i] + SCHED_LAT_SAMPLE_INTVL - 1) / SCHED_LAT_SAMPLE_INTVL);
+
+	test_lat_check(&lats[SCHED_QOS_FETCH], &max_bucket_min);
+	assert_true(max_bucket_min <= TEST_FETCH_DEADLINE);
+	test_lat_check(&lats[SCHED_QOS_UPDATE], &max_bucket_min);
+	assert_true(max_bucket_min <= TEST_UPDATE_DEADLINE);
+	test_lat_check(&lats[SCHED_QOS_BG], &max_bucket_min);
+	assert_true(max_bucket_min > TEST_FETCH_DEADLINE);
+
+	d_list_for_each_entry_safe(req, next, &bg_list, tr_link) {
+		d_list_del(&req->tr_link);
+		D_FREE(req);
+	}
+	D_FREE(lats);
+}
+
+static void
+test_mixed_load_reserve_default(void **state)
+{
+	run_mixed_load(SCHED_FETCH_RESERVE_DEFAULT);
+}
+
+static void
+test_mixed_load_reserve_high(void **state)
+{
+	run_mixed_load(80);
+}
+
+static int
+init_tests(void **state)
+{
+	int	rc;
+
+	rc = d_tm_init(TEST_TM_IDX, D_TM_SHARED_MEMORY_SIZE, D_TM_SERVER_PROCESS);
+	if (rc != 0)
+		return rc;
+
+	cli_ctx = d_tm_open(TEST_TM_IDX);
+	if (cli_ctx == NULL)
+		return -DER_NOMEM;
+
+	return d_log_init();
+}
+
+static int
+fini_tests(void **state)
+{
+	d_tm_close(&cli_ctx);
+	d_tm_fini();
+	d_log_fini();
+
+	return 0;
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_qos_deadline_normal),
+		cmocka_unit_test(test_qos_deadline_latency),
+		cmocka_unit_test(test_qos_deadline_batch),
+		cmocka_unit_test(test_deadline_expired),
+		cmocka_unit_test(test_deadline_expired_space_pressure),
+		cmocka_unit_test(test_mixed_load_reserve_default),
+		cmocka_unit_test(test_mixed_load_reserve_high),
+	};
+
+	return cmocka_run_group_tests_name("engine_sched", tests, init_tests, fini_tests);
+}
@@ -943,6 +943,82 @@ crt_bulk_access(crt_bulk_t bulk_hdl, d_sg_list_t *sgl);
 int
 crt_bulk_free(crt_bulk_t bulk_hdl);
 
+/**
+ * Get a bulk handle for \p sgl from the registration cache of the context,
+ * creating (and optionally binding) it on a miss. Handles are keyed by the
+ * address and length of every iov plus \p bulk_perm and evicted in LRU order.
+ * Only buffers within regions registered by crt_bulk_cache_register() are
+ * cached. If the cache is disabled (CRT_BULK_CACHE_SIZE not set) or any iov is
+ * outside of a registered region, this is equivalent to crt_bulk_create()
+ * followed by crt_bulk_bind().
+ *
+ * \param[in] crt_ctx          CRT transport context
+ * \param[in] sgl              iovs of the buffers
+ * \param[in] bulk_perm        bulk permission
+ * \param[in] bind             bind the handle to \p crt_ctx
+ * \param[out] bulk_hdl        bulk handle, to be released by crt_bulk_free()
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_create_cached(crt_context_t crt_ctx, d_sg_list_t *sgl,
+		       crt_bulk_perm_t bulk_perm, bool bind,
+		       crt_bulk_t *bulk_hdl);
+
+/**
+ * Drop all cached bulk handles of the context overlapping with the address
+ * range [\p addr, \p addr + \p len). Handles in use by inflight RPCs stay
+ * valid until they are freed by their users.
+ *
+ * \param[in] crt_ctx          CRT transport context
+ * \param[in] addr             start address of the range
+ * \param[in] len              length of the range, 0 to drop all handles
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_invalidate(crt_context_t crt_ctx, void *addr, size_t len);
+
+/**
+ * Allow the buffer [\p addr, \p addr + \p len) to be cached by
+ * crt_bulk_create_cached() of all contexts. The caller must call
+ * crt_bulk_cache_deregister() before freeing or remapping the buffer.
+ *
+ * \param[in] addr             start address of the buffer
+ * \param[in] len              length of the buffer
+ *
+ * \return                     DER_SUCCESS on success, -DER_EXIST if the
+ *                             buffer overlaps with a registered one, negative
+ *                             value if other error
+ */
+int
+crt_bulk_cache_register(void *addr, size_t len);
+
+/**
+ * Deregister a buffer registered by crt_bulk_cache_register() with the same
+ * \p addr and \p len, and drop its cached handles from all contexts.
+ *
+ * \param[in] addr             start address of the buffer
+ * \param[in] len              length of the buffer
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_deregister(void *addr, size_t len);
+
+/**
+ * Query the statistics of the bulk registration cache of the context.
+ *
+ * \param[in] crt_ctx          CRT transport context, NULL for the sum of all
+ *                             contexts
+ * \param[out] stats           cache statistics
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_stats_get(crt_context_t crt_ctx,
+			 struct crt_bulk_cache_stats *stats);
+
 /**
  * Start a bulk transferring (inside an RPC handler).
  *
@@ -1218,6 +1294,62 @@ crt_group_config_save(crt_group_t *grp, bool forall);
 int
 crt_group_config_remove(crt_group_t *grp);
 
+/**
+ * Prefetch the URIs of all tags of a range of ranks from one server in a
+ * few RPCs and insert them into the local lookup cache of \p grp. Only URIs
+ * of ranks that are already members of \p grp are inserted. Large ranges are
+ * fetched in several round trips as each reply is capped. Replies from a
+ * server with an older group version than the local one are ignored. This is
+ * a hint to avoid one URI lookup per (rank, tag) on first contact; failures
+ * are harmless and only reported through \p complete_cb.
+ *
+ * \param[in] ctx              CRT context to send the RPC from
+ * \param[in] grp              Primary group handle
+ * \param[in] contact_rank     Rank to fetch the URIs from
+ * \param[in] rank_start       First rank of the range
+ * \param[in] rank_nr          Number of ranks in the range
+ * \param[in] complete_cb      Optional completion callback
+ * \param[in] arg              Argument passed to \p complete_cb
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_group_uri_prefetch(crt_context_t ctx, crt_group_t *grp,
+		       d_rank_t contact_rank, d_rank_t rank_start,
+		       uint32_t rank_nr, crt_cb_t complete_cb, void *arg);
+
+/**
+ * Save the URI lookup cache of a primary group to a file, tagged with
+ * \p version. The file is synced and replaced atomically. Nothing is written
+ * if the cache did not change since it was last loaded from or saved to a
+ * file, so a group should use a single cache file.
+ *
+ * \param[in] grp              Primary group handle
+ * \param[in] path             Path of the cache file
+ * \param[in] version          Version of the membership the cache belongs to
+ *
+ * \return                     DER_SUCCESS on success, negative value if error
+ */
+int
+crt_group_uri_cache_save(crt_group_t *grp, const char *path, uint64_t version);
+
+/**
+ * Load a URI cache file saved by crt_group_uri_cache_save() into the lookup
+ * cache of a primary group. Entries of ranks which are not members of \p grp
+ * are skipped.
+ *
+ * \param[in] grp              Primary group handle
+ * \param[in] path             Path of the cache file
+ * \param[in] version          Expected version of the cache file
+ *
+ * \return                     DER_SUCCESS on success, -DER_STALE if the file
+ *                             was saved with another version, -DER_INVAL if
+ *                             it has another format or is corrupted, negative
+ *                             value on other errors
+ */
+int
+crt_group_uri_cache_load(crt_group_t *grp, const char *path, uint64_t version);
+
 /**
  * Detach a primary service group which was attached previously.
  *
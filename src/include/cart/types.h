@@ -353,6 +353,15 @@ struct crt_bulk_desc {
 	size_t		 bd_len; /**< length of the bulk transferring */
 };
 
+/** Statistics of the bulk registration cache of a context */
+struct crt_bulk_cache_stats {
+	uint64_t	bcs_hits; /**< handles reused from the cache */
+	uint64_t	bcs_misses; /**< handles created and inserted */
+	uint64_t	bcs_bypasses; /**< buffers not registered for caching */
+	uint64_t	bcs_evictions; /**< handles evicted by LRU */
+	uint64_t	bcs_invalidations; /**< handles dropped by invalidation */
+};
+
 /** Callback info structure */
 struct crt_cb_info {
 	crt_rpc_t		*cci_rpc; /**< rpc struct */
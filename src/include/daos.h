@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2016-2021 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -46,6 +46,61 @@ daos_init(void);
 int
 daos_fini(void);
 
+/** Statistics of the bulk registration cache, see daos_mem_register() */
+struct daos_mem_cache_stats {
+	/** transfers which reused a cached registration */
+	uint64_t	dmcs_hits;
+	/** transfers which registered a buffer and cached it */
+	uint64_t	dmcs_misses;
+	/** transfers from buffers not registered by daos_mem_register() */
+	uint64_t	dmcs_bypasses;
+	/** cached registrations evicted to stay within the cache size */
+	uint64_t	dmcs_evictions;
+	/** cached registrations dropped by daos_mem_deregister() */
+	uint64_t	dmcs_invalidations;
+};
+
+/**
+ * Declare that the I/O buffer [\p buf, \p buf + \p len) stays allocated
+ * until daos_mem_deregister() is called for it. Its network registration can
+ * then be cached and reused across I/O when CRT_BULK_CACHE_SIZE is set, other
+ * buffers are registered for each I/O.
+ *
+ * \param[in]	buf	Start address of the buffer.
+ * \param[in]	len	Length of the buffer.
+ *
+ * \return		0		Success
+ *			-DER_INVAL	Invalid parameter
+ *			-DER_EXIST	Overlaps with a registered buffer
+ */
+int
+daos_mem_register(void *buf, size_t len);
+
+/**
+ * Drop the cached registrations of a buffer registered by daos_mem_register(),
+ * must be called before the buffer is freed or unmapped.
+ *
+ * \param[in]	buf	Start address of the buffer, as registered.
+ * \param[in]	len	Length of the buffer, as registered.
+ *
+ * \return		0		Success
+ *			-DER_NONEXIST	Buffer not registered
+ */
+int
+daos_mem_deregister(void *buf, size_t len);
+
+/**
+ * Query the bulk registration cache statistics of this process. The hit rate
+ * is dmcs_hits / (dmcs_hits + dmcs_misses + dmcs_bypasses).
+ *
+ * \param[out]	stats	Statistics summed over all network contexts.
+ *
+ * \return		0		Success
+ *			-DER_INVAL	Invalid parameter
+ */
+int
+daos_mem_cache_query(struct daos_mem_cache_stats *stats);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -73,6 +73,8 @@ struct credit_context {
 	int			 tsc_cred_nr;
 	/** value size for \a tsc_credits */
 	int			 tsc_cred_vsize;
+	/** all credits share the value buffer of the first one */
+	bool			 tsc_cred_vbuf_shared;
 	/** if pool/cont already created then can skip internal creation */
 	bool			 tsc_skip_pool_create;
 	bool			 tsc_skip_cont_create;
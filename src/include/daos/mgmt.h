@@ -39,6 +39,7 @@ struct dc_mgmt_sys_info {
 	uint32_t	crt_timeout;
 	int32_t		srv_srx_set;
 	d_rank_list_t  *ms_ranks;
+	uint64_t	data_version;
 };
 
 /** Client system handle */
@@ -49,6 +50,8 @@ struct dc_mgmt_sys {
 	bool			sy_server;
 	crt_group_t	       *sy_group;
 	struct dc_mgmt_sys_info	sy_info;
+	/* path of the persistent URI cache, NULL if disabled */
+	char		       *sy_uri_cache;
 };
 
 int dc_mgmt_sys_attach(const char *name, struct dc_mgmt_sys **sysp);
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -45,7 +45,12 @@
 #define DAOS_PO_QUERY_PROP_SCRUB_THRESH		(1ULL << (PROP_BIT_START + 17))
 #define DAOS_PO_QUERY_PROP_SVC_REDUN_FAC	(1ULL << (PROP_BIT_START + 18))
 #define DAOS_PO_QUERY_PROP_OBJ_VERSION		(1ULL << (PROP_BIT_START + 19))
-#define DAOS_PO_QUERY_PROP_BIT_END		35
+#define DAOS_PO_QUERY_PROP_QOS_CLASS		(1ULL << (PROP_BIT_START + 20))
+#define DAOS_PO_QUERY_PROP_READ_BW_LIMIT	(1ULL << (PROP_BIT_START + 21))
+#define DAOS_PO_QUERY_PROP_WRITE_BW_LIMIT	(1ULL << (PROP_BIT_START + 22))
+#define DAOS_PO_QUERY_PROP_READ_IOPS_LIMIT	(1ULL << (PROP_BIT_START + 23))
+#define DAOS_PO_QUERY_PROP_WRITE_IOPS_LIMIT	(1ULL << (PROP_BIT_START + 24))
+#define DAOS_PO_QUERY_PROP_BIT_END		40
 
 #define DAOS_PO_QUERY_PROP_ALL									\
 	(DAOS_PO_QUERY_PROP_LABEL | DAOS_PO_QUERY_PROP_SPACE_RB |				\
@@ -56,7 +61,10 @@
 	 DAOS_PO_QUERY_PROP_POLICY | DAOS_PO_QUERY_PROP_GLOBAL_VERSION |			\
 	 DAOS_PO_QUERY_PROP_UPGRADE_STATUS | DAOS_PO_QUERY_PROP_SCRUB_MODE |			\
 	 DAOS_PO_QUERY_PROP_SCRUB_FREQ | DAOS_PO_QUERY_PROP_SCRUB_THRESH |			\
-	 DAOS_PO_QUERY_PROP_SVC_REDUN_FAC | DAOS_PO_QUERY_PROP_OBJ_VERSION)
+	 DAOS_PO_QUERY_PROP_SVC_REDUN_FAC | DAOS_PO_QUERY_PROP_OBJ_VERSION |			\
+	 DAOS_PO_QUERY_PROP_QOS_CLASS | DAOS_PO_QUERY_PROP_READ_BW_LIMIT |			\
+	 DAOS_PO_QUERY_PROP_WRITE_BW_LIMIT | DAOS_PO_QUERY_PROP_READ_IOPS_LIMIT |		\
+	 DAOS_PO_QUERY_PROP_WRITE_IOPS_LIMIT)
 /*
  * Aggregation of pool/container/object/keys disk format change.
  */
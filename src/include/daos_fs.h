@@ -99,6 +99,30 @@ typedef struct {
 	daos_size_t		doi_chunk_size;
 } dfs_obj_info_t;
 
+/** Statistics of the dentry cache of a DFS mount */
+typedef struct {
+	/** lookups answered with a cached entry */
+	uint64_t		dcs_hits;
+	/** lookups answered with a cached non-existent entry */
+	uint64_t		dcs_neg_hits;
+	/** lookups that had to fetch the entry from the parent directory */
+	uint64_t		dcs_misses;
+	/** entries dropped on a local change or because the cache was full */
+	uint64_t		dcs_evicts;
+	/** entries currently cached */
+	uint64_t		dcs_nr;
+} dfs_dcache_stats_t;
+
+/** Progress of a parallel directory tree removal */
+typedef struct {
+	/** directories removed so far */
+	uint64_t		drs_dirs;
+	/** files and symlinks removed so far */
+	uint64_t		drs_files;
+	/** operations currently in flight */
+	uint32_t		drs_inflight;
+} dfs_remove_stats_t;
+
 /**
  * Initialize the DAOS and DFS library. Typically this is called at the beginning of a user program
  * or in IO middleware initialization. This is required to be called if using the
@@ -377,6 +401,38 @@ dfs_global2local_all(int flags, d_iov_t glob, dfs_t **dfs);
 int
 dfs_set_prefix(dfs_t *dfs, const char *prefix);
 
+/**
+ * Enable, tune or disable the dentry cache of a DFS mount. Once enabled, the
+ * entries fetched by path lookups and stat calls are kept in memory, for
+ * \a dentry_timeout seconds if the entry exists and for \a ndentry_timeout
+ * seconds if it does not. Changes made through this mount invalidate the
+ * affected entries, changes made by other clients are only seen once the
+ * cached entry expires. The cache can also be enabled on mount with the
+ * DFS_DENTRY_TIMEOUT and DFS_NDENTRY_TIMEOUT environment variables. It can be
+ * called at any time, disabling the cache drops all the cached entries and
+ * clears the statistics.
+ *
+ * \param[in]	dfs		Pointer to the mounted file system.
+ * \param[in]	dentry_timeout	Seconds an existing entry is cached for.
+ *				Passing 0 for both timeouts disables the cache.
+ * \param[in]	ndentry_timeout	Seconds a non-existent entry is cached for.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_dcache_set(dfs_t *dfs, double dentry_timeout, double ndentry_timeout);
+
+/**
+ * Query the dentry cache statistics of a DFS mount.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[out]	stats	Cache statistics, all zero if the cache is disabled.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_dcache_query(dfs_t *dfs, dfs_dcache_stats_t *stats);
+
 /**
  * Convert from a dfs_obj_t to a daos_obj_id_t.
  *
@@ -601,6 +657,13 @@ dfs_writex(dfs_t *dfs, dfs_obj_t *obj, dfs_iod_t *iod, d_sg_list_t *sgl,
 /**
  * Query size of file data.
  *
+ * If the "dfs-size-hint" container attribute is set to "on" when the container is mounted, the
+ * size is read from a hint stored with the file entry instead of being queried from all the shards
+ * of the file. This also applies to dfs_stat, dfs_ostat and dfs_readdirplus. The hint is not used
+ * while any handle, on any client, that modified the file is still open, and the size is published
+ * when the last of them is released. Clients that mount the container before the attribute is set
+ * do not maintain the hint, so it should only be changed while the container is not in use.
+ *
  * \param[in]	dfs	Pointer to the mounted file system.
  * \param[in]	obj	Opened file object.
  * \param[out]	size	Size of file.
@@ -767,6 +830,32 @@ int
 dfs_mkdir(dfs_t *dfs, dfs_obj_t *parent, const char *name, mode_t mode,
 	  daos_oclass_id_t cid);
 
+/**
+ * Create many regular files or directories in the same directory at once. The entries are
+ * inserted in the parent directory with one conditional object update each, all in flight
+ * together. Nothing is opened, use dfs_lookup_rel() or dfs_open() to access the new objects.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	nr	Number of entries to create.
+ * \param[in]	names	Link names of the new entries, must remain valid until completion.
+ * \param[in]	mode	mode_t (permissions + type) of all the new entries, the type must be
+ *			S_IFREG or S_IFDIR.
+ * \param[in]	cid	DAOS object class id (pass 0 for default MAX_RW).
+ * \param[in]	chunk_size
+ *			Chunk size of the files (pass 0 for default 1 MiB), ignored for dirs.
+ * \param[out]	rcs	Array of \a nr per-entry errno codes, 0 if the entry was created,
+ *			EEXIST if it already existed.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 if the request was executed, \a rcs has the result of each entry,
+ *			errno code on failure of the whole request.
+ */
+int
+dfs_create_multi(dfs_t *dfs, dfs_obj_t *parent, int nr, const char *names[], mode_t mode,
+		 daos_oclass_id_t cid, daos_size_t chunk_size, int *rcs, daos_event_t *ev);
+
 /**
  * Remove an object from parent directory. If object is a directory and is
  * non-empty; this will fail unless force option is true. If object is a
@@ -784,6 +873,39 @@ int
 dfs_remove(dfs_t *dfs, dfs_obj_t *parent, const char *name, bool force,
 	   daos_obj_id_t *oid);
 
+/**
+ * User callback defined for dfs_remove_tree, called as a parallel removal progresses. Returning
+ * a non zero errno code stops the removal, and dfs_remove_tree returns that code.
+ */
+typedef int (*dfs_remove_cb_t)(dfs_remove_stats_t *stats, void *arg);
+
+/**
+ * Remove an object from parent directory, and if it is a directory, everything under it. Unlike
+ * dfs_remove with force, the tree is not walked one entry at a time: enumerations of the
+ * directories and removals of the entries are issued asynchronously, with up to \a max_inflight
+ * of them in flight at once, and sub-directories are enumerated while other entries are being
+ * removed. dfs_remove with force uses the same mode if the DFS_REMOVE_INFLIGHT environment
+ * variable is set to a non zero value.
+ *
+ * If the mount uses DTX, the tree is removed in a single transaction as dfs_remove does, and
+ * \a max_inflight is ignored. Otherwise the removal is not atomic, and on failure part of the
+ * tree might have been removed already.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	name	Name of object to remove in parent dir.
+ * \param[in]	max_inflight
+ *			Max number of operations in flight, 0 to remove the tree serially.
+ * \param[in]	cb	Optional progress callback.
+ * \param[in]	arg	Pointer to user data passed to \a cb.
+ * \param[out]	oid	Optionally return the DAOS Object ID of the removed obj.
+ *
+ * \return		0 on success, errno code on failure.
+ */
+int
+dfs_remove_tree(dfs_t *dfs, dfs_obj_t *parent, const char *name, uint32_t max_inflight,
+		dfs_remove_cb_t cb, void *arg, daos_obj_id_t *oid);
+
 /**
  * Move/rename an object.
  *
@@ -974,6 +1096,28 @@ dfs_stat(dfs_t *dfs, dfs_obj_t *parent, const char *name,
 int
 dfs_ostat(dfs_t *dfs, dfs_obj_t *obj, struct stat *stbuf);
 
+/**
+ * Stat many entries of the same directory at once. The entries are fetched from the parent
+ * directory with one object fetch each, all in flight together, followed by the size queries
+ * of the regular files. The stat buffers are populated as with dfs_stat(), except that the
+ * times of a directory are the ones of its entry. Symlinks are not dereferenced.
+ *
+ * \param[in]	dfs	Pointer to the mounted file system.
+ * \param[in]	parent	Opened parent directory object. If NULL, use root obj.
+ * \param[in]	nr	Number of entries.
+ * \param[in]	names	Link names of the entries, must remain valid until completion.
+ * \param[out]	stbufs	Array of \a nr stat structs, filled for the entries that succeeded.
+ * \param[out]	rcs	Array of \a nr per-entry errno codes, 0 if the entry was stat'ed.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		0 if the request was executed, \a rcs has the result of each entry,
+ *			errno code on failure of the whole request.
+ */
+int
+dfs_stat_multi(dfs_t *dfs, dfs_obj_t *parent, int nr, const char *names[],
+	       struct stat *stbufs, int *rcs, daos_event_t *ev);
+
 /** Option to set the mode_t on an entry */
 #define DFS_SET_ATTR_MODE	(1 << 0)
 /** Option to set the access time on an entry */
@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -28,6 +28,23 @@ extern "C" {
 /** Conditional Op: Remove key if it exists, fail otherwise */
 #define DAOS_COND_KEY_REMOVE	DAOS_COND_PUNCH
 
+/** A single key and value of a multi-key KV operation */
+typedef struct {
+	/** Key of the entry */
+	const char		*kve_key;
+	/**
+	 * Size of the value.
+	 * For put, the size of the buffer to be inserted.
+	 * For get, [in]: size of the user buffer, [out]: actual size of the value.
+	 * Unused for remove.
+	 */
+	daos_size_t		 kve_size;
+	/** Value buffer, unused for remove. For get, if NULL only the size is returned */
+	void			*kve_buf;
+	/** [out]: Result of the operation on this key */
+	int			 kve_rc;
+} daos_kv_entry_t;
+
 /**
  * Open a KV object. This is a local operation (no RPC involved).
  * The type bits in the oid must set DAOS_OT_KV_*.
@@ -162,6 +179,89 @@ int
 daos_kv_remove(daos_handle_t oh, daos_handle_t th, uint64_t flags,
 	       const char *key, daos_event_t *ev);
 
+/**
+ * Insert or update several KV pairs, with the same semantics as daos_kv_put() for each key.
+ * This is not a batched RPC: one update RPC is sent per key, all of them in flight at the same
+ * time under a single event.  The result of each key is returned in its entry, including errors
+ * failing the whole operation.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Update flags, applied to every key.
+ * \param[in]	nr	Number of entries in \a kves.
+ * \param[in,out]
+ *		kves	[in]: keys and values to insert. [out]: per-key result in kve_rc.
+ *			The keys should be unique within \a kves.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success, for all keys
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			Otherwise the error of one of the failed keys, see kve_rc
+ *			for the result of each key.
+ */
+int
+daos_kv_put_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  daos_kv_entry_t *kves, daos_event_t *ev);
+
+/**
+ * Fetch the values of several keys, with the same semantics as daos_kv_get() for each key.
+ * This is not a batched RPC: one fetch RPC is sent per key, all of them in flight at the same
+ * time under a single event.  The result of each key is returned in its entry, including errors
+ * failing the whole operation.  Keys which do not exist return a size of zero.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Fetch flags, applied to every key.
+ * \param[in]	nr	Number of entries in \a kves.
+ * \param[in,out]
+ *		kves	[in]: keys and buffers to fetch into. [out]: size of each value and
+ *			per-key result in kve_rc, -DER_REC2BIG if the value did not fit.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success, for all keys
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			Otherwise the error of one of the failed keys, see kve_rc
+ *			for the result of each key.
+ */
+int
+daos_kv_get_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		  daos_kv_entry_t *kves, daos_event_t *ev);
+
+/**
+ * Remove several keys, with the same semantics as daos_kv_remove() for each key.
+ * This is not a batched RPC: one punch RPC is sent per key, all of them in flight at the same
+ * time under a single event.  The result of each key is returned in its entry, including errors
+ * failing the whole operation.
+ *
+ * \param[in]	oh	Object open handle.
+ * \param[in]	th	Transaction handle.
+ * \param[in]	flags	Remove flags, applied to every key.
+ * \param[in]	nr	Number of entries in \a kves.
+ * \param[in,out]
+ *		kves	[in]: keys to remove. [out]: per-key result in kve_rc.
+ * \param[in]	ev	Completion event, it is optional and can be NULL.
+ *			Function will run in blocking mode if \a ev is NULL.
+ *
+ * \return		These values will be returned by \a ev::ev_error in
+ *			non-blocking mode:
+ *			0		Success, for all keys
+ *			-DER_NO_HDL	Invalid object open handle
+ *			-DER_INVAL	Invalid parameter
+ *			Otherwise the error of one of the failed keys, see kve_rc
+ *			for the result of each key.
+ */
+int
+daos_kv_remove_multi(daos_handle_t oh, daos_handle_t th, uint64_t flags, uint32_t nr,
+		     daos_kv_entry_t *kves, daos_event_t *ev);
+
 /**
  * List/enumerate all keys in an object.
  *
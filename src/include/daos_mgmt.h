@@ -61,6 +61,16 @@ enum {
 	DMG_KEY_FAIL_LOC	 = 0,
 	DMG_KEY_FAIL_VALUE,
 	DMG_KEY_FAIL_NUM,
+	/* Per-pool & per-target read bandwidth limit (bytes/sec), 0 for unlimited */
+	DMG_KEY_SCHED_READ_BW,
+	/* Per-pool & per-target write bandwidth limit (bytes/sec), 0 for unlimited */
+	DMG_KEY_SCHED_WRITE_BW,
+	/* Per-pool & per-target read IOPS limit, 0 for unlimited */
+	DMG_KEY_SCHED_READ_IOPS,
+	/* Per-pool & per-target write IOPS limit, 0 for unlimited */
+	DMG_KEY_SCHED_WRITE_IOPS,
+	/* Incremental reintegration, 0 to disable, see DAOS_REBUILD_INCREMENTAL */
+	DMG_KEY_REBUILD_INCREMENTAL,
 	DMG_KEY_NUM,
 };
 
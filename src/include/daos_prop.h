@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2015-2022 Intel Corporation.
+ * (C) Copyright 2015-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -123,6 +123,36 @@ enum daos_pool_props {
 	DAOS_PROP_PO_SVC_REDUN_FAC,
 	/** object global version */
 	DAOS_PROP_PO_OBJ_VERSION,
+	/**
+	 * QoS class of the pool IO in the engine scheduler, see DAOS_QOS_CLASS_*
+	 *
+	 * default: DAOS_QOS_CLASS_NORMAL
+	 */
+	DAOS_PROP_PO_QOS_CLASS,
+	/**
+	 * Read bandwidth limit, in bytes per second, of each pool target, enforced by the engine scheduler.
+	 *
+	 * default: 0 (fall back to the engine-wide limit)
+	 */
+	DAOS_PROP_PO_READ_BW_LIMIT,
+	/**
+	 * Write bandwidth limit, in bytes per second, of each pool target, enforced by the engine scheduler.
+	 *
+	 * default: 0 (fall back to the engine-wide limit)
+	 */
+	DAOS_PROP_PO_WRITE_BW_LIMIT,
+	/**
+	 * Read IOPS limit of each pool target, enforced by the engine scheduler.
+	 *
+	 * default: 0 (fall back to the engine-wide limit)
+	 */
+	DAOS_PROP_PO_READ_IOPS_LIMIT,
+	/**
+	 * Write IOPS limit of each pool target, enforced by the engine scheduler.
+	 *
+	 * default: 0 (fall back to the engine-wide limit)
+	 */
+	DAOS_PROP_PO_WRITE_IOPS_LIMIT,
 	DAOS_PROP_PO_MAX,
 };
 
@@ -198,6 +228,23 @@ enum {
 #define DAOS_PROP_PO_SCRUB_FREQ_DEFAULT 604800 /* 1 week in seconds */
 #define DAOS_PROP_PO_SCRUB_THRESH_DEFAULT 0
 
+/**
+ * Pool QoS class, it scales the queue latency targets of the pool IO requests
+ * when the engines run the deadline scheduling policy, and has no effect with
+ * other policies.
+ */
+enum {
+	/* Default latency targets */
+	DAOS_QOS_CLASS_NORMAL = 0,
+	/* A quarter of the default latency targets */
+	DAOS_QOS_CLASS_LATENCY = 1,
+	/* Four times the default latency targets */
+	DAOS_QOS_CLASS_BATCH = 2,
+	DAOS_QOS_CLASS_INVALID = 3,
+};
+
+#define DAOS_PROP_PO_QOS_CLASS_DEFAULT DAOS_QOS_CLASS_NORMAL
+
 /** self healing strategy bits */
 #define DAOS_SELF_HEAL_AUTO_EXCLUDE	(1U << 0)
 #define DAOS_SELF_HEAL_AUTO_REBUILD	(1U << 1)
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -54,6 +54,9 @@ extern unsigned int	 dss_instance_idx;
 /** Bypass for the nvme health check */
 extern bool		 dss_nvme_bypass_health_check;
 
+/** Incremental reintegration, see DAOS_REBUILD_INCREMENTAL */
+extern bool		 dss_incr_reint;
+
 /**
  * Stackable Module API
  * Provides a modular interface to load and register server-side code on
@@ -237,6 +240,8 @@ struct sched_req_attr {
 	uuid_t		sra_pool_id;
 	uint32_t	sra_type;
 	uint32_t	sra_flags;
+	/* IO size in bytes, used by per-pool bandwidth limit */
+	uint64_t	sra_size;
 };
 
 static inline void
@@ -245,6 +250,7 @@ sched_req_attr_init(struct sched_req_attr *attr, unsigned int type,
 {
 	attr->sra_type = type;
 	attr->sra_flags = 0;
+	attr->sra_size = 0;
 	uuid_copy(attr->sra_pool_id, *pool_id);
 }
 
@@ -323,6 +329,40 @@ void sched_req_wait(struct sched_request *req, bool abort);
  */
 bool sched_req_is_aborted(struct sched_request *req);
 
+/* Per-pool scheduling properties, derived from the pool properties */
+struct sched_pool_prop {
+	/* See DAOS_PROP_PO_QOS_CLASS */
+	uint32_t	spp_qos_class;
+	/* See DAOS_PROP_PO_*_LIMIT, 0 to use the engine-wide limit */
+	uint64_t	spp_read_bw;
+	uint64_t	spp_write_bw;
+	uint64_t	spp_read_iops;
+	uint64_t	spp_write_iops;
+};
+
+/**
+ * Apply the scheduling properties of a pool to the scheduler of the calling
+ * xstream. Only the main xstream of a target queues pool requests, it's a
+ * no-op on other xstreams.
+ *
+ * \param[in] pool_id	Pool UUID.
+ * \param[in] prop	Scheduling properties.
+ *
+ * \retval		Zero on success, negative value on error.
+ */
+int sched_pool_prop_set(uuid_t pool_id, struct sched_pool_prop *prop);
+
+/**
+ * Charge the bandwidth limit of a pool for IO whose size wasn't known when the
+ * request was scheduled, e.g. fetch with DAOS_REC_ANY. Following requests of the
+ * pool will be held until the overdrawn tokens are refilled.
+ *
+ * \param[in] pool_id	Pool UUID.
+ * \param[in] req_type	SCHED_REQ_FETCH or SCHED_REQ_UPDATE.
+ * \param[in] size	IO size in bytes.
+ */
+void sched_pool_io_charge(uuid_t pool_id, unsigned int req_type, uint64_t size);
+
 #define SCHED_SPACE_PRESS_NONE	0
 
 /**
@@ -77,7 +77,17 @@ struct ds_pool {
 	uint32_t		sp_stopping:1,
 				sp_fetch_hdls:1,
 				sp_disable_rebuild:1,
-				sp_need_discard:1;
+				sp_need_discard:1,
+				/* Some targets are not UPIN, see DAOS_REBUILD_INCREMENTAL */
+				sp_map_degraded:1,
+				/* Reintegration without full discard, see migrate_obj_ult() */
+				sp_incr_reint:1,
+				/* Leader only: the reintegrating targets kept their data */
+				sp_reint_incr:1,
+				/* Leader only: a reintegrating target lost its data, see
+				 * rebuild_scan_broadcast()
+				 */
+				sp_reint_full:1;
 
 	/* pool_uuid + map version + leader term + rebuild generation define a
 	 * rebuild job.
@@ -99,6 +109,13 @@ struct ds_pool {
 	uint64_t		sp_scrub_mode;
 	uint64_t		sp_scrub_freq_sec;
 	uint64_t		sp_scrub_thresh;
+	/** QoS class of the pool IO, see DAOS_PROP_PO_QOS_CLASS */
+	uint32_t		sp_qos_class;
+	/** IO limits of each target, see DAOS_PROP_PO_*_LIMIT, 0 means engine-wide limit */
+	uint64_t		sp_read_bw_limit;
+	uint64_t		sp_write_bw_limit;
+	uint64_t		sp_read_iops_limit;
+	uint64_t		sp_write_iops_limit;
 };
 
 int ds_pool_lookup(const uuid_t uuid, struct ds_pool **pool);
@@ -157,7 +174,13 @@ struct ds_pool_child {
 	int		spc_ref;
 	ABT_eventual	spc_ref_eventual;
 
-	uint64_t	spc_discard_done:1;
+	uint64_t	spc_discard_done:1,
+			/* The dirty object log does not cover all changes since
+			 * the pool became degraded, e.g. the engine restarted.
+			 */
+			spc_dirty_invalid:1,
+			/* The VOS pool is stamped, see update_child_stamp() */
+			spc_stamped:1;
 	/**
 	 * Per-pool per-module metrics, see ${modname}_pool_metrics for the
 	 * actual structure. Initialized only for modules that specified a
@@ -295,6 +318,7 @@ int dsc_pool_open(uuid_t pool_uuid, uuid_t pool_hdl_uuid,
 		       daos_handle_t *ph);
 int dsc_pool_close(daos_handle_t ph);
 int ds_pool_tgt_discard(uuid_t pool_uuid, uint64_t epoch);
+int ds_pool_tgt_reint_discard(struct ds_pool *pool);
 
 int
 ds_pool_mark_upgrade_completed(uuid_t pool_uuid, int ret);
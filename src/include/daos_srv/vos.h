@@ -202,6 +202,20 @@ vos_dtx_mark_sync(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch);
 int
 vos_dtx_cmt_reindex(daos_handle_t coh);
 
+/**
+ * Re-index the next batch of active DTX entries. The container may be opened
+ * without indexing its active DTX table (DAOS_VOS_LAZY_INDEX), the rest of the
+ * table is indexed on its first access.
+ *
+ * \param coh	[IN]		Container open handle.
+ *
+ * \return	Zero on success, need further re-index.
+ *		Positive, re-index is completed.
+ *		Negative value if error.
+ */
+int
+vos_dtx_act_reindex_next(daos_handle_t coh);
+
 /**
  * Cleanup local DTX when local modification failed.
  *
@@ -993,6 +1007,35 @@ int
 vos_iter_fetch(daos_handle_t ih, vos_iter_entry_t *entry,
 	       daos_anchor_t *anchor);
 
+/**
+ * Return up to \a nr entries starting from the current cursor, and move the
+ * cursor past the last returned entry. It is equivalent to calling
+ * vos_iter_fetch() and vos_iter_next() \a nr times, but the d-key and a-key
+ * iterators only check the visibility of each key once.
+ *
+ * Returned keys are not copied, they are only valid until the caller yields
+ * or modifies the tree. Iterators with a filter callback are not supported.
+ *
+ * vos_iterate(), and so object enumeration, does not use this: its callbacks
+ * act on the entry under the cursor (vos_iter_copy(), delete, yield and
+ * re-probe), so it still fetches one entry at a time.
+ *
+ * \param ih	  [IN]	Iterator handle
+ * \param entries [OUT]	Array of \a nr entries
+ * \param anchors [OUT]	Optional, array of \a nr anchors for the entries
+ * \param nr	  [IN]	Size of the arrays
+ *		  [OUT]	Number of returned entries
+ *
+ * \return		Zero if the cursor points to an available entry
+ *			-DER_NONEXIST if the iteration reached the end,
+ *			entries may still have been returned
+ *			-DER_NOSYS if the iterator has a filter
+ *			negative value if error
+ */
+int
+vos_iter_fetch_batch(daos_handle_t ih, vos_iter_entry_t *entries,
+		     daos_anchor_t *anchors, unsigned int *nr);
+
 /**
  * Copy out the data fetched by vos_iter_fetch()
  *
@@ -1190,6 +1233,89 @@ enum vos_pool_opc {
 int
 vos_pool_ctl(daos_handle_t poh, enum vos_pool_opc opc, void *param);
 
+/**
+ * Start or stop logging the objects modified in the pool, so that an
+ * incremental reintegration only has to migrate the objects changed since.
+ * The log is kept in DRAM and is lost on pool close.
+ *
+ * \param poh	[IN]	Pool open handle
+ * \param epoch	[IN]	Epoch the tracking starts from, 0 to stop tracking
+ *			and drop the log. No-op if already tracking.
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_pool_dirty_track(daos_handle_t poh, daos_epoch_t epoch);
+
+/**
+ * Query the dirty object tracking of the pool.
+ *
+ * \param poh	[IN]	Pool open handle
+ * \param epoch	[OUT]	Epoch the tracking started from, 0 if the pool is
+ *			not tracked or the log overflowed
+ * \param nr	[OUT]	Number of dirty objects (optional)
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_pool_dirty_query(daos_handle_t poh, daos_epoch_t *epoch, uint64_t *nr);
+
+/**
+ * Check whether the object has been modified since the dirty tracking of
+ * the pool started. Always true if the pool is not tracked.
+ *
+ * \param coh	[IN]	Container open handle
+ * \param oid	[IN]	Object ID
+ */
+bool
+vos_obj_is_dirty(daos_handle_t coh, daos_unit_oid_t oid);
+
+/**
+ * Persist the reintegration stamp of the pool. The caller stamps the pool with
+ * the identity of its backing storage while the target is in service, so that
+ * a later reintegration can tell whether the pool still holds that data.
+ *
+ * \param poh	[IN]	Pool open handle
+ * \param stamp	[IN]	Nonzero storage identity, 0 to clear the stamp
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_pool_stamp_set(daos_handle_t poh, uint64_t stamp);
+
+/**
+ * Get the reintegration stamp of the pool, 0 if it was never stamped.
+ *
+ * \param poh	[IN]	Pool open handle
+ * \param stamp	[OUT]	The stamp
+ *
+ * \return		Zero on success, negative value if error
+ */
+int
+vos_pool_stamp_get(daos_handle_t poh, uint64_t *stamp);
+
+/** Return values of the \a yield_func of vos_gc_pool(), negative aborts GC */
+enum {
+	/** No foreground I/O, reclaim as fast as possible */
+	VOS_GC_YIELD_IDLE	= 0,
+	/** Foreground I/O is running, reclaim in the background */
+	VOS_GC_YIELD_BUSY	= 1,
+	/** Foreground I/O is running, but the pool is running out of space */
+	VOS_GC_YIELD_PRESSURE	= 2,
+};
+
+/**
+ * Reclaim space of a pool. Credits of each batch are sized by an adaptive
+ * controller from the GC backlog, the trend of used space and the foreground
+ * load reported by \a yield_func between batches.
+ *
+ * \param[in] poh		Pool handle
+ * \param[in] credits		Total credits budget, -1 for unlimited
+ * \param[in] yield_func	Called between batches, returns VOS_GC_YIELD_*
+ * \param[in] yield_arg		Argument of \a yield_func
+ *
+ * \return			Number of flushed NVMe extents, or error code
+ */
 int
 vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 	    void *yield_arg);
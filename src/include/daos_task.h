@@ -120,6 +120,10 @@ typedef enum {
 
 	DAOS_OPC_POOL_FILTER_CONT,
 	DAOS_OPC_OBJ_KEY2ANCHOR,
+
+	DAOS_OPC_KV_PUT_MULTI,
+	DAOS_OPC_KV_GET_MULTI,
+	DAOS_OPC_KV_REMOVE_MULTI,
 	DAOS_OPC_MAX
 } daos_opc_t;
 
@@ -1008,6 +1012,20 @@ typedef struct {
 	daos_anchor_t		*anchor;
 } daos_kv_list_t;
 
+/** KV multi-key put/get/remove args */
+typedef struct {
+	/** KV open handle. */
+	daos_handle_t		oh;
+	/** Transaction open handle. */
+	daos_handle_t		th;
+	/** Operation flags. */
+	uint64_t		flags;
+	/** Number of entries in #kves. */
+	uint32_t		nr;
+	/** Keys, values and per-key results. */
+	daos_kv_entry_t		*kves;
+} daos_kv_multi_t;
+
 /**
  * Create an asynchronous task and associate it with a daos client operation.
  * For synchronous operations please use the specific API for that operation.
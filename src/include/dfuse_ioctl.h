@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2017-2022 Intel Corporation.
+ * (C) Copyright 2017-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -28,6 +28,10 @@
 #define DFUSE_IOCTL_REPLY_PFILE  (DFUSE_IOCTL_REPLY_BASE + 8)
 
 #define DFUSE_IOCTL_R_DFUSE_USER (DFUSE_IOCTL_REPLY_BASE + 9)
+#define DFUSE_IOCTL_R_EQ_STATS   (DFUSE_IOCTL_REPLY_BASE + 10)
+
+/* Maximum number of event queues dfuse will create */
+#define DFUSE_IOCTL_EQ_MAX       64
 
 /** Metadada caching is enabled for this file */
 #define DFUSE_IOCTL_FLAGS_MCACHE (0x1)
@@ -60,6 +64,23 @@ struct dfuse_user_reply {
 	gid_t gid;
 };
 
+/* Statistics for one event queue */
+struct dfuse_eq_stat {
+	/* Events launched and not yet completed */
+	int64_t  des_depth;
+	/* Highest depth seen */
+	int64_t  des_max_depth;
+	/* Total number of events */
+	uint64_t des_events;
+};
+
+/* Query for event queue statistics */
+struct dfuse_eq_stats_reply {
+	int                  eqr_version;
+	int                  eqr_count;
+	struct dfuse_eq_stat eqr_eqs[DFUSE_IOCTL_EQ_MAX];
+};
+
 /* Defines the IOCTL command to get the object ID for a open file */
 #define DFUSE_IOCTL_IL ((int)_IOR(DFUSE_IOCTL_TYPE, DFUSE_IOCTL_REPLY_CORE, struct dfuse_il_reply))
 
@@ -76,4 +97,8 @@ struct dfuse_user_reply {
 #define DFUSE_IOCTL_DFUSE_USER                                                                     \
 	((int)_IOR(DFUSE_IOCTL_TYPE, DFUSE_IOCTL_R_DFUSE_USER, struct dfuse_user_reply))
 
+/* Return the depth and event counts of each event queue */
+#define DFUSE_IOCTL_EQ_STATS                                                                       \
+	((int)_IOR(DFUSE_IOCTL_TYPE, DFUSE_IOCTL_R_EQ_STATS, struct dfuse_eq_stats_reply))
+
 #endif /* __DFUSE_IOCTL_H__ */
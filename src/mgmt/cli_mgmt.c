@@ -163,6 +163,7 @@ fill_sys_info(Mgmt__GetAttachInfoResp *resp, struct dc_mgmt_sys_info *info)
 	info->crt_ctx_share_addr = hint->crt_ctx_share_addr;
 	info->crt_timeout = hint->crt_timeout;
 	info->srv_srx_set = hint->srv_srx_set;
+	info->data_version = resp->data_version;
 
 	/* Fill info->ms_ranks. */
 	if (resp->n_ms_ranks == 0) {
@@ -675,6 +676,72 @@ err:
 	return rc;
 }
 
+/*
+ * Optionally warm up the URI lookup cache of a freshly attached group, so the
+ * first RPC to each (rank, tag) does not need a separate URI lookup:
+ *  - DAOS_URI_CACHE=<path> loads the URIs saved by a previous process attached
+ *    to the same system version, and saves them again at detach time if the
+ *    cache changed;
+ *  - DAOS_URI_PREFETCH=1 asks a random rank for all the URIs it knows.
+ * Both are best effort, failures only cost the regular lookups.
+ */
+static void
+attach_uri_cache(struct dc_mgmt_sys *sys, Mgmt__GetAttachInfoResp *resp)
+{
+	char		*path;
+	bool		 prefetch = false;
+	d_rank_t	 rank;
+	d_rank_t	 rank_min = CRT_NO_RANK;
+	d_rank_t	 rank_max = 0;
+	int		 i;
+	int		 rc;
+
+	path = getenv("DAOS_URI_CACHE");
+	if (path != NULL && strlen(path) > 0) {
+		D_STRNDUP(sys->sy_uri_cache, path, PATH_MAX);
+		if (sys->sy_uri_cache != NULL) {
+			rc = crt_group_uri_cache_load(sys->sy_group, path,
+						      sys->sy_info.data_version);
+			D_DEBUG(DB_MGMT, "load URI cache %s: "DF_RC"\n", path,
+				DP_RC(rc));
+		}
+	}
+
+	d_getenv_bool("DAOS_URI_PREFETCH", &prefetch);
+	if (!prefetch || resp->n_rank_uris == 0)
+		return;
+
+	for (i = 0; i < resp->n_rank_uris; i++) {
+		rank = resp->rank_uris[i]->rank;
+		rank_min = min(rank_min, rank);
+		rank_max = max(rank_max, rank);
+	}
+
+	rank = resp->rank_uris[d_rand() % resp->n_rank_uris]->rank;
+	rc = crt_group_uri_prefetch(daos_get_crt_ctx(), sys->sy_group, rank,
+				    rank_min, rank_max - rank_min + 1, NULL,
+				    NULL);
+	if (rc != 0)
+		D_DEBUG(DB_MGMT, "URI prefetch from rank %u failed: "DF_RC"\n",
+			rank, DP_RC(rc));
+}
+
+static void
+detach_uri_cache(struct dc_mgmt_sys *sys)
+{
+	int rc;
+
+	if (sys->sy_uri_cache == NULL)
+		return;
+
+	rc = crt_group_uri_cache_save(sys->sy_group, sys->sy_uri_cache,
+				      sys->sy_info.data_version);
+	if (rc != 0)
+		D_WARN("failed to save URI cache %s: "DF_RC"\n",
+		       sys->sy_uri_cache, DP_RC(rc));
+	D_FREE(sys->sy_uri_cache);
+}
+
 static void
 detach_group(bool server, crt_group_t *group)
 {
@@ -726,6 +793,7 @@ attach(const char *name, struct dc_mgmt_sys **sysp)
 	if (rc != 0)
 		goto err_info;
 
+	attach_uri_cache(sys, resp);
 	free_get_attach_info_resp(resp);
 out:
 	*sysp = sys;
@@ -745,6 +813,7 @@ detach(struct dc_mgmt_sys *sys)
 	D_DEBUG(DB_MGMT, "detaching from system '%s'\n", sys->sy_name);
 	D_ASSERT(d_list_empty(&sys->sy_link));
 	D_ASSERTF(sys->sy_ref == 0, "%d\n", sys->sy_ref);
+	detach_uri_cache(sys);
 	detach_group(sys->sy_server, sys->sy_group);
 	if (!sys->sy_server)
 		put_attach_info(&sys->sy_info, NULL /* resp */);
@@ -1923,15 +1923,12 @@ obj_bulk_prep(d_sg_list_t *sgls, unsigned int nr, bool bulk_bind,
 	for (; sgls != NULL && i < nr; i++) {
 		if (sgls[i].sg_iovs != NULL &&
 		    sgls[i].sg_iovs[0].iov_buf != NULL) {
-			rc = crt_bulk_create(daos_task2ctx(task), &sgls[i],
-					     bulk_perm, &bulks[i]);
+			/* reuses registrations of daos_mem_register() buffers */
+			rc = crt_bulk_create_cached(daos_task2ctx(task),
+						    &sgls[i], bulk_perm,
+						    bulk_bind, &bulks[i]);
 			if (rc < 0)
 				D_GOTO(out, rc);
-			if (!bulk_bind)
-				continue;
-			rc = crt_bulk_bind(bulks[i], daos_task2ctx(task));
-			if (rc != 0)
-				D_GOTO(out, rc);
 		}
 	}
 
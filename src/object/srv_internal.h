@@ -97,6 +97,11 @@ struct migrate_pool_tls {
 	/* The new layout version for upgrade job */
 	uint32_t		mpt_new_layout_ver;
 
+	/* Throughput sampling window for the migrate metrics */
+	uint64_t		mpt_win_start;
+	uint64_t		mpt_win_bytes;
+	uint64_t		mpt_win_objs;
+
 	/* migrate leader ULT */
 	unsigned int		mpt_ult_running:1,
 				mpt_init_tls:1,
@@ -106,6 +111,12 @@ struct migrate_pool_tls {
 void
 migrate_pool_tls_destroy(struct migrate_pool_tls *tls);
 
+/** Inline threshold of the enumeration RPC issued by the migration puller */
+extern unsigned int migrate_enum_inline_thres;
+
+void
+migrate_tunables_init(void);
+
 /*
  * Report latency on a per-I/O size.
  * Buckets starts at [0; 256B[ and are increased by power of 2
@@ -134,6 +145,20 @@ struct obj_pool_metrics {
 	struct d_tm_node_t	*opm_update_ec_full;
 	/** Total number of EC partial update operations (type = counter) */
 	struct d_tm_node_t	*opm_update_ec_partial;
+	/** Total number of bytes pulled by migration (type = counter) */
+	struct d_tm_node_t	*opm_mig_bytes;
+	/** Total number of dkeys pulled by migration (type = counter) */
+	struct d_tm_node_t	*opm_mig_dkeys;
+	/** Total number of objects pulled by migration (type = counter) */
+	struct d_tm_node_t	*opm_mig_objs;
+	/** Migration bytes pulled per second (type = gauge) */
+	struct d_tm_node_t	*opm_mig_bw;
+	/** Migration objects pulled per second (type = gauge) */
+	struct d_tm_node_t	*opm_mig_obj_rate;
+	/** Migration bytes in flight (type = gauge) */
+	struct d_tm_node_t	*opm_mig_inflight;
+	/** Migration dkey ULTs queued or running (type = gauge) */
+	struct d_tm_node_t	*opm_mig_queue;
 };
 
 struct obj_tls {
@@ -37,6 +37,7 @@ obj_mod_init(void)
 		goto out_class;
 	}
 
+	migrate_tunables_init();
 	return 0;
 
 out_class:
@@ -210,6 +211,19 @@ struct dss_module_key obj_module_key = {
 	.dmk_fini = obj_tls_fini,
 };
 
+static inline uint64_t
+obj_rw_req_size(struct obj_rw_in *orw)
+{
+	daos_size_t	size;
+
+	size = daos_iods_len(orw->orw_iod_array.oia_iods, orw->orw_iod_array.oia_iod_nr);
+	/* Unknown size, e.g. fetch with DAOS_REC_ANY, it's charged after fetch */
+	if (size == (daos_size_t)-1)
+		return 0;
+
+	return size;
+}
+
 static int
 obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 {
@@ -218,11 +232,13 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 
 		sched_req_attr_init(attr, SCHED_REQ_UPDATE,
 				    &orw->orw_pool_uuid);
+		attr->sra_size = obj_rw_req_size(orw);
 	} else if (obj_rpc_is_fetch(rpc)) {
 		struct obj_rw_in	*orw = crt_req_get(rpc);
 
 		sched_req_attr_init(attr, SCHED_REQ_FETCH,
 				    &orw->orw_pool_uuid);
+		attr->sra_size = obj_rw_req_size(orw);
 	} else if (obj_rpc_is_migrate(rpc)) {
 		struct obj_migrate_in	*omi = crt_req_get(rpc);
 
@@ -320,6 +336,49 @@ obj_metrics_alloc(const char *path, int tgt_id)
 		D_WARN("Failed to create EC partial update counter: "DF_RC"\n",
 		       DP_RC(rc));
 
+	/** Migration (rebuild/reintegration) throughput and queue depth */
+	rc = d_tm_add_metric(&metrics->opm_mig_bytes, D_TM_COUNTER,
+			     "total number of bytes pulled by migration", "bytes",
+			     "%s/migrate/bytes/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate bytes counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_dkeys, D_TM_COUNTER,
+			     "total number of dkeys pulled by migration", "dkeys",
+			     "%s/migrate/dkeys/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate dkeys counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_objs, D_TM_COUNTER,
+			     "total number of objects pulled by migration", "objs",
+			     "%s/migrate/objs/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate objs counter: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_bw, D_TM_GAUGE,
+			     "migration bandwidth", "bytes/sec",
+			     "%s/migrate/bandwidth/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate bandwidth gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_obj_rate, D_TM_GAUGE,
+			     "migration object rate", "objs/sec",
+			     "%s/migrate/obj_rate/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate obj rate gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_inflight, D_TM_GAUGE,
+			     "migration bytes in flight", "bytes",
+			     "%s/migrate/inflight/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate inflight gauge: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->opm_mig_queue, D_TM_GAUGE,
+			     "migration dkeys queued or in progress", "dkeys",
+			     "%s/migrate/queue_depth/tgt_%u", path, tgt_id);
+	if (rc)
+		D_WARN("Failed to create migrate queue gauge: "DF_RC"\n", DP_RC(rc));
+
 	return metrics;
 }
 
@@ -157,6 +157,38 @@ obj_rw_complete(crt_rpc_t *rpc, struct obj_io_context *ioc,
 	return status;
 }
 
+/*
+ * The size of a fetch with DAOS_REC_ANY isn't known when it's scheduled, charge the
+ * pool bandwidth limit with the fetched size once the reply is ready.
+ */
+static void
+obj_fetch_charge(crt_rpc_t *rpc)
+{
+	struct obj_rw_in	*orw = crt_req_get(rpc);
+	struct obj_rw_out	*orwo = crt_reply_get(rpc);
+	daos_iod_t		*iods = orw->orw_iod_array.oia_iods;
+	uint32_t		 iod_nr = orw->orw_iod_array.oia_iod_nr;
+	daos_iod_t		 iod;
+	daos_size_t		 size = 0;
+	int			 i;
+
+	if (daos_iods_len(iods, iod_nr) != (daos_size_t)-1)
+		return;	/* charged on schedule, see obj_get_req_attr() */
+
+	if (orwo->orw_iod_sizes.ca_arrays == NULL || orwo->orw_iod_sizes.ca_count < iod_nr)
+		return;
+
+	for (i = 0; i < iod_nr; i++) {
+		iod = iods[i];
+		iod.iod_size = orwo->orw_iod_sizes.ca_arrays[i];
+		if (iod.iod_size == DAOS_REC_ANY)
+			continue;
+		size += daos_iods_len(&iod, 1);
+	}
+
+	sched_pool_io_charge(orw->orw_pool_uuid, SCHED_REQ_FETCH, size);
+}
+
 static void
 obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
 	     struct obj_io_context *ioc)
@@ -191,6 +223,9 @@ obj_rw_reply(crt_rpc_t *rpc, int status, uint64_t epoch,
 	}
 
 	if (obj_rpc_is_fetch(rpc)) {
+		if (status == 0)
+			obj_fetch_charge(rpc);
+
 		if (orwo->orw_iod_sizes.ca_arrays != NULL) {
 			D_FREE(orwo->orw_iod_sizes.ca_arrays);
 			orwo->orw_iod_sizes.ca_count = 0;
@@ -3199,6 +3234,13 @@ ds_obj_enum_handler(crt_rpc_t *rpc)
 
 	/* TODO: Transfer the inline_thres from enumerate RPC */
 	enum_arg.inline_thres = 32;
+	/* Return the small values inline to the migration puller, so it does not
+	 * need to issue one fetch RPC per dkey. EC migration always refetches to
+	 * recalculate the checksums, don't bother to inline for it.
+	 */
+	if (oei->oei_flags & ORF_FOR_MIGRATION && opc == DAOS_OBJ_RPC_ENUMERATE &&
+	    !daos_oclass_is_ec(&ioc.ioc_oca))
+		enum_arg.inline_thres = migrate_enum_inline_thres;
 
 	if (opc == DAOS_OBJ_RECX_RPC_ENUMERATE) {
 		oeo->oeo_eprs.ca_count = 0;
@@ -37,6 +37,17 @@
 #define MIGRATE_MAX_SIZE	(1 << 28)
 /* Max migrate ULT number on the server */
 #define MIGRATE_MAX_ULT		8192
+/* Default size of the buffer used to enumerate the object to be migrated */
+#define MIGRATE_ENUM_BUF_SIZE	(32 << 10)
+/* Sampling window of the migrate throughput metrics (ms) */
+#define MIGRATE_METRICS_WINDOW	1000
+
+/* Max inflight data size per xstream, DAOS_MIGRATE_INFLIGHT_MB */
+static uint64_t		migrate_inflight_max_size = MIGRATE_MAX_SIZE;
+/* Max migrate ULT number per xstream, DAOS_MIGRATE_MAX_ULT */
+static unsigned int	migrate_inflight_max_ult = MIGRATE_MAX_ULT;
+/* Enumeration buffer size of the puller, DAOS_MIGRATE_ENUM_BUF_KB */
+static unsigned int	migrate_enum_buf_size = MIGRATE_ENUM_BUF_SIZE;
 
 struct migrate_one {
 	daos_key_t		 mo_dkey;
@@ -455,8 +466,9 @@ migrate_pool_tls_create_one(void *data)
 	pool_tls->mpt_pool = ds_pool_child_lookup(arg->pool_uuid);
 	pool_tls->mpt_new_layout_ver = arg->new_layout_ver;
 	pool_tls->mpt_opc = arg->opc;
-	pool_tls->mpt_inflight_max_size = MIGRATE_MAX_SIZE;
-	pool_tls->mpt_inflight_max_ult = MIGRATE_MAX_ULT;
+	pool_tls->mpt_inflight_max_size = migrate_inflight_max_size;
+	pool_tls->mpt_inflight_max_ult = migrate_inflight_max_ult;
+	pool_tls->mpt_win_start = daos_getmtime_coarse();
 	pool_tls->mpt_inflight_size = 0;
 	pool_tls->mpt_refcount = 1;
 	if (arg->svc_list) {
@@ -716,6 +728,90 @@ migrate_csum_calc(struct daos_csummer *csummer, struct migrate_one *mrone, daos_
 #define MAX_BUF_SIZE		2048
 #define CSUM_BUF_SIZE		256
 
+/* Single values up to this size are returned inline by the enumeration, so
+ * the dkeys carrying them are migrated without a further fetch RPC, see
+ * migrate_fetch_update_inline(), DAOS_MIGRATE_INLINE_SIZE.
+ */
+#define MIGRATE_INLINE_SIZE	(MAX_BUF_SIZE / 2)
+#define MIGRATE_INLINE_MIN	32
+
+unsigned int migrate_enum_inline_thres = MIGRATE_INLINE_SIZE;
+
+void
+migrate_tunables_init(void)
+{
+	unsigned int	val;
+
+	val = migrate_inflight_max_size >> 20;
+	d_getenv_int("DAOS_MIGRATE_INFLIGHT_MB", &val);
+	if (val > 0)
+		migrate_inflight_max_size = (uint64_t)val << 20;
+
+	d_getenv_int("DAOS_MIGRATE_MAX_ULT", &migrate_inflight_max_ult);
+	if (migrate_inflight_max_ult == 0)
+		migrate_inflight_max_ult = MIGRATE_MAX_ULT;
+
+	val = migrate_enum_buf_size >> 10;
+	d_getenv_int("DAOS_MIGRATE_ENUM_BUF_KB", &val);
+	if (val > 0)
+		migrate_enum_buf_size = val << 10;
+
+	d_getenv_int("DAOS_MIGRATE_INLINE_SIZE", &migrate_enum_inline_thres);
+	if (migrate_enum_inline_thres < MIGRATE_INLINE_MIN)
+		migrate_enum_inline_thres = MIGRATE_INLINE_MIN;
+	else if (migrate_enum_inline_thres >= MAX_BUF_SIZE)
+		migrate_enum_inline_thres = MAX_BUF_SIZE - 1;
+
+	D_INFO("migrate inflight "DF_U64" MB, max ULTs %u, enum buffer %u KB, inline %u\n",
+	       migrate_inflight_max_size >> 20, migrate_inflight_max_ult,
+	       migrate_enum_buf_size >> 10, migrate_enum_inline_thres);
+}
+
+static struct obj_pool_metrics *
+migrate_metrics_get(struct migrate_pool_tls *tls)
+{
+	if (tls->mpt_pool == NULL)
+		return NULL;
+
+	return tls->mpt_pool->spc_metrics[DAOS_OBJ_MODULE];
+}
+
+/* Account migrated data and refresh the throughput/queue depth gauges */
+static void
+migrate_metrics_update(struct migrate_pool_tls *tls, uint64_t bytes, uint64_t dkeys,
+		       uint64_t objs)
+{
+	struct obj_pool_metrics	*opm = migrate_metrics_get(tls);
+	uint64_t		 now;
+	uint64_t		 elapsed;
+
+	if (opm == NULL)
+		return;
+
+	if (bytes > 0)
+		d_tm_inc_counter(opm->opm_mig_bytes, bytes);
+	if (dkeys > 0)
+		d_tm_inc_counter(opm->opm_mig_dkeys, dkeys);
+	if (objs > 0)
+		d_tm_inc_counter(opm->opm_mig_objs, objs);
+
+	d_tm_set_gauge(opm->opm_mig_inflight, tls->mpt_inflight_size);
+	d_tm_set_gauge(opm->opm_mig_queue, tls->mpt_generated_ult - tls->mpt_executed_ult);
+
+	tls->mpt_win_bytes += bytes;
+	tls->mpt_win_objs += objs;
+	now = daos_getmtime_coarse();
+	elapsed = now - tls->mpt_win_start;
+	if (elapsed < MIGRATE_METRICS_WINDOW)
+		return;
+
+	d_tm_set_gauge(opm->opm_mig_bw, tls->mpt_win_bytes * 1000 / elapsed);
+	d_tm_set_gauge(opm->opm_mig_obj_rate, tls->mpt_win_objs * 1000 / elapsed);
+	tls->mpt_win_start = now;
+	tls->mpt_win_bytes = 0;
+	tls->mpt_win_objs = 0;
+}
+
 /**
  * allocate the memory for the iods_csums and unpack the csum_iov into the
  * into the iods_csums.
@@ -1073,8 +1169,9 @@ migrate_fetch_update_single(struct migrate_one *mrone, daos_handle_t oh,
 	struct dcs_iod_csums	*iod_csums = NULL;
 	uint64_t		 update_flags = VOS_OF_REBUILD;
 	uint32_t		tgt_off = 0;
+	bool			 fetch = false;
 	int			 i;
-	int			 rc;
+	int			 rc = 0;
 
 	D_ASSERT(mrone->mo_iod_num <= OBJ_ENUM_UNPACK_MAX_IODS);
 	for (i = 0; i < mrone->mo_iod_num; i++) {
@@ -1082,6 +1179,17 @@ migrate_fetch_update_single(struct migrate_one *mrone, daos_handle_t oh,
 
 		size = daos_iods_len(&mrone->mo_iods[i], 1);
 		D_ASSERT(size != -1);
+		/* The value was returned inline by the enumeration, no need to
+		 * fetch it again, see migrate_enum_inline_thres.
+		 */
+		if (mrone->mo_sgls != NULL && mrone->mo_sgls[i].sg_nr > 0 &&
+		    mrone->mo_sgls[i].sg_iovs[0].iov_len == size &&
+		    !daos_oclass_is_ec(&mrone->mo_oca)) {
+			sgls[i] = mrone->mo_sgls[i];
+			continue;
+		}
+
+		fetch = true;
 		D_ALLOC(data, size);
 		if (data == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
@@ -1093,9 +1201,14 @@ migrate_fetch_update_single(struct migrate_one *mrone, daos_handle_t oh,
 	}
 
 	D_DEBUG(DB_REBUILD,
-		DF_UOID" mrone %p dkey "DF_KEY" nr %d eph "DF_U64"\n",
+		DF_UOID" mrone %p dkey "DF_KEY" nr %d eph "DF_U64" fetch %s\n",
 		DP_UOID(mrone->mo_oid), mrone, DP_KEY(&mrone->mo_dkey),
-		mrone->mo_iod_num, mrone->mo_epoch);
+		mrone->mo_iod_num, mrone->mo_epoch, fetch ? "yes" : "no");
+
+	if (!fetch) {
+		p_csum_iov = &mrone->mo_csum_iov;
+		D_GOTO(update, rc);
+	}
 
 	if (!daos_oclass_is_ec(&mrone->mo_oca)) {
 		rc = daos_iov_alloc(&csum_iov, CSUM_BUF_SIZE, false);
@@ -1186,6 +1299,7 @@ migrate_fetch_update_single(struct migrate_one *mrone, daos_handle_t oh,
 			DP_LAYOUT(los[i]));
 	}
 
+update:
 	csummer = dsc_cont2csummer(dc_obj_hdl2cont_hdl(oh));
 	rc = migrate_csum_calc(csummer, mrone, mrone->mo_iods, mrone->mo_iod_num, sgls,
 			       p_csum_iov, &iod_csums);
@@ -1696,8 +1810,10 @@ migrate_one_ult(void *arg)
 		D_GOTO(out, rc);
 
 	tls->mpt_inflight_size += data_size;
+	migrate_metrics_update(tls, 0, 0, 0);
 	rc = migrate_dkey(tls, mrone, data_size);
 	tls->mpt_inflight_size -= data_size;
+	migrate_metrics_update(tls, rc == 0 ? mrone->mo_size : 0, rc == 0 ? 1 : 0, 0);
 
 	ABT_mutex_lock(tls->mpt_inflight_mutex);
 	ABT_cond_broadcast(tls->mpt_inflight_cond);
@@ -2487,6 +2603,8 @@ put:
 
 #define KDS_NUM		96
 #define ITER_BUF_SIZE	2048
+/* Average enumeration buffer bytes consumed per key descriptor */
+#define ITER_KD_SIZE	32
 
 /**
  * Iterate akeys/dkeys of the object
@@ -2498,10 +2616,11 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 	daos_anchor_t		 anchor;
 	daos_anchor_t		 dkey_anchor;
 	daos_anchor_t		 akey_anchor;
-	char			 stack_buf[ITER_BUF_SIZE] = {0};
+	char			*enum_buf = NULL;
 	char			*buf = NULL;
 	daos_size_t		 buf_len;
-	daos_key_desc_t		 kds[KDS_NUM] = {0};
+	daos_key_desc_t		*kds = NULL;
+	uint32_t		 kds_nr;
 	d_iov_t			 csum = {0};
 	d_iov_t			 *p_csum;
 	uint8_t			 stack_csum_buf[CSUM_BUF_SIZE] = {0};
@@ -2570,17 +2689,27 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 	unpack_arg.oh = oh;
 	unpack_arg.version = tls->mpt_version;
 	D_INIT_LIST_HEAD(&unpack_arg.merge_list);
-	buf = stack_buf;
-	buf_len = ITER_BUF_SIZE;
 
 	dsc_cont_get_props(coh, &props);
 	rc = dsc_obj_id2oc_attr(arg->oid.id_pub, &props, &unpack_arg.oc_attr);
 	if (rc) {
 		D_ERROR("Unknown object class: %u\n",
 			daos_obj_id2class(arg->oid.id_pub));
-		D_GOTO(out_cont, rc);
+		D_GOTO(out_obj, rc);
 	}
 
+	/* Enumerate with a large buffer, so that many small dkeys, together with
+	 * their inline values, are pulled by a single RPC, while the dkeys of the
+	 * previous batch are still being written by migrate_one_ult().
+	 */
+	buf_len = max(migrate_enum_buf_size, ITER_BUF_SIZE);
+	kds_nr = max(buf_len / ITER_KD_SIZE, KDS_NUM);
+	D_ALLOC(enum_buf, buf_len);
+	D_ALLOC_ARRAY(kds, kds_nr);
+	if (enum_buf == NULL || kds == NULL)
+		D_GOTO(out_obj, rc = -DER_NOMEM);
+	buf = enum_buf;
+
 	if (daos_oclass_is_ec(&unpack_arg.oc_attr)) {
 		p_csum = NULL;
 		/* EC rotate needs to fetch from all shards */
@@ -2596,7 +2725,7 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 
 	while (!tls->mpt_fini) {
 		memset(buf, 0, buf_len);
-		memset(kds, 0, KDS_NUM * sizeof(*kds));
+		memset(kds, 0, kds_nr * sizeof(*kds));
 		iov.iov_len = 0;
 		iov.iov_buf = buf;
 		iov.iov_buf_len = buf_len;
@@ -2609,7 +2738,7 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 			p_csum->iov_len = 0;
 
 		daos_anchor_set_flags(&dkey_anchor, enum_flags);
-		num = KDS_NUM;
+		num = kds_nr;
 		rc = dsc_obj_list_obj(oh, epr, NULL, NULL, NULL,
 				     &num, kds, &sgl, &anchor,
 				     &dkey_anchor, &akey_anchor, p_csum);
@@ -2628,7 +2757,7 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 			else
 				buf_len = roundup(kds[0].kd_key_len * 2, 8);
 
-			if (buf != stack_buf)
+			if (buf != enum_buf)
 				D_FREE(buf);
 			D_ALLOC(buf, buf_len);
 			if (buf == NULL) {
@@ -2721,8 +2850,11 @@ migrate_one_epoch_object(daos_epoch_range_t *epr, struct migrate_pool_tls *tls,
 		enum_flags |= DIOF_TO_LEADER;
 	}
 
-	if (buf != NULL && buf != stack_buf)
+out_obj:
+	if (buf != NULL && buf != enum_buf)
 		D_FREE(buf);
+	D_FREE(enum_buf);
+	D_FREE(kds);
 
 	if (csum.iov_buf != NULL && csum.iov_buf != stack_csum_buf)
 		D_FREE(csum.iov_buf);
@@ -2841,6 +2973,31 @@ migrate_obj_punch(struct iter_obj_arg *arg)
  * Note that this ULT is guaranteed to only be spawned once per object per
  * container per migration session (using mpt_migrated_root)
  */
+/*
+ * Incremental reintegration keeps the stale data on the reintegrating target, drop
+ * the stale copy of the object before it is migrated again.
+ */
+static int
+migrate_obj_discard(struct migrate_pool_tls *tls, struct iter_obj_arg *arg)
+{
+	struct ds_cont_child	*cont_child = NULL;
+	daos_epoch_range_t	 epr;
+	int			 rc;
+
+	rc = migrate_get_cont_child(tls, arg->cont_uuid, &cont_child);
+	if (rc != 0 || cont_child == NULL)
+		return rc;
+
+	epr.epr_lo = 0;
+	epr.epr_hi = tls->mpt_max_eph;
+	rc = vos_discard(cont_child->sc_hdl, &arg->oid, &epr, NULL, NULL);
+	D_CDEBUG(rc == 0, DB_REBUILD, DLOG_ERR, DF_UUID" discard "DF_UOID" up to "DF_X64": "
+		 DF_RC"\n", DP_UUID(arg->cont_uuid), DP_UOID(arg->oid), epr.epr_hi, DP_RC(rc));
+
+	ds_cont_child_put(cont_child);
+	return rc;
+}
+
 static void
 migrate_obj_ult(void *data)
 {
@@ -2871,6 +3028,12 @@ migrate_obj_ult(void *data)
 			D_GOTO(free_notls, rc);
 	}
 
+	if (tls->mpt_opc == RB_OP_REINT && tls->mpt_pool->spc_pool->sp_incr_reint) {
+		rc = migrate_obj_discard(tls, arg);
+		if (rc)
+			D_GOTO(free, rc);
+	}
+
 	for (i = 0; i < arg->snap_cnt; i++) {
 		epr.epr_lo = i > 0 ? arg->snaps[i - 1] + 1 : 0;
 		epr.epr_hi = arg->snaps[i];
@@ -2898,8 +3061,10 @@ migrate_obj_ult(void *data)
 		arg->epoch = DAOS_EPOCH_MAX;
 	}
 free:
-	if (arg->epoch == DAOS_EPOCH_MAX)
+	if (arg->epoch == DAOS_EPOCH_MAX) {
 		tls->mpt_obj_count++;
+		migrate_metrics_update(tls, 0, 0, 1);
+	}
 
 	tls->mpt_obj_executed_ult++;
 	if (rc == -DER_NONEXIST) {
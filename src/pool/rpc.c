@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -321,6 +321,21 @@ pool_query_bits(daos_pool_info_t *po_info, daos_prop_t *prop)
 		case DAOS_PROP_PO_OBJ_VERSION:
 			bits |= DAOS_PO_QUERY_PROP_OBJ_VERSION;
 			break;
+		case DAOS_PROP_PO_QOS_CLASS:
+			bits |= DAOS_PO_QUERY_PROP_QOS_CLASS;
+			break;
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+			bits |= DAOS_PO_QUERY_PROP_READ_BW_LIMIT;
+			break;
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+			bits |= DAOS_PO_QUERY_PROP_WRITE_BW_LIMIT;
+			break;
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+			bits |= DAOS_PO_QUERY_PROP_READ_IOPS_LIMIT;
+			break;
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
+			bits |= DAOS_PO_QUERY_PROP_WRITE_IOPS_LIMIT;
+			break;
 		default:
 			D_ERROR("ignore bad dpt_type %d.\n", entry->dpe_type);
 			break;
@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -141,7 +141,7 @@
 	X(POOL_TGT_DISCARD,						\
 		0, &CQF_pool_tgt_discard,				\
 		ds_pool_tgt_discard_handler,				\
-		NULL)
+		&ds_pool_tgt_discard_co_ops)
 /* Define for RPC enum population below */
 #define X(a, b, c, d, e) a
 
@@ -497,7 +497,8 @@ CRT_RPC_DECLARE(pool_tgt_query_map, DAOS_ISEQ_POOL_TGT_QUERY_MAP,
 	((struct pool_target_addr) (ptdi_addrs)		CRT_ARRAY)
 
 #define DAOS_OSEQ_POOL_TGT_DISCARD /* output fields */		\
-	((int32_t)		(ptdo_rc)		CRT_VAR)
+	((int32_t)		(ptdo_rc)		CRT_VAR) \
+	((uint32_t)		(ptdo_full)		CRT_VAR)
 
 CRT_RPC_DECLARE(pool_tgt_discard, DAOS_ISEQ_POOL_TGT_DISCARD,
 		DAOS_OSEQ_POOL_TGT_DISCARD)
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -105,6 +105,11 @@ static struct crt_corpc_ops ds_pool_tgt_query_co_ops = {
 	.co_pre_forward	= NULL,
 };
 
+static struct crt_corpc_ops ds_pool_tgt_discard_co_ops = {
+	.co_aggregate	= ds_pool_tgt_discard_aggregator,
+	.co_pre_forward	= NULL,
+};
+
 /* Define for cont_rpcs[] array population below.
  * See POOL_PROTO_*_RPC_LIST macro definition
  */
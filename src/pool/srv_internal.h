@@ -28,6 +28,7 @@ struct pool_metrics {
 	struct d_tm_node_t	*query_total;
 	struct d_tm_node_t	*query_space_total;
 	struct d_tm_node_t	*evict_total;
+	struct d_tm_node_t	*open_to_ready;
 };
 
 /* Pool thread-local storage */
@@ -74,6 +75,11 @@ struct pool_iv_prop {
 	uint32_t	pip_upgrade_status;
 	uint64_t	pip_svc_redun_fac;
 	uint32_t	pip_obj_version;
+	uint32_t	pip_qos_class;
+	uint64_t	pip_read_bw_limit;
+	uint64_t	pip_write_bw_limit;
+	uint64_t	pip_read_iops_limit;
+	uint64_t	pip_write_iops_limit;
 	struct daos_acl	*pip_acl;
 	d_rank_list_t   pip_svc_list;
 	uint32_t	pip_acl_offset;
@@ -175,6 +181,7 @@ int ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop);
 int ds_pool_tgt_connect(struct ds_pool *pool, struct pool_iv_conn *pic);
 void ds_pool_tgt_query_map_handler(crt_rpc_t *rpc);
 void ds_pool_tgt_discard_handler(crt_rpc_t *rpc);
+int ds_pool_tgt_discard_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv);
 
 /*
  * srv_util.c
@@ -205,6 +205,21 @@ pool_iv_prop_l2g(daos_prop_t *prop, struct pool_iv_prop *iv_prop)
 		case DAOS_PROP_PO_SVC_REDUN_FAC:
 			iv_prop->pip_svc_redun_fac = prop_entry->dpe_val;
 			break;
+		case DAOS_PROP_PO_QOS_CLASS:
+			iv_prop->pip_qos_class = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+			iv_prop->pip_read_bw_limit = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+			iv_prop->pip_write_bw_limit = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+			iv_prop->pip_read_iops_limit = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
+			iv_prop->pip_write_iops_limit = prop_entry->dpe_val;
+			break;
 		default:
 			D_ASSERTF(0, "bad dpe_type %d\n", prop_entry->dpe_type);
 			break;
@@ -339,6 +354,21 @@ pool_iv_prop_g2l(struct pool_iv_prop *iv_prop, daos_prop_t *prop)
 		case DAOS_PROP_PO_SVC_REDUN_FAC:
 			prop_entry->dpe_val = iv_prop->pip_svc_redun_fac;
 			break;
+		case DAOS_PROP_PO_QOS_CLASS:
+			prop_entry->dpe_val = iv_prop->pip_qos_class;
+			break;
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+			prop_entry->dpe_val = iv_prop->pip_read_bw_limit;
+			break;
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+			prop_entry->dpe_val = iv_prop->pip_write_bw_limit;
+			break;
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+			prop_entry->dpe_val = iv_prop->pip_read_iops_limit;
+			break;
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
+			prop_entry->dpe_val = iv_prop->pip_write_iops_limit;
+			break;
 		default:
 			D_ASSERTF(0, "bad dpe_type %d\n", prop_entry->dpe_type);
 			break;
@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2017-2022 Intel Corporation.
+ * (C) Copyright 2017-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -43,6 +43,11 @@ RDB_STRING_KEY(ds_pool_prop_, scrub_freq);
 RDB_STRING_KEY(ds_pool_prop_, scrub_thresh);
 RDB_STRING_KEY(ds_pool_prop_, svc_redun_fac);
 RDB_STRING_KEY(ds_pool_prop_, obj_version);
+RDB_STRING_KEY(ds_pool_prop_, qos_class);
+RDB_STRING_KEY(ds_pool_prop_, read_bw_limit);
+RDB_STRING_KEY(ds_pool_prop_, write_bw_limit);
+RDB_STRING_KEY(ds_pool_prop_, read_iops_limit);
+RDB_STRING_KEY(ds_pool_prop_, write_iops_limit);
 
 /** default properties, should cover all optional pool properties */
 struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
@@ -108,6 +113,21 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_PO_OBJ_VERSION,
 		.dpe_val	= DS_POOL_OBJ_VERSION,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_QOS_CLASS,
+		.dpe_val	= DAOS_PROP_PO_QOS_CLASS_DEFAULT,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_READ_BW_LIMIT,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_WRITE_BW_LIMIT,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_READ_IOPS_LIMIT,
+		.dpe_val	= 0,
+	}, {
+		.dpe_type	= DAOS_PROP_PO_WRITE_IOPS_LIMIT,
+		.dpe_val	= 0,
 	},
 };
 
@@ -1,5 +1,5 @@
 /*
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -73,6 +73,11 @@ extern d_iov_t ds_pool_prop_scrub_freq;		/* uint64_t */
 extern d_iov_t ds_pool_prop_scrub_thresh;	/* uint64_t */
 extern d_iov_t ds_pool_prop_svc_redun_fac;	/* uint64_t */
 extern d_iov_t ds_pool_prop_obj_version;	/* uint32_t */
+extern d_iov_t ds_pool_prop_qos_class;		/* uint64_t */
+extern d_iov_t ds_pool_prop_read_bw_limit;	/* uint64_t */
+extern d_iov_t ds_pool_prop_write_bw_limit;	/* uint64_t */
+extern d_iov_t ds_pool_prop_read_iops_limit;	/* uint64_t */
+extern d_iov_t ds_pool_prop_write_iops_limit;	/* uint64_t */
 /* Please read the IMPORTANT notes above before adding new keys. */
 
 /*
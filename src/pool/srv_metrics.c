@@ -80,6 +80,12 @@ ds_pool_metrics_alloc(const char *path, int tgt_id)
 	if (rc != 0)
 		D_WARN("Failed to create pool query space counter: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->open_to_ready, D_TM_GAUGE,
+			     "Time to open the pool and start its containers on all targets", "ms",
+			     "%s/open_to_ready", path);
+	if (rc != 0)
+		D_WARN("Failed to create pool open to ready gauge: "DF_RC"\n", DP_RC(rc));
+
 	return metrics;
 }
 
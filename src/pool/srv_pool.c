@@ -333,6 +333,11 @@ pool_prop_default_copy(daos_prop_t *prop_def, daos_prop_t *prop)
 		case DAOS_PROP_PO_EC_PDA:
 		case DAOS_PROP_PO_RP_PDA:
 		case DAOS_PROP_PO_SVC_REDUN_FAC:
+		case DAOS_PROP_PO_QOS_CLASS:
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
 		case DAOS_PROP_PO_POLICY:
@@ -590,6 +595,26 @@ pool_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop)
 			d_iov_set(&value, &val32, sizeof(val32));
 			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_obj_version, &value);
 			break;
+		case DAOS_PROP_PO_QOS_CLASS:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_class, &value);
+			break;
+		case DAOS_PROP_PO_READ_BW_LIMIT:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_read_bw_limit, &value);
+			break;
+		case DAOS_PROP_PO_WRITE_BW_LIMIT:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_write_bw_limit, &value);
+			break;
+		case DAOS_PROP_PO_READ_IOPS_LIMIT:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_read_iops_limit, &value);
+			break;
+		case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_write_iops_limit, &value);
+			break;
 		default:
 			D_ERROR("bad dpe_type %d.\n", entry->dpe_type);
 			return -DER_INVAL;
@@ -2429,6 +2454,86 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		idx++;
 	}
 
+	if (bits & DAOS_PO_QUERY_PROP_QOS_CLASS) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_qos_class, &value);
+		if (rc == -DER_NONEXIST) { /* pool created before the property */
+			rc = 0;
+			val = DAOS_PROP_PO_QOS_CLASS_DEFAULT;
+			prop->dpp_entries[idx].dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+		} else if (rc != 0) {
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_QOS_CLASS;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_READ_BW_LIMIT) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_read_bw_limit, &value);
+		if (rc == -DER_NONEXIST) { /* pool created before the property */
+			rc = 0;
+			val = 0;
+			prop->dpp_entries[idx].dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+		} else if (rc != 0) {
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_READ_BW_LIMIT;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_WRITE_BW_LIMIT) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_write_bw_limit, &value);
+		if (rc == -DER_NONEXIST) { /* pool created before the property */
+			rc = 0;
+			val = 0;
+			prop->dpp_entries[idx].dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+		} else if (rc != 0) {
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_WRITE_BW_LIMIT;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_READ_IOPS_LIMIT) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_read_iops_limit, &value);
+		if (rc == -DER_NONEXIST) { /* pool created before the property */
+			rc = 0;
+			val = 0;
+			prop->dpp_entries[idx].dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+		} else if (rc != 0) {
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_READ_IOPS_LIMIT;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_WRITE_IOPS_LIMIT) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_write_iops_limit, &value);
+		if (rc == -DER_NONEXIST) { /* pool created before the property */
+			rc = 0;
+			val = 0;
+			prop->dpp_entries[idx].dpe_flags |= DAOS_PROP_ENTRY_NOT_SET;
+		} else if (rc != 0) {
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_WRITE_IOPS_LIMIT;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+
 	*prop_out = prop;
 	return 0;
 
@@ -3701,6 +3806,11 @@ ds_pool_query_handler(crt_rpc_t *rpc, int version)
 			case DAOS_PROP_PO_SCRUB_THRESH:
 			case DAOS_PROP_PO_SVC_REDUN_FAC:
 			case DAOS_PROP_PO_OBJ_VERSION:
+			case DAOS_PROP_PO_QOS_CLASS:
+			case DAOS_PROP_PO_READ_BW_LIMIT:
+			case DAOS_PROP_PO_WRITE_BW_LIMIT:
+			case DAOS_PROP_PO_READ_IOPS_LIMIT:
+			case DAOS_PROP_PO_WRITE_IOPS_LIMIT:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
@@ -4716,6 +4826,31 @@ pool_upgrade_props(struct rdb_tx *tx, struct pool_svc *svc,
 	if (rc != 0)
 		D_GOTO(out_free, rc);
 
+	rc = pool_upgrade_one_prop_int(tx, svc, pool_uuid, &need_commit, "QoS class",
+				       &ds_pool_prop_qos_class, DAOS_PROP_PO_QOS_CLASS_DEFAULT);
+	if (rc != 0)
+		D_GOTO(out_free, rc);
+
+	rc = pool_upgrade_one_prop_int(tx, svc, pool_uuid, &need_commit, "read bandwidth limit",
+				       &ds_pool_prop_read_bw_limit, 0);
+	if (rc != 0)
+		D_GOTO(out_free, rc);
+
+	rc = pool_upgrade_one_prop_int(tx, svc, pool_uuid, &need_commit, "write bandwidth limit",
+				       &ds_pool_prop_write_bw_limit, 0);
+	if (rc != 0)
+		D_GOTO(out_free, rc);
+
+	rc = pool_upgrade_one_prop_int(tx, svc, pool_uuid, &need_commit, "read IOPS limit",
+				       &ds_pool_prop_read_iops_limit, 0);
+	if (rc != 0)
+		D_GOTO(out_free, rc);
+
+	rc = pool_upgrade_one_prop_int(tx, svc, pool_uuid, &need_commit, "write IOPS limit",
+				       &ds_pool_prop_write_iops_limit, 0);
+	if (rc != 0)
+		D_GOTO(out_free, rc);
+
 	d_iov_set(&value, &val32, sizeof(val32));
 	rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_upgrade_status, &value);
 	if (rc && rc != -DER_NONEXIST) {
@@ -6198,11 +6333,25 @@ pool_discard(crt_context_t ctx, struct pool_svc *svc, struct pool_target_addr_li
 
 	ptdi_out = crt_reply_get(rpc);
 	D_ASSERT(ptdi_out != NULL);
-	rc = ptdi_out->ptdo_rc;
+	if (rc == 0)
+		rc = ptdi_out->ptdo_rc;
 	if (rc != 0)
 		D_ERROR(DF_UUID": pool discard failed: rc: %d\n",
 			DP_UUID(svc->ps_pool->sp_uuid), rc);
 
+	/* The rebuild scan only goes incremental if every reintegrating target kept its
+	 * data, see rebuild_scan_broadcast().
+	 */
+	if (dss_incr_reint) {
+		if (rc == 0 && ptdi_out->ptdo_full == 0) {
+			svc->ps_pool->sp_reint_incr = 1;
+		} else {
+			D_INFO(DF_UUID": %u engines lost data, full reintegration\n",
+			       DP_UUID(svc->ps_pool->sp_uuid), ptdi_out->ptdo_full);
+			svc->ps_pool->sp_reint_full = 1;
+		}
+	}
+
 	crt_req_decref(rpc);
 
 out:
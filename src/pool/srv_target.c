@@ -33,6 +33,7 @@
 #include <daos_srv/container.h>
 #include <daos_srv/daos_mgmt_srv.h>
 #include <daos_srv/vos.h>
+#include <daos_srv/smd.h>
 #include <daos_srv/rebuild.h>
 #include <daos_srv/srv_csum.h>
 #include "rpc.h"
@@ -130,13 +131,14 @@ gc_rate_ctl(void *arg)
 	/* Let GC ULT run in tight mode when system is idle */
 	if (!dss_xstream_is_busy()) {
 		sched_req_yield(req);
-		return 0;
+		return VOS_GC_YIELD_IDLE;
 	}
 
 	/*
-	 * When it's under space pressure, GC will continue run in slack mode
-	 * no matter what reclaim policy is used, otherwise, it'll take an extra
-	 * sleep to minimize the performance impact.
+	 * When it's under space pressure, GC will continue run and VOS sizes
+	 * its batches for reclaim no matter what reclaim policy is used,
+	 * otherwise, it'll take an extra sleep to minimize the performance
+	 * impact.
 	 */
 	if (sched_req_space_check(req) == SCHED_SPACE_PRESS_NONE) {
 		uint32_t msecs;
@@ -146,10 +148,11 @@ gc_rate_ctl(void *arg)
 		sched_req_sleep(req, msecs);
 	} else {
 		sched_req_yield(req);
+		return VOS_GC_YIELD_PRESSURE;
 	}
 
 	/* Let GC ULT run in slack mode when system is busy */
-	return 1;
+	return VOS_GC_YIELD_BUSY;
 }
 
 static void
@@ -327,6 +330,8 @@ pool_child_add_one(void *varg)
 
 	uuid_copy(child->spc_uuid, arg->pla_uuid);
 	child->spc_map_version = arg->pla_map_version;
+	/* Changes made before the child was started are unknown */
+	child->spc_dirty_invalid = 1;
 	child->spc_ref = 1; /* 1 for the list */
 
 	rc = ABT_eventual_create(sizeof(child->spc_ref),
@@ -437,8 +442,11 @@ pool_alloc_ref(void *key, unsigned int ksize, void *varg,
 	struct ds_pool_create_arg      *arg = varg;
 	struct ds_pool		       *pool;
 	struct pool_child_lookup_arg	collective_arg;
+	struct pool_metrics	       *metrics;
 	char				group_id[DAOS_UUID_STR_SIZE];
 	struct dss_module_info	       *info = dss_get_module_info();
+	uint64_t			start;
+	uint64_t			open_ms;
 	unsigned int			iv_ns_id;
 	int				rc;
 	int				rc_tmp;
@@ -506,6 +514,7 @@ pool_alloc_ref(void *key, unsigned int ksize, void *varg,
 	collective_arg.pla_pool = pool;
 	collective_arg.pla_uuid = key;
 	collective_arg.pla_map_version = arg->pca_map_version;
+	start = daos_get_ntime();
 	rc = dss_thread_collective(pool_child_add_one, &collective_arg, 0);
 	if (rc != 0) {
 		D_ERROR(DF_UUID": failed to add ES pool caches: "DF_RC"\n",
@@ -513,6 +522,13 @@ pool_alloc_ref(void *key, unsigned int ksize, void *varg,
 		goto err_iv_ns;
 	}
 
+	/* Targets open the pool in parallel, DTX re-index goes on in background */
+	open_ms = (daos_get_ntime() - start) / NSEC_PER_MSEC;
+	metrics = pool->sp_metrics[DAOS_POOL_MODULE];
+	d_tm_set_gauge(metrics->open_to_ready, open_ms);
+	D_DEBUG(DB_MGMT, DF_UUID": opened on all targets in "DF_U64" ms\n", DP_UUID(key),
+		open_ms);
+
 	*link = &pool->sp_entry;
 	return 0;
 
@@ -1391,6 +1407,100 @@ update_pool_group(struct ds_pool *pool, struct pool_map *map)
  * Called via dss_collective() to update the pool map version in the
  * ds_pool_child object.
  */
+/* Any target which is not UPIN has missed, or is catching up with, some updates */
+static bool
+pool_map_degraded(struct pool_map *map)
+{
+	unsigned int	tgt_cnt = 0;
+
+	pool_map_find_tgts_by_state(map, PO_COMP_ST_DOWN | PO_COMP_ST_DOWNOUT | PO_COMP_ST_UP,
+				    NULL, &tgt_cnt);
+	return tgt_cnt > 0;
+}
+
+/*
+ * Objects modified while the pool is degraded are recorded in the VOS dirty object log,
+ * so that reintegration only has to migrate these objects, see rebuild_scanner().
+ */
+static void
+update_child_dirty_track(struct ds_pool *pool, struct ds_pool_child *child)
+{
+	int	rc;
+
+	if (!pool->sp_map_degraded) {
+		/* All targets are UPIN again, nothing to reintegrate */
+		vos_pool_dirty_track(child->spc_hdl, 0);
+		child->spc_dirty_invalid = 0;
+		return;
+	}
+
+	/* Disabled while degraded, the log would miss changes if enabled later on */
+	if (!dss_incr_reint) {
+		child->spc_dirty_invalid = 1;
+		return;
+	}
+
+	if (child->spc_dirty_invalid)
+		return;
+
+	rc = vos_pool_dirty_track(child->spc_hdl, d_hlc_get());
+	if (rc != 0) {
+		D_WARN(DF_UUID": failed to track dirty objects, full scan on reintegration: "
+		       DF_RC"\n", DP_UUID(pool->sp_uuid), DP_RC(rc));
+		child->spc_dirty_invalid = 1;
+	}
+}
+
+/* Identity of the storage backing the pool child, a replaced NVMe device gets new blobs */
+static int
+pool_child_stamp(struct ds_pool_child *child, uint64_t *stamp)
+{
+	uint64_t	blob_id = 0;
+	int		rc;
+
+	rc = smd_pool_get_blob(child->spc_uuid, dss_get_module_info()->dmi_tgt_id, &blob_id);
+	if (rc == -DER_NONEXIST)
+		rc = 0;	/* SCM only pool */
+	if (rc != 0)
+		return rc;
+
+	*stamp = blob_id != 0 ? blob_id : 1;
+	return 0;
+}
+
+/*
+ * Stamp the VOS pool once the target is UPIN, a reintegrating target only keeps its data if
+ * the stamp is still there and matches, see pool_child_reint_check().
+ */
+static void
+update_child_stamp(struct ds_pool *pool, struct ds_pool_child *child)
+{
+	struct pool_target	*tgt;
+	uint64_t		 stamp;
+	int			 rc;
+
+	rc = pool_map_find_target_by_rank_idx(pool->sp_map, dss_self_rank(),
+					      dss_get_module_info()->dmi_tgt_id, &tgt);
+	if (rc != 1 || tgt->ta_comp.co_status != PO_COMP_ST_UPIN) {
+		/* Stamp again once back in, the NVMe device might have been replaced */
+		child->spc_stamped = 0;
+		return;
+	}
+
+	if (child->spc_stamped)
+		return;
+
+	rc = pool_child_stamp(child, &stamp);
+	if (rc == 0)
+		rc = vos_pool_stamp_set(child->spc_hdl, stamp);
+	if (rc != 0) {
+		D_WARN(DF_UUID": failed to stamp pool, full reintegration: "DF_RC"\n",
+		       DP_UUID(pool->sp_uuid), DP_RC(rc));
+		return;
+	}
+	child->spc_stamped = 1;
+}
+
 static int
 update_child_map(void *data)
 {
@@ -1402,6 +1512,11 @@ update_child_map(void *data)
 		return -DER_NONEXIST;
 
 	child->spc_map_version = pool->sp_map_version;
+	/* Also done when disabled, so that incremental reintegration can be enabled at runtime */
+	if (pool->sp_map != NULL) {
+		update_child_dirty_track(pool, child);
+		update_child_stamp(pool, child);
+	}
 	ds_pool_child_put(child);
 	return 0;
 }
@@ -1473,6 +1588,11 @@ ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
 			map_version);
 
 		pool->sp_map_version = map_version;
+		if (pool->sp_map != NULL) {
+			pool->sp_map_degraded = pool_map_degraded(pool->sp_map);
+			if (!pool->sp_map_degraded)
+				pool->sp_incr_reint = 0;
+		}
 		rc = dss_task_collective(update_child_map, pool, 0);
 		D_ASSERT(rc == 0);
 		update_map = true;
@@ -1560,12 +1680,22 @@ update_vos_prop_on_targets(void *in)
 	struct ds_pool			*pool = (struct ds_pool *)in;
 	struct ds_pool_child		*child = NULL;
 	struct policy_desc_t		policy_desc = {0};
+	struct sched_pool_prop		sched_prop = {0};
 	int                              ret         = 0;
 
 	child = ds_pool_child_lookup(pool->sp_uuid);
 	if (child == NULL)
 		return -DER_NONEXIST;	/* no child created yet? */
 
+	sched_prop.spp_qos_class = pool->sp_qos_class;
+	sched_prop.spp_read_bw = pool->sp_read_bw_limit;
+	sched_prop.spp_write_bw = pool->sp_write_bw_limit;
+	sched_prop.spp_read_iops = pool->sp_read_iops_limit;
+	sched_prop.spp_write_iops = pool->sp_write_iops_limit;
+	ret = sched_pool_prop_set(pool->sp_uuid, &sched_prop);
+	if (ret)
+		goto out;
+
 	policy_desc = pool->sp_policy_desc;
 	ret = vos_pool_ctl(child->spc_hdl, VOS_PO_CTL_SET_POLICY, &policy_desc);
 	if (ret)
@@ -1599,6 +1729,11 @@ ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
 	pool->sp_ec_pda = iv_prop->pip_ec_pda;
 	pool->sp_rp_pda = iv_prop->pip_rp_pda;
 	pool->sp_space_rb = iv_prop->pip_space_rb;
+	pool->sp_qos_class = iv_prop->pip_qos_class;
+	pool->sp_read_bw_limit = iv_prop->pip_read_bw_limit;
+	pool->sp_write_bw_limit = iv_prop->pip_write_bw_limit;
+	pool->sp_read_iops_limit = iv_prop->pip_read_iops_limit;
+	pool->sp_write_iops_limit = iv_prop->pip_write_iops_limit;
 
 	if (iv_prop->pip_self_heal & DAOS_SELF_HEAL_AUTO_REBUILD)
 		pool->sp_disable_rebuild = 0;
@@ -1715,6 +1850,12 @@ struct tgt_discard_arg {
 	uuid_t			     pool_uuid;
 	uint64_t		     epoch;
 	struct pool_target_addr_list tgt_list;
+	/* State of the targets to discard */
+	unsigned int		     tgt_state;
+	/* Containers found on the targets by pool_child_reint_check() */
+	ABT_mutex		     conts_lock;
+	uuid_t			    *conts;
+	int			     conts_nr;
 };
 
 struct child_discard_arg {
@@ -1733,11 +1874,19 @@ tgt_discard_arg_alloc(struct pool_target_addr_list *tgt_list)
 	if (arg == NULL)
 		return NULL;
 
+	rc = ABT_mutex_create(&arg->conts_lock);
+	if (rc != ABT_SUCCESS) {
+		D_FREE(arg);
+		return NULL;
+	}
+
 	rc = pool_target_addr_list_alloc(tgt_list->pta_number, &arg->tgt_list);
 	if (rc != 0) {
+		ABT_mutex_free(&arg->conts_lock);
 		D_FREE(arg);
 		return NULL;
 	}
+	arg->tgt_state = PO_COMP_ST_DOWNOUT;
 
 	for (i = 0; i < tgt_list->pta_number; i++) {
 		arg->tgt_list.pta_addrs[i].pta_rank = tgt_list->pta_addrs[i].pta_rank;
@@ -1751,6 +1900,8 @@ static void
 tgt_discard_arg_free(struct tgt_discard_arg *arg)
 {
 	pool_target_addr_list_free(&arg->tgt_list);
+	ABT_mutex_free(&arg->conts_lock);
+	D_FREE(arg->conts);
 	D_FREE(arg);
 }
 
@@ -1891,11 +2042,12 @@ ds_pool_tgt_discard_ult(void *data)
 	if (pool->sp_map != NULL) {
 		unsigned int status;
 
-		/* It should only discard the target in DOWNOUT state, and skip
-		 * targets in other state.
+		/* It should only discard the target in DOWNOUT state (or UP, see
+		 * ds_pool_tgt_reint_discard()), and skip targets in other state.
 		 */
 		status = PO_COMP_ST_UP | PO_COMP_ST_UPIN | PO_COMP_ST_DRAIN |
-			 PO_COMP_ST_DOWN | PO_COMP_ST_NEW;
+			 PO_COMP_ST_DOWN | PO_COMP_ST_NEW | PO_COMP_ST_DOWNOUT;
+		status &= ~arg->tgt_state;
 		rc = ds_pool_get_tgt_idx_by_state(arg->pool_uuid, status,
 						  &coll_args.ca_exclude_tgts,
 						  &coll_args.ca_exclude_tgts_cnt);
@@ -1918,6 +2070,209 @@ free:
 	tgt_discard_arg_free(arg);
 }
 
+struct cont_collect_arg {
+	uuid_t	*conts;
+	int	 conts_nr;
+};
+
+static int
+cont_collect_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+		vos_iter_param_t *iter_param, void *cb_arg, unsigned int *acts)
+{
+	struct cont_collect_arg	*arg = cb_arg;
+	uuid_t			*conts;
+
+	D_REALLOC_ARRAY(conts, arg->conts, arg->conts_nr, arg->conts_nr + 1);
+	if (conts == NULL)
+		return -DER_NOMEM;
+
+	uuid_copy(conts[arg->conts_nr++], entry->ie_couuid);
+	arg->conts = conts;
+	return 0;
+}
+
+/* Merge the containers of one target into the list of the engine */
+static int
+cont_collect_merge(struct tgt_discard_arg *arg, struct cont_collect_arg *local)
+{
+	uuid_t	*conts;
+	int	 i;
+	int	 j;
+	int	 rc = 0;
+
+	ABT_mutex_lock(arg->conts_lock);
+	for (i = 0; i < local->conts_nr; i++) {
+		for (j = 0; j < arg->conts_nr; j++) {
+			if (uuid_compare(arg->conts[j], local->conts[i]) == 0)
+				break;
+		}
+		if (j < arg->conts_nr)
+			continue;
+
+		D_REALLOC_ARRAY(conts, arg->conts, arg->conts_nr, arg->conts_nr + 1);
+		if (conts == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+
+		uuid_copy(conts[arg->conts_nr++], local->conts[i]);
+		arg->conts = conts;
+	}
+out:
+	ABT_mutex_unlock(arg->conts_lock);
+	return rc;
+}
+
+/*
+ * Called via dss_thread_collective() on a reintegrating engine to check that each
+ * reintegrating target still holds the data it had when it was last UPIN, i.e. its VOS pool
+ * was not recreated and the NVMe device was not replaced since. Also collect the containers
+ * on the targets, some of them might have been destroyed while the targets were out.
+ */
+static int
+pool_child_reint_check(void *data)
+{
+	struct tgt_discard_arg	*arg = data;
+	struct cont_collect_arg	 local = { 0 };
+	struct ds_pool_child	*child;
+	vos_iter_param_t	 param = { 0 };
+	struct vos_iter_anchors	 anchor = { 0 };
+	struct pool_target_addr	 addr;
+	uint64_t		 stamp = 0;
+	uint64_t		 expected = 0;
+	int			 rc;
+
+	addr.pta_rank = dss_self_rank();
+	addr.pta_target = dss_get_module_info()->dmi_tgt_id;
+	if (!pool_target_addr_found(&arg->tgt_list, &addr))
+		return 0;
+
+	child = ds_pool_child_lookup(arg->pool_uuid);
+	if (child == NULL)
+		return -DER_DATA_LOSS;
+
+	rc = vos_pool_stamp_get(child->spc_hdl, &stamp);
+	if (rc == 0)
+		rc = pool_child_stamp(child, &expected);
+	if (rc != 0)
+		goto out;
+
+	if (stamp == 0 || stamp != expected || DAOS_FAIL_CHECK(DAOS_REBUILD_REINT_DATA_LOST)) {
+		D_INFO(DF_UUID"/%u: stamp "DF_X64" does not match "DF_X64"\n",
+		       DP_UUID(arg->pool_uuid), addr.pta_target, stamp, expected);
+		D_GOTO(out, rc = -DER_DATA_LOSS);
+	}
+
+	param.ip_hdl = child->spc_hdl;
+	rc = vos_iterate(&param, VOS_ITER_COUUID, false, &anchor, cont_collect_cb, NULL, &local,
+			 NULL);
+	if (rc == 0)
+		rc = cont_collect_merge(arg, &local);
+out:
+	D_FREE(local.conts);
+	ds_pool_child_put(child);
+	return rc;
+}
+
+/* Destroy the containers that were destroyed while the reintegrating targets were out */
+static void
+tgt_reint_cont_cleanup_ult(void *data)
+{
+	struct tgt_discard_arg	*arg = data;
+	daos_prop_t		*prop;
+	int			 i;
+	int			 rc;
+
+	prop = daos_prop_alloc(1);
+	if (prop == NULL)
+		goto out;
+	prop->dpp_entries[0].dpe_type = DAOS_PROP_CO_REDUN_FAC;
+
+	for (i = 0; i < arg->conts_nr; i++) {
+		rc = ds_cont_fetch_prop(arg->pool_uuid, arg->conts[i], prop);
+		if (rc != -DER_NONEXIST)
+			continue;
+
+		D_INFO(DF_CONT": destroyed while the targets were out\n",
+		       DP_CONT(arg->pool_uuid, arg->conts[i]));
+		rc = ds_cont_tgt_destroy(arg->pool_uuid, arg->conts[i]);
+		if (rc != 0)
+			D_ERROR(DF_CONT": destroy failed: "DF_RC"\n",
+				DP_CONT(arg->pool_uuid, arg->conts[i]), DP_RC(rc));
+	}
+	daos_prop_free(prop);
+out:
+	tgt_discard_arg_free(arg);
+}
+
+/*
+ * The rebuild leader did not accept the incremental reintegration this engine was prepared
+ * for, e.g. another reintegrating target lost its data or the leader changed. Discard the
+ * reintegrating (UP) targets of this engine before the full reintegration migrates to them.
+ */
+int
+ds_pool_tgt_reint_discard(struct ds_pool *pool)
+{
+	struct pool_target_addr_list	 list = { 0 };
+	struct tgt_discard_arg		*arg = NULL;
+	int				*tgts = NULL;
+	unsigned int			 tgts_cnt = 0;
+	int				 i;
+	int				 rc;
+
+	if (!pool->sp_incr_reint)
+		return 0;
+
+	rc = ds_pool_get_tgt_idx_by_state(pool->sp_uuid, PO_COMP_ST_UP, &tgts, &tgts_cnt);
+	if (rc != 0 || tgts_cnt == 0)
+		goto out;
+
+	rc = pool_target_addr_list_alloc(tgts_cnt, &list);
+	if (rc != 0)
+		goto out;
+
+	for (i = 0; i < tgts_cnt; i++) {
+		list.pta_addrs[i].pta_rank = dss_self_rank();
+		list.pta_addrs[i].pta_target = tgts[i];
+	}
+
+	arg = tgt_discard_arg_alloc(&list);
+	pool_target_addr_list_free(&list);
+	if (arg == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	/* The targets are UP and might take new writes already, everything up to now is
+	 * migrated again since the rebuild stable epoch can only be later.
+	 */
+	uuid_copy(arg->pool_uuid, pool->sp_uuid);
+	arg->epoch = d_hlc_get();
+	arg->tgt_state = PO_COMP_ST_UP;
+
+	D_INFO(DF_UUID": incremental reintegration refused, discard %u targets\n",
+	       DP_UUID(pool->sp_uuid), tgts_cnt);
+	pool->sp_need_discard = 1;
+	rc = dss_ult_create(ds_pool_tgt_discard_ult, arg, DSS_XS_SYS, 0, 0, NULL);
+	if (rc != 0) {
+		pool->sp_need_discard = 0;
+		tgt_discard_arg_free(arg);
+	}
+out:
+	if (rc == 0)
+		pool->sp_incr_reint = 0;
+	D_FREE(tgts);
+	return rc;
+}
+
+int
+ds_pool_tgt_discard_aggregator(crt_rpc_t *source, crt_rpc_t *result, void *priv)
+{
+	struct pool_tgt_discard_out	*out_source = crt_reply_get(source);
+	struct pool_tgt_discard_out	*out_result = crt_reply_get(result);
+
+	if (out_result->ptdo_rc == 0)
+		out_result->ptdo_rc = out_source->ptdo_rc;
+	out_result->ptdo_full += out_source->ptdo_full;
+	return 0;
+}
+
 void
 ds_pool_tgt_discard_handler(crt_rpc_t *rpc)
 {
@@ -1946,6 +2301,29 @@ ds_pool_tgt_discard_handler(crt_rpc_t *rpc)
 		D_GOTO(out, rc = 0);
 	}
 
+	if (dss_incr_reint) {
+		rc = dss_thread_collective(pool_child_reint_check, arg, 0);
+		if (rc == 0) {
+			/* Keep the data on the reintegrating targets, each object is discarded
+			 * right before it is migrated again, see migrate_obj_ult().
+			 */
+			D_INFO(DF_UUID": skip discard for incremental reintegration\n",
+			       DP_UUID(arg->pool_uuid));
+			pool->sp_incr_reint = 1;
+			rc = dss_ult_create(tgt_reint_cont_cleanup_ult, arg, DSS_XS_SYS, 0, 0,
+					    NULL);
+			if (rc != 0)
+				tgt_discard_arg_free(arg);
+			ds_pool_put(pool);
+			D_GOTO(out, rc = 0);
+		}
+
+		D_INFO(DF_UUID": targets can not keep their data, full reintegration: "DF_RC"\n",
+		       DP_UUID(arg->pool_uuid), DP_RC(rc));
+		out->ptdo_full = 1;
+		pool->sp_incr_reint = 0;
+	}
+
 	pool->sp_need_discard = 1;
 	rc = dss_ult_create(ds_pool_tgt_discard_ult, arg, DSS_XS_SYS, 0, 0, NULL);
 
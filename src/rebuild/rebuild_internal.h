@@ -20,6 +20,19 @@
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/rebuild.h>
 
+/* Objects to be rebuilt are classified by the redundancy they have left,
+ * the most at-risk class is migrated first, see rebuild_objects_send_ult().
+ */
+enum rebuild_redun_class {
+	/* No redundancy left, one more failure loses data */
+	REBUILD_REDUN_NONE,
+	/* One more failure can be tolerated */
+	REBUILD_REDUN_ONE,
+	/* More failures can be tolerated, or no redundancy lost (drain, reint...) */
+	REBUILD_REDUN_MORE,
+	REBUILD_REDUN_NR,
+};
+
 /* Track the pool rebuild status on each target, which exists on
  * all server targets. Then each target will report its rebuild
  * status to the global pool tracker(see below) on the master node,
@@ -90,6 +103,10 @@ struct rebuild_tgt_pool_tracker {
 	/* new layout version for upgrade rebuild */
 	uint32_t		rt_new_layout_ver;
 
+	/* last reported per redundancy class progress, see rebuild_redun_class */
+	uint64_t		rt_redun_found[REBUILD_REDUN_NR];
+	uint64_t		rt_redun_sent[REBUILD_REDUN_NR];
+
 	unsigned int		rt_lead_puller_running:1,
 				rt_abort:1,
 				/* re-report #rebuilt cnt per master change */
@@ -97,7 +114,9 @@ struct rebuild_tgt_pool_tracker {
 				rt_finishing:1,
 				rt_scan_done:1,
 				rt_global_scan_done:1,
-				rt_global_done:1;
+				rt_global_done:1,
+				/* Only the dirty objects are reintegrated */
+				rt_incr_reint:1;
 };
 
 struct rebuild_server_status {
@@ -233,10 +252,14 @@ struct rebuild_task {
  */
 struct rebuild_pool_tls {
 	uuid_t		rebuild_pool_uuid;
-	daos_handle_t	rebuild_tree_hdl; /*hold objects being rebuilt */
+	/* hold objects being rebuilt, one tree per redundancy class */
+	daos_handle_t	rebuild_tree_hdls[REBUILD_REDUN_NR];
 	d_list_t	rebuild_pool_list;
 	uint64_t	rebuild_pool_obj_count;
 	uint64_t	rebuild_pool_reclaim_obj_count;
+	/* objects found and sent per redundancy class */
+	uint64_t	rebuild_pool_redun_found[REBUILD_REDUN_NR];
+	uint64_t	rebuild_pool_redun_sent[REBUILD_REDUN_NR];
 	unsigned int	rebuild_pool_ver;
 	uint32_t	rebuild_pool_gen;
 	uint64_t	rebuild_pool_leader_term;
@@ -262,6 +285,8 @@ struct rebuild_tgt_query_info {
 	int status;
 	uint64_t obj_count;
 	uint64_t tobe_obj_count;
+	uint64_t redun_found[REBUILD_REDUN_NR];
+	uint64_t redun_sent[REBUILD_REDUN_NR];
 	uint64_t rec_count;
 	uint64_t size;
 	bool rebuilding;
@@ -296,6 +321,8 @@ struct rebuild_iv {
 #define SCAN_OBJ_YIELD_CNT	128
 
 extern struct dss_module_key rebuild_module_key;
+/* Migrate objects by redundancy class, DAOS_REBUILD_PRIO_SCAN */
+extern bool rebuild_prio_scan;
 static inline struct rebuild_tls *
 rebuild_tls_get()
 {
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2017-2022 Intel Corporation.
+ * (C) Copyright 2017-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -43,6 +43,12 @@ enum rebuild_operation {
 
 extern struct crt_proto_format rebuild_proto_fmt;
 
+/* rsi_flags */
+enum {
+	/* Every reintegrating target kept its data, only scan the dirty objects */
+	REBUILD_SCAN_INCR_REINT	= (1 << 0),
+};
+
 #define DAOS_ISEQ_REBUILD_SCAN	/* input fields */		 \
 	((uuid_t)		(rsi_pool_uuid)		CRT_VAR) \
 	((uint64_t)		(rsi_leader_term)	CRT_VAR) \
@@ -53,7 +59,8 @@ extern struct crt_proto_format rebuild_proto_fmt;
 	((uint32_t)		(rsi_rebuild_ver)	CRT_VAR) \
 	((uint32_t)		(rsi_master_rank)	CRT_VAR) \
 	((uint32_t)		(rsi_rebuild_gen)	CRT_VAR) \
-	((uint32_t)		(rsi_layout_ver)	CRT_VAR)
+	((uint32_t)		(rsi_layout_ver)	CRT_VAR) \
+	((uint32_t)		(rsi_flags)		CRT_VAR)
 
 #define DAOS_OSEQ_REBUILD_SCAN	/* output fields */		 \
 	((uint64_t)		(rso_stable_epoch)	CRT_VAR) \
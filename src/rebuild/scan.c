@@ -28,8 +28,12 @@
 #include "rebuild_internal.h"
 
 #define REBUILD_SEND_LIMIT	4096
+
+bool rebuild_prio_scan = true;
+
 struct rebuild_send_arg {
 	struct rebuild_tgt_pool_tracker *rpt;
+	struct rebuild_pool_tls		*tls;
 	daos_unit_oid_t			*oids;
 	daos_epoch_t			*ephs;
 	daos_epoch_t			*punched_ephs;
@@ -37,6 +41,8 @@ struct rebuild_send_arg {
 	unsigned int			*shards;
 	int				count;
 	unsigned int			tgt_id;
+	/* redundancy class of the tree being sent */
+	int				redun;
 };
 
 struct rebuild_obj_val {
@@ -127,10 +133,37 @@ rebuild_obj_send_cb(struct tree_cache_root *root, struct rebuild_send_arg *arg)
 			DP_UUID(rpt->rt_pool_uuid), arg->tgt_id);
 		dss_sleep(0);
 	}
+	if (rc == 0)
+		arg->tls->rebuild_pool_redun_sent[arg->redun] += arg->count;
 out:
 	return rc;
 }
 
+/* Find the most at-risk redundancy class with objects to be sent */
+static int
+rebuild_redun_next(struct rebuild_pool_tls *tls)
+{
+	int	i;
+
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		if (!dbtree_is_empty(tls->rebuild_tree_hdls[i]))
+			return i;
+	}
+
+	return -1;
+}
+
+/* Objects with less redundancy left have been found by the scanner after the
+ * current tree started being sent, stop it and send those first.
+ */
+static bool
+rebuild_send_preempted(struct rebuild_send_arg *arg)
+{
+	int	redun = rebuild_redun_next(arg->tls);
+
+	return redun >= 0 && redun < arg->redun;
+}
+
 static int
 obj_tree_destroy_current_probe(daos_handle_t ih, daos_handle_t cur_hdl, d_iov_t *key_iov)
 {
@@ -211,6 +244,9 @@ rebuild_tgt_iter_cb(daos_handle_t ih, d_iov_t *key_iov, d_iov_t *val_iov, void *
 				DP_RC(rc));
 			break;
 		}
+
+		if (rebuild_send_preempted(arg))
+			return 1;
 	}
 
 	d_iov_set(&save_key_iov, &tgt_id, sizeof(tgt_id));
@@ -240,6 +276,9 @@ rebuild_cont_iter_cb(daos_handle_t ih, d_iov_t *key_iov,
 				DP_RC(rc));
 			break;
 		}
+
+		if (rebuild_send_preempted(arg))
+			return 1;
 	}
 
 	d_iov_set(&save_key_iov, arg->cont_uuid, sizeof(uuid_t));
@@ -287,19 +326,23 @@ rebuild_objects_send_ult(void *data)
 	arg.ephs = ephs;
 	arg.punched_ephs = punched_ephs;
 	arg.rpt = rpt;
-	while (!tls->rebuild_pool_scan_done || !dbtree_is_empty(tls->rebuild_tree_hdl)) {
+	arg.tls = tls;
+	while (!tls->rebuild_pool_scan_done || rebuild_redun_next(tls) >= 0) {
 		if (rpt->rt_stable_epoch == 0) {
 			dss_sleep(0);
 			continue;
 		}
 
-		if (dbtree_is_empty(tls->rebuild_tree_hdl)) {
+		arg.redun = rebuild_redun_next(tls);
+		if (arg.redun < 0) {
 			dss_sleep(0);
 			continue;
 		}
 
-		/* walk through the rebuild tree and send the rebuild objects */
-		rc = dbtree_iterate(tls->rebuild_tree_hdl, DAOS_INTENT_MIGRATION,
+		/* walk through the rebuild tree of the most at-risk objects and
+		 * send them, restart from the top if more at-risk objects show up.
+		 */
+		rc = dbtree_iterate(tls->rebuild_tree_hdls[arg.redun], DAOS_INTENT_MIGRATION,
 				    false, rebuild_cont_iter_cb, &arg);
 		if (rc < 0) {
 			D_ERROR("dbtree iterate failed: "DF_RC"\n", DP_RC(rc));
@@ -346,7 +389,7 @@ rebuild_scan_done(void *data)
 static int
 rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 		      daos_unit_oid_t oid, unsigned int tgt_id, unsigned int shard,
-		      daos_epoch_t epoch, daos_epoch_t punched_epoch)
+		      daos_epoch_t epoch, daos_epoch_t punched_epoch, int redun)
 {
 	struct rebuild_pool_tls *tls;
 	struct rebuild_obj_val	val;
@@ -356,15 +399,17 @@ rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid, rpt->rt_rebuild_ver,
 				      rpt->rt_rebuild_gen);
 	D_ASSERT(tls != NULL);
-	D_ASSERT(daos_handle_is_valid(tls->rebuild_tree_hdl));
+	D_ASSERT(redun >= 0 && redun < REBUILD_REDUN_NR);
+	D_ASSERT(daos_handle_is_valid(tls->rebuild_tree_hdls[redun]));
 
 	tls->rebuild_pool_obj_count++;
+	tls->rebuild_pool_redun_found[redun]++;
 	val.eph = epoch;
 	val.punched_eph = punched_epoch;
 	val.shard = shard;
 	d_iov_set(&val_iov, &val, sizeof(struct rebuild_obj_val));
 	oid.id_shard = shard; /* Convert the OID to rebuilt one */
-	rc = obj_tree_insert(tls->rebuild_tree_hdl, co_uuid, tgt_id, oid, &val_iov);
+	rc = obj_tree_insert(tls->rebuild_tree_hdls[redun], co_uuid, tgt_id, oid, &val_iov);
 	if (rc == -DER_EXIST) {
 		/* If there is reintegrate being restarted due to the failure, then
 		 * it might put multiple shards into the same VOS target, because
@@ -380,8 +425,9 @@ rebuild_object_insert(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 			       DP_UUID(co_uuid), DP_UOID(oid), tgt_id);
 		rc = 0;
 	}
-	D_DEBUG(DB_REBUILD, "insert "DF_UOID"/"DF_UUID" tgt %u "DF_U64"/"DF_U64": "DF_RC"\n",
-		DP_UOID(oid), DP_UUID(co_uuid), tgt_id, epoch, punched_epoch, DP_RC(rc));
+	D_DEBUG(DB_REBUILD, "insert "DF_UOID"/"DF_UUID" tgt %u "DF_U64"/"DF_U64" redun %d: "
+		DF_RC"\n", DP_UOID(oid), DP_UUID(co_uuid), tgt_id, epoch, punched_epoch, redun,
+		DP_RC(rc));
 
 	return rc;
 }
@@ -396,6 +442,8 @@ struct rebuild_scan_arg {
 	int				snapshot_cnt;
 	uint32_t			yield_freq;
 	int32_t				obj_yield_cnt;
+	/* Only scan the objects in the dirty object log */
+	bool				dirty_only;
 };
 
 /**
@@ -613,7 +661,8 @@ rebuild_object_local(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid,
 
 static int
 rebuild_object(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid, daos_unit_oid_t oid,
-	       unsigned int tgt, uint32_t shard, d_rank_t myrank, vos_iter_entry_t *ent)
+	       unsigned int tgt, uint32_t shard, d_rank_t myrank, vos_iter_entry_t *ent,
+	       int redun)
 {
 	uint32_t		mytarget = dss_get_module_info()->dmi_tgt_id;
 	struct pool_target	*target;
@@ -644,11 +693,43 @@ rebuild_object(struct rebuild_tgt_pool_tracker *rpt, uuid_t co_uuid, daos_unit_o
 		rc = rebuild_object_local(rpt, co_uuid, oid, target->ta_comp.co_index, shard,
 					  eph, punched_eph);
 	else
-		rc = rebuild_object_insert(rpt, co_uuid, oid, tgt, shard, eph, punched_eph);
+		rc = rebuild_object_insert(rpt, co_uuid, oid, tgt, shard, eph, punched_eph,
+					   redun);
 
 	return rc;
 }
 
+/**
+ * Classify the object by the redundancy left in its redundancy group, i.e.
+ * the fault tolerance of the object class minus the shards of the group
+ * being rebuilt. Only failures (exclude) lose redundancy, the shards moved by
+ * drain, reintegration or extension still have a healthy copy.
+ */
+static int
+rebuild_obj_redun(struct rebuild_tgt_pool_tracker *rpt, struct daos_oclass_attr *oc_attr,
+		  daos_unit_oid_t oid, unsigned int *shards, int shard_nr)
+{
+	uint32_t	grp_size = daos_oclass_grp_size(oc_attr);
+	int		lost = 0;
+	int		left;
+	int		i;
+
+	if (!rebuild_prio_scan || rpt->rt_rebuild_op != RB_OP_EXCLUDE)
+		return REBUILD_REDUN_MORE;
+
+	for (i = 0; i < shard_nr; i++) {
+		if (oid.id_shard / grp_size == shards[i] / grp_size)
+			lost++;
+	}
+
+	left = (int)oc_attr->ca_resil_degree - lost;
+	if (left <= 0)
+		return REBUILD_REDUN_NONE;
+	if (left == 1)
+		return REBUILD_REDUN_ONE;
+	return REBUILD_REDUN_MORE;
+}
+
 static int
 rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 		    vos_iter_type_t type, vos_iter_param_t *param,
@@ -666,6 +747,7 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 	struct daos_oclass_attr		*oc_attr;
 	uint32_t			grp_size;
 	int				rebuild_nr = 0;
+	int				redun;
 	d_rank_t			myrank;
 	int				i;
 	int				rc = 0;
@@ -678,6 +760,11 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 	/* If the OID is invisible, then snapshots must be created on the object. */
 	D_ASSERTF(!(ent->ie_vis_flags & VOS_VIS_FLAG_COVERED) || arg->snapshot_cnt > 0,
 		  "flags %x snapshot_cnt %d\n", ent->ie_vis_flags, arg->snapshot_cnt);
+
+	/* Not changed since the reintegrating target went out, it still has it */
+	if (arg->dirty_only && !vos_obj_is_dirty(ch, oid))
+		D_GOTO(out, rc = 0);
+
 	map = pl_map_find(rpt->rt_pool_uuid, oid.id_pub);
 	if (map == NULL) {
 		D_ERROR(DF_UOID ": Cannot find valid placement map" DF_UUID "\n", DP_UOID(oid),
@@ -731,6 +818,7 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 
 	rebuild_nr = rc;
 	rc = 0;
+	redun = rebuild_obj_redun(rpt, oc_attr, oid, shards, rebuild_nr);
 	for (i = 0; i < rebuild_nr; i++) {
 		D_DEBUG(DB_REBUILD, "rebuild obj "DF_UOID"/"DF_UUID"/"DF_UUID
 			"on %d for shard %d eph "DF_U64" visible %s\n", DP_UOID(oid),
@@ -745,7 +833,8 @@ rebuild_obj_scan_cb(daos_handle_t ch, vos_iter_entry_t *ent,
 			continue;
 		}
 
-		rc = rebuild_object(rpt, arg->co_uuid, oid, tgts[i], shards[i], myrank, ent);
+		rc = rebuild_object(rpt, arg->co_uuid, oid, tgts[i], shards[i], myrank, ent,
+				    redun);
 		if (rc)
 			D_GOTO(out, rc);
 
@@ -884,6 +973,7 @@ rebuild_scanner(void *data)
 	struct vos_iter_anchors		anchor = { 0 };
 	ABT_thread			ult_send = ABT_THREAD_NULL;
 	struct umem_attr		uma;
+	int				i;
 	int				rc = 0;
 
 	tls = rebuild_pool_tls_lookup(rpt->rt_pool_uuid, rpt->rt_rebuild_ver,
@@ -907,15 +997,17 @@ rebuild_scanner(void *data)
 		D_DEBUG(DB_REBUILD, "sleep 2 seconds then retry\n");
 		dss_sleep(2 * 1000);
 	}
-	D_ASSERT(daos_handle_is_inval(tls->rebuild_tree_hdl));
-	/* Create object tree root */
+	/* Create object tree roots, one per redundancy class */
 	memset(&uma, 0, sizeof(uma));
 	uma.uma_id = UMEM_CLASS_VMEM;
-	rc = dbtree_create(DBTREE_CLASS_UV, 0, 4, &uma, NULL,
-			   &tls->rebuild_tree_hdl);
-	if (rc != 0) {
-		D_ERROR("failed to create rebuild tree: "DF_RC"\n", DP_RC(rc));
-		D_GOTO(out, rc);
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		D_ASSERT(daos_handle_is_inval(tls->rebuild_tree_hdls[i]));
+		rc = dbtree_create(DBTREE_CLASS_UV, 0, 4, &uma, NULL,
+				   &tls->rebuild_tree_hdls[i]);
+		if (rc != 0) {
+			D_ERROR("failed to create rebuild tree: "DF_RC"\n", DP_RC(rc));
+			D_GOTO(out, rc);
+		}
 	}
 
 	if (rpt->rt_rebuild_op != RB_OP_RECLAIM && rpt->rt_rebuild_op != RB_OP_FAIL_RECLAIM) {
@@ -937,6 +1029,18 @@ rebuild_scanner(void *data)
 	arg.rpt = rpt;
 	arg.yield_freq = SCAN_YIELD_FREQ;
 	arg.obj_yield_cnt = SCAN_OBJ_YIELD_CNT;
+	if (rpt->rt_rebuild_op == RB_OP_REINT && rpt->rt_incr_reint &&
+	    !child->spc_dirty_invalid) {
+		daos_epoch_t	dirty_eph = 0;
+		uint64_t	dirty_nr = 0;
+
+		vos_pool_dirty_query(child->spc_hdl, &dirty_eph, &dirty_nr);
+		arg.dirty_only = dirty_eph != 0;
+		D_INFO(DF_UUID" incremental reintegration: %s, "DF_U64" dirty objects since "
+		       DF_X64"\n", DP_UUID(rpt->rt_pool_uuid), arg.dirty_only ? "yes" : "no",
+		       dirty_nr, dirty_eph);
+	}
+
 	if (!rebuild_status_match(rpt, PO_COMP_ST_UP)) {
 		rc = vos_iterate(&param, VOS_ITER_COUUID, false, &anchor,
 				 rebuild_container_scan_cb, NULL, &arg, NULL);
@@ -73,6 +73,7 @@ rebuild_pool_tls_create(uuid_t pool_uuid, uuid_t poh_uuid, uuid_t coh_uuid,
 {
 	struct rebuild_pool_tls *rebuild_pool_tls;
 	struct rebuild_tls *tls = rebuild_tls_get();
+	int			i;
 
 	rebuild_pool_tls = rebuild_pool_tls_lookup(pool_uuid, ver, gen);
 	D_ASSERT(rebuild_pool_tls == NULL);
@@ -88,7 +89,8 @@ rebuild_pool_tls_create(uuid_t pool_uuid, uuid_t poh_uuid, uuid_t coh_uuid,
 	rebuild_pool_tls->rebuild_pool_scan_done = 0;
 	rebuild_pool_tls->rebuild_pool_obj_count = 0;
 	rebuild_pool_tls->rebuild_pool_reclaim_obj_count = 0;
-	rebuild_pool_tls->rebuild_tree_hdl = DAOS_HDL_INVAL;
+	for (i = 0; i < REBUILD_REDUN_NR; i++)
+		rebuild_pool_tls->rebuild_tree_hdls[i] = DAOS_HDL_INVAL;
 	/* Only 1 thread will access the list, no need lock */
 	d_list_add(&rebuild_pool_tls->rebuild_pool_list,
 		   &tls->rebuild_pool_list);
@@ -101,10 +103,14 @@ rebuild_pool_tls_create(uuid_t pool_uuid, uuid_t poh_uuid, uuid_t coh_uuid,
 static void
 rebuild_pool_tls_destroy(struct rebuild_pool_tls *tls)
 {
+	int	i;
+
 	D_DEBUG(DB_REBUILD, "TLS destroy for "DF_UUID" ver %d\n",
 		DP_UUID(tls->rebuild_pool_uuid), tls->rebuild_pool_ver);
-	if (daos_handle_is_valid(tls->rebuild_tree_hdl))
-		rebuild_obj_tree_destroy(tls->rebuild_tree_hdl);
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		if (daos_handle_is_valid(tls->rebuild_tree_hdls[i]))
+			rebuild_obj_tree_destroy(tls->rebuild_tree_hdls[i]);
+	}
 	d_list_del(&tls->rebuild_pool_list);
 	D_FREE(tls);
 }
@@ -388,6 +394,7 @@ dss_rebuild_check_one(void *data)
 	struct rebuild_tgt_query_info	*status = arg->status;
 	struct rebuild_tgt_pool_tracker	*rpt = arg->rpt;
 	unsigned int			idx = dss_get_module_info()->dmi_tgt_id;
+	int				i;
 
 	if (is_current_tgt_unavail(rpt))
 		return 0;
@@ -409,6 +416,10 @@ dss_rebuild_check_one(void *data)
 
 	status->obj_count += pool_tls->rebuild_pool_reclaim_obj_count;
 	status->tobe_obj_count += pool_tls->rebuild_pool_obj_count;
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		status->redun_found[i] += pool_tls->rebuild_pool_redun_found[i];
+		status->redun_sent[i] += pool_tls->rebuild_pool_redun_sent[i];
+	}
 	ABT_mutex_unlock(status->lock);
 
 	return 0;
@@ -470,6 +481,41 @@ out:
 	return rc;
 }
 
+static const char *rebuild_redun_names[REBUILD_REDUN_NR] = {
+	[REBUILD_REDUN_NONE]	= "no redundancy",
+	[REBUILD_REDUN_ONE]	= "one failure",
+	[REBUILD_REDUN_MORE]	= "more failures",
+};
+
+/* Report per redundancy class progress, so operators can see how much data
+ * is still at risk during the rebuild.
+ */
+static void
+rebuild_redun_report(struct rebuild_tgt_pool_tracker *rpt,
+		     struct rebuild_tgt_query_info *status)
+{
+	int	i;
+
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		if (status->redun_found[i] != rpt->rt_redun_found[i] ||
+		    status->redun_sent[i] != rpt->rt_redun_sent[i])
+			break;
+	}
+	if (i == REBUILD_REDUN_NR)
+		return;
+
+	for (i = 0; i < REBUILD_REDUN_NR; i++) {
+		if (status->redun_found[i] == 0)
+			continue;
+
+		D_INFO(DF_UUID" ver %u: objects left with %s, "DF_U64"/"DF_U64" sent\n",
+		       DP_UUID(rpt->rt_pool_uuid), rpt->rt_rebuild_ver,
+		       rebuild_redun_names[i], status->redun_sent[i], status->redun_found[i]);
+		rpt->rt_redun_found[i] = status->redun_found[i];
+		rpt->rt_redun_sent[i] = status->redun_sent[i];
+	}
+}
+
 void
 ds_rebuild_running_query(uuid_t pool_uuid, uint32_t *upper_ver)
 {
@@ -982,6 +1028,15 @@ rebuild_scan_broadcast(struct ds_pool *pool, struct rebuild_global_pool_tracker
 	rsi->rsi_layout_ver = layout_version;
 	rsi->rsi_tgts_num = tgts_failed->pti_number;
 	rsi->rsi_rebuild_op = rebuild_op;
+	/* The flags cover every reintegration merged into this task, a new leader never
+	 * saw the discard replies and always goes for a full reintegration.
+	 */
+	if (rebuild_op == RB_OP_REINT && pool->sp_reint_incr && !pool->sp_reint_full)
+		rsi->rsi_flags |= REBUILD_SCAN_INCR_REINT;
+	if (rebuild_op == RB_OP_REINT) {
+		pool->sp_reint_incr = 0;
+		pool->sp_reint_full = 0;
+	}
 	crt_group_rank(pool->sp_group,  &rsi->rsi_master_rank);
 
 	rc = dss_rpc_send(rpc);
@@ -2130,6 +2185,8 @@ rebuild_tgt_status_check_ult(void *arg)
 			break;
 		rc = rebuild_tgt_query(rpt, &status);
 		ABT_mutex_free(&status.lock);
+		if (rc == 0)
+			rebuild_redun_report(rpt, &status);
 		if (rc || status.status != 0) {
 			D_ERROR(DF_UUID" rebuild failed: "DF_RC"\n",
 				DP_UUID(rpt->rt_pool_uuid),
@@ -2396,6 +2453,13 @@ rebuild_tgt_prepare(crt_rpc_t *rpc, struct rebuild_tgt_pool_tracker **p_rpt)
 		D_GOTO(out, rc);
 
 	rpt->rt_rebuild_op = rsi->rsi_rebuild_op;
+	if (rsi->rsi_flags & REBUILD_SCAN_INCR_REINT) {
+		rpt->rt_incr_reint = 1;
+	} else if (rpt->rt_rebuild_op == RB_OP_REINT) {
+		rc = ds_pool_tgt_reint_discard(pool);
+		if (rc)
+			D_GOTO(out, rc);
+	}
 
 	rc = ds_pool_iv_srv_hdl_fetch(pool, &rpt->rt_poh_uuid,
 				      &rpt->rt_coh_uuid);
@@ -2493,6 +2557,8 @@ init(void)
 	if (rc != ABT_SUCCESS)
 		return dss_abterr2der(rc);
 
+	d_getenv_bool("DAOS_REBUILD_PRIO_SCAN", &rebuild_prio_scan);
+
 	rc = rebuild_iv_init();
 	return rc;
 }
@@ -31,6 +31,7 @@ enum {
 
 int	ts_mode = TS_MODE_DAOS;
 int	ts_class = OC_SX;
+bool	ts_reuse_buf;
 
 static int
 daos_update_or_fetch(int obj_idx, enum ts_op_type op_type,
@@ -290,6 +291,10 @@ const char perf_daos_usage[] = "\n"
 "	Object class for DAOS full stack test.\n\n"
 "-g dmg_conf\n"
 "	dmg configuration file.\n\n"
+"-B\n"
+"	All I/O credits share the same value buffer, so every transfer reuses\n"
+"	the same memory. Combine with CRT_BULK_CACHE_SIZE=N to measure the\n"
+"	bulk registration cache, its hit rate is printed at exit.\n\n"
 "Examples:\n"
 "	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n";
 
@@ -309,10 +314,11 @@ const struct option perf_daos_opts[] = {
 	{ "credits",	required_argument,	NULL,	'C' },
 	{ "class",	required_argument,	NULL,	'c' },
 	{ "dmg_conf",	required_argument,	NULL,	'g' },
+	{ "reuse_buf",	no_argument,		NULL,	'B' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_daos_optstr[] = "T:C:c:g:";
+const char perf_daos_optstr[] = "T:C:c:g:B";
 
 int
 main(int argc, char **argv)
@@ -381,6 +387,9 @@ main(int argc, char **argv)
 		case 'g':
 			dmg_conf = optarg;
 			break;
+		case 'B':
+			ts_reuse_buf = true;
+			break;
 		}
 	}
 
@@ -431,6 +440,7 @@ main(int argc, char **argv)
 	stride_buf_init(ts_stride);
 
 	ts_ctx.tsc_cred_vsize	= ts_stride;
+	ts_ctx.tsc_cred_vbuf_shared = ts_reuse_buf;
 	ts_ctx.tsc_scm_size	= ts_scm_size;
 	ts_ctx.tsc_nvme_size	= ts_nvme_size;
 	ts_ctx.tsc_dmg_conf	= dmg_conf;
@@ -501,6 +511,22 @@ main(int argc, char **argv)
 
 	rc = run_commands(cmds, pf_tests);
 
+	if (ts_reuse_buf && ts_ctx.tsc_mpi_rank == 0) {
+		struct daos_mem_cache_stats	stats;
+		uint64_t			lookups;
+
+		if (daos_mem_cache_query(&stats) == 0) {
+			lookups = stats.dmcs_hits + stats.dmcs_misses +
+				  stats.dmcs_bypasses;
+			fprintf(stdout, "Bulk cache: "DF_U64"%% hit rate, "
+				DF_U64" hits, "DF_U64" misses, "DF_U64
+				" bypasses\n",
+				lookups == 0 ? 0 : stats.dmcs_hits * 100 / lookups,
+				stats.dmcs_hits, stats.dmcs_misses,
+				stats.dmcs_bypasses);
+		}
+	}
+
 	if (ts_indices)
 		free(ts_indices);
 	stride_buf_fini();
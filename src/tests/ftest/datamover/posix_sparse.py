@@ -0,0 +1,95 @@
+'''
+  (C) Copyright 2023 Intel Corporation.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+'''
+from os.path import basename, join
+
+from data_mover_test_base import DataMoverTestBase
+from duns_utils import format_path
+
+
+class DmvrPosixSparse(DataMoverTestBase):
+    # pylint: disable=too-many-ancestors
+    """Test class for POSIX DataMover sparse file validation
+
+    Test Class Description:
+        Tests that daos fs copy preserves the data and the holes of sparse files.
+    :avocado: recursive
+    """
+
+    def test_dm_posix_sparse_fs_copy(self):
+        """
+        Test Description:
+            Tests copying sparse files with fs copy.
+        :avocado: tags=all,daily_regression
+        :avocado: tags=vm
+        :avocado: tags=datamover,daos_fs_copy,dfs,daos_cmd
+        :avocado: tags=DmvrPosixSparse,test_dm_posix_sparse_fs_copy
+        """
+        self.run_dm_posix_sparse("FS_COPY")
+
+    def run_dm_posix_sparse(self, tool):
+        """
+        Use Cases:
+            1. Create pool
+            2. Create container
+            3. Create a POSIX directory with:
+                - A file with holes between data ranges
+                - A file with a trailing hole
+                - A file that is a single hole
+                - Many small files, copied side by side
+            4. Copy the POSIX directory to the container
+            5. Copy the container directory to a new POSIX directory
+            6. Verify the copy matches the source and the holes are kept
+        """
+        # Set the tool to use
+        self.set_tool(tool)
+
+        # Create 1 pool and 1 container
+        pool = self.create_pool()
+        cont = self.get_container(pool)
+
+        src_posix_path = self.new_posix_test_path()
+        sparse_files = {
+            "sparse_holes": [
+                "truncate -s 64M '{0}'",
+                "dd if=/dev/urandom of='{0}' bs=1M count=1 seek=8 conv=notrunc",
+                "dd if=/dev/urandom of='{0}' bs=1M count=1 seek=40 conv=notrunc"],
+            "sparse_tail": [
+                "dd if=/dev/urandom of='{0}' bs=1M count=1",
+                "truncate -s 32M '{0}'"],
+            "sparse_empty": [
+                "truncate -s 16M '{0}'"],
+        }
+        for name, cmds in sparse_files.items():
+            for cmd in cmds:
+                self.execute_cmd(cmd.format(join(src_posix_path, name)))
+        self.execute_cmd(
+            "for i in $(seq 1 32); do "
+            "dd if=/dev/urandom of='{}/small_'$i bs=4k count=$i; done".format(src_posix_path))
+
+        # Copy POSIX to DAOS, the source directory is copied into the container root
+        self.run_datamover(
+            self.test_id + " (posix to daos)",
+            src_path=src_posix_path,
+            dst_path=format_path(pool, cont))
+
+        # Copy DAOS back to a new POSIX directory
+        dst_posix_path = self.new_posix_test_path(create=False)
+        self.run_datamover(
+            self.test_id + " (daos to posix)",
+            src_path=format_path(pool, cont, "/" + basename(src_posix_path)),
+            dst_path=dst_posix_path)
+
+        # The data and the file sizes must match
+        self.run_diff(src_posix_path, dst_posix_path)
+
+        # The holes must not be filled, skip the check where the source has none
+        for name in sparse_files:
+            src_file = join(src_posix_path, name)
+            dst_file = join(dst_posix_path, name)
+            self.execute_cmd(
+                "if [ $(stat -c %b '{0}') -lt $(( $(stat -c %s '{0}') / 512 )) ]; then "
+                "[ $(stat -c %b '{1}') -lt $(( $(stat -c %s '{1}') / 512 )) ]; fi".format(
+                    src_file, dst_file))
@@ -375,9 +375,6 @@ objects_fetch(struct pf_param *param)
  * commands.
  */
 
-#define PARAM_SEP	';'
-#define PARAM_ASSIGN	'='
-
 int
 pf_parse_common(char *str, struct pf_param *param, pf_parse_cb_t parse_cb,
 		char **strp)
@@ -728,6 +725,8 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 			   strcmp(test_name, "DISCARD") == 0 ||
 			   strcmp(test_name, "GARBAGE COLLECTION") == 0) {
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration;
+		} else if (strcmp(test_name, "ITERATE") == 0) {
+			total = ts_ctx.tsc_mpi_size * param->pa_iter.keys;
 		} else if (strcmp(test_name, "PUNCH") == 0) {
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration * param->pa_obj_nr;
 			if (param->pa_rw.dkey_flag)
@@ -748,9 +747,10 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 			bandwidth = (rate * param->pa_rw.size) / (1024 * 1024);
 			fprintf(stdout, "\tbandwith : %-10.3f MB/sec\n", bandwidth);
 		}
-		fprintf(stdout, "\trate     : %-10.2f IO/sec\n"
+		fprintf(stdout, "\trate     : %-10.2f %s/sec\n"
 			"\tlatency  : %-10.3f us "
-			"(nonsense if credits > 1)\n", rate, latency);
+			"(nonsense if credits > 1)\n", rate,
+			strcmp(test_name, "ITERATE") == 0 ? "keys" : "IO", latency);
 
 		fprintf(stdout, "Duration across processes:\n");
 		fprintf(stdout, "\tMAX duration : %-10.6f sec\n",
@@ -802,6 +802,7 @@ const char perf_common_usage[] = "\n"
 "	'o=$N' : Offset for update or fetch\n"
 "	's=$N' : IO size for update or fetch\n"
 "	'd'    : Dkey punch (for Punch test)\n"
+"	'b=$N' : Fetch $N keys per call (for Iteration test)\n"
 "	'v'    : Verbose mode\n\n"
 "	Test commands are in format of: \"C;p=x;q D;a;b\" The upper-case\n"
 "	character is command, e.g. U=update, F=fetch, anything after\n"
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2021-2022 Intel Corporation.
+ * (C) Copyright 2021-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -16,6 +16,10 @@
 #define PF_DKEY_PREF	"blade"
 #define PF_AKEY_PREF	"apple"
 
+/* separators of the test command parameters, see run_commands() */
+#define PARAM_SEP	';'
+#define PARAM_ASSIGN	'='
+
 enum ts_op_type {
 	TS_DO_UPDATE = 0,
 	TS_DO_FETCH
@@ -44,7 +48,11 @@ struct pf_param {
 		/* private parameter for iteration */
 		struct {
 			/* visible iteration */
-			bool	visible;
+			bool		visible;
+			/* # keys fetched per call, zero for callback iteration */
+			int		batch;
+			/* output parameter, # keys iterated */
+			uint64_t	keys;
 		} pa_iter;
 		/* private parameter for update, fetch and verify */
 		struct {
@@ -62,7 +70,14 @@ struct pf_param {
 			bool	full_scan;
 			/* Force merge */
 			bool	force_merge;
+			/* Foreground updates between GC batches */
+			bool	gc_busy;
 		} pa_agg;
+		/* private parameter for container reopen */
+		struct {
+			/* # containers */
+			int	cont_nr;
+		} pa_cont;
 	};
 };
 
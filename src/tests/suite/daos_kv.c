@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -335,6 +335,114 @@ kv_cond_ops(void **state)
 	print_message("all good\n");
 } /* End simple_put_get */
 
+#define MULTI_KEYS 100
+
+static void
+kv_multi_ops(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t	oid;
+	daos_handle_t	oh;
+	daos_kv_entry_t	kves[MULTI_KEYS];
+	char		keys[MULTI_KEYS][32];
+	uint64_t	vals[MULTI_KEYS];
+	uint64_t	vals_out[MULTI_KEYS];
+	char		small;
+	int		num_keys = 0;
+	int		i;
+	int		rc;
+
+	oid = daos_test_oid_gen(arg->coh, OC_SX, type, 0, arg->myrank);
+
+	/** open the object */
+	rc = daos_kv_open(arg->coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("Multi-key PUT of %d keys\n", MULTI_KEYS);
+	for (i = 0; i < MULTI_KEYS; i++) {
+		sprintf(keys[i], "multi_key%d", i);
+		vals[i]			= i * 10;
+		kves[i].kve_key		= keys[i];
+		kves[i].kve_size	= sizeof(vals[i]);
+		kves[i].kve_buf		= &vals[i];
+	}
+	rc = daos_kv_put_multi(oh, DAOS_TX_NONE, 0, MULTI_KEYS, kves, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < MULTI_KEYS; i++)
+		assert_rc_equal(kves[i].kve_rc, 0);
+
+	list_keys(oh, &num_keys);
+	assert_int_equal(num_keys, MULTI_KEYS);
+
+	print_message("Multi-key GET of %d keys\n", MULTI_KEYS);
+	for (i = 0; i < MULTI_KEYS; i++) {
+		vals_out[i]		= 0;
+		kves[i].kve_size	= sizeof(vals_out[i]);
+		kves[i].kve_buf		= &vals_out[i];
+	}
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, MULTI_KEYS, kves, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < MULTI_KEYS; i++) {
+		assert_rc_equal(kves[i].kve_rc, 0);
+		assert_int_equal(kves[i].kve_size, sizeof(vals[i]));
+		assert_int_equal(vals_out[i], vals[i]);
+	}
+
+	print_message("Multi-key GET with a small buffer for one key (should fail)\n");
+	kves[1].kve_size	= sizeof(small);
+	kves[1].kve_buf		= &small;
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, 2, kves, NULL);
+	assert_rc_equal(rc, -DER_REC2BIG);
+	assert_rc_equal(kves[0].kve_rc, 0);
+	assert_rc_equal(kves[1].kve_rc, -DER_REC2BIG);
+	assert_int_equal(kves[1].kve_size, sizeof(vals[1]));
+
+	print_message("Multi-key conditional INSERT of existing keys (should fail)\n");
+	for (i = 0; i < MULTI_KEYS; i++) {
+		kves[i].kve_size	= sizeof(vals[i]);
+		kves[i].kve_buf		= &vals[i];
+	}
+	rc = daos_kv_put_multi(oh, DAOS_TX_NONE, DAOS_COND_KEY_INSERT, MULTI_KEYS, kves,
+			       NULL);
+	assert_rc_equal(rc, -DER_EXIST);
+	for (i = 0; i < MULTI_KEYS; i++)
+		assert_rc_equal(kves[i].kve_rc, -DER_EXIST);
+
+	print_message("Multi-key REMOVE of half the keys\n");
+	rc = daos_kv_remove_multi(oh, DAOS_TX_NONE, 0, MULTI_KEYS / 2, kves, NULL);
+	assert_rc_equal(rc, 0);
+
+	list_keys(oh, &num_keys);
+	assert_int_equal(num_keys, MULTI_KEYS - MULTI_KEYS / 2);
+
+	print_message("Multi-key GET of removed keys returns zero size\n");
+	for (i = 0; i < MULTI_KEYS / 2; i++) {
+		kves[i].kve_size	= sizeof(vals_out[i]);
+		kves[i].kve_buf		= &vals_out[i];
+	}
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, MULTI_KEYS / 2, kves, NULL);
+	assert_rc_equal(rc, 0);
+	for (i = 0; i < MULTI_KEYS / 2; i++)
+		assert_int_equal(kves[i].kve_size, 0);
+
+	print_message("Destroying KV\n");
+	rc = daos_kv_destroy(oh, DAOS_TX_NONE, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_kv_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	print_message("Multi-key GET with a closed handle fails every key\n");
+	for (i = 0; i < MULTI_KEYS; i++)
+		kves[i].kve_rc = 0;
+	rc = daos_kv_get_multi(oh, DAOS_TX_NONE, 0, MULTI_KEYS, kves, NULL);
+	assert_rc_equal(rc, -DER_NO_HDL);
+	for (i = 0; i < MULTI_KEYS; i++)
+		assert_rc_equal(kves[i].kve_rc, -DER_NO_HDL);
+
+	print_message("all good\n");
+} /* End kv_multi_ops */
+
 static const struct CMUnitTest kv_tests[] = {
 	{"KV: Object Put/GET (blocking)",
 	 simple_put_get, async_disable, NULL},
@@ -344,6 +452,8 @@ static const struct CMUnitTest kv_tests[] = {
 	 simple_put_get, async_enable, NULL},
 	{"KV: Object Conditional Ops (blocking)",
 	 kv_cond_ops, async_disable, NULL},
+	{"KV: Object Multi-key Put/Get/Remove (blocking)",
+	 kv_multi_ops, async_disable, NULL},
 };
 
 int
@@ -1305,6 +1305,136 @@ rebuild_many_objects_with_failure(void **state)
 	D_FREE(oids);
 }
 
+/* Objects left untouched while the rank is out, a full reintegration has to move them all */
+#define REINT_CLEAN_OBJ_NR	(OBJ_NR * 4)
+
+static void
+rebuild_status_get(test_arg_t *arg, struct daos_rebuild_status *rst)
+{
+	daos_pool_info_t	pinfo = { 0 };
+
+	pinfo.pi_bits = DPI_REBUILD_STATUS;
+	assert_success(test_pool_get_info(arg, &pinfo, NULL /* engine_ranks */));
+	assert_int_equal(pinfo.pi_rebuild_st.rs_state, DRS_COMPLETED);
+	assert_int_equal(pinfo.pi_rebuild_st.rs_errno, 0);
+	*rst = pinfo.pi_rebuild_st;
+}
+
+static void
+rebuild_incr_reint_set(test_arg_t *arg, bool enable)
+{
+	if (arg->myrank == 0)
+		assert_success(daos_debug_set_params(arg->group, -1, DMG_KEY_REBUILD_INCREMENTAL,
+						     enable, 0, NULL));
+	par_barrier(PAR_COMM_WORLD);
+}
+
+/*
+ * Objects modified and a container destroyed while a rank is out, with incremental
+ * reintegration enabled and the rank keeping its data (only the modified objects are
+ * migrated) or losing it (full reintegration, everything is migrated).
+ */
+static void
+rebuild_reint_modified_internal(void **state, bool data_lost)
+{
+	test_arg_t			*arg = *state;
+	daos_obj_id_t			 oids[REINT_CLEAN_OBJ_NR];
+	daos_obj_id_t			 dirty_oids[OBJ_NR];
+	daos_obj_id_t			 gone_oids[OBJ_NR];
+	struct daos_rebuild_status	 excl_st;
+	struct daos_rebuild_status	 reint_st;
+	d_rank_t			 rank = ranks_to_kill[0];
+	daos_handle_t			 coh;
+	daos_handle_t			 coh_saved;
+	uuid_t				 cont_uuid;
+	char				 cont_str[DAOS_UUID_STR_SIZE];
+	int				 i;
+
+	if (!test_runable(arg, 4))
+		return;
+
+	/* Before the rank goes out, the dirty object log starts on that pool map change */
+	rebuild_incr_reint_set(arg, true);
+
+	for (i = 0; i < REINT_CLEAN_OBJ_NR; i++) {
+		oids[i] = daos_test_oid_gen(arg->coh, arg->obj_class, 0, 0, arg->myrank);
+		oids[i] = dts_oid_set_rank(oids[i], rank);
+	}
+	rebuild_io(arg, oids, REINT_CLEAN_OBJ_NR);
+
+	assert_success(daos_cont_create(arg->pool.poh, &cont_uuid, NULL, NULL));
+	uuid_unparse(cont_uuid, cont_str);
+	assert_success(daos_cont_open(arg->pool.poh, cont_str, DAOS_COO_RW, &coh, NULL, NULL));
+	for (i = 0; i < OBJ_NR; i++) {
+		gone_oids[i] = daos_test_oid_gen(coh, arg->obj_class, 0, 0, arg->myrank);
+		gone_oids[i] = dts_oid_set_rank(gone_oids[i], rank);
+	}
+	coh_saved = arg->coh;
+	arg->coh = coh;
+	rebuild_io(arg, gone_oids, OBJ_NR);
+	arg->coh = coh_saved;
+	assert_success(daos_cont_close(coh, NULL));
+
+	rebuild_single_pool_rank(arg, rank, false);
+	/* Every object has a shard on the excluded rank */
+	rebuild_status_get(arg, &excl_st);
+	assert_true(excl_st.rs_obj_nr >= REINT_CLEAN_OBJ_NR + OBJ_NR);
+
+	print_message("modify objects and destroy container %s while rank %u is out\n",
+		      cont_str, rank);
+	for (i = 0; i < OBJ_NR; i++) {
+		dirty_oids[i] = daos_test_oid_gen(arg->coh, arg->obj_class, 0, 0, arg->myrank);
+		dirty_oids[i] = dts_oid_set_rank(dirty_oids[i], rank);
+	}
+	rebuild_io(arg, dirty_oids, OBJ_NR);
+	assert_success(daos_cont_destroy(arg->pool.poh, cont_str, false, NULL));
+
+	if (data_lost && arg->myrank == 0)
+		daos_debug_set_params(arg->group, rank, DMG_KEY_FAIL_LOC,
+				      DAOS_REBUILD_REINT_DATA_LOST | DAOS_FAIL_ALWAYS, 0, NULL);
+
+	reintegrate_single_pool_rank(arg, rank, false);
+
+	if (data_lost && arg->myrank == 0)
+		daos_debug_set_params(arg->group, rank, DMG_KEY_FAIL_LOC, 0, 0, NULL);
+
+	rebuild_status_get(arg, &reint_st);
+	print_message("exclude obj="DF_U64" rec="DF_U64", reintegrate obj="DF_U64" rec="DF_U64
+		      "\n", excl_st.rs_obj_nr, excl_st.rs_rec_nr, reint_st.rs_obj_nr,
+		      reint_st.rs_rec_nr);
+	assert_true(reint_st.rs_obj_nr > 0);
+	if (data_lost) {
+		/* Full reintegration, the clean objects are migrated back as well */
+		assert_true(reint_st.rs_obj_nr >= REINT_CLEAN_OBJ_NR + OBJ_NR);
+		assert_true(reint_st.rs_rec_nr * 2 > excl_st.rs_rec_nr);
+	} else {
+		/* Incremental, the work scales with the objects modified while out */
+		assert_true(reint_st.rs_obj_nr < REINT_CLEAN_OBJ_NR);
+		assert_true(reint_st.rs_obj_nr * 2 < excl_st.rs_obj_nr);
+		assert_true(reint_st.rs_rec_nr * 2 < excl_st.rs_rec_nr);
+	}
+
+	/* The replicas on the reintegrated rank must match the others */
+	rebuild_io_verify(arg, oids, REINT_CLEAN_OBJ_NR);
+	rebuild_io_verify(arg, dirty_oids, OBJ_NR);
+	rebuild_io_validate(arg, oids, REINT_CLEAN_OBJ_NR);
+	rebuild_io_validate(arg, dirty_oids, OBJ_NR);
+
+	rebuild_incr_reint_set(arg, false);
+}
+
+static void
+rebuild_reint_modified(void **state)
+{
+	rebuild_reint_modified_internal(state, false);
+}
+
+static void
+rebuild_reint_data_lost(void **state)
+{
+	rebuild_reint_modified_internal(state, true);
+}
+
 #define KB 1024
 #define MB (KB * 1024)
 #define GB (MB * 1024)
@@ -1486,6 +1616,10 @@ static const struct CMUnitTest rebuild_tests[] = {
 	 rebuild_many_objects_with_failure, rebuild_sub_setup, test_teardown},
 	{"REBUILD23: object corrupt rebuild",
 	 rebuild_object_with_csum_error, rebuild_small_sub_rf1_setup, test_teardown},
+	{"REBUILD24: reintegrate after modify and container destroy",
+	 rebuild_reint_modified, rebuild_small_sub_setup, test_teardown},
+	{"REBUILD25: reintegrate a rank that lost its data",
+	 rebuild_reint_data_lost, rebuild_small_sub_setup, test_teardown},
 };
 
 int
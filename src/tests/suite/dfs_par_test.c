@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -934,6 +934,99 @@ dfs_test_create_atomicity(void **state)
 	}
 }
 
+#define CREATE_MULTI_NR		512
+#define CREATE_MULTI_BATCH	64
+
+/** the create rate of batches vs. one by one is measured by DFS_PERF_TEST2 */
+static void
+dfs_test_create_multi(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_obj_t	*dir;
+	dfs_obj_t	*obj;
+	char		dirname[32];
+	char		*names[CREATE_MULTI_NR];
+	int		*rcs;
+	struct stat	*stbufs;
+	struct stat	stbuf;
+	const char	*missing[2];
+	int		i;
+	int		rc;
+
+	D_ALLOC_ARRAY(rcs, CREATE_MULTI_NR);
+	assert_non_null(rcs);
+	D_ALLOC_ARRAY(stbufs, CREATE_MULTI_NR);
+	assert_non_null(stbufs);
+	for (i = 0; i < CREATE_MULTI_NR; i++) {
+		D_ASPRINTF(names[i], "file.%d", i);
+		assert_non_null(names[i]);
+	}
+
+	sprintf(dirname, "multi_dir_%d", arg->myrank);
+	rc = dfs_mkdir(dfs_mt, NULL, dirname, S_IWUSR | S_IRUSR | S_IXUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, dirname, O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	/** the first entry exists already, the rest of its batch is still created */
+	rc = dfs_open(dfs_mt, dir, names[0], S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	par_barrier(PAR_COMM_WORLD);
+	for (i = 0; i < CREATE_MULTI_NR; i += CREATE_MULTI_BATCH) {
+		rc = dfs_create_multi(dfs_mt, dir, CREATE_MULTI_BATCH, (const char **)&names[i],
+				      S_IFREG | S_IWUSR | S_IRUSR, 0, 0, &rcs[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	assert_int_equal(rcs[0], EEXIST);
+	for (i = 1; i < CREATE_MULTI_NR; i++)
+		assert_int_equal(rcs[i], 0);
+
+	/** entries created in a batch are regular files, like the ones of dfs_open */
+	for (i = 0; i < CREATE_MULTI_NR; i += CREATE_MULTI_BATCH / 4) {
+		rc = dfs_stat(dfs_mt, dir, names[i], &stbuf);
+		assert_int_equal(rc, 0);
+		assert_true(S_ISREG(stbuf.st_mode));
+	}
+
+	/** existing entries fail individually */
+	rc = dfs_create_multi(dfs_mt, dir, CREATE_MULTI_BATCH, (const char **)names,
+			      S_IFREG | S_IWUSR | S_IRUSR, 0, 0, rcs, NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < CREATE_MULTI_BATCH; i++)
+		assert_int_equal(rcs[i], EEXIST);
+
+	rc = dfs_stat_multi(dfs_mt, dir, CREATE_MULTI_NR, (const char **)names, stbufs, rcs,
+			    NULL);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < CREATE_MULTI_NR; i++) {
+		assert_int_equal(rcs[i], 0);
+		assert_true(S_ISREG(stbufs[i].st_mode));
+		assert_int_equal(stbufs[i].st_size, 0);
+	}
+
+	missing[0] = names[0];
+	missing[1] = "no_such_file";
+	rc = dfs_stat_multi(dfs_mt, dir, 2, missing, stbufs, rcs, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(rcs[0], 0);
+	assert_int_equal(rcs[1], ENOENT);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, dirname, true, NULL);
+	assert_int_equal(rc, 0);
+	par_barrier(PAR_COMM_WORLD);
+
+	for (i = 0; i < CREATE_MULTI_NR; i++)
+		D_FREE(names[i]);
+	D_FREE(stbufs);
+	D_FREE(rcs);
+}
+
 static const struct CMUnitTest dfs_par_tests[] = {
 	{ "DFS_PAR_TEST1: Conditional OPs",
 	  dfs_test_cond, async_disable, test_case_teardown},
@@ -947,6 +1040,8 @@ static const struct CMUnitTest dfs_par_tests[] = {
 	  dfs_test_cont_atomic, async_disable, test_case_teardown},
 	{ "DFS_PAR_TEST6: DFS File and Dir create (without O_EXCL) atomicity",
 	  dfs_test_create_atomicity, async_disable, test_case_teardown},
+	{ "DFS_PAR_TEST7: DFS multi-entry create and stat",
+	  dfs_test_create_multi, async_disable, test_case_teardown},
 };
 
 static int
@@ -0,0 +1,500 @@
+/**
+ * (C) Copyright 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * DFS benchmarks, they report rates and are only run on request with dfs_test -b.
+ * The behaviour they rely on is checked by the DFS unit and parallel tests.
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include "dfs_test.h"
+
+/** global DFS mount used for all tests */
+static uuid_t		co_uuid;
+static daos_handle_t	co_hdl;
+static dfs_t		*dfs_mt;
+
+#define DCACHE_DEPTH	8
+#define DCACHE_ITER	2000
+
+static uint64_t
+dcache_stat_loop(dfs_t *dfs, const char *path)
+{
+	struct stat	stbuf;
+	dfs_obj_t	*obj;
+	uint64_t	start;
+	int		i;
+	int		rc;
+
+	start = daos_get_ntime();
+	for (i = 0; i < DCACHE_ITER; i++) {
+		rc = dfs_lookup(dfs, path, O_RDONLY, &obj, NULL, &stbuf);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	return daos_get_ntime() - start;
+}
+
+/** lookup + stat of a deep path, with and without the dentry cache */
+static void
+dfs_perf_dcache(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_t			*dfs;
+	dfs_obj_t		*dir, *file;
+	dfs_dcache_stats_t	stats;
+	char			path[DCACHE_DEPTH * 8 + 16] = "";
+	char			name[16];
+	uint64_t		nocache_ns, cache_ns;
+	int			i;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs);
+	assert_int_equal(rc, 0);
+
+	dir = NULL;
+	for (i = 0; i < DCACHE_DEPTH; i++) {
+		dfs_obj_t *parent = dir;
+
+		sprintf(name, "dc%d", i);
+		rc = dfs_open(dfs, parent, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+			      O_RDWR | O_CREAT, 0, 0, NULL, &dir);
+		assert_int_equal(rc, 0);
+		if (parent) {
+			rc = dfs_release(parent);
+			assert_int_equal(rc, 0);
+		}
+		strcat(path, "/");
+		strcat(path, name);
+	}
+	rc = dfs_open(dfs, dir, "file", S_IFREG | S_IWUSR | S_IRUSR, O_RDWR | O_CREAT, 0, 0,
+		      NULL, &file);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(file);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	strcat(path, "/file");
+
+	print_message("Lookup + stat of %s, %d times...\n", path, DCACHE_ITER);
+	rc = dfs_dcache_set(dfs, 0, 0);
+	assert_int_equal(rc, 0);
+	nocache_ns = dcache_stat_loop(dfs, path);
+
+	rc = dfs_dcache_set(dfs, 60, 60);
+	assert_int_equal(rc, 0);
+	cache_ns = dcache_stat_loop(dfs, path);
+
+	rc = dfs_dcache_query(dfs, &stats);
+	assert_int_equal(rc, 0);
+	print_message("no cache: %.0f lookups/sec, cache: %.0f lookups/sec\n",
+		      DCACHE_ITER * 1e9 / nocache_ns, DCACHE_ITER * 1e9 / cache_ns);
+	print_message("hits "DF_U64", negative hits "DF_U64", misses "DF_U64", hit rate %.1f%%\n",
+		      stats.dcs_hits, stats.dcs_neg_hits, stats.dcs_misses,
+		      100.0 * stats.dcs_hits / (stats.dcs_hits + stats.dcs_misses));
+
+	rc = dfs_remove(dfs, NULL, "dc0", true, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_umount(dfs);
+	assert_int_equal(rc, 0);
+}
+
+#define CREATE_MULTI_NR		512
+#define CREATE_MULTI_BATCH	64
+
+static double
+create_rate(test_arg_t *arg, uint64_t elapsed)
+{
+	uint64_t	max = 0;
+
+	/** the slowest rank bounds the aggregate rate */
+	par_reduce(PAR_COMM_WORLD, &elapsed, &max, 1, PAR_UINT64, PAR_MAX, 0);
+	if (max == 0)
+		max = 1;
+	return (double)CREATE_MULTI_NR * arg->rank_size * NSEC_PER_SEC / max;
+}
+
+/** every rank creates files in its own directory, one by one then in batches */
+static void
+dfs_perf_create_multi(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_obj_t	*dir;
+	dfs_obj_t	*obj;
+	char		dirname[32];
+	char		*names[CREATE_MULTI_NR];
+	int		*rcs;
+	uint64_t	start;
+	double		serial_rate;
+	double		multi_rate;
+	int		i;
+	int		rc;
+
+	D_ALLOC_ARRAY(rcs, CREATE_MULTI_NR);
+	assert_non_null(rcs);
+	for (i = 0; i < CREATE_MULTI_NR; i++) {
+		D_ASPRINTF(names[i], "file.%d", i);
+		assert_non_null(names[i]);
+	}
+
+	sprintf(dirname, "multi_dir_%d", arg->myrank);
+	rc = dfs_mkdir(dfs_mt, NULL, dirname, S_IWUSR | S_IRUSR | S_IXUSR, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs_mt, NULL, dirname, O_RDWR, &dir, NULL, NULL);
+	assert_int_equal(rc, 0);
+
+	par_barrier(PAR_COMM_WORLD);
+	start = daos_get_ntime();
+	for (i = 0; i < CREATE_MULTI_NR; i++) {
+		rc = dfs_open(dfs_mt, dir, names[i], S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	serial_rate = create_rate(arg, daos_get_ntime() - start);
+
+	par_barrier(PAR_COMM_WORLD);
+	for (i = 0; i < CREATE_MULTI_NR; i++) {
+		rc = dfs_remove(dfs_mt, dir, names[i], false, NULL);
+		assert_int_equal(rc, 0);
+	}
+
+	par_barrier(PAR_COMM_WORLD);
+	start = daos_get_ntime();
+	for (i = 0; i < CREATE_MULTI_NR; i += CREATE_MULTI_BATCH) {
+		rc = dfs_create_multi(dfs_mt, dir, CREATE_MULTI_BATCH, (const char **)&names[i],
+				      S_IFREG | S_IWUSR | S_IRUSR, 0, 0, &rcs[i], NULL);
+		assert_int_equal(rc, 0);
+	}
+	multi_rate = create_rate(arg, daos_get_ntime() - start);
+	for (i = 0; i < CREATE_MULTI_NR; i++)
+		assert_int_equal(rcs[i], 0);
+
+	if (arg->myrank == 0)
+		print_message("%d ranks, creates/sec: one by one %.0f, batch of %d %.0f\n",
+			      arg->rank_size, serial_rate, CREATE_MULTI_BATCH, multi_rate);
+
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, dirname, true, NULL);
+	assert_int_equal(rc, 0);
+	par_barrier(PAR_COMM_WORLD);
+
+	for (i = 0; i < CREATE_MULTI_NR; i++)
+		D_FREE(names[i]);
+	D_FREE(rcs);
+}
+
+#define RMTREE_WIDTH	4
+#define RMTREE_DEPTH	3
+#define RMTREE_FILES	16
+#define RMTREE_INFLIGHT	64
+
+/** every directory has RMTREE_FILES files and RMTREE_WIDTH sub-directories */
+static void
+rmtree_build(dfs_t *dfs, dfs_obj_t *dir, int depth, uint64_t *entries)
+{
+	dfs_obj_t	*obj;
+	char		name[16];
+	int		i;
+	int		rc;
+
+	for (i = 0; i < RMTREE_FILES; i++) {
+		sprintf(name, "f%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	*entries += RMTREE_FILES;
+
+	if (depth == 0)
+		return;
+
+	for (i = 0; i < RMTREE_WIDTH; i++) {
+		sprintf(name, "d%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rmtree_build(dfs, obj, depth - 1, entries);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+		(*entries)++;
+	}
+}
+
+static uint64_t
+rmtree_time(uint32_t max_inflight, uint64_t *entries)
+{
+	dfs_obj_t	*top;
+	uint64_t	start;
+	int		rc;
+
+	*entries = 0;
+	rc = dfs_open(dfs_mt, NULL, "rmtree", S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &top);
+	assert_int_equal(rc, 0);
+	rmtree_build(dfs_mt, top, RMTREE_DEPTH, entries);
+	rc = dfs_release(top);
+	assert_int_equal(rc, 0);
+
+	start = daos_get_ntime();
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", max_inflight, NULL, NULL, NULL);
+	assert_int_equal(rc, 0);
+	return daos_get_ntime() - start;
+}
+
+/** remove the same directory tree serially, then with operations in flight */
+static void
+dfs_perf_remove_tree(void **state)
+{
+	test_arg_t	*arg = *state;
+	uint64_t	entries;
+	uint64_t	serial_ns, par_ns;
+
+	if (arg->myrank != 0)
+		return;
+
+	serial_ns = rmtree_time(0, &entries);
+	par_ns = rmtree_time(RMTREE_INFLIGHT, &entries);
+	print_message("Tree of "DF_U64" entries, serial: %.0f entries/sec, "
+		      "%d in flight: %.0f entries/sec\n", entries, entries * 1e9 / serial_ns,
+		      RMTREE_INFLIGHT, entries * 1e9 / par_ns);
+}
+
+#define SIZE_HINT_ITER	1000
+#define SIZE_HINT_FSIZE	(5 * 1024 * 1024)
+
+static uint64_t
+size_hint_stat_loop(dfs_t *dfs, const char *name)
+{
+	struct stat	stbuf;
+	uint64_t	start;
+	int		i;
+	int		rc;
+
+	start = daos_get_ntime();
+	for (i = 0; i < SIZE_HINT_ITER; i++) {
+		rc = dfs_stat(dfs, NULL, name, &stbuf);
+		assert_int_equal(rc, 0);
+		assert_int_equal(stbuf.st_size, SIZE_HINT_FSIZE);
+	}
+	return daos_get_ntime() - start;
+}
+
+/** stat of a wide striped file, from its size hint and by querying the array */
+static void
+dfs_perf_size_hint(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_t		*dfs;
+	dfs_obj_t	*obj;
+	const char	*attr_name = "dfs-size-hint";
+	const void	*attr_value = "on";
+	size_t		attr_size = 2;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		*buf;
+	uint64_t	nohint_ns, hint_ns;
+	int		rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	/** dfs_mt was mounted without the hint */
+	rc = daos_cont_set_attr(co_hdl, 1, &attr_name, &attr_value, &attr_size, NULL);
+	assert_rc_equal(rc, 0);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC(buf, 1024 * 1024);
+	assert_non_null(buf);
+	d_iov_set(&iov, buf, 1024 * 1024);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	rc = dfs_open(dfs, NULL, "size_hint", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, OC_SX, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs, obj, &sgl, SIZE_HINT_FSIZE - 1024 * 1024, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	nohint_ns = size_hint_stat_loop(dfs_mt, "size_hint");
+	hint_ns = size_hint_stat_loop(dfs, "size_hint");
+	print_message("stat without hint: %.0f/sec, with hint: %.0f/sec\n",
+		      SIZE_HINT_ITER * 1e9 / nohint_ns, SIZE_HINT_ITER * 1e9 / hint_ns);
+
+	rc = dfs_remove(dfs, NULL, "size_hint", false, NULL);
+	assert_int_equal(rc, 0);
+	D_FREE(buf);
+	rc = dfs_umount(dfs);
+	assert_int_equal(rc, 0);
+	rc = daos_cont_del_attr(co_hdl, 1, &attr_name, NULL);
+	assert_rc_equal(rc, 0);
+}
+
+#define STRIDE_CHUNK		(1024 * 1024)
+#define STRIDE_NR_CHUNKS	16
+#define STRIDE_LEN		512
+#define STRIDE			4096
+#define STRIDE_NR		(STRIDE_CHUNK * STRIDE_NR_CHUNKS / STRIDE)
+
+/** column major read of a wide striped file, one dfs_read per range then one dfs_readx */
+static void
+dfs_perf_strided_read(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_obj_t	*obj;
+	dfs_iod_t	iod;
+	daos_range_t	*rgs;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		*buf;
+	daos_size_t	read_size;
+	daos_size_t	total;
+	uint64_t	start, rg_ns, list_ns;
+	int		i;
+	int		rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	D_ALLOC(buf, STRIDE_CHUNK * STRIDE_NR_CHUNKS);
+	assert_non_null(buf);
+	D_ALLOC_ARRAY(rgs, STRIDE_NR);
+	assert_non_null(rgs);
+
+	rc = dfs_open(dfs_mt, NULL, "strided", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, OC_SX, STRIDE_CHUNK, NULL, &obj);
+	assert_int_equal(rc, 0);
+	d_iov_set(&iov, buf, STRIDE_CHUNK * STRIDE_NR_CHUNKS);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+	rc = dfs_write(dfs_mt, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+
+	/** consecutive ranges alternate between chunks */
+	for (i = 0; i < STRIDE_NR; i++) {
+		int chunk = i % STRIDE_NR_CHUNKS;
+		int row = i / STRIDE_NR_CHUNKS;
+
+		rgs[i].rg_idx = (daos_off_t)chunk * STRIDE_CHUNK + (daos_off_t)row * STRIDE;
+		rgs[i].rg_len = STRIDE_LEN;
+	}
+	total = (daos_size_t)STRIDE_NR * STRIDE_LEN;
+
+	print_message("Reading %d ranges of %d bytes...\n", STRIDE_NR, STRIDE_LEN);
+	d_iov_set(&iov, buf, STRIDE_LEN);
+	start = daos_get_ntime();
+	for (i = 0; i < STRIDE_NR; i++) {
+		iov.iov_buf = buf + (daos_size_t)i * STRIDE_LEN;
+		rc = dfs_read(dfs_mt, obj, &sgl, rgs[i].rg_idx, &read_size, NULL);
+		assert_int_equal(rc, 0);
+		assert_int_equal(read_size, STRIDE_LEN);
+	}
+	rg_ns = daos_get_ntime() - start;
+
+	d_iov_set(&iov, buf, total);
+	iod.iod_nr = STRIDE_NR;
+	iod.iod_rgs = rgs;
+	start = daos_get_ntime();
+	rc = dfs_readx(dfs_mt, obj, &iod, &sgl, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	list_ns = daos_get_ntime() - start;
+	assert_int_equal(read_size, total);
+	print_message("one at a time: %.1f MB/s, readx: %.1f MB/s\n",
+		      total * 1e3 / rg_ns, total * 1e3 / list_ns);
+
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "strided", false, NULL);
+	assert_int_equal(rc, 0);
+	D_FREE(rgs);
+	D_FREE(buf);
+}
+
+static const struct CMUnitTest dfs_perf_tests[] = {
+	{ "DFS_PERF_TEST1: dfs dentry cache lookup rate",
+	  dfs_perf_dcache, async_disable, test_case_teardown},
+	{ "DFS_PERF_TEST2: DFS multi-entry create rate",
+	  dfs_perf_create_multi, async_disable, test_case_teardown},
+	{ "DFS_PERF_TEST3: dfs parallel remove of a directory tree rate",
+	  dfs_perf_remove_tree, async_disable, test_case_teardown},
+	{ "DFS_PERF_TEST4: dfs file size hint stat rate",
+	  dfs_perf_size_hint, async_disable, test_case_teardown},
+	{ "DFS_PERF_TEST5: dfs strided list read bandwidth",
+	  dfs_perf_strided_read, async_disable, test_case_teardown},
+};
+
+static int
+dfs_perf_setup(void **state)
+{
+	test_arg_t	*arg;
+	int		rc = 0;
+
+	rc = test_setup(state, SETUP_POOL_CONNECT, true, DEFAULT_POOL_SIZE, 0, NULL);
+	if (rc != 0)
+		return rc;
+
+	arg = *state;
+
+	if (arg->myrank == 0) {
+		rc = dfs_cont_create(arg->pool.poh, &co_uuid, NULL, &co_hdl, &dfs_mt);
+		assert_int_equal(rc, 0);
+		print_message("Created DFS Container "DF_UUIDF"\n", DP_UUID(co_uuid));
+	}
+
+	handle_share(&co_hdl, HANDLE_CO, arg->myrank, arg->pool.poh, 0);
+	dfs_test_share(arg->pool.poh, co_hdl, arg->myrank, &dfs_mt);
+
+	return rc;
+}
+
+static int
+dfs_perf_teardown(void **state)
+{
+	test_arg_t	*arg = *state;
+	int		rc;
+
+	rc = dfs_umount(dfs_mt);
+	assert_int_equal(rc, 0);
+	rc = daos_cont_close(co_hdl, NULL);
+	assert_int_equal(rc, 0);
+
+	par_barrier(PAR_COMM_WORLD);
+	if (arg->myrank == 0) {
+		char str[37];
+
+		uuid_unparse(co_uuid, str);
+		rc = daos_cont_destroy(arg->pool.poh, str, 0, NULL);
+		assert_rc_equal(rc, 0);
+		print_message("Destroyed DFS Container "DF_UUIDF"\n", DP_UUID(co_uuid));
+	}
+	par_barrier(PAR_COMM_WORLD);
+
+	return test_teardown(state);
+}
+
+int
+run_dfs_perf_test(int rank, int size)
+{
+	int rc = 0;
+
+	par_barrier(PAR_COMM_WORLD);
+	rc = cmocka_run_group_tests_name("DAOS_FileSystem_DFS_Perf", dfs_perf_tests,
+					 dfs_perf_setup, dfs_perf_teardown);
+	par_barrier(PAR_COMM_WORLD);
+	return rc;
+}
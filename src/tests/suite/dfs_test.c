@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -20,6 +20,8 @@
  */
 #define TESTS "pus"
 static const char *all_tests = TESTS;
+/** benchmarks, not part of the default run */
+#define PERF_TESTS "b"
 
 static void
 print_usage(int rank)
@@ -32,6 +34,7 @@ print_usage(int rank)
 	print_message("dfs_test -p|--parallel\n");
 	print_message("dfs_test -u|--unit\n");
 	print_message("dfs_test -s|--sys\n");
+	print_message("dfs_test -b|--perf\n");
 	print_message("Default <daos_tests> runs all tests\n=============\n");
 	print_message("dfs_test -E|--exclude TESTS\n");
 	print_message("dfs_test -n|--dmg_config\n");
@@ -67,6 +70,12 @@ run_specified_tests(const char *tests, int rank, int size,
 			daos_test_print(rank, "=====================");
 			nr_failed += run_dfs_sys_unit_test(rank, size);
 			break;
+		case 'b':
+			daos_test_print(rank, "\n\n=================");
+			daos_test_print(rank, "DFS benchmarks..");
+			daos_test_print(rank, "=====================");
+			nr_failed += run_dfs_perf_test(rank, size);
+			break;
 
 		default:
 			D_ASSERT(0);
@@ -106,6 +115,7 @@ main(int argc, char **argv)
 		{"parallel",	no_argument,		NULL,	'p'},
 		{"unit",	no_argument,		NULL,	'u'},
 		{"sys",		no_argument,		NULL,	's'},
+		{"perf",	no_argument,		NULL,	'b'},
 		{NULL,		0,			NULL,	0}
 	};
 
@@ -117,9 +127,9 @@ main(int argc, char **argv)
 
 	memset(tests, 0, sizeof(tests));
 
-	while ((opt = getopt_long(argc, argv, "aE:n:pus",
+	while ((opt = getopt_long(argc, argv, "aE:n:pusb",
 				  long_options, &index)) != -1) {
-		if (strchr(all_tests, opt) != NULL) {
+		if (strchr(all_tests, opt) != NULL || strchr(PERF_TESTS, opt) != NULL) {
 			tests[ntests] = opt;
 			ntests++;
 			continue;
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -19,6 +19,7 @@
 int run_dfs_unit_test(int rank, int size);
 int run_dfs_par_test(int rank, int size);
 int run_dfs_sys_unit_test(int rank, int size);
+int run_dfs_perf_test(int rank, int size);
 
 static inline void
 dfs_test_share(daos_handle_t poh, daos_handle_t coh, int rank, dfs_t **dfs)
@@ -2388,6 +2388,540 @@ dfs_test_xattrs(void **state)
 	assert_int_equal(rc, 0);
 }
 
+#define DCACHE_DEPTH	8
+
+/** the lookup rate with the dentry cache is measured by DFS_PERF_TEST1 */
+static void
+dfs_test_dcache(void **state)
+{
+	test_arg_t		*arg = *state;
+	dfs_t			*dfs;
+	dfs_obj_t		*dir, *file, *file2;
+	dfs_dcache_stats_t	stats;
+	struct stat		stbuf;
+	char			path[DCACHE_DEPTH * 8 + 16] = "";
+	char			name[16];
+	int			i;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	/** separate mount so that dfs_mt sees changes as another client would */
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs);
+	assert_int_equal(rc, 0);
+
+	print_message("Negative entries hide a remote create until they expire...\n");
+	rc = dfs_dcache_set(dfs, 60, 60);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_f", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_open(dfs_mt, NULL, "dcache_f", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &file);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_f", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_dcache_query(dfs, &stats);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stats.dcs_neg_hits, 1);
+
+	/** a negative entry of a microsecond is expired by the time the remote create is done */
+	rc = dfs_dcache_set(dfs, 0, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_dcache_set(dfs, 60, 1e-6);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_g", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_open(dfs_mt, NULL, "dcache_g", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &file2);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_g", &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_dcache_query(dfs, &stats);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stats.dcs_neg_hits, 0);
+	rc = dfs_release(file2);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "dcache_g", false, NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("Local changes invalidate the cached entry...\n");
+	rc = dfs_stat(dfs, NULL, "dcache_f", &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_chmod(dfs, NULL, "dcache_f", S_IFREG | S_IRUSR);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_f", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_mode, S_IFREG | S_IRUSR);
+	rc = dfs_remove(dfs, NULL, "dcache_f", false, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "dcache_f", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	rc = dfs_release(file);
+	assert_int_equal(rc, 0);
+
+	/** deep path of directories with a file at the bottom */
+	dir = NULL;
+	for (i = 0; i < DCACHE_DEPTH; i++) {
+		dfs_obj_t *parent = dir;
+
+		sprintf(name, "dc%d", i);
+		rc = dfs_open(dfs, parent, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+			      O_RDWR | O_CREAT, 0, 0, NULL, &dir);
+		assert_int_equal(rc, 0);
+		if (parent) {
+			rc = dfs_release(parent);
+			assert_int_equal(rc, 0);
+		}
+		strcat(path, "/");
+		strcat(path, name);
+	}
+	rc = dfs_open(dfs, dir, "file", S_IFREG | S_IWUSR | S_IRUSR, O_RDWR | O_CREAT, 0, 0,
+		      NULL, &file);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(file);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(dir);
+	assert_int_equal(rc, 0);
+	strcat(path, "/file");
+
+	print_message("Repeated lookups of %s only miss once per component...\n", path);
+	rc = dfs_dcache_set(dfs, 0, 0);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup(dfs, path, O_RDONLY, &file, NULL, &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(file);
+	assert_int_equal(rc, 0);
+	/** a disabled cache is flushed and no longer used */
+	rc = dfs_dcache_query(dfs, &stats);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stats.dcs_nr, 0);
+	assert_int_equal(stats.dcs_misses, 0);
+
+	rc = dfs_dcache_set(dfs, 60, 60);
+	assert_int_equal(rc, 0);
+	for (i = 0; i < 4; i++) {
+		rc = dfs_lookup(dfs, path, O_RDONLY, &file, NULL, &stbuf);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(file);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_dcache_query(dfs, &stats);
+	assert_int_equal(rc, 0);
+	assert_true(stats.dcs_misses <= DCACHE_DEPTH + 1);
+	assert_true(stats.dcs_hits > stats.dcs_misses);
+
+	rc = dfs_remove(dfs, NULL, "dc0", true, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_umount(dfs);
+	assert_int_equal(rc, 0);
+}
+
+#define RMTREE_WIDTH	4
+#define RMTREE_DEPTH	3
+#define RMTREE_FILES	16
+#define RMTREE_INFLIGHT	64
+
+/** every directory has RMTREE_FILES files, a symlink and RMTREE_WIDTH sub-directories */
+static void
+rmtree_build(dfs_t *dfs, dfs_obj_t *dir, int depth, uint64_t *dirs, uint64_t *files)
+{
+	dfs_obj_t	*obj;
+	char		name[16];
+	int		i;
+	int		rc;
+
+	for (i = 0; i < RMTREE_FILES; i++) {
+		sprintf(name, "f%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFREG | S_IWUSR | S_IRUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+	}
+	rc = dfs_open(dfs, dir, "sym", S_IFLNK, O_RDWR | O_CREAT | O_EXCL, 0, 0, "f0", &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	*files += RMTREE_FILES + 1;
+
+	if (depth == 0)
+		return;
+
+	for (i = 0; i < RMTREE_WIDTH; i++) {
+		sprintf(name, "d%d", i);
+		rc = dfs_open(dfs, dir, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+			      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+		assert_int_equal(rc, 0);
+		rmtree_build(dfs, obj, depth - 1, dirs, files);
+		rc = dfs_release(obj);
+		assert_int_equal(rc, 0);
+		(*dirs)++;
+	}
+}
+
+static void
+rmtree_create(dfs_t *dfs, const char *name, uint64_t *dirs, uint64_t *files)
+{
+	dfs_obj_t	*top;
+	int		rc;
+
+	*dirs = 0;
+	*files = 0;
+	rc = dfs_open(dfs, NULL, name, S_IFDIR | S_IWUSR | S_IRUSR | S_IXUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &top);
+	assert_int_equal(rc, 0);
+	rmtree_build(dfs, top, RMTREE_DEPTH, dirs, files);
+	rc = dfs_release(top);
+	assert_int_equal(rc, 0);
+}
+
+struct rmtree_progress {
+	uint64_t		rp_calls;
+	dfs_remove_stats_t	rp_last;
+	uint32_t		rp_max_inflight;
+	/** fail the removal once this many directories are gone, 0 to never fail */
+	uint64_t		rp_cancel_dirs;
+};
+
+static int
+rmtree_progress_cb(dfs_remove_stats_t *stats, void *arg)
+{
+	struct rmtree_progress *prog = arg;
+
+	prog->rp_calls++;
+	prog->rp_last = *stats;
+	if (stats->drs_inflight > prog->rp_max_inflight)
+		prog->rp_max_inflight = stats->drs_inflight;
+	if (prog->rp_cancel_dirs && stats->drs_dirs >= prog->rp_cancel_dirs)
+		return ECANCELED;
+	return 0;
+}
+
+/** the removal rate, serial vs. parallel, is measured by DFS_PERF_TEST3 */
+static void
+dfs_test_remove_tree(void **state)
+{
+	test_arg_t		*arg = *state;
+	struct rmtree_progress	prog = {0};
+	struct stat		stbuf;
+	uint64_t		dirs, files;
+	bool			use_dtx = false;
+	int			rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	d_getenv_bool("DFS_USE_DTX", &use_dtx);
+
+	rmtree_create(dfs_mt, "rmtree", &dirs, &files);
+	print_message("Tree of "DF_U64" dirs and "DF_U64" files, removed serially...\n",
+		      dirs, files);
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", 0, NULL, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_mt, NULL, "rmtree", &stbuf);
+	assert_int_equal(rc, ENOENT);
+
+	rmtree_create(dfs_mt, "rmtree", &dirs, &files);
+	print_message("Same tree, removed with %d operations in flight...\n", RMTREE_INFLIGHT);
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", RMTREE_INFLIGHT, rmtree_progress_cb, &prog,
+			     NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_mt, NULL, "rmtree", &stbuf);
+	assert_int_equal(rc, ENOENT);
+
+	/** a transaction is committed at once, the tree is removed serially */
+	if (use_dtx)
+		return;
+
+	assert_true(prog.rp_calls > 0);
+	assert_true(prog.rp_max_inflight <= RMTREE_INFLIGHT);
+	assert_int_equal(prog.rp_last.drs_dirs, dirs);
+	assert_int_equal(prog.rp_last.drs_files, files);
+	assert_int_equal(prog.rp_last.drs_inflight, 0);
+
+	print_message("Same tree, removed with one operation in flight...\n");
+	rmtree_create(dfs_mt, "rmtree", &dirs, &files);
+	memset(&prog, 0, sizeof(prog));
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", 1, rmtree_progress_cb, &prog, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_mt, NULL, "rmtree", &stbuf);
+	assert_int_equal(rc, ENOENT);
+	assert_true(prog.rp_max_inflight <= 1);
+	assert_int_equal(prog.rp_last.drs_dirs, dirs);
+	assert_int_equal(prog.rp_last.drs_files, files);
+
+	print_message("Removal stopped by the progress callback...\n");
+	rmtree_create(dfs_mt, "rmtree", &dirs, &files);
+	memset(&prog, 0, sizeof(prog));
+	prog.rp_cancel_dirs = 1;
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", RMTREE_INFLIGHT, rmtree_progress_cb, &prog,
+			     NULL);
+	assert_int_equal(rc, ECANCELED);
+	rc = dfs_stat(dfs_mt, NULL, "rmtree", &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove_tree(dfs_mt, NULL, "rmtree", RMTREE_INFLIGHT, NULL, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs_mt, NULL, "rmtree", &stbuf);
+	assert_int_equal(rc, ENOENT);
+}
+
+/** the stat rate with and without the size hint is measured by DFS_PERF_TEST4 */
+static void
+dfs_test_size_hint(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_t		*dfs;
+	dfs_obj_t	*obj, *obj2;
+	const char	*attr_name = "dfs-size-hint";
+	const void	*attr_value = "on";
+	size_t		attr_size = 2;
+	d_sg_list_t	sgl;
+	d_iov_t		iov;
+	char		*buf;
+	struct stat	stbuf, hint_stbuf;
+	daos_size_t	size;
+	int		rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	rc = daos_cont_set_attr(co_hdl, 1, &attr_name, &attr_value, &attr_size, NULL);
+	assert_rc_equal(rc, 0);
+	rc = dfs_mount(arg->pool.poh, co_hdl, O_RDWR, &dfs);
+	assert_int_equal(rc, 0);
+
+	D_ALLOC(buf, 1024 * 1024);
+	assert_non_null(buf);
+	d_iov_set(&iov, buf, 1024 * 1024);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+
+	/** wide striped, where querying the size is the most expensive */
+	rc = dfs_open(dfs, NULL, "size_hint", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, OC_SX, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+
+	print_message("Size is queried while the file is being written...\n");
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 1024 * 1024);
+	rc = dfs_get_size(dfs, obj, &size);
+	assert_int_equal(rc, 0);
+	assert_int_equal(size, 1024 * 1024);
+	rc = dfs_write(dfs, obj, &sgl, 4 * 1024 * 1024, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 5 * 1024 * 1024);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+
+	print_message("Size and times come from the hint once released...\n");
+	rc = dfs_stat(dfs_mt, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &hint_stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(hint_stbuf.st_size, stbuf.st_size);
+	assert_int_equal(hint_stbuf.st_blocks, stbuf.st_blocks);
+	assert_int_equal(hint_stbuf.st_mtim.tv_sec, stbuf.st_mtim.tv_sec);
+	assert_int_equal(hint_stbuf.st_mtim.tv_nsec, stbuf.st_mtim.tv_nsec);
+
+	print_message("Truncate updates the hint...\n");
+	rc = dfs_lookup_rel(dfs, NULL, "size_hint", O_RDWR, &obj, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_punch(dfs, obj, 4096, DFS_MAX_FSIZE);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 4096);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 4096);
+
+	print_message("The hint is not used while another handle is still writing...\n");
+	rc = dfs_lookup_rel(dfs, NULL, "size_hint", O_RDWR, &obj, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_lookup_rel(dfs, NULL, "size_hint", O_RDWR, &obj2, NULL, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs, obj2, &sgl, 1024 * 1024, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj2);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs, obj, &sgl, 2 * 1024 * 1024, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 3 * 1024 * 1024);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 3 * 1024 * 1024);
+
+	print_message("A new file with the same name does not use the old hint...\n");
+	rc = dfs_remove(dfs_mt, NULL, "size_hint", false, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_open(dfs_mt, NULL, "size_hint", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, 0, 0, NULL, &obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_write(dfs_mt, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_stat(dfs, NULL, "size_hint", &stbuf);
+	assert_int_equal(rc, 0);
+	assert_int_equal(stbuf.st_size, 1024 * 1024);
+
+	rc = dfs_remove(dfs, NULL, "size_hint", false, NULL);
+	assert_int_equal(rc, 0);
+	D_FREE(buf);
+	rc = dfs_umount(dfs);
+	assert_int_equal(rc, 0);
+	rc = daos_cont_del_attr(co_hdl, 1, &attr_name, NULL);
+	assert_rc_equal(rc, 0);
+}
+
+#define STRIDE_CHUNK	(1024 * 1024)
+#define STRIDE_NR_CHUNKS	16
+#define STRIDE_LEN	512
+#define STRIDE		4096
+#define STRIDE_NR	(STRIDE_CHUNK * STRIDE_NR_CHUNKS / STRIDE)
+
+/** byte at offset off of the strided test file */
+static inline char
+stride_pattern(daos_off_t off)
+{
+	return (char)(off * 7 + off / 4096);
+}
+
+static void
+stride_check(char *buf, daos_range_t *rgs, int nr)
+{
+	daos_size_t	pos = 0;
+	daos_size_t	j;
+	int		i;
+
+	for (i = 0; i < nr; i++) {
+		for (j = 0; j < rgs[i].rg_len; j++)
+			assert_int_equal(buf[pos + j], stride_pattern(rgs[i].rg_idx + j));
+		pos += rgs[i].rg_len;
+	}
+}
+
+/** the bandwidth of dfs_readx vs. one dfs_read per range is measured by DFS_PERF_TEST5 */
+static void
+dfs_test_strided_read(void **state)
+{
+	test_arg_t	*arg = *state;
+	dfs_obj_t	*obj;
+	dfs_iod_t	iod;
+	daos_range_t	*rgs;
+	d_sg_list_t	sgl, msgl;
+	d_iov_t		iov;
+	d_iov_t		iovs[STRIDE_NR_CHUNKS];
+	char		*buf;
+	char		*rbuf;
+	daos_size_t	read_size;
+	daos_size_t	total;
+	int		i;
+	int		rc;
+
+	if (arg->myrank != 0)
+		return;
+
+	D_ALLOC(buf, STRIDE_CHUNK * STRIDE_NR_CHUNKS);
+	assert_non_null(buf);
+	D_ALLOC(rbuf, STRIDE_NR * STRIDE_LEN);
+	assert_non_null(rbuf);
+	D_ALLOC_ARRAY(rgs, STRIDE_NR);
+	assert_non_null(rgs);
+	for (i = 0; i < STRIDE_CHUNK * STRIDE_NR_CHUNKS; i++)
+		buf[i] = stride_pattern(i);
+
+	rc = dfs_open(dfs_mt, NULL, "strided", S_IFREG | S_IWUSR | S_IRUSR,
+		      O_RDWR | O_CREAT | O_EXCL, OC_SX, STRIDE_CHUNK, NULL, &obj);
+	assert_int_equal(rc, 0);
+	d_iov_set(&iov, buf, STRIDE_CHUNK * STRIDE_NR_CHUNKS);
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+	sgl.sg_iovs = &iov;
+	rc = dfs_write(dfs_mt, obj, &sgl, 0, NULL);
+	assert_int_equal(rc, 0);
+
+	/** column major order, consecutive ranges alternate between chunks */
+	for (i = 0; i < STRIDE_NR; i++) {
+		int chunk = i % STRIDE_NR_CHUNKS;
+		int row = i / STRIDE_NR_CHUNKS;
+
+		rgs[i].rg_idx = (daos_off_t)chunk * STRIDE_CHUNK + (daos_off_t)row * STRIDE;
+		rgs[i].rg_len = STRIDE_LEN;
+	}
+	total = (daos_size_t)STRIDE_NR * STRIDE_LEN;
+
+	print_message("Reading %d ranges of %d bytes with a single dfs_readx...\n", STRIDE_NR,
+		      STRIDE_LEN);
+	d_iov_set(&iov, rbuf, total);
+	iod.iod_nr = STRIDE_NR;
+	iod.iod_rgs = rgs;
+	rc = dfs_readx(dfs_mt, obj, &iod, &sgl, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(read_size, total);
+	stride_check(rbuf, rgs, STRIDE_NR);
+
+	print_message("Same ranges split over several memory segments...\n");
+	memset(rbuf, 0, total);
+	for (i = 0; i < STRIDE_NR_CHUNKS; i++)
+		d_iov_set(&iovs[i], rbuf + (daos_size_t)i * (total / STRIDE_NR_CHUNKS),
+			  total / STRIDE_NR_CHUNKS);
+	msgl.sg_nr = STRIDE_NR_CHUNKS;
+	msgl.sg_nr_out = 0;
+	msgl.sg_iovs = iovs;
+	rc = dfs_readx(dfs_mt, obj, &iod, &msgl, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(read_size, total);
+	stride_check(rbuf, rgs, STRIDE_NR);
+
+	print_message("Overlapping ranges and ranges past EOF...\n");
+	memset(rbuf, 0, total);
+	rgs[0].rg_idx = 100;
+	rgs[0].rg_len = 1000;
+	rgs[1].rg_idx = STRIDE_CHUNK - 10;
+	rgs[1].rg_len = 20;
+	rgs[2].rg_idx = 500;
+	rgs[2].rg_len = 1000;
+	iod.iod_nr = 3;
+	d_iov_set(&iov, rbuf, 2020);
+	rc = dfs_readx(dfs_mt, obj, &iod, &sgl, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(read_size, 2020);
+	stride_check(rbuf, rgs, 3);
+
+	rgs[2].rg_idx = (daos_off_t)STRIDE_CHUNK * STRIDE_NR_CHUNKS - 100;
+	rgs[2].rg_len = 200;
+	d_iov_set(&iov, rbuf, 1220);
+	rc = dfs_readx(dfs_mt, obj, &iod, &sgl, &read_size, NULL);
+	assert_int_equal(rc, 0);
+	assert_int_equal(read_size, 1120);
+	rgs[2].rg_len = 100;
+	stride_check(rbuf, rgs, 3);
+
+	rc = dfs_release(obj);
+	assert_int_equal(rc, 0);
+	rc = dfs_remove(dfs_mt, NULL, "strided", false, NULL);
+	assert_int_equal(rc, 0);
+	D_FREE(rgs);
+	D_FREE(rbuf);
+	D_FREE(buf);
+}
+
 static const struct CMUnitTest dfs_unit_tests[] = {
 	{ "DFS_UNIT_TEST1: DFS mount / umount",
 	  dfs_test_mount, async_disable, test_case_teardown},
@@ -2433,6 +2967,14 @@ static const struct CMUnitTest dfs_unit_tests[] = {
 	  dfs_test_multiple_pools, async_disable, test_case_teardown},
 	{ "DFS_UNIT_TEST22: dfs extended attributes",
 	  dfs_test_xattrs, test_case_teardown},
+	{ "DFS_UNIT_TEST23: dfs dentry cache",
+	  dfs_test_dcache, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST24: dfs parallel remove of a directory tree",
+	  dfs_test_remove_tree, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST25: dfs file size hint",
+	  dfs_test_size_hint, async_disable, test_case_teardown},
+	{ "DFS_UNIT_TEST26: dfs strided list read",
+	  dfs_test_strided_read, async_disable, test_case_teardown},
 };
 
 static int
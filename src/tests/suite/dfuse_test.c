@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2021-2022 Intel Corporation.
+ * (C) Copyright 2021-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -267,10 +267,11 @@ do_stream(void **state)
 void
 do_ioctl(void **state)
 {
-	int                     fd;
-	int                     rc;
-	struct dfuse_user_reply dur  = {};
-	int                     root = open(test_dir, O_DIRECTORY);
+	int                         fd;
+	int                         rc;
+	struct dfuse_user_reply     dur  = {};
+	struct dfuse_eq_stats_reply eqr  = {};
+	int                         root = open(test_dir, O_DIRECTORY);
 
 	assert_return_code(root, errno);
 
@@ -294,6 +295,14 @@ do_ioctl(void **state)
 	assert_int_equal(dur.uid, geteuid());
 	assert_int_equal(dur.gid, getegid());
 
+	/* Event queue statistics, there is always at least one queue */
+	rc = ioctl(fd, DFUSE_IOCTL_EQ_STATS, &eqr);
+	assert_return_code(rc, errno);
+
+	assert_int_equal(eqr.eqr_version, DFUSE_IOCTL_VERSION);
+	assert_in_range(eqr.eqr_count, 1, DFUSE_IOCTL_EQ_MAX);
+	assert_true(eqr.eqr_eqs[0].des_max_depth >= eqr.eqr_eqs[0].des_depth);
+
 out:
 
 	rc = close(fd);
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2018-2022 Intel Corporation.
+ * (C) Copyright 2018-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -21,6 +21,7 @@
 #include <daos/common.h>
 #include <daos/tests_lib.h>
 #include <daos_srv/vos.h>
+#include <daos_srv/dtx_srv.h>
 #include <daos_test.h>
 #include <daos/dts.h>
 #include "perf_internal.h"
@@ -275,6 +276,9 @@ iter_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type, vos_ite
 {
 	struct pf_param *ppa = cb_arg;
 
+	if (type == VOS_ITER_DKEY || type == VOS_ITER_AKEY)
+		ppa->pa_iter.keys++;
+
 	if (ppa->pa_verbose) {
 		switch (type) {
 		case VOS_ITER_DKEY:
@@ -297,12 +301,66 @@ iter_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type, vos_ite
 	return 0;
 }
 
+/* Iterate the keys of @type with vos_iter_fetch_batch, and the akeys of each dkey */
+static int
+obj_iter_keys_batch(vos_iter_param_t *param, vos_iter_type_t type, vos_iter_entry_t *ents,
+		    struct pf_param *ppa)
+{
+	vos_iter_param_t	 akey_param;
+	daos_handle_t		 ih;
+	unsigned int		 nr;
+	unsigned int		 i;
+	int			 rc;
+
+	rc = vos_iter_prepare(type, param, &ih, NULL);
+	if (rc == -DER_NONEXIST)
+		return 0;
+	if (rc)
+		return rc;
+
+	rc = vos_iter_probe(ih, NULL);
+	while (rc == 0) {
+		nr = ppa->pa_iter.batch;
+		rc = vos_iter_fetch_batch(ih, ents, NULL, &nr);
+		if (rc != 0 && rc != -DER_NONEXIST)
+			break;
+
+		ppa->pa_iter.keys += nr;
+		if (type == VOS_ITER_AKEY) {
+			if (ppa->pa_verbose) {
+				for (i = 0; i < nr; i++)
+					D_PRINT("\takey ="DF_KEY"\n", DP_KEY(&ents[i].ie_key));
+			}
+			continue;
+		}
+
+		for (i = 0; i < nr; i++) {
+			int	krc;
+
+			if (ppa->pa_verbose)
+				D_PRINT("\tdkey ="DF_KEY"\n", DP_KEY(&ents[i].ie_key));
+			akey_param = *param;
+			akey_param.ip_dkey = ents[i].ie_key;
+			krc = obj_iter_keys_batch(&akey_param, VOS_ITER_AKEY,
+						  &ents[ppa->pa_iter.batch], ppa);
+			if (krc) {
+				rc = krc;
+				break;
+			}
+		}
+	}
+	vos_iter_finish(ih);
+
+	return rc == -DER_NONEXIST ? 0 : rc;
+}
+
 /* Iterate all of dkey/akey/record */
 static int
 obj_iter_records(daos_unit_oid_t oid, struct pf_param *ppa)
 {
 	struct vos_iter_anchors	anchors = {0};
 	vos_iter_param_t	param = {};
+	vos_iter_entry_t	*ents = NULL;
 	int			rc = 0;
 	uint64_t		start = 0;
 
@@ -318,11 +376,24 @@ obj_iter_records(daos_unit_oid_t oid, struct pf_param *ppa)
 	param.ip_epr.epr_hi = DAOS_EPOCH_MAX;
 	param.ip_epc_expr = VOS_IT_EPC_RR;
 
+	/* dkey entries have to stay valid while iterating the akeys */
+	if (ppa->pa_iter.batch > 0) {
+		D_ALLOC_ARRAY(ents, 2 * ppa->pa_iter.batch);
+		if (ents == NULL)
+			return -DER_NOMEM;
+	}
+
 	TS_TIME_START(&ppa->pa_duration, start);
 	if (ppa->pa_verbose)
 		D_PRINT("Iteration dkeys in "DF_UOID"\n", DP_UOID(oid));
-	rc = vos_iterate(&param, VOS_ITER_DKEY, true, &anchors, iter_cb, NULL, ppa, NULL);
+	if (ents != NULL)
+		rc = obj_iter_keys_batch(&param, VOS_ITER_DKEY, ents, ppa);
+	else
+		rc = vos_iterate(&param, VOS_ITER_DKEY, true, &anchors, iter_cb, NULL, ppa,
+				 NULL);
 	TS_TIME_END(&ppa->pa_duration, start);
+
+	D_FREE(ents);
 	return rc;
 }
 
@@ -504,11 +575,76 @@ pf_discard(struct pf_test *ts, struct pf_param *param)
 	return rc;
 }
 
+struct gc_busy_arg {
+	/* updates the first dkey of each object */
+	struct pf_param	ga_param;
+	uint64_t	ga_ios;
+	uint64_t	ga_lat_total;
+	uint64_t	ga_lat_max;
+	int		ga_rc;
+};
+
+/* Foreground updates between GC batches, like the engine scheduler would run them */
+static int
+gc_busy_yield(void *arg)
+{
+	struct gc_busy_arg	*ga = arg;
+	uint64_t		 start;
+	uint64_t		 lat;
+
+	start = daos_get_ntime();
+	ga->ga_rc = objects_update(&ga->ga_param);
+	if (ga->ga_rc != 0)
+		return -1;
+
+	lat = daos_get_ntime() - start;
+	ga->ga_lat_total += lat;
+	ga->ga_lat_max = max(ga->ga_lat_max, lat);
+	ga->ga_ios++;
+
+	return VOS_GC_YIELD_BUSY;
+}
+
+static int
+gc_busy(struct pf_param *param)
+{
+	struct gc_busy_arg	ga = { 0 };
+	uint64_t		start = 0;
+	int			rc;
+
+	rc = objects_open();
+	if (rc)
+		return rc;
+
+	ga.ga_param = *param;
+	ga.ga_param.pa_dkey_nr = 1;
+
+	TS_TIME_START(&param->pa_duration, start);
+	do {
+		rc = vos_gc_pool(ts_ctx.tsc_poh, -1, gc_busy_yield, &ga);
+		if (rc >= 0)
+			rc = ga.ga_rc;
+	} while (rc == 0 && !vos_gc_pool_idle(ts_ctx.tsc_poh));
+	TS_TIME_END(&param->pa_duration, start);
+	if (rc)
+		return rc;
+
+	if (ga.ga_ios != 0)
+		D_PRINT("Foreground updates: "DF_U64", latency avg "DF_U64" us, max "DF_U64
+			" us\n", ga.ga_ios, ga.ga_lat_total / ga.ga_ios / NSEC_PER_USEC,
+			ga.ga_lat_max / NSEC_PER_USEC);
+
+	return objects_close();
+}
+
 static int
 pf_gc(struct pf_test *ts, struct pf_param *param)
 {
 	uint64_t		start = 0;
 
+	if (param->pa_agg.gc_busy)
+		return gc_busy(param);
+
 	TS_TIME_START(&param->pa_duration, start);
 
 	gc_wait();
@@ -518,6 +654,140 @@ pf_gc(struct pf_test *ts, struct pf_param *param)
 	return 0;
 }
 
+#define TS_REOPEN_CONTS	1000
+
+/* Leave a prepared DTX in the container, like an engine that stopped in the middle of I/O */
+static int
+cont_prepare_dtx(daos_handle_t coh)
+{
+	struct dtx_handle	*dth;
+	struct dtx_memberships	*mbs;
+	daos_unit_oid_t		 oid = dts_unit_oid_gen(0, 0);
+	daos_key_t		 dkey;
+	daos_iod_t		 iod = { 0 };
+	d_sg_list_t		 sgl;
+	d_iov_t			 val;
+	char			 buf[16] = { 0 };
+	int			 rc;
+
+	D_ALLOC_PTR(dth);
+	if (dth == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC(mbs, sizeof(*mbs) + sizeof(struct dtx_daos_target));
+	if (mbs == NULL) {
+		D_FREE(dth);
+		return -DER_NOMEM;
+	}
+	mbs->dm_tgt_cnt = 1;
+	mbs->dm_grp_cnt = 1;
+	mbs->dm_data_size = sizeof(struct dtx_daos_target);
+	mbs->dm_tgts[0].ddt_id = 1;
+
+	daos_dti_gen_unique(&dth->dth_xid);
+	dth->dth_ver = 1;
+	dth->dth_refs = 1;
+	dth->dth_mbs = mbs;
+	dth->dth_coh = coh;
+	dth->dth_epoch = d_hlc_get();
+	dth->dth_leader_oid = oid;
+	dth->dth_flags = DTE_LEADER;
+	dth->dth_modification_cnt = 1;
+	dth->dth_op_seq = 1;
+	D_INIT_LIST_HEAD(&dth->dth_share_cmt_list);
+	D_INIT_LIST_HEAD(&dth->dth_share_abt_list);
+	D_INIT_LIST_HEAD(&dth->dth_share_act_list);
+	D_INIT_LIST_HEAD(&dth->dth_share_tbd_list);
+
+	d_iov_set(&dkey, "dkey", strlen("dkey"));
+	dth->dth_dkey_hash = d_hash_murmur64((const unsigned char *)dkey.iov_buf,
+					     dkey.iov_len, 5731);
+	d_iov_set(&iod.iod_name, "akey", strlen("akey"));
+	iod.iod_type = DAOS_IOD_SINGLE;
+	iod.iod_size = sizeof(buf);
+	iod.iod_nr = 1;
+	d_iov_set(&val, buf, sizeof(buf));
+	sgl.sg_iovs = &val;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+
+	rc = vos_dtx_rsrvd_init(dth);
+	if (rc == 0) {
+		vos_dtx_attach(dth, false, false);
+		rc = vos_obj_update_ex(coh, oid, dth->dth_epoch, 0, 0, &dkey, 1, &iod, NULL,
+				       &sgl, dth);
+		vos_dtx_detach(dth);
+	}
+	vos_dtx_rsrvd_fini(dth);
+	D_FREE(mbs);
+	D_FREE(dth);
+	return rc;
+}
+
+/*
+ * Time to reopen containers with active DTX entries, it stands in for an engine restart.
+ * Run it with and without DAOS_VOS_LAZY_INDEX to compare.
+ */
+static int
+pf_reopen(struct pf_test *ts, struct pf_param *param)
+{
+	uuid_t		*uuids;
+	daos_handle_t	*cohs;
+	double		 duration = 0;
+	uint64_t	 start = 0;
+	int		 nr = param->pa_cont.cont_nr;
+	int		 i;
+	int		 rc = 0;
+
+	if (nr == 0)
+		nr = TS_REOPEN_CONTS;
+
+	D_ALLOC_ARRAY(uuids, nr);
+	D_ALLOC_ARRAY(cohs, nr);
+	if (uuids == NULL || cohs == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < nr; i++) {
+		uuid_generate(uuids[i]);
+		rc = vos_cont_create(ts_ctx.tsc_poh, uuids[i]);
+		if (rc)
+			goto destroy;
+		rc = vos_cont_open(ts_ctx.tsc_poh, uuids[i], &cohs[i]);
+		if (rc)
+			goto destroy;
+		rc = cont_prepare_dtx(cohs[i]);
+		vos_cont_close(cohs[i]);
+		if (rc)
+			goto destroy;
+	}
+
+	/* Drop the DRAM state of the containers as a restart does, reopen them */
+	TS_TIME_START(&duration, start);
+	for (i = 0; i < nr; i++) {
+		rc = vos_cont_open(ts_ctx.tsc_poh, uuids[i], &cohs[i]);
+		if (rc)
+			break;
+	}
+	TS_TIME_END(&duration, start);
+	param->pa_duration += duration;
+
+	if (param->pa_perf && rc == 0)
+		D_PRINT("Reopen %d containers: %.0f us\n", nr, duration);
+
+	while (--i >= 0)
+		vos_cont_close(cohs[i]);
+	i = nr;
+destroy:
+	while (--i >= 0)
+		vos_cont_destroy(ts_ctx.tsc_poh, uuids[i]);
+out:
+	D_FREE(cohs);
+	D_FREE(uuids);
+	return rc;
+}
+
 static int
 pf_verify(struct pf_test *ts, struct pf_param *param)
 {
@@ -606,6 +876,14 @@ pf_parse_iterate_cb(char *str, struct pf_param *pa, char **strp)
 		pa->pa_iter.visible = true;
 		str++;
 		break;
+	case 'b':
+		str++;
+		if (*str != PARAM_ASSIGN)
+			return -1;
+		pa->pa_iter.batch = strtol(&str[1], &str, 0);
+		if (pa->pa_iter.batch < 0)
+			return -1;
+		break;
 	}
 	*strp = str;
 	return 0;
@@ -627,6 +905,7 @@ pf_parse_iterate(char *str, struct pf_param *pa, char **strp)
  *	'v': enables verbosity
  *	'f': Force full scan
  *	'm': Force merge of adjacent recx
+ *	'b': Foreground updates between GC batches
  */
 static int
 pf_parse_aggregate_cb(char *str, struct pf_param *pa, char **strp)
@@ -643,6 +922,10 @@ pf_parse_aggregate_cb(char *str, struct pf_param *pa, char **strp)
 		pa->pa_agg.force_merge = true;
 		str++;
 		break;
+	case 'b':
+		pa->pa_agg.gc_busy = true;
+		str++;
+		break;
 	}
 	*strp = str;
 	return 0;
@@ -654,6 +937,38 @@ pf_parse_aggregate(char *str, struct pf_param *pa, char **strp)
 	return pf_parse_common(str, pa, pf_parse_aggregate_cb, strp);
 }
 
+/**
+ * Example: "C;c=1000;p"
+ * 'C' is container reopen test
+ *	'p': outputting performance result
+ *	'c': number of containers, 1000 by default
+ */
+static int
+pf_parse_reopen_cb(char *str, struct pf_param *pa, char **strp)
+{
+	switch (*str) {
+	default:
+		str++;
+		break;
+	case 'c':
+		str++;
+		if (*str != PARAM_ASSIGN)
+			return -1;
+		pa->pa_cont.cont_nr = strtol(&str[1], &str, 0);
+		if (pa->pa_cont.cont_nr < 0)
+			return -1;
+		break;
+	}
+	*strp = str;
+	return 0;
+}
+
+static int
+pf_parse_reopen(char *str, struct pf_param *pa, char **strp)
+{
+	return pf_parse_common(str, pa, pf_parse_reopen_cb, strp);
+}
+
 /* predefined test cases */
 struct pf_test pf_tests[] = {
 	{
@@ -710,6 +1025,12 @@ struct pf_test pf_tests[] = {
 		.ts_parse	= pf_parse_aggregate,
 		.ts_func	= pf_gc,
 	},
+	{
+		.ts_code	= 'C',
+		.ts_name	= "CONTAINER REOPEN",
+		.ts_parse	= pf_parse_reopen,
+		.ts_func	= pf_reopen,
+	},
 	{
 		.ts_code	= 0,
 	},
@@ -729,7 +1050,15 @@ const char perf_vos_usage[] = "\n"
 "-I	Use constant akey.  Required for QUERY test.\n\n"
 "-x	Run each test in an ABT ULT.\n\n"
 "Examples:\n"
-"	$ vos_perf -s 1024k -A -R 'U U;o=4k;s=4k V'\n";
+"	$ vos_perf -s 1024k -A -R 'U U;o=4k;s=4k V'\n"
+"	Fetch hot keys with a punch history (incarnation log status cache):\n"
+"	$ vos_perf -o 1 -d 16 -R 'U;k P;d;k U;k P;d;k U;k F;k;i=10000;p'\n"
+"	Reclaim discarded data with foreground updates between GC batches:\n"
+"	$ vos_perf -d 64k -R 'U D G;b;p'\n"
+"	Aggregate with partitioned ULTs, compare with DAOS_VOS_AGG_ULTS unset:\n"
+"	$ DAOS_VOS_AGG_ULTS=4 vos_perf -o 256 -A -R 'U;k;i=8 A;m;p'\n"
+"	Reopen containers with prepared DTX, compare with DAOS_VOS_LAZY_INDEX unset:\n"
+"	$ DAOS_VOS_LAZY_INDEX=1 vos_perf -R 'C;c=1000;p'\n";
 
 static void
 ts_print_usage(void)
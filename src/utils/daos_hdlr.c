@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -24,6 +24,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <dlfcn.h>
+#include <pthread.h>
 #include <daos.h>
 #include <daos/common.h>
 #include <daos/checksum.h>
@@ -43,7 +44,6 @@
 struct file_dfs {
 	enum {POSIX, DAOS} type;
 	int fd;
-	daos_off_t offset;
 	dfs_obj_t *obj;
 	dfs_sys_t *dfs_sys;
 };
@@ -692,26 +692,23 @@ out:
 }
 
 static int
-file_write(struct cmd_args_s *ap, struct file_dfs *file_dfs,
-	   const char *file, void *buf, ssize_t *size)
+file_pwrite(struct cmd_args_s *ap, struct file_dfs *file_dfs,
+	    const char *file, void *buf, ssize_t *size, daos_off_t offset)
 {
 	int rc = 0;
-	/* posix write returns -1 on error so wrapper uses ssize_t, but
-	 * dfs_sys_read takes daos_size_t for size argument
+	/* posix pwrite returns -1 on error so wrapper uses ssize_t, but
+	 * dfs_sys_write takes daos_size_t for size argument
 	 */
 	daos_size_t tmp_size = *size;
 
 	if (file_dfs->type == POSIX) {
-		*size = write(file_dfs->fd, buf, *size);
+		*size = pwrite(file_dfs->fd, buf, *size, offset);
 		if (*size < 0)
 			rc = errno;
 	} else if (file_dfs->type == DAOS) {
-		rc = dfs_sys_write(file_dfs->dfs_sys, file_dfs->obj, buf, file_dfs->offset,
+		rc = dfs_sys_write(file_dfs->dfs_sys, file_dfs->obj, buf, offset,
 				   &tmp_size, NULL);
 		*size = tmp_size;
-		if (rc == 0)
-			/* update file pointer with number of bytes written */
-			file_dfs->offset += *size;
 	} else {
 		rc = EINVAL;
 		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
@@ -855,26 +852,47 @@ file_lstat(struct cmd_args_s *ap, struct file_dfs *file_dfs,
 }
 
 static int
-file_read(struct cmd_args_s *ap, struct file_dfs *file_dfs,
-	  const char *file, void *buf, ssize_t *size)
+file_pread(struct cmd_args_s *ap, struct file_dfs *file_dfs,
+	   const char *file, void *buf, ssize_t *size, daos_off_t offset)
 {
 	int rc = 0;
-	/* posix read returns -1 on error so wrapper uses ssize_t, but
+	/* posix pread returns -1 on error so wrapper uses ssize_t, but
 	 * dfs_sys_read takes daos_size_t for size argument
 	 */
 	daos_size_t tmp_size = *size;
 
 	if (file_dfs->type == POSIX) {
-		*size = read(file_dfs->fd, buf, *size);
+		*size = pread(file_dfs->fd, buf, *size, offset);
 		if (*size < 0)
 			rc = errno;
 	} else if (file_dfs->type == DAOS) {
-		rc = dfs_sys_read(file_dfs->dfs_sys, file_dfs->obj, buf, file_dfs->offset,
+		rc = dfs_sys_read(file_dfs->dfs_sys, file_dfs->obj, buf, offset,
 				  &tmp_size, NULL);
 		*size = tmp_size;
-		if (rc == 0)
-			/* update file pointer with number of bytes read */
-			file_dfs->offset += (daos_off_t)*size;
+	} else {
+		rc = EINVAL;
+		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
+	}
+	return rc;
+}
+
+static int
+file_truncate(struct cmd_args_s *ap, struct file_dfs *file_dfs, const char *file,
+	      daos_off_t length)
+{
+	dfs_t	*dfs;
+	int	rc = 0;
+
+	if (file_dfs->type == POSIX) {
+		rc = ftruncate(file_dfs->fd, length);
+		if (rc != 0)
+			rc = errno;
+	} else if (file_dfs->type == DAOS) {
+		rc = dfs_sys2base(file_dfs->dfs_sys, &dfs);
+		if (rc != 0)
+			return rc;
+		/* a punch to DFS_MAX_FSIZE sets the size, extending the file if needed */
+		rc = dfs_punch(dfs, file_dfs->obj, length, DFS_MAX_FSIZE);
 	} else {
 		rc = EINVAL;
 		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
@@ -955,80 +973,470 @@ file_chmod(struct cmd_args_s *ap, struct file_dfs *file_dfs, const char *path,
 	return rc;
 }
 
+/* Same as file_chmod() on the open file, no path lookup is done */
 static int
-fs_copy_file(struct cmd_args_s *ap,
-	     struct file_dfs *src_file_dfs,
-	     struct file_dfs *dst_file_dfs,
-	     struct stat *src_stat,
-	     const char *src_path,
-	     const char *dst_path)
+file_fchmod(struct cmd_args_s *ap, struct file_dfs *file_dfs, const char *file,
+	    mode_t mode)
 {
-	int src_flags		= O_RDONLY;
-	int dst_flags		= O_CREAT | O_TRUNC | O_WRONLY;
-	mode_t tmp_mode_file	= S_IRUSR | S_IWUSR;
-	int rc;
-	uint64_t file_length	= src_stat->st_size;
-	uint64_t total_bytes	= 0;
-	uint64_t buf_size	= 64 * 1024 * 1024;
-	void *buf		= NULL;
+	struct stat	stbuf = {0};
+	dfs_t		*dfs;
+	int		rc = 0;
 
-	/* Open source file */
-	rc = file_open(ap, src_file_dfs, src_path, src_flags);
-	if (rc != 0)
-		D_GOTO(out, rc = daos_errno2der(rc));
+	if (file_dfs->type == POSIX) {
+		rc = fchmod(file_dfs->fd, mode);
+		if (rc != 0)
+			rc = errno;
+	} else if (file_dfs->type == DAOS) {
+		rc = dfs_sys2base(file_dfs->dfs_sys, &dfs);
+		if (rc != 0)
+			return rc;
+		stbuf.st_mode = mode;
+		rc = dfs_osetattr(dfs, file_dfs->obj, &stbuf, DFS_SET_ATTR_MODE);
+	} else {
+		rc = EINVAL;
+		DH_PERROR_SYS(ap, rc, "File type not known '%s' type=%d", file, file_dfs->type);
+	}
+	return rc;
+}
 
-	/* Open destination file */
-	rc = file_open(ap, dst_file_dfs, dst_path, dst_flags, tmp_mode_file);
-	if (rc != 0)
-		D_GOTO(out_src_file, rc = daos_errno2der(rc));
+/* Default size of each copy buffer, also the unit of work of a copy thread */
+#define FS_COPY_BUF_SIZE	(16 * 1024 * 1024)
+/* Accepted range of the copy buffer size */
+#define FS_COPY_BUF_MIN		FS_COPY_HOLE_SIZE
+#define FS_COPY_BUF_MAX		(1024 * 1024 * 1024)
+/* Default and maximum number of copy threads */
+#define FS_COPY_THREADS		4
+#define FS_COPY_THREADS_MAX	64
+/* Cap on the memory used by the buffers of all the copy threads */
+#define FS_COPY_MEM_MAX		(4ULL * 1024 * 1024 * 1024)
+/* Number of files opened ahead of the copy threads, per thread */
+#define FS_COPY_QUEUE_DEPTH	2
+/* Size of the blocks scanned for zeroes, all-zero blocks are left as holes */
+#define FS_COPY_HOLE_SIZE	(64 * 1024)
+
+struct fs_copy_pool;
+
+/* One regular file handed to the copy threads */
+struct fs_copy_file_args {
+	/* link in fs_copy_pool::files while chunks are left to hand out */
+	d_list_t		 link;
+	struct fs_copy_pool	*pool;
+	/* own fd/obj, the dfs_sys mount is shared with the directory walk */
+	struct file_dfs		 src_file_dfs;
+	struct file_dfs		 dst_file_dfs;
+	char			*src_path;
+	char			*dst_path;
+	mode_t			 mode;
+	uint64_t		 file_length;
+	/* the fields below are protected by the pool lock */
+	uint64_t		 next_offset;
+	/* number of threads copying a chunk of this file */
+	uint32_t		 nr_active;
+	/* first error hit on this file */
+	int			 rc;
+};
+
+struct fs_copy_worker {
+	struct fs_copy_pool	*pool;
+	pthread_t		 thread;
+	char			*buf;
+};
+
+/*
+ * Copy threads shared by all the files of one copy. The directory walk opens
+ * the files and queues them, the threads claim chunks of the oldest queued
+ * file so that small files are copied side by side and large files are split
+ * across the idle threads.
+ */
+struct fs_copy_pool {
+	struct cmd_args_s	*ap;
+	struct fs_copy_worker	*workers;
+	uint32_t		 nr_threads;
+	uint64_t		 buf_size;
+	pthread_mutex_t		 lock;
+	/* signaled when a file is queued and on shutdown */
+	pthread_cond_t		 work_cond;
+	/* signaled when a file is finished */
+	pthread_cond_t		 space_cond;
+	/* the fields below are protected by lock */
+	d_list_t		 files;
+	/* files opened and not finished yet */
+	uint32_t		 nr_files;
+	bool			 done;
+	/* first error hit on any file */
+	int			 rc;
+};
+
+static bool
+fs_copy_is_zero(const char *buf, size_t len)
+{
+	return buf[0] == 0 && memcmp(buf, buf + 1, len - 1) == 0;
+}
+
+/* Write the non-zero extents of buf, the destination is sized once all chunks are copied */
+static int
+fs_copy_write_extents(struct fs_copy_file_args *fa, char *buf, ssize_t len, daos_off_t offset)
+{
+	ssize_t	start = 0;
+	ssize_t	pos = 0;
+	ssize_t	size;
+	int	rc;
+
+	while (start < len) {
+		/* skip leading zero blocks */
+		while (start < len) {
+			size = min(len - start, FS_COPY_HOLE_SIZE);
+			if (!fs_copy_is_zero(buf + start, size))
+				break;
+			start += size;
+		}
+		if (start == len)
+			break;
 
-	/* Allocate read/write buffer */
-	D_ALLOC(buf, buf_size);
-	if (buf == NULL)
-		D_GOTO(out_dst_file, rc = -DER_NOMEM);
+		/* extend the extent up to the next zero block */
+		pos = start;
+		while (pos < len) {
+			size = min(len - pos, FS_COPY_HOLE_SIZE);
+			if (fs_copy_is_zero(buf + pos, size))
+				break;
+			pos += size;
+		}
 
-	/* read from source file, then write to dest file */
-	while (total_bytes < file_length) {
-		ssize_t left_to_read = buf_size;
-		uint64_t bytes_left = file_length - total_bytes;
+		while (start < pos) {
+			size = pos - start;
+			rc = file_pwrite(fa->pool->ap, &fa->dst_file_dfs, fa->dst_path,
+					 buf + start, &size, offset + start);
+			if (rc != 0)
+				return rc;
+			if (size == 0)
+				return EIO;
+			start += size;
+		}
+	}
+	return 0;
+}
+
+static int
+fs_copy_chunk(struct fs_copy_file_args *fa, char *buf, uint64_t offset)
+{
+	struct cmd_args_s	*ap = fa->pool->ap;
+	ssize_t			 chunk_len;
+	ssize_t			 total;
+	ssize_t			 size;
+	int			 rc;
 
-		if (bytes_left < buf_size)
-			left_to_read = (size_t)bytes_left;
-		rc = file_read(ap, src_file_dfs, src_path, buf, &left_to_read);
+	chunk_len = min(fa->pool->buf_size, fa->file_length - offset);
+	for (total = 0; total < chunk_len; total += size) {
+		size = chunk_len - total;
+		rc = file_pread(ap, &fa->src_file_dfs, fa->src_path, buf + total, &size,
+				offset + total);
 		if (rc != 0) {
 			rc = daos_errno2der(rc);
-			DH_PERROR_DER(ap, rc, "File read failed");
-			D_GOTO(out_buf, rc);
+			DH_PERROR_DER(ap, rc, "File read failed on '%s'", fa->src_path);
+			return rc;
 		}
-		ssize_t bytes_to_write = left_to_read;
+		/* source was truncated while being copied */
+		if (size == 0)
+			break;
+	}
 
-		rc = file_write(ap, dst_file_dfs, dst_path, buf, &bytes_to_write);
+	rc = fs_copy_write_extents(fa, buf, total, offset);
+	if (rc != 0) {
+		rc = daos_errno2der(rc);
+		DH_PERROR_DER(ap, rc, "File write failed on '%s'", fa->dst_path);
+	}
+	return rc;
+}
+
+static void
+fs_copy_file_free(struct fs_copy_file_args *fa)
+{
+	D_FREE(fa->src_path);
+	D_FREE(fa->dst_path);
+	D_FREE(fa);
+}
+
+/*
+ * Size the destination, set its permissions and close both files. Only
+ * handles are used so that directories may be chmod'ed by the walk meanwhile.
+ */
+static void
+fs_copy_file_fini(struct fs_copy_file_args *fa)
+{
+	struct fs_copy_pool	*pool = fa->pool;
+	struct cmd_args_s	*ap = pool->ap;
+	int			 rc = fa->rc;
+
+	/* the trailing hole, if any, was not written */
+	if (rc == 0 && fa->file_length > 0) {
+		rc = file_truncate(ap, &fa->dst_file_dfs, fa->dst_path, fa->file_length);
 		if (rc != 0) {
 			rc = daos_errno2der(rc);
-			DH_PERROR_DER(ap, rc, "File write failed");
-			D_GOTO(out_buf, rc);
+			DH_PERROR_DER(ap, rc, "Setting dst file size failed on '%s'",
+				      fa->dst_path);
 		}
-		total_bytes += left_to_read;
 	}
 
 	/* set perms on destination to original source perms */
-	rc = file_chmod(ap, dst_file_dfs, dst_path, src_stat->st_mode);
+	if (rc == 0) {
+		rc = file_fchmod(ap, &fa->dst_file_dfs, fa->dst_path, fa->mode);
+		if (rc != 0) {
+			rc = daos_errno2der(rc);
+			DH_PERROR_DER(ap, rc, "updating dst file permissions failed on '%s'",
+				      fa->dst_path);
+		}
+	}
+
+	file_close(ap, &fa->dst_file_dfs, fa->dst_path);
+	file_close(ap, &fa->src_file_dfs, fa->src_path);
+
+	D_MUTEX_LOCK(&pool->lock);
+	if (rc == 0)
+		ap->fs_copy_stats->num_files++;
+	else if (pool->rc == 0)
+		pool->rc = rc;
+	pool->nr_files--;
+	pthread_cond_broadcast(&pool->space_cond);
+	D_MUTEX_UNLOCK(&pool->lock);
+
+	fs_copy_file_free(fa);
+}
+
+/* Called with the pool lock held, finishes the file once no chunk is left to copy */
+static void
+fs_copy_file_put(struct fs_copy_file_args *fa)
+{
+	struct fs_copy_pool *pool = fa->pool;
+
+	if (!d_list_empty(&fa->link) || fa->nr_active > 0)
+		return;
+
+	D_MUTEX_UNLOCK(&pool->lock);
+	fs_copy_file_fini(fa);
+	D_MUTEX_LOCK(&pool->lock);
+}
+
+static void *
+fs_copy_worker(void *arg)
+{
+	struct fs_copy_worker		*w = arg;
+	struct fs_copy_pool		*pool = w->pool;
+	struct fs_copy_file_args	*fa;
+	uint64_t			 offset;
+	int				 rc;
+
+	D_MUTEX_LOCK(&pool->lock);
+	while (1) {
+		while (d_list_empty(&pool->files) && !pool->done)
+			pthread_cond_wait(&pool->work_cond, &pool->lock);
+		/* queued files are always drained before exiting */
+		if (d_list_empty(&pool->files))
+			break;
+
+		fa = d_list_entry(pool->files.next, struct fs_copy_file_args, link);
+		if (pool->rc != 0) {
+			/* another file failed, skip the chunks not handed out yet */
+			d_list_del_init(&fa->link);
+			if (fa->rc == 0)
+				fa->rc = -DER_CANCELED;
+			fs_copy_file_put(fa);
+			continue;
+		}
+
+		offset = fa->next_offset;
+		fa->next_offset += pool->buf_size;
+		fa->nr_active++;
+		if (fa->next_offset >= fa->file_length)
+			d_list_del_init(&fa->link);
+		D_MUTEX_UNLOCK(&pool->lock);
+
+		rc = fs_copy_chunk(fa, w->buf, offset);
+
+		D_MUTEX_LOCK(&pool->lock);
+		fa->nr_active--;
+		if (rc != 0) {
+			if (fa->rc == 0)
+				fa->rc = rc;
+			d_list_del_init(&fa->link);
+		}
+		fs_copy_file_put(fa);
+	}
+	D_MUTEX_UNLOCK(&pool->lock);
+	return NULL;
+}
+
+/*
+ * Start the copy threads, each owns one buffer. The thread count and buffer
+ * size come from the command line and are clamped so that the buffers of all
+ * threads stay within FS_COPY_MEM_MAX.
+ */
+static int
+fs_copy_pool_init(struct fs_copy_pool *pool, struct cmd_args_s *ap)
+{
+	struct fs_copy_worker	*w;
+	uint64_t		 buf_size;
+	uint32_t		 nr_threads;
+	uint32_t		 i;
+	int			 rc;
+
+	buf_size = ap->copy_buf_size ? ap->copy_buf_size : FS_COPY_BUF_SIZE;
+	buf_size = min(max(buf_size, FS_COPY_BUF_MIN), FS_COPY_BUF_MAX);
+	nr_threads = ap->copy_threads ? ap->copy_threads : FS_COPY_THREADS;
+	nr_threads = min(nr_threads, FS_COPY_THREADS_MAX);
+	nr_threads = min(nr_threads, FS_COPY_MEM_MAX / buf_size);
+	if ((ap->copy_threads != 0 && nr_threads != ap->copy_threads) ||
+	    (ap->copy_buf_size != 0 && buf_size != ap->copy_buf_size))
+		fprintf(ap->errstream, "copying with %u threads and "DF_U64" byte buffers\n",
+			nr_threads, buf_size);
+
+	memset(pool, 0, sizeof(*pool));
+	pool->ap = ap;
+	pool->buf_size = buf_size;
+	D_INIT_LIST_HEAD(&pool->files);
+
+	rc = D_MUTEX_INIT(&pool->lock, NULL);
+	if (rc != 0)
+		return rc;
+	rc = pthread_cond_init(&pool->work_cond, NULL);
+	if (rc != 0)
+		D_GOTO(out_lock, rc = daos_errno2der(rc));
+	rc = pthread_cond_init(&pool->space_cond, NULL);
+	if (rc != 0)
+		D_GOTO(out_work_cond, rc = daos_errno2der(rc));
+
+	D_ALLOC_ARRAY(pool->workers, nr_threads);
+	if (pool->workers == NULL)
+		D_GOTO(out_space_cond, rc = -DER_NOMEM);
+
+	for (i = 0; i < nr_threads; i++) {
+		w = &pool->workers[i];
+		w->pool = pool;
+		D_ALLOC(w->buf, buf_size);
+		if (w->buf == NULL) {
+			rc = -DER_NOMEM;
+			break;
+		}
+		rc = pthread_create(&w->thread, NULL, fs_copy_worker, w);
+		if (rc != 0) {
+			rc = daos_errno2der(rc);
+			D_FREE(w->buf);
+			break;
+		}
+		pool->nr_threads++;
+	}
+	/* carry on with the threads already started */
+	if (pool->nr_threads == 0) {
+		DH_PERROR_DER(ap, rc, "Failed to start copy threads");
+		D_GOTO(out_workers, rc);
+	}
+	return 0;
+
+out_workers:
+	D_FREE(pool->workers);
+out_space_cond:
+	pthread_cond_destroy(&pool->space_cond);
+out_work_cond:
+	pthread_cond_destroy(&pool->work_cond);
+out_lock:
+	D_MUTEX_DESTROY(&pool->lock);
+	return rc;
+}
+
+/* Wait for the queued files to be copied and stop the copy threads */
+static int
+fs_copy_pool_fini(struct fs_copy_pool *pool)
+{
+	uint32_t i;
+
+	D_MUTEX_LOCK(&pool->lock);
+	pool->done = true;
+	pthread_cond_broadcast(&pool->work_cond);
+	D_MUTEX_UNLOCK(&pool->lock);
+
+	for (i = 0; i < pool->nr_threads; i++) {
+		pthread_join(pool->workers[i].thread, NULL);
+		D_FREE(pool->workers[i].buf);
+	}
+	D_ASSERT(pool->nr_files == 0);
+
+	D_FREE(pool->workers);
+	pthread_cond_destroy(&pool->space_cond);
+	pthread_cond_destroy(&pool->work_cond);
+	D_MUTEX_DESTROY(&pool->lock);
+	return pool->rc;
+}
+
+/*
+ * Open the source and destination files and queue them to the copy threads.
+ * The file is counted and its permissions set once its data is copied, errors
+ * of the copy are returned by fs_copy_pool_fini().
+ */
+static int
+fs_copy_file(struct fs_copy_pool *pool,
+	     struct file_dfs *src_file_dfs,
+	     struct file_dfs *dst_file_dfs,
+	     struct stat *src_stat,
+	     const char *src_path,
+	     const char *dst_path)
+{
+	struct cmd_args_s	*ap = pool->ap;
+	int src_flags		= O_RDONLY;
+	int dst_flags		= O_CREAT | O_TRUNC | O_WRONLY;
+	mode_t tmp_mode_file	= S_IRUSR | S_IWUSR;
+	struct fs_copy_file_args *fa;
+	int rc;
+
+	/* bound the number of files held open ahead of the copy threads */
+	D_MUTEX_LOCK(&pool->lock);
+	while (pool->rc == 0 && pool->nr_files >= pool->nr_threads * FS_COPY_QUEUE_DEPTH)
+		pthread_cond_wait(&pool->space_cond, &pool->lock);
+	rc = pool->rc;
+	D_MUTEX_UNLOCK(&pool->lock);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_PTR(fa);
+	if (fa == NULL)
+		return -DER_NOMEM;
+	D_INIT_LIST_HEAD(&fa->link);
+	fa->pool = pool;
+	fa->src_file_dfs = *src_file_dfs;
+	fa->dst_file_dfs = *dst_file_dfs;
+	fa->mode = src_stat->st_mode;
+	fa->file_length = src_stat->st_size;
+	D_STRNDUP(fa->src_path, src_path, strlen(src_path));
+	D_STRNDUP(fa->dst_path, dst_path, strlen(dst_path));
+	if (fa->src_path == NULL || fa->dst_path == NULL)
+		D_GOTO(out_free, rc = -DER_NOMEM);
+
+	/* Open source file */
+	rc = file_open(ap, &fa->src_file_dfs, src_path, src_flags);
+	if (rc != 0)
+		D_GOTO(out_free, rc = daos_errno2der(rc));
+
+	/* Open destination file */
+	rc = file_open(ap, &fa->dst_file_dfs, dst_path, dst_flags, tmp_mode_file);
 	if (rc != 0) {
-		rc = daos_errno2der(rc);
-		DH_PERROR_DER(ap, rc, "updating dst file permissions failed");
-		D_GOTO(out_buf, rc);
+		file_close(ap, &fa->src_file_dfs, src_path);
+		D_GOTO(out_free, rc = daos_errno2der(rc));
 	}
 
-out_buf:
-	D_FREE(buf);
-out_dst_file:
-	file_close(ap, dst_file_dfs, dst_path);
-out_src_file:
-	file_close(ap, src_file_dfs, src_path);
-out:
-	/* reset offsets if there is another file to copy */
-	src_file_dfs->offset = 0;
-	dst_file_dfs->offset = 0;
+	/* only the directory walk adds files, so the slot waited for is still free */
+	D_MUTEX_LOCK(&pool->lock);
+	pool->nr_files++;
+	if (fa->file_length > 0) {
+		d_list_add_tail(&fa->link, &pool->files);
+		pthread_cond_broadcast(&pool->work_cond);
+	}
+	D_MUTEX_UNLOCK(&pool->lock);
+
+	/* nothing to copy, finish an empty file right away */
+	if (fa->file_length == 0)
+		fs_copy_file_fini(fa);
+	return 0;
+
+out_free:
+	fs_copy_file_free(fa);
 	return rc;
 }
 
@@ -1107,13 +1515,11 @@ fs_copy_symlink(struct cmd_args_s *ap,
 	}
 out_copy_symlink:
 	D_FREE(symlink_value);
-	src_file_dfs->offset = 0;
-	dst_file_dfs->offset = 0;
 	return rc;
 }
 
 static int
-fs_copy_dir(struct cmd_args_s *ap,
+fs_copy_dir(struct fs_copy_pool *pool,
 	    struct file_dfs *src_file_dfs,
 	    struct file_dfs *dst_file_dfs,
 	    struct stat *src_stat,
@@ -1121,6 +1527,7 @@ fs_copy_dir(struct cmd_args_s *ap,
 	    const char *dst_path,
 	    struct fs_copy_stats *num)
 {
+	struct cmd_args_s	*ap = pool->ap;
 	DIR			*src_dir = NULL;
 	struct dirent		*entry = NULL;
 	char			*next_src_path = NULL;
@@ -1194,12 +1601,11 @@ fs_copy_dir(struct cmd_args_s *ap,
 
 		switch (next_src_stat.st_mode & S_IFMT) {
 		case S_IFREG:
-			rc = fs_copy_file(ap, src_file_dfs, dst_file_dfs,
+			rc = fs_copy_file(pool, src_file_dfs, dst_file_dfs,
 					  &next_src_stat, next_src_path,
 					  next_dst_path);
 			if ((rc != 0) && (rc != -DER_EXIST))
 				D_GOTO(out, rc);
-			num->num_files++;
 			break;
 		case S_IFLNK:
 			rc = fs_copy_symlink(ap, src_file_dfs, dst_file_dfs,
@@ -1210,7 +1616,7 @@ fs_copy_dir(struct cmd_args_s *ap,
 			num->num_links++;
 			break;
 		case S_IFDIR:
-			rc = fs_copy_dir(ap, src_file_dfs, dst_file_dfs, &next_src_stat,
+			rc = fs_copy_dir(pool, src_file_dfs, dst_file_dfs, &next_src_stat,
 					 next_src_path, next_dst_path, num);
 			if ((rc != 0) && (rc != -DER_EXIST))
 				D_GOTO(out, rc);
@@ -1260,7 +1666,9 @@ fs_copy(struct cmd_args_s *ap,
 	const char *dst_path,
 	struct fs_copy_stats *num)
 {
+	struct fs_copy_pool	pool;
 	int		rc = 0;
+	int		rc2;
 	struct stat	src_stat;
 	struct stat	dst_stat;
 	bool		copy_into_dst = false;
@@ -1311,25 +1719,30 @@ fs_copy(struct cmd_args_s *ap,
 		}
 	}
 
-	switch (src_stat.st_mode & S_IFMT) {
-	case S_IFREG:
-		rc = fs_copy_file(ap, src_file_dfs, dst_file_dfs, &src_stat, src_path,
-				  dst_path);
-		if (rc == 0)
-			num->num_files++;
-		break;
-	case S_IFDIR:
-		rc = fs_copy_dir(ap, src_file_dfs, dst_file_dfs, &src_stat, src_path,
-				 dst_path, num);
-		if (rc == 0)
-			num->num_dirs++;
-		break;
-	default:
+	if (!S_ISREG(src_stat.st_mode) && !S_ISDIR(src_stat.st_mode)) {
 		rc = -DER_INVAL;
 		DH_PERROR_DER(ap, rc, "Only files and directories are supported");
 		D_GOTO(out, rc);
 	}
 
+	rc = fs_copy_pool_init(&pool, ap);
+	if (rc != 0)
+		D_GOTO(out, rc);
+
+	if (S_ISREG(src_stat.st_mode))
+		rc = fs_copy_file(&pool, src_file_dfs, dst_file_dfs, &src_stat, src_path,
+				  dst_path);
+	else
+		rc = fs_copy_dir(&pool, src_file_dfs, dst_file_dfs, &src_stat, src_path,
+				 dst_path, num);
+
+	/* files still queued are copied before the threads stop */
+	rc2 = fs_copy_pool_fini(&pool);
+	if (rc == 0)
+		rc = rc2;
+	if (rc == 0 && S_ISDIR(src_stat.st_mode))
+		num->num_dirs++;
+
 out:
 	if (copy_into_dst) {
 		D_FREE(tmp_path);
@@ -2052,7 +2465,6 @@ file_set_defaults_dfs(struct file_dfs *file_dfs)
 	/* set defaults for file_dfs struct */
 	file_dfs->type = DAOS;
 	file_dfs->fd = -1;
-	file_dfs->offset = 0;
 	file_dfs->obj = NULL;
 	file_dfs->dfs_sys = NULL;
 }
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2016-2022 Intel Corporation.
+ * (C) Copyright 2016-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -139,6 +139,8 @@ struct cmd_args_s {
 	struct dm_args		*dm_args;	/* datamover arguments */
 	struct fs_copy_stats	*fs_copy_stats;	/* fs copy stats */
 	bool			 fs_copy_posix; /* fs copy to POSIX */
+	uint32_t		 copy_threads;	/* --threads, fs copy pool shared by all files */
+	daos_size_t		 copy_buf_size;	/* --buffer-size, per copy thread */
 
 	FILE			*outstream;	/* normal output stream */
 	FILE			*errstream;	/* errors stream */
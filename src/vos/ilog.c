@@ -207,6 +207,137 @@ ilog_mag2ver(uint32_t magic) {
 	return (magic & ILOG_VERSION_MASK) >> ILOG_MAGIC_BITS;
 }
 
+/** Per-xstream cache of committed entries for hot logs.  Resolving the status
+ *  of an entry requires a DTX lookup, and a key with a long history of punches
+ *  pays it for every entry on every fetch even though a committed entry never
+ *  changes status again.  Slots are keyed by root and version and the status
+ *  is recorded by position, so any modification of the log invalidates it.
+ */
+#define ILOG_CACHE_BITS		10
+#define ILOG_CACHE_SIZE		(1 << ILOG_CACHE_BITS)
+/** Longer logs are not cached */
+#define ILOG_CACHE_MAX_NR	4096
+
+struct ilog_cache_slot {
+	/** Root of the cached log, NULL if the slot is free */
+	struct ilog_root	*cs_root;
+	/** Version of the log when cached */
+	uint32_t		 cs_version;
+	/** Number of entries in the log when cached */
+	uint32_t		 cs_nr;
+	/** Epochs of the first and last entries, guard against root reuse */
+	daos_epoch_t		 cs_first;
+	daos_epoch_t		 cs_last;
+	/** Bitmap of committed entries */
+	uint8_t			*cs_committed;
+	/** Size of cs_committed in bytes */
+	uint32_t		 cs_size;
+};
+
+struct ilog_status_cache {
+	struct ilog_cache_slot	 sc_slots[ILOG_CACHE_SIZE];
+	struct ilog_cache_stats	 sc_stats;
+	struct d_tm_node_t	*sc_hit;
+	struct d_tm_node_t	*sc_miss;
+};
+
+int
+ilog_cache_create(int tgt_id, struct ilog_status_cache **cachep)
+{
+	struct ilog_status_cache	*cache;
+	int				 rc;
+
+	D_ALLOC_PTR(cache);
+	if (cache == NULL)
+		return -DER_NOMEM;
+
+	*cachep = cache;
+	if (tgt_id < 0)
+		return 0;
+
+	rc = d_tm_add_metric(&cache->sc_hit, D_TM_COUNTER,
+			     "Number of ilog fetches served from the status cache",
+			     "fetches", "io/ilog_cache/hit/tgt_%u", tgt_id);
+	if (rc)
+		D_WARN("Failed to create ilog cache hit sensor: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&cache->sc_miss, D_TM_COUNTER,
+			     "Number of ilog fetches missing the status cache",
+			     "fetches", "io/ilog_cache/miss/tgt_%u", tgt_id);
+	if (rc)
+		D_WARN("Failed to create ilog cache miss sensor: "DF_RC"\n", DP_RC(rc));
+
+	return 0;
+}
+
+void
+ilog_cache_destroy(struct ilog_status_cache *cache)
+{
+	int	i;
+
+	for (i = 0; i < ILOG_CACHE_SIZE; i++)
+		D_FREE(cache->sc_slots[i].cs_committed);
+	D_FREE(cache);
+}
+
+void
+ilog_cache_flush(void)
+{
+	struct ilog_status_cache	*cache = vos_tls_get()->vtl_ilog_cache;
+	int				 i;
+
+	if (cache == NULL)
+		return;
+
+	for (i = 0; i < ILOG_CACHE_SIZE; i++)
+		cache->sc_slots[i].cs_root = NULL;
+}
+
+void
+ilog_cache_stats_get(struct ilog_cache_stats *stats)
+{
+	struct ilog_status_cache	*cache = vos_tls_get()->vtl_ilog_cache;
+
+	if (cache == NULL)
+		memset(stats, 0, sizeof(*stats));
+	else
+		*stats = cache->sc_stats;
+}
+
+static inline struct ilog_cache_slot *
+ilog_cache_root2slot(struct ilog_status_cache *cache, struct ilog_root *root)
+{
+	return &cache->sc_slots[daos_u64_hash((uint64_t)root, ILOG_CACHE_BITS)];
+}
+
+static void
+ilog_cache_count(bool hit)
+{
+	struct ilog_status_cache	*cache = vos_tls_get()->vtl_ilog_cache;
+
+	if (hit) {
+		cache->sc_stats.ics_hits++;
+		d_tm_inc_counter(cache->sc_hit, 1);
+	} else {
+		cache->sc_stats.ics_misses++;
+		d_tm_inc_counter(cache->sc_miss, 1);
+	}
+}
+
+static void
+ilog_cache_invalidate(struct ilog_root *root)
+{
+	struct ilog_status_cache	*cache = vos_tls_get()->vtl_ilog_cache;
+	struct ilog_cache_slot		*slot;
+
+	if (cache == NULL)
+		return;
+
+	slot = ilog_cache_root2slot(cache, root);
+	if (slot->cs_root == root)
+		slot->cs_root = NULL;
+}
+
 /** Increment the version of the log.   The object tree in particular can
  *  benefit from cached state of the tree.  In order to detect when to
  *  update the case, we keep a version.
@@ -272,6 +403,8 @@ ilog_tx_end(struct ilog_context *lctx, int rc)
 	}
 
 done:
+	/* The log may have changed, drop its cached status */
+	ilog_cache_invalidate(lctx->ic_root);
 	lctx->ic_in_txn = false;
 	return umem_tx_end(lctx->ic_umm, rc);
 }
@@ -1187,6 +1320,83 @@ done:
 	return 0;
 }
 
+/** Committed status is only known to be final for the VOS DTX callbacks, and
+ *  only when it is not the view of an active DTX, a migration or one of the
+ *  intents that handle aborted entries specially.
+ */
+static struct ilog_cache_slot *
+ilog_cache_slot_get(struct ilog_context *lctx, uint32_t intent)
+{
+	struct ilog_status_cache	*cache;
+	struct dtx_handle		*dth;
+
+	if (lctx->ic_cbs.dc_log_status_cb != vos_ilog_status_get)
+		return NULL;
+
+	switch (intent) {
+	case DAOS_INTENT_PURGE:
+	case DAOS_INTENT_CHECK:
+	case DAOS_INTENT_DISCARD:
+		return NULL;
+	default:
+		break;
+	}
+
+	dth = vos_dth_get();
+	if (dth != NULL && (dth->dth_ent != NULL || dth->dth_for_migration ||
+			    !d_list_empty(&dth->dth_share_cmt_list)))
+		return NULL;
+
+	cache = vos_tls_get()->vtl_ilog_cache;
+	if (cache == NULL)
+		return NULL;
+
+	return ilog_cache_root2slot(cache, lctx->ic_root);
+}
+
+static bool
+ilog_cache_match(struct ilog_cache_slot *slot, struct ilog_root *root,
+		 struct ilog_array_cache *cache)
+{
+	return slot->cs_root == root && slot->cs_version == ilog_mag2ver(root->lr_magic) &&
+	       slot->cs_nr == cache->ac_nr &&
+	       slot->cs_first == cache->ac_entries[0].id_epoch &&
+	       slot->cs_last == cache->ac_entries[cache->ac_nr - 1].id_epoch;
+}
+
+static void
+ilog_cache_store(struct ilog_cache_slot *slot, struct ilog_root *root,
+		 struct ilog_array_cache *cache, struct ilog_entries *entries)
+{
+	uint32_t	size = (cache->ac_nr + NBBY - 1) / NBBY;
+	uint8_t		*bitmap;
+	int		 i;
+
+	slot->cs_root = NULL;
+	if (cache->ac_nr > ILOG_CACHE_MAX_NR)
+		return;
+
+	if (size > slot->cs_size) {
+		D_REALLOC_NZ(bitmap, slot->cs_committed, size);
+		if (bitmap == NULL)
+			return;
+		slot->cs_committed = bitmap;
+		slot->cs_size = size;
+	}
+
+	memset(slot->cs_committed, 0, size);
+	for (i = 0; i < cache->ac_nr; i++) {
+		if (entries->ie_info[i].ii_status == ILOG_COMMITTED)
+			setbit(slot->cs_committed, i);
+	}
+
+	slot->cs_version = ilog_mag2ver(root->lr_magic);
+	slot->cs_nr = cache->ac_nr;
+	slot->cs_first = cache->ac_entries[0].id_epoch;
+	slot->cs_last = cache->ac_entries[cache->ac_nr - 1].id_epoch;
+	slot->cs_root = root;
+}
+
 int
 ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 	   const struct ilog_desc_cbs *cbs, uint32_t intent, bool has_cond,
@@ -1199,8 +1409,11 @@ ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 	struct ilog_array_cache	 cache;
 	int			 i;
 	int			 status;
+	struct ilog_cache_slot	*slot;
+	uint64_t		 saved = 0;
 	int			 rc = 0;
 	bool			 retry;
+	bool			 hit = false;
 
 	ILOG_ASSERT_VALID(root_df);
 
@@ -1235,15 +1448,31 @@ ilog_fetch(struct umem_instance *umm, struct ilog_df *root_df,
 	else
 		retry = true;
 
+	slot = ilog_cache_slot_get(lctx, intent);
+	if (slot != NULL) {
+		hit = ilog_cache_match(slot, root, &cache);
+		ilog_cache_count(hit);
+	}
+
 	for (i = 0; i < cache.ac_nr; i++) {
 		id = &cache.ac_entries[i];
-		status = ilog_status_get(lctx, id, intent, retry);
-		if (status < 0 && status != -DER_INPROGRESS)
-			D_GOTO(fail, rc = status);
+		if (hit && isset(slot->cs_committed, i)) {
+			status = ILOG_COMMITTED;
+			saved++;
+		} else {
+			status = ilog_status_get(lctx, id, intent, retry);
+			if (status < 0 && status != -DER_INPROGRESS)
+				D_GOTO(fail, rc = status);
+		}
 		entries->ie_info[entries->ie_num_entries].ii_removed = 0;
 		entries->ie_info[entries->ie_num_entries++].ii_status = status;
 	}
 
+	if (slot != NULL) {
+		vos_tls_get()->vtl_ilog_cache->sc_stats.ics_saved += saved;
+		ilog_cache_store(slot, root, &cache, entries);
+	}
+
 out:
 	D_ASSERT(rc != -DER_NONEXIST);
 	if (entries->ie_num_entries == 0)
@@ -69,6 +69,46 @@ struct ilog_desc_cbs {
 	void	*dc_log_del_args;
 };
 
+/** Hit/miss statistics of the per-xstream ilog status cache */
+struct ilog_cache_stats {
+	/** Fetches that found the log in the cache */
+	uint64_t	ics_hits;
+	/** Fetches that had to resolve every entry */
+	uint64_t	ics_misses;
+	/** Status callbacks skipped thanks to cached entries */
+	uint64_t	ics_saved;
+};
+
+struct ilog_status_cache;
+
+/** Allocate the status cache of an xstream
+ *
+ *  \param	tgt_id[IN]	Target ID for telemetry, or -1 to skip it
+ *  \param	cache[OUT]	Returned cache
+ *
+ *  \return 0 on success, error code on failure
+ */
+int
+ilog_cache_create(int tgt_id, struct ilog_status_cache **cache);
+
+/** Free a status cache allocated by ilog_cache_create
+ *
+ *  \param	cache[IN]	The cache to free
+ */
+void
+ilog_cache_destroy(struct ilog_status_cache *cache);
+
+/** Drop all entries of the status cache of the calling xstream */
+void
+ilog_cache_flush(void);
+
+/** Retrieve the statistics of the status cache of the calling xstream
+ *
+ *  \param	stats[OUT]	Returned statistics
+ */
+void
+ilog_cache_stats_get(struct ilog_cache_stats *stats);
+
 /** Globally initialize incarnation log */
 int
 ilog_init(void);
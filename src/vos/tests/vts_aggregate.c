@@ -2859,6 +2859,283 @@ aggregate_35(void **state)
 	assert_int_equal(feats & INIT_FEATS, INIT_FEATS);
 }
 
+#define AGG_PART_ULTS		4
+
+/*
+ * Aggregate EV over multiple objects/keys with partitioned ULTs, random yield.
+ */
+static void
+aggregate_36(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct agg_tst_dataset	 ds = { 0 };
+	daos_recx_t		 recx_tot;
+	unsigned int		 saved_ults = vos_agg_ults;
+
+	recx_tot.rx_idx = 0;
+	recx_tot.rx_nr = 20;
+
+	ds.td_type = DAOS_IOD_ARRAY;
+	ds.td_iod_size = 1024;
+	ds.td_expected_recs = -1;
+	ds.td_recx_nr = 1;
+	ds.td_recx = &recx_tot;
+	ds.td_upd_epr.epr_lo = 1;
+	ds.td_upd_epr.epr_hi = 1000;
+	ds.td_agg_epr.epr_lo = 750;
+	ds.td_agg_epr.epr_hi = 1000;
+	ds.td_discard = false;
+
+	daos_fail_loc_set(DAOS_VOS_AGG_RANDOM_YIELD | DAOS_FAIL_ALWAYS);
+	vos_agg_ults = AGG_PART_ULTS;
+	aggregate_multi(arg, &ds);
+	vos_agg_ults = saved_ults;
+	cleanup();
+}
+
+#define AGG_PART_OBJS		64
+#define AGG_PART_UPDATES	8
+#define AGG_PART_IOD_SIZE	64
+#define AGG_PART_RECX_NR	16
+/* Records covered by the overlapped extents of each object */
+#define AGG_PART_RECS		(AGG_PART_UPDATES - 1 + AGG_PART_RECX_NR)
+
+/*
+ * Update AGG_PART_OBJS objects with overlapped extents, aggregate them with @ults ULTs,
+ * verify the data and return the number of physical records of each object in @recs.
+ */
+static void
+aggregate_parts_round(struct io_test_args *arg, daos_epoch_t epoch_lo, unsigned int ults,
+		      int *recs)
+{
+	daos_epoch_range_t	 epr;
+	daos_recx_t		 recx;
+	daos_unit_oid_t		 oids[AGG_PART_OBJS];
+	char			 dkey[UPDATE_DKEY_SIZE] = { 0 };
+	char			 akey[UPDATE_AKEY_SIZE] = { 0 };
+	char			*buf;
+	daos_epoch_t		 epoch = epoch_lo;
+	unsigned int		 saved_ults = vos_agg_ults;
+	int			 i, j, rc;
+
+	D_ALLOC(buf, AGG_PART_IOD_SIZE * AGG_PART_RECS);
+	assert_non_null(buf);
+
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+	for (i = 0; i < AGG_PART_OBJS; i++) {
+		oids[i] = dts_unit_oid_gen(0, 0);
+		for (j = 0; j < AGG_PART_UPDATES; j++) {
+			recx.rx_idx = j;
+			recx.rx_nr = AGG_PART_RECX_NR;
+			memset(buf, 'a' + j, AGG_PART_IOD_SIZE * AGG_PART_RECX_NR);
+			update_value(arg, oids[i], epoch++, 0, dkey, akey, DAOS_IOD_ARRAY,
+				     AGG_PART_IOD_SIZE, &recx, buf);
+		}
+	}
+
+	epr.epr_lo = epoch_lo;
+	epr.epr_hi = epoch;
+	vos_agg_ults = ults;
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, VOS_AGG_FL_FORCE_MERGE);
+	vos_agg_ults = saved_ults;
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < AGG_PART_OBJS; i++) {
+		recs[i] = phy_recs_nr(arg, oids[i], &epr, dkey, akey, DAOS_IOD_ARRAY);
+
+		/* Each record holds the data of the latest update covering it */
+		recx.rx_idx = 0;
+		recx.rx_nr = AGG_PART_RECS;
+		fetch_value(arg, oids[i], epoch, 0, dkey, akey, DAOS_IOD_ARRAY,
+			    AGG_PART_IOD_SIZE, &recx, buf);
+		for (j = 0; j < AGG_PART_RECS; j++) {
+			char	exp = 'a' + min(j, AGG_PART_UPDATES - 1);
+
+			assert_int_equal(buf[j * AGG_PART_IOD_SIZE], exp);
+			assert_int_equal(buf[(j + 1) * AGG_PART_IOD_SIZE - 1], exp);
+		}
+	}
+	D_FREE(buf);
+}
+
+/*
+ * Partitioned ULTs must aggregate exactly like a single ULT, every object is merged
+ * the same way and keeps the same data, with or w/o adaptive policy.
+ */
+static void
+aggregate_37(void **state)
+{
+	struct io_test_args	*arg = *state;
+	int			 single[AGG_PART_OBJS];
+	int			 parts[AGG_PART_OBJS];
+	bool			 saved_adaptive = vos_agg_adaptive;
+	daos_epoch_t		 epoch = 1;
+	int			 i, round;
+
+	for (round = 0; round < 2; round++) {
+		/* Per-akey temperature must not depend on the partition of the akey */
+		vos_agg_adaptive = (round != 0);
+		VERBOSE_MSG("Aggregate with partitioned ULTs %s adaptive policy\n",
+			    vos_agg_adaptive ? "with" : "w/o");
+
+		aggregate_parts_round(arg, epoch, 1, single);
+		epoch += AGG_PART_OBJS * AGG_PART_UPDATES + 1;
+		aggregate_parts_round(arg, epoch, AGG_PART_ULTS, parts);
+		epoch += AGG_PART_OBJS * AGG_PART_UPDATES + 1;
+
+		for (i = 0; i < AGG_PART_OBJS; i++) {
+			/* Overlapped extents are merged */
+			assert_true(single[i] < AGG_PART_UPDATES);
+			assert_int_equal(parts[i], single[i]);
+		}
+	}
+	vos_agg_adaptive = saved_adaptive;
+	cleanup();
+}
+
+/*
+ * Merge small SCM records w/o 'force_merge' flag, with or w/o adaptive policy.
+ */
+static void
+aggregate_38(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct agg_tst_dataset	 ds = { 0 };
+	daos_recx_t		 recx_arr[VOS_EVT_ORDER + 5];
+	bool			 saved_adaptive = vos_agg_adaptive;
+	int			 i, rec_cnt;
+
+	for (i = 0; i < ARRAY_SIZE(recx_arr); i++) {
+		recx_arr[i].rx_idx = i * 8;
+		recx_arr[i].rx_nr = 8;
+	}
+
+	ds.td_type = DAOS_IOD_ARRAY;
+	ds.td_iod_size = 1;
+	ds.td_recx = recx_arr;
+	ds.td_upd_epr.epr_lo = 1;
+	ds.td_agg_epr.epr_lo = 0;
+	ds.td_discard = false;
+
+	/* Fewer records than VOS_EVT_ORDER, only merged when they are hot */
+	rec_cnt = VOS_EVT_ORDER - 5;
+	ds.td_recx_nr = rec_cnt;
+	ds.td_upd_epr.epr_hi = rec_cnt;
+	ds.td_agg_epr.epr_hi = rec_cnt + 1;
+
+	VERBOSE_MSG("Aggregate hot SCM records w/o adaptive policy\n");
+	vos_agg_adaptive = false;
+	ds.td_expected_recs = rec_cnt;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+
+	VERBOSE_MSG("Aggregate hot SCM records with adaptive policy\n");
+	vos_agg_adaptive = true;
+	ds.td_expected_recs = 1;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+
+	/* More records than VOS_EVT_ORDER, not merged when they are cold */
+	rec_cnt = ARRAY_SIZE(recx_arr);
+	ds.td_recx_nr = rec_cnt;
+	ds.td_upd_epr.epr_hi = rec_cnt;
+	ds.td_agg_epr.epr_hi = rec_cnt + d_sec2hlc(vos_agg_cold_sec + 1);
+
+	VERBOSE_MSG("Aggregate cold SCM records w/o adaptive policy\n");
+	vos_agg_adaptive = false;
+	ds.td_expected_recs = 1;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+
+	VERBOSE_MSG("Aggregate cold SCM records with adaptive policy\n");
+	vos_agg_adaptive = true;
+	ds.td_expected_recs = rec_cnt;
+	aggregate_basic_lb(arg, &ds, 0, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+
+	vos_agg_adaptive = saved_adaptive;
+	cleanup();
+}
+
+#define AGG_TIER_RECS		4
+#define AGG_TIER_REC_SIZE	1024
+
+/* Update AGG_TIER_RECS contiguous small records, they are stored on SCM */
+static void
+aggregate_tier_update(struct io_test_args *arg, daos_unit_oid_t oid, char *dkey, char *akey)
+{
+	daos_recx_t	 recx;
+	char		*buf;
+	int		 i;
+
+	D_ALLOC(buf, AGG_TIER_REC_SIZE);
+	assert_non_null(buf);
+
+	for (i = 0; i < AGG_TIER_RECS; i++) {
+		recx.rx_idx = i * AGG_TIER_REC_SIZE;
+		recx.rx_nr = AGG_TIER_REC_SIZE;
+		update_value(arg, oid, i + 1, 0, dkey, akey, DAOS_IOD_ARRAY, 1, &recx, buf);
+	}
+	D_FREE(buf);
+}
+
+/*
+ * Cold small SCM records are moved to NVMe on aggregation.
+ */
+static void
+aggregate_39(void **state)
+{
+	struct io_test_args	*arg = *state;
+	vos_pool_info_t		 pool_info;
+	struct vos_pool_space	*vps = &pool_info.pif_space;
+	daos_epoch_range_t	 epr = { 0 };
+	daos_unit_oid_t		 oid;
+	char			 dkey[UPDATE_DKEY_SIZE] = { 0 };
+	char			 akey[UPDATE_AKEY_SIZE] = { 0 };
+	unsigned int		 saved_cold_sec = vos_tier_cold_sec;
+	daos_size_t		 nvme_free;
+	int			 rc;
+
+	rc = vos_pool_query(arg->ctx.tc_po_hdl, &pool_info);
+	assert_rc_equal(rc, 0);
+
+	/* NVMe isn't enabled */
+	if (NVME_TOTAL(vps) == 0) {
+		print_message("NVMe isn't enabled, skip test\n");
+		skip();
+	}
+
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+	/* The records are written a few seconds before the aggregation upper bound */
+	epr.epr_hi = AGG_TIER_RECS + d_sec2hlc(3);
+
+	VERBOSE_MSG("Aggregate SCM records w/o tiering\n");
+	oid = dts_unit_oid_gen(0, 0);
+	aggregate_tier_update(arg, oid, dkey, akey);
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(phy_recs_nr(arg, oid, &epr, dkey, akey, DAOS_IOD_ARRAY), AGG_TIER_RECS);
+
+	VERBOSE_MSG("Aggregate cold SCM records with tiering\n");
+	vos_tier_cold_sec = 1;
+	oid = dts_unit_oid_gen(0, 0);
+	aggregate_tier_update(arg, oid, dkey, akey);
+	/* Age the access tracking so the object isn't accessed for vos_tier_cold_sec */
+	vos_hdl2pool(arg->ctx.tc_po_hdl)->vp_atime_start -= vos_tier_cold_sec + 1;
+
+	rc = vos_pool_query(arg->ctx.tc_po_hdl, &pool_info);
+	assert_rc_equal(rc, 0);
+	nvme_free = NVME_FREE(vps);
+
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, VOS_AGG_FL_FORCE_SCAN);
+	vos_tier_cold_sec = saved_cold_sec;
+	assert_rc_equal(rc, 0);
+	assert_int_equal(phy_recs_nr(arg, oid, &epr, dkey, akey, DAOS_IOD_ARRAY), 1);
+
+	rc = vos_pool_query(arg->ctx.tc_po_hdl, &pool_info);
+	assert_rc_equal(rc, 0);
+	assert_true(NVME_FREE(vps) < nvme_free);
+	cleanup();
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -2975,6 +3252,14 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_34, NULL, agg_tst_teardown },
 	{ "VOS435: Test aggregation timestamp functions",
 	  aggregate_35, NULL, NULL },
+	{ "VOS436: Aggregate EV, multiple objects, keys, partitioned ULTs",
+	  aggregate_36, NULL, agg_tst_teardown },
+	{ "VOS437: Aggregate with single ULT vs. partitioned ULTs",
+	  aggregate_37, NULL, agg_tst_teardown },
+	{ "VOS438: Merge small SCM records with adaptive policy",
+	  aggregate_38, NULL, agg_tst_teardown },
+	{ "VOS439: Move cold small SCM records to NVMe",
+	  aggregate_39, NULL, agg_tst_teardown },
 };
 
 int
@@ -13,6 +13,7 @@
 #include <daos/common.h>
 #include <daos_srv/dtx_srv.h>
 #include <daos_srv/vos_types.h>
+#include <vos_internal.h>
 #include "vts_io.h"
 
 static void
@@ -858,6 +859,107 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+/* The restart time of many containers is measured by "vos_perf -R 'C;p'" */
+#define VTS_RESTART_CONTS	16
+
+static void
+dtx_19_open_all(struct io_test_args *args, uuid_t *co_uuids, daos_handle_t *cohs,
+		struct dtx_id *xid, bool lazy)
+{
+	int		rc;
+	int		i;
+
+	vos_lazy_index = lazy;
+
+	for (i = 0; i < VTS_RESTART_CONTS; i++) {
+		rc = vos_cont_open(args->ctx.tc_po_hdl, co_uuids[i], &cohs[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < VTS_RESTART_CONTS; i++) {
+		assert_int_equal(vos_hdl2cont(cohs[i])->vc_act_dtx_indexed, !lazy);
+
+		/* The first access indexes the active DTX table */
+		rc = vos_dtx_check(cohs[i], &xid[i], NULL, NULL, NULL, NULL, false);
+		assert_rc_equal(rc, DTX_ST_PREPARED);
+		assert_true(vos_hdl2cont(cohs[i])->vc_act_dtx_indexed);
+
+		rc = vos_cont_close(cohs[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	vos_lazy_index = false;
+}
+
+/* Restart containers with active DTX entries */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args		*args = *state;
+	daos_handle_t			 coh = args->ctx.tc_co_hdl;
+	struct dtx_id			*xid;
+	uuid_t				*co_uuids;
+	daos_handle_t			*cohs;
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	int				 rc;
+	int				 i;
+
+	D_ALLOC_ARRAY(xid, VTS_RESTART_CONTS);
+	D_ALLOC_ARRAY(co_uuids, VTS_RESTART_CONTS);
+	D_ALLOC_ARRAY(cohs, VTS_RESTART_CONTS);
+	assert_true(xid != NULL && co_uuids != NULL && cohs != NULL);
+
+	/* Leave a prepared DTX in each container */
+	for (i = 0; i < VTS_RESTART_CONTS; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		uuid_generate(co_uuids[i]);
+		rc = vos_cont_create(args->ctx.tc_po_hdl, co_uuids[i]);
+		assert_rc_equal(rc, 0);
+		rc = vos_cont_open(args->ctx.tc_po_hdl, co_uuids[i], &cohs[i]);
+		assert_rc_equal(rc, 0);
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey, dkey_buf, &akey, akey_buf,
+				    &iod, &sgl, &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		args->ctx.tc_co_hdl = cohs[i];
+		vts_dtx_begin(&args->oid, cohs[i], epoch, dkey_hash, &dth);
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl, dth, true);
+		assert_rc_equal(rc, 0);
+		xid[i] = dth->dth_xid;
+		vts_dtx_end(dth);
+		args->ctx.tc_co_hdl = coh;
+
+		/* Drop the DRAM state as a restart does */
+		rc = vos_cont_close(cohs[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	dtx_19_open_all(args, co_uuids, cohs, xid, false);
+	dtx_19_open_all(args, co_uuids, cohs, xid, true);
+
+	for (i = 0; i < VTS_RESTART_CONTS; i++) {
+		rc = vos_cont_destroy(args->ctx.tc_po_hdl, co_uuids[i]);
+		assert_rc_equal(rc, 0);
+	}
+
+	D_FREE(cohs);
+	D_FREE(co_uuids);
+	D_FREE(xid);
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -892,6 +994,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: Restart containers with lazy DTX index",
+	  dtx_19, NULL, dtx_tst_teardown },
 };
 
 int
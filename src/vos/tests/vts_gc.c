@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -12,6 +12,7 @@
 
 #include "vts_io.h"
 #include <daos_api.h>
+#include <vos_internal.h>
 
 #define NO_FLAGS	    (0)
 
@@ -551,6 +552,140 @@ gc_cont_test(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+/** Keys of the object destroyed by the adaptive GC test */
+#define GC_ADAPT_KEYS		2048
+/** Foreground updates issued between two GC batches */
+#define GC_ADAPT_FG_IOS		4
+
+struct gc_adapt_arg {
+	struct gc_test_args	*aa_args;
+	struct io_credit	*aa_cred;
+	struct vos_pool		*aa_pool;
+	daos_unit_oid_t		 aa_oid;
+	/** Load reported to GC, see VOS_GC_YIELD_* */
+	int			 aa_load;
+	/** First batch of a vos_gc_pool() call */
+	bool			 aa_first;
+	uint64_t		 aa_batches;
+	uint64_t		 aa_ios;
+	int			 aa_rc;
+};
+
+/** Check the credits of the batch just run, then run foreground I/O if busy */
+static int
+gc_adapt_yield(void *arg)
+{
+	struct gc_adapt_arg	*aa = arg;
+	struct vos_gc_ctl	*ctl = &aa->aa_pool->vp_gc_ctl;
+	int			 i;
+
+	/* The first batch of a cycle always runs as idle */
+	if (aa->aa_load == VOS_GC_YIELD_IDLE || aa->aa_first) {
+		assert_true(ctl->gcc_credits >= GC_CREDS_TIGHT);
+		assert_true(ctl->gcc_credits <= GC_CREDS_BOOST);
+	} else {
+		/* Stay out of the way of foreground I/O unless GC is behind */
+		assert_true(ctl->gcc_credits >= GC_CREDS_MIN);
+		assert_true(ctl->gcc_credits <= (ctl->gcc_behind ? GC_CREDS_TIGHT :
+						 GC_CREDS_SLACK));
+	}
+	aa->aa_first = false;
+	aa->aa_batches++;
+
+	if (aa->aa_load == VOS_GC_YIELD_IDLE)
+		return VOS_GC_YIELD_IDLE;
+
+	for (i = 0; i < GC_ADAPT_FG_IOS; i++) {
+		dts_key_gen(aa->aa_cred->tc_dbuf, DTS_KEY_LEN, NULL);
+		aa->aa_rc = gc_obj_update(aa->aa_args, aa->aa_args->gc_ctx.tsc_coh, aa->aa_oid,
+					  2, aa->aa_cred);
+		if (aa->aa_rc != 0)
+			return -1;
+		aa->aa_ios++;
+	}
+
+	return aa->aa_load;
+}
+
+static int
+gc_adapt_run(struct gc_test_args *args, int load)
+{
+	struct gc_adapt_arg	 aa = { 0 };
+	struct io_credit	*cred;
+	daos_unit_oid_t		 oid;
+	daos_handle_t		 coh = args->gc_ctx.tsc_coh;
+	unsigned int		 keys = GC_ADAPT_KEYS;
+	unsigned int		 i;
+	int			 rc;
+
+	if (DAOS_ON_VALGRIND)
+		keys = 256;
+
+	cred = dts_credit_take(&args->gc_ctx);
+	D_ASSERT(cred);
+	d_iov_set(&cred->tc_dkey, cred->tc_dbuf, DTS_KEY_LEN);
+	d_iov_set(&cred->tc_iod.iod_name, cred->tc_abuf, DTS_KEY_LEN);
+	dts_key_gen(cred->tc_abuf, DTS_KEY_LEN, NULL);
+
+	print_message("destroy object with %u keys, reclaim it %s\n", keys,
+		      load == VOS_GC_YIELD_IDLE ? "idle" : "under foreground I/O");
+	oid = dts_unit_oid_gen(0, 0);
+	for (i = 0; i < keys; i++) {
+		dts_key_gen(cred->tc_dbuf, DTS_KEY_LEN, NULL);
+		rc = gc_obj_update(args, coh, oid, 1, cred);
+		if (rc)
+			goto out;
+	}
+
+	rc = vos_obj_delete(coh, oid);
+	if (rc) {
+		print_error("failed to delete object: %s\n", d_errstr(rc));
+		goto out;
+	}
+
+	aa.aa_args = args;
+	aa.aa_cred = cred;
+	aa.aa_pool = vos_hdl2pool(args->gc_ctx.tsc_poh);
+	aa.aa_oid = dts_unit_oid_gen(0, 0);
+	aa.aa_load = load;
+
+	while (!vos_gc_pool_idle(args->gc_ctx.tsc_poh)) {
+		aa.aa_first = true;
+		rc = vos_gc_pool(args->gc_ctx.tsc_poh, -1, gc_adapt_yield, &aa);
+		if (rc < 0 || aa.aa_rc != 0) {
+			rc = rc < 0 ? rc : aa.aa_rc;
+			print_error("GC failed: %s\n", d_errstr(rc));
+			goto out;
+		}
+	}
+
+	/* Drained in several batches, with foreground I/O in between when busy */
+	assert_true(aa.aa_batches > 0);
+	if (load == VOS_GC_YIELD_BUSY)
+		assert_int_equal(aa.aa_ios, aa.aa_batches * GC_ADAPT_FG_IOS);
+	else
+		assert_int_equal(aa.aa_ios, 0);
+	/* The controller starts over once the pool is drained */
+	assert_int_equal(aa.aa_pool->vp_gc_ctl.gcc_credits, 0);
+	rc = 0;
+out:
+	dts_credit_return(&args->gc_ctx, cred);
+	return rc;
+}
+
+static void
+gc_adapt_test(void **state)
+{
+	struct gc_test_args *args = *state;
+	int		     rc;
+
+	rc = gc_adapt_run(args, VOS_GC_YIELD_BUSY);
+	assert_rc_equal(rc, 0);
+
+	rc = gc_adapt_run(args, VOS_GC_YIELD_IDLE);
+	assert_rc_equal(rc, 0);
+}
+
 static int
 gc_setup(void **state)
 {
@@ -618,6 +753,8 @@ static const struct CMUnitTest gc_tests[] = {
 	  gc_obj_test_destroy, gc_prepare, NULL},
 	{ "GC06: container garbage reopened container",
 	  gc_obj_test_reopened, gc_prepare, NULL},
+	{ "GC07: adaptive GC credits under foreground I/O",
+	  gc_adapt_test, gc_prepare, NULL},
 };
 
 int
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -1046,6 +1046,118 @@ ilog_test_discard(void **state)
 	ilog_fetch_finish(&ilents);
 }
 
+static int
+status_cache_fetch(struct umem_instance *umm, struct ilog_df *ilog,
+		   const struct ilog_desc_cbs *cbs, int *nr)
+{
+	struct ilog_entries	ilog_entries;
+	struct ilog_entry	entry;
+	int			rc;
+
+	/** Fresh entries on every call, like a new I/O request would do */
+	ilog_fetch_init(&ilog_entries);
+
+	rc = ilog_fetch(umm, ilog, cbs, DAOS_INTENT_DEFAULT, false, &ilog_entries);
+	if (rc != 0)
+		goto out;
+
+	*nr = 0;
+	ilog_foreach_entry(&ilog_entries, &entry) {
+		if (entry.ie_status != ILOG_COMMITTED) {
+			print_message("Unexpected status %d for epoch "DF_U64"\n",
+				      entry.ie_status, entry.ie_id.id_epoch);
+			rc = -DER_MISC;
+			goto out;
+		}
+		(*nr)++;
+	}
+out:
+	ilog_fetch_finish(&ilog_entries);
+	return rc;
+}
+
+#define NUM_HOT_PUNCH	200
+static void
+ilog_test_status_cache(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_pool		*pool;
+	struct umem_instance	*umm;
+	struct ilog_df		*ilog;
+	struct ilog_desc_cbs	 cbs;
+	struct ilog_cache_stats	 prev;
+	struct ilog_cache_stats	 stats;
+	daos_handle_t		 loh;
+	daos_epoch_t		 epoch;
+	int			 nr;
+	int			 rc;
+
+	pool = vos_hdl2pool(args->ctx.tc_po_hdl);
+	assert_non_null(pool);
+	umm = vos_pool2umm(pool);
+
+	/** The cache only applies to the real DTX status callbacks */
+	vos_ilog_desc_cbs_init(&cbs, args->ctx.tc_co_hdl);
+
+	ilog = ilog_alloc_root(umm);
+
+	rc = ilog_create(umm, ilog);
+	LOG_FAIL(rc, 0, "Failed to create a new incarnation log\n");
+
+	rc = ilog_open(umm, ilog, &cbs, &loh);
+	LOG_FAIL(rc, 0, "Failed to open incarnation log\n");
+
+	/** A hot key with a long history of punches */
+	for (epoch = 1; epoch <= NUM_HOT_PUNCH; epoch++) {
+		rc = ilog_update(loh, NULL, epoch, 1, epoch % 2 == 0);
+		LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	}
+
+	ilog_cache_stats_get(&prev);
+	rc = status_cache_fetch(umm, ilog, &cbs, &nr);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(nr, NUM_HOT_PUNCH);
+	ilog_cache_stats_get(&stats);
+	assert_int_equal(stats.ics_misses, prev.ics_misses + 1);
+
+	/** Second fetch resolves nothing */
+	prev = stats;
+	rc = status_cache_fetch(umm, ilog, &cbs, &nr);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(nr, NUM_HOT_PUNCH);
+	ilog_cache_stats_get(&stats);
+	assert_int_equal(stats.ics_hits, prev.ics_hits + 1);
+	assert_int_equal(stats.ics_saved, prev.ics_saved + NUM_HOT_PUNCH);
+
+	/** Any modification invalidates the cached status */
+	rc = ilog_update(loh, NULL, epoch, 1, true);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+
+	prev = stats;
+	rc = status_cache_fetch(umm, ilog, &cbs, &nr);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(nr, NUM_HOT_PUNCH + 1);
+	ilog_cache_stats_get(&stats);
+	assert_int_equal(stats.ics_misses, prev.ics_misses + 1);
+	assert_int_equal(stats.ics_saved, prev.ics_saved);
+
+	/** A flushed cache, e.g. on pool close, resolves everything again */
+	ilog_cache_flush();
+	prev = stats;
+	rc = status_cache_fetch(umm, ilog, &cbs, &nr);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(nr, NUM_HOT_PUNCH + 1);
+	ilog_cache_stats_get(&stats);
+	assert_int_equal(stats.ics_misses, prev.ics_misses + 1);
+	assert_int_equal(stats.ics_hits, prev.ics_hits);
+
+	ilog_close(loh);
+	rc = ilog_destroy(umm, &cbs, ilog);
+	assert_rc_equal(rc, 0);
+
+	ilog_free_root(umm, ilog);
+}
+
 static const struct CMUnitTest inc_tests[] = {
 	{ "VOS500.1: VOS incarnation log UPDATE", ilog_test_update, NULL,
 		NULL},
@@ -1057,6 +1169,8 @@ static const struct CMUnitTest inc_tests[] = {
 		NULL, NULL},
 	{ "VOS500.5: VOS incarnation log DISCARD test", ilog_test_discard,
 		NULL, NULL},
+	{ "VOS500.6: VOS incarnation log status cache test",
+		ilog_test_status_cache, NULL, NULL},
 };
 
 int
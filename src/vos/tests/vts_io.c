@@ -1176,6 +1176,82 @@ io_iter_test_key2anchor(void **state)
 	io_iter_test_base(arg);
 }
 
+#define BATCH_ITER_NR	(7)
+
+/** Batched d-key iteration returns the same keys as fetch and next */
+static void
+io_iter_test_batch(void **state)
+{
+	struct io_test_args	*arg = *state;
+	vos_iter_entry_t	 ents[BATCH_ITER_NR];
+	vos_iter_entry_t	 ent;
+	vos_iter_param_t	 param;
+	daos_handle_t		 ih;
+	daos_handle_t		 bih;
+	unsigned int		 nr;
+	unsigned int		 i;
+	int			 total = 0;
+	int			 rc;
+
+	memset(&param, 0, sizeof(param));
+	param.ip_hdl		= arg->ctx.tc_co_hdl;
+	param.ip_oid		= arg->oid;
+	param.ip_epr.epr_lo	= vts_epoch_gen + 10;
+	param.ip_epr.epr_hi	= DAOS_EPOCH_MAX;
+	param.ip_epc_expr	= VOS_IT_EPC_GE;
+
+	rc = vos_iter_prepare(VOS_ITER_DKEY, &param, &ih, NULL);
+	assert_rc_equal(rc, 0);
+	rc = vos_iter_prepare(VOS_ITER_DKEY, &param, &bih, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = vos_iter_probe(ih, NULL);
+	assert_rc_equal(rc, 0);
+	rc = vos_iter_probe(bih, NULL);
+	assert_rc_equal(rc, 0);
+
+	while (rc == 0) {
+		nr = BATCH_ITER_NR;
+		rc = vos_iter_fetch_batch(bih, ents, NULL, &nr);
+		assert_true(rc == 0 || rc == -DER_NONEXIST);
+		if (rc == 0)
+			assert_int_equal(nr, BATCH_ITER_NR);
+
+		for (i = 0; i < nr; i++) {
+			rc = vos_iter_fetch(ih, &ent, NULL);
+			assert_rc_equal(rc, 0);
+			assert_int_equal(ents[i].ie_key.iov_len, ent.ie_key.iov_len);
+			assert_memory_equal(ents[i].ie_key.iov_buf, ent.ie_key.iov_buf,
+					    ent.ie_key.iov_len);
+			assert_int_equal(ents[i].ie_epoch, ent.ie_epoch);
+			assert_int_equal(ents[i].ie_vis_flags, ent.ie_vis_flags);
+
+			rc = vos_iter_next(ih, NULL);
+			assert_true(rc == 0 || rc == -DER_NONEXIST);
+		}
+		total += nr;
+		if (rc == 0) {
+			/* Both cursors point to the same key */
+			rc = vos_iter_fetch(bih, &ents[0], NULL);
+			assert_rc_equal(rc, 0);
+		}
+	}
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	/* The batch iterator is at the end as well */
+	nr = BATCH_ITER_NR;
+	rc = vos_iter_fetch_batch(bih, ents, NULL, &nr);
+	assert_rc_equal(rc, -DER_NONEXIST);
+	assert_int_equal(nr, 0);
+
+	vos_iter_finish(bih);
+	vos_iter_finish(ih);
+
+	print_message("Enumerated in batch: %d, total_keys: %lu.\n",
+		      total, vts_cntr.cn_dkeys);
+	assert_int_equal(total, vts_cntr.cn_dkeys);
+}
+
 #define RANGE_ITER_KEYS (10)
 
 static int
@@ -1945,6 +2021,99 @@ io_fetch_no_exist_object_zc(void **state)
 	io_fetch_no_exist_object_base(state, TF_ZERO_COPY);
 }
 
+#define DIRTY_TEST_OBJS	4
+
+static void
+io_dirty_log(void **state)
+{
+	struct io_test_args	*arg = *state;
+	daos_unit_oid_t		 oids[DIRTY_TEST_OBJS];
+	daos_unit_oid_t		 clean;
+	daos_epoch_t		 epoch = gen_rand_epoch();
+	uint64_t		 nr;
+	int			 i;
+	int			 rc;
+
+	arg->ta_flags = 0;
+	/* Written before tracking starts, never dirty */
+	clean = gen_oid(arg->otype);
+	arg->oid = clean;
+	rc = io_update_and_fetch_dkey(arg, epoch, epoch);
+	assert_rc_equal(rc, 0);
+
+	/* Nothing is tracked, every object is dirty */
+	assert_true(vos_obj_is_dirty(arg->ctx.tc_co_hdl, clean));
+
+	rc = vos_pool_dirty_track(arg->ctx.tc_po_hdl, ++epoch);
+	assert_rc_equal(rc, 0);
+	assert_false(vos_obj_is_dirty(arg->ctx.tc_co_hdl, clean));
+
+	for (i = 0; i < DIRTY_TEST_OBJS; i++) {
+		oids[i] = gen_oid(arg->otype);
+		arg->oid = oids[i];
+		epoch++;
+		rc = io_update_and_fetch_dkey(arg, epoch, epoch);
+		assert_rc_equal(rc, 0);
+	}
+
+	/* Update the same object again, it is tracked only once */
+	arg->oid = oids[0];
+	epoch++;
+	rc = io_update_and_fetch_dkey(arg, epoch, epoch);
+	assert_rc_equal(rc, 0);
+
+	rc = vos_obj_punch(arg->ctx.tc_co_hdl, oids[1], ++epoch, 0, 0, NULL, 0,
+			   NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = vos_pool_dirty_query(arg->ctx.tc_po_hdl, &epoch, &nr);
+	assert_rc_equal(rc, 0);
+	assert_true(epoch != 0);
+	assert_int_equal(nr, DIRTY_TEST_OBJS);
+
+	for (i = 0; i < DIRTY_TEST_OBJS; i++)
+		assert_true(vos_obj_is_dirty(arg->ctx.tc_co_hdl, oids[i]));
+	assert_false(vos_obj_is_dirty(arg->ctx.tc_co_hdl, clean));
+
+	/* Stop tracking, the log is dropped */
+	rc = vos_pool_dirty_track(arg->ctx.tc_po_hdl, 0);
+	assert_rc_equal(rc, 0);
+	rc = vos_pool_dirty_query(arg->ctx.tc_po_hdl, &epoch, &nr);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(epoch, 0);
+	assert_int_equal(nr, 0);
+	assert_true(vos_obj_is_dirty(arg->ctx.tc_co_hdl, clean));
+}
+
+static void
+io_pool_stamp(void **state)
+{
+	struct io_test_args	*arg = *state;
+	uint64_t		 stamp;
+	int			 rc;
+
+	rc = vos_pool_stamp_set(arg->ctx.tc_po_hdl, 0);
+	assert_rc_equal(rc, 0);
+	rc = vos_pool_stamp_get(arg->ctx.tc_po_hdl, &stamp);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stamp, 0);
+
+	rc = vos_pool_stamp_set(arg->ctx.tc_po_hdl, 0x1234);
+	assert_rc_equal(rc, 0);
+	/* Stamping again with the same value is a no-op */
+	rc = vos_pool_stamp_set(arg->ctx.tc_po_hdl, 0x1234);
+	assert_rc_equal(rc, 0);
+	rc = vos_pool_stamp_get(arg->ctx.tc_po_hdl, &stamp);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stamp, 0x1234);
+
+	rc = vos_pool_stamp_set(arg->ctx.tc_po_hdl, 0);
+	assert_rc_equal(rc, 0);
+	rc = vos_pool_stamp_get(arg->ctx.tc_po_hdl, &stamp);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stamp, 0);
+}
+
 static void
 io_simple_one_key_test(void **state, unsigned int flags)
 {
@@ -2979,6 +3148,7 @@ static const struct CMUnitTest iterator_tests[] = {
     {"VOS240.0: KV Iter tests (for dkey)", io_iter_test, NULL, NULL},
     {"VOS240.1: KV Iter tests with anchor (for dkey)", io_iter_test_with_anchor, NULL, NULL},
     {"VOS240.7: key2anchor iterator test", io_iter_test_key2anchor, NULL, NULL},
+    {"VOS240.8: Batched KV Iter tests (for dkey)", io_iter_test_batch, NULL, NULL},
     {"VOS240.3: KV range Iteration tests (for dkey)", io_obj_forward_iter_test, NULL, NULL},
     {"VOS240.4: KV reverse range Iteration tests (for dkey)", io_obj_reverse_iter_test, NULL, NULL},
     {"VOS240.5 KV range iteration tests (for recx)", io_obj_forward_recx_iter_test, NULL, NULL},
@@ -3008,6 +3178,8 @@ static const struct CMUnitTest io_tests[] = {
     {"VOS282.1: Fetch from non existent dkey with zero-copy", io_fetch_no_exist_dkey_zc, NULL,
      NULL},
     {"VOS282.2: Accessing pool, container with same UUID", pool_cont_same_uuid, NULL, NULL},
+    {"VOS283: Dirty object log", io_dirty_log, NULL, NULL},
+    {"VOS284: Pool reintegration stamp", io_pool_stamp, NULL, NULL},
     {"VOS299: Space overflow negative error test", io_pool_overflow_test, NULL,
      io_pool_overflow_teardown},
 };
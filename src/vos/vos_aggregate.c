@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -16,6 +16,9 @@
 #include "vos_policy.h"
 
 unsigned int vos_agg_nvme_thresh = VOS_MW_NVME_THRESH;
+unsigned int vos_agg_ults = 1;
+bool vos_agg_adaptive;
+unsigned int vos_agg_cold_sec = VOS_AGG_COLD_SEC;
 
 /*
  * EV tree sorted iterator returns logical entry in extent start order, and
@@ -152,6 +155,33 @@ struct vos_agg_credits {
 };
 
 #define EV_TRACE_MAX 1024
+/*
+ * Shared by the ULTs aggregating the partitions of a container, see agg_run_parts().
+ * Only the coordinator calls the caller's yield function, the other ULTs follow its
+ * pace and its tight/slack/abort decisions.
+ */
+struct agg_part_ctl {
+	/* Bumped each time the coordinator returns from yield */
+	uint64_t		 pc_yield_gen;
+	/* Helpers wait on pc_yield_cond for the next yield of the coordinator, and the
+	 * coordinator on pc_park_cond for all the helpers to be parked or finished.
+	 */
+	ABT_mutex		 pc_lock;
+	ABT_cond		 pc_yield_cond;
+	ABT_cond		 pc_park_cond;
+	uint32_t		 pc_parts;
+	/* # of helper ULTs not finished yet */
+	uint32_t		 pc_running;
+	/* # of helper ULTs waiting on pc_yield_cond for the current generation */
+	uint32_t		 pc_parked;
+	/* First error of the helper ULTs */
+	int			 pc_rc;
+	uint32_t		 pc_tight:1,
+				 pc_abort:1,
+				 pc_csum_err:1,
+				 pc_nospc_err:1;
+};
+
 struct vos_agg_param {
 	vos_iter_entry_t        ap_evt_trace[EV_TRACE_MAX];
 	int                     ap_trace_start;
@@ -165,7 +195,29 @@ struct vos_agg_param {
 	unsigned int		ap_discard:1,
 				ap_csum_err:1,
 				ap_nospc_err:1,
-				ap_discard_obj:1;
+				ap_discard_obj:1,
+				/* Calls ap_yield_func for all partitions */
+				ap_part_coord:1,
+				/* Current object isn't accessed for vos_tier_cold_sec */
+				ap_tier_obj:1;
+	/* Partition of the object ID space, NULL ap_part_ctl for no partitioning */
+	struct agg_part_ctl	*ap_part_ctl;
+	uint32_t		 ap_part;
+	/* # of objects scanned in the partition */
+	uint64_t		 ap_part_objs;
+	/* Upper bound of the aggregation epoch range */
+	daos_epoch_t		 ap_epr_hi;
+	/* Current akey: latest aggregatable write, # of visible extents scanned */
+	daos_epoch_t		 ap_akey_write;
+	uint32_t		 ap_akey_exts;
+	/* EV bytes read and rewritten by merging, EV bytes freed in this pass */
+	daos_size_t		 ap_read_size;
+	daos_size_t		 ap_rewrite_size;
+	daos_size_t		 ap_free_size;
+	/* SCM bytes freed & allocated, bytes moved to NVMe by tiering in this pass */
+	daos_size_t		 ap_scm_freed;
+	daos_size_t		 ap_scm_alloc;
+	daos_size_t		 ap_tier_size;
 	struct umem_instance	*ap_umm;
 	int			(*ap_yield_func)(void *arg);
 	void			*ap_yield_arg;
@@ -227,6 +279,30 @@ agg_cont2metrics(struct vos_container *cont)
 	return &vpm->vp_agg_metrics;
 }
 
+/*
+ * Records of current akey are cold when neither the object is accessed nor the
+ * akey is written for vos_tier_cold_sec, they are moved to NVMe on merging.
+ */
+static inline bool
+agg_tier_cold(struct vos_agg_param *agg_param)
+{
+	if (!agg_param->ap_tier_obj || agg_param->ap_akey_write == 0 ||
+	    agg_param->ap_epr_hi <= agg_param->ap_akey_write)
+		return false;
+
+	return d_hlc2sec(agg_param->ap_epr_hi - agg_param->ap_akey_write) >= vos_tier_cold_sec;
+}
+
+static inline uint16_t
+agg_media_select(struct vos_agg_param *agg_param, struct vos_object *obj, daos_size_t size)
+{
+	if (agg_tier_cold(agg_param))
+		return vos_policy_media_select_cold(vos_obj2pool(obj), DAOS_IOD_ARRAY, size);
+
+	return vos_policy_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY, size,
+				       VOS_IOS_AGGREGATION);
+}
+
 static int
 agg_del_sv(daos_handle_t ih, struct vos_agg_param *agg_param,
 	   vos_iter_entry_t *entry, unsigned int *acts)
@@ -314,21 +390,56 @@ need_aggregate(daos_handle_t ih, struct vos_agg_param *agg_param, vos_iter_desc_
 	return agg_needed;
 }
 
+/* Wait for the coordinator to be scheduled again, then follow its decision */
+static bool
+vos_aggregate_yield_part(struct vos_agg_param *agg_param)
+{
+	struct agg_part_ctl	*pc = agg_param->ap_part_ctl;
+	uint64_t		 gen = pc->pc_yield_gen;
+
+	/* Don't take the xstream from foreground I/O while the coordinator is throttled */
+	ABT_mutex_lock(pc->pc_lock);
+	pc->pc_parked++;
+	ABT_cond_signal(pc->pc_park_cond);
+	while (gen == pc->pc_yield_gen && !pc->pc_abort)
+		ABT_cond_wait(pc->pc_yield_cond, pc->pc_lock);
+	ABT_mutex_unlock(pc->pc_lock);
+
+	credits_set(&agg_param->ap_credits, pc->pc_tight);
+	return pc->pc_abort;
+}
+
 static inline bool
 vos_aggregate_yield(struct vos_agg_param *agg_param)
 {
-	int	rc;
+	struct agg_part_ctl	*pc = agg_param->ap_part_ctl;
+	int			 rc;
 
 	/* Current DTX handle must be NULL, since aggregation runs under non-DTX mode. */
 	D_ASSERT(vos_dth_get() == NULL);
 
-	if (agg_param->ap_yield_func == NULL) {
+	if (pc != NULL && !agg_param->ap_part_coord)
+		return vos_aggregate_yield_part(agg_param);
+
+	if (agg_param->ap_yield_func == NULL || (pc != NULL && pc->pc_abort)) {
 		bio_yield();
-		credits_set(&agg_param->ap_credits, true);
-		return false;
+		rc = 0;
+	} else {
+		rc = agg_param->ap_yield_func(agg_param->ap_yield_arg);
+	}
+
+	if (pc != NULL) {
+		ABT_mutex_lock(pc->pc_lock);
+		pc->pc_tight = (rc == 0);
+		if (rc < 0)
+			pc->pc_abort = 1;
+		pc->pc_yield_gen++;
+		/* the parked helpers are released, wait for them to park again */
+		pc->pc_parked = 0;
+		ABT_cond_broadcast(pc->pc_yield_cond);
+		ABT_mutex_unlock(pc->pc_lock);
 	}
 
-	rc = agg_param->ap_yield_func(agg_param->ap_yield_arg);
 	/* Abort */
 	if (rc < 0)
 		return true;
@@ -339,12 +450,31 @@ vos_aggregate_yield(struct vos_agg_param *agg_param)
 	return false;
 }
 
+static inline uint32_t
+agg_oid2part(daos_unit_oid_t oid, uint32_t parts)
+{
+	return d_hash_mix64(oid.id_pub.lo ^ oid.id_pub.hi) % parts;
+}
+
 static int
 vos_agg_filter(daos_handle_t ih, vos_iter_desc_t *desc, void *cb_arg, unsigned int *acts)
 {
 	struct vos_agg_param	*agg_param = cb_arg;
+	struct agg_part_ctl	*pc = agg_param->ap_part_ctl;
 	int			 rc = 0;
 
+	/* Owned by another partition, still consume credits to yield periodically */
+	if (pc != NULL && desc->id_type == VOS_ITER_OBJ &&
+	    agg_oid2part(desc->id_oid, pc->pc_parts) != agg_param->ap_part) {
+		*acts |= VOS_ITER_CB_SKIP;
+		credits_consume(&agg_param->ap_credits, AGG_OP_SKIP);
+		goto out;
+	}
+
+	/* Consulted by the merge policy, see agg_akey_temp() */
+	if (desc->id_type == VOS_ITER_AKEY)
+		agg_param->ap_akey_write = desc->id_agg_write;
+
 	rc = need_aggregate(ih, agg_param, desc);
 	if (rc == 0) {
 		if (desc->id_type == VOS_ITER_OBJ) {
@@ -395,6 +525,10 @@ vos_agg_obj(daos_handle_t ih, vos_iter_entry_t *entry,
 	    struct vos_agg_param *agg_param, unsigned int *acts)
 {
 	agg_param->ap_oid = entry->ie_oid;
+	agg_param->ap_part_objs++;
+	if (!agg_param->ap_discard)
+		agg_param->ap_tier_obj = vos_policy_obj_cold(vos_hdl2cont(agg_param->ap_coh),
+							     entry->ie_oid);
 	inc_agg_counter(agg_param, VOS_ITER_OBJ, AGG_OP_SCAN);
 
 	return 0;
@@ -485,6 +619,7 @@ vos_agg_akey(daos_handle_t ih, vos_iter_entry_t *entry,
 
 	/* Reset the max epoch for low-level SV tree iteration */
 	agg_param->ap_max_epoch = 0;
+	agg_param->ap_akey_exts = 0;
 	/* The merge window for EV tree aggregation should have been closed */
 	if (merge_window_status(&agg_param->ap_window) != MW_CLOSED)
 		D_ASSERTF(false, "Merge window isn't closed.\n");
@@ -665,6 +800,15 @@ delete_evt_entry(struct vos_agg_param *agg_param, struct vos_obj_iter *oiter,
 		return rc;
 	}
 
+	if (!agg_param->ap_discard && !bio_addr_is_hole(&entry->ie_biov.bi_addr)) {
+		agg_param->ap_free_size += entry->ie_orig_recx.rx_nr * entry->ie_rsize;
+		if (entry->ie_biov.bi_addr.ba_type == DAOS_MEDIA_SCM)
+			agg_param->ap_scm_freed += entry->ie_orig_recx.rx_nr * entry->ie_rsize;
+		if (vam && vam->vam_free_size)
+			d_tm_inc_counter(vam->vam_free_size,
+					 entry->ie_orig_recx.rx_nr * entry->ie_rsize);
+	}
+
 	if (vam && vam->vam_del_ev && !agg_param->ap_discard)
 		d_tm_inc_counter(vam->vam_del_ev, 1);
 	credits_consume(&agg_param->ap_credits, AGG_OP_DEL);
@@ -977,16 +1121,13 @@ process_physical:
 }
 
 static int
-reserve_segment(struct vos_object *obj, struct agg_io_context *io,
+reserve_segment(struct vos_object *obj, struct agg_io_context *io, uint16_t media,
 		daos_size_t size, bio_addr_t *addr)
 {
 	uint64_t	off, now;
-	uint16_t	media;
 	int		rc;
 
 	memset(addr, 0, sizeof(*addr));
-	media = vos_policy_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY, size,
-					VOS_IOS_AGGREGATION);
 
 	if (media == DAOS_MEDIA_SCM) {
 		off = vos_reserve_scm(obj->obj_cont, io->ic_rsrvd_scm, size);
@@ -1094,6 +1235,7 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
 	struct vos_object	*obj = oiter->it_obj;
+	struct vos_agg_param	*agg_param = container_of(mw, struct vos_agg_param, ap_window);
 	struct agg_io_context	*io = &mw->mw_io_ctxt;
 	struct evt_entry_in	*ent_in = &lgc_seg->ls_ent_in;
 	struct agg_phy_ent	*phy_ent;
@@ -1101,6 +1243,7 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 	struct bio_sglist	 bsgl = { 0 }, bsgl_dst = { 0 };
 	bio_addr_t		 addr_src;
 	daos_size_t		 seg_size, copy_size, read_size = 0;
+	daos_size_t		 raw_size = 0;
 	struct evt_extent	 ext = { 0 };
 	daos_off_t		 phy_lo = 0;
 	unsigned int		 i, seg_count, biov_idx = 0;
@@ -1189,12 +1332,15 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 
 			csum_add_recalcs(&io->ic_csum_recalcs, phy_ent, &ext, biov_idx);
 		}
+		/* Including the data read for csum verification */
+		raw_size += bio_iov2raw_len(&bsgl.bs_iovs[biov_idx]);
 		biov_idx++;
 		read_size += copy_size;
 	}
 	D_ASSERT(seg_size == read_size);
 
-	rc = reserve_segment(obj, io, seg_size, &ent_in->ei_addr);
+	rc = reserve_segment(obj, io, agg_media_select(agg_param, obj, seg_size), seg_size,
+			     &ent_in->ei_addr);
 	if (rc) {
 		D_CDEBUG(rc == -DER_NOSPACE, DB_EPC, DLOG_ERR,
 			"Reserve "DF_U64" segment error: "DF_RC"\n", seg_size, DP_RC(rc));
@@ -1231,11 +1377,16 @@ post:
 	} else {
 		struct vos_agg_metrics	*vam = agg_cont2metrics(obj->obj_cont);
 
+		agg_param->ap_read_size += raw_size;
+		agg_param->ap_rewrite_size += seg_size;
+
 		if (vam) {
 			if (vam->vam_merge_recs)
 				d_tm_inc_counter(vam->vam_merge_recs, seg_count);
 			if (vam->vam_merge_size)
 				d_tm_inc_counter(vam->vam_merge_size, seg_size);
+			if (vam->vam_read_size)
+				d_tm_inc_counter(vam->vam_read_size, raw_size);
 		}
 	}
 out:
@@ -1417,12 +1568,16 @@ insert_segments(daos_handle_t ih, struct agg_merge_window *mw, bool last, unsign
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
 	struct vos_object	*obj = oiter->it_obj;
+	struct vos_agg_param	*agg_param = container_of(mw, struct vos_agg_param, ap_window);
+	struct vos_agg_metrics	*vam;
 	struct agg_io_context	*io = &mw->mw_io_ctxt;
 	struct agg_phy_ent	*phy_ent, *tmp;
 	struct agg_lgc_ent	*lgc_ent;
 	struct agg_lgc_seg	*lgc_seg;
 	struct evt_entry_in	*ent_in;
 	struct evt_rect		 rect;
+	daos_size_t		 freed = 0, scm_freed = 0;
+	daos_size_t		 scm_alloc = 0, tiered = 0;
 	unsigned int		 i, leftovers = 0;
 	int			 rc;
 
@@ -1513,6 +1668,11 @@ insert_segments(daos_handle_t ih, struct agg_merge_window *mw, bool last, unsign
 		/* Physical entry is in window or fully removed */
 		if (rect.rc_ex.ex_hi <= mw->mw_ext.ex_hi ||
 		    phy_ent->pe_remove) {
+			if (!bio_addr_is_hole(&phy_ent->pe_addr)) {
+				freed += evt_extent_width(&rect.rc_ex) * mw->mw_rsize;
+				if (phy_ent->pe_addr.ba_type == DAOS_MEDIA_SCM)
+					scm_freed += evt_extent_width(&rect.rc_ex) * mw->mw_rsize;
+			}
 			d_list_del(&phy_ent->pe_link);
 			unmark_removals(mw, phy_ent);
 			free_phy_ent(phy_ent);
@@ -1551,6 +1711,13 @@ insert_segments(daos_handle_t ih, struct agg_merge_window *mw, bool last, unsign
 				DP_RECT(&ent_in->ei_rect), DP_RC(rc));
 			goto abort;
 		}
+
+		if (bio_addr_is_hole(&ent_in->ei_addr))
+			continue;
+		if (ent_in->ei_addr.ba_type == DAOS_MEDIA_SCM)
+			scm_alloc += evt_rect_width(&ent_in->ei_rect) * mw->mw_rsize;
+		else if (agg_tier_cold(agg_param))
+			tiered += evt_rect_width(&ent_in->ei_rect) * mw->mw_rsize;
 	}
 
 	/* Clear window size */
@@ -1569,6 +1736,19 @@ abort:
 	else
 		rc = umem_tx_commit(vos_obj2umm(obj));
 
+	if (rc == 0) {
+		agg_param->ap_free_size += freed;
+		agg_param->ap_scm_freed += scm_freed;
+		agg_param->ap_scm_alloc += scm_alloc;
+		agg_param->ap_tier_size += tiered;
+
+		vam = agg_cont2metrics(obj->obj_cont);
+		if (vam && vam->vam_free_size && freed)
+			d_tm_inc_counter(vam->vam_free_size, freed);
+		if (vam && vam->vam_tier_size && tiered)
+			d_tm_inc_counter(vam->vam_tier_size, tiered);
+	}
+
 	return rc;
 }
 
@@ -1628,31 +1808,82 @@ free_removal_records(struct agg_merge_window *mw, d_list_t *head, bool top)
 	}
 }
 
+/* Write temperature of akey, used by adaptive aggregation */
+enum {
+	AGG_TEMP_WARM,
+	AGG_TEMP_HOT,
+	AGG_TEMP_COLD,
+};
+
+/* Hot SCM records are merged once this many logical records accumulated */
+#define AGG_HOT_MERGE_CNT	(VOS_EVT_ORDER / 2)
+/* Cold records are merged only when the akey has this many visible extents */
+#define AGG_COLD_FRAG_CNT	(VOS_EVT_ORDER * 2)
+
+/*
+ * Classify current akey by the age of its latest write, relative to the upper
+ * bound of aggregation epoch range.
+ */
+static inline int
+agg_akey_temp(struct vos_agg_param *agg_param)
+{
+	uint64_t	age = 0;
+
+	if (!vos_agg_adaptive || agg_param->ap_akey_write == 0)
+		return AGG_TEMP_WARM;
+
+	if (agg_param->ap_epr_hi > agg_param->ap_akey_write)
+		age = d_hlc2sec(agg_param->ap_epr_hi - agg_param->ap_akey_write);
+
+	if (age >= vos_agg_cold_sec)
+		return AGG_TEMP_COLD;
+	if (age < vos_agg_cold_sec / VOS_AGG_HOT_RATIO)
+		return AGG_TEMP_HOT;
+	return AGG_TEMP_WARM;
+}
+
 static inline bool
-need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_size)
+need_merge(daos_handle_t ih, struct vos_agg_param *agg_param, uint16_t src_media, bool hole,
+	   int lgc_cnt, daos_size_t seg_size)
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
 	struct vos_object	*obj = oiter->it_obj;
 	unsigned int		 seg_blks, nvme_blks;
 	uint16_t		 tgt_media;
+	int			 temp;
 
 	D_ASSERTF(lgc_cnt > 0 && seg_size > 0, "lgc_cnt=%d seg_size=" DF_U64 "\n", lgc_cnt,
 		  seg_size);
-	if (lgc_cnt == 1)
+	/* A single cold record could still be moved to NVMe */
+	if (lgc_cnt == 1 && (hole || !agg_tier_cold(agg_param)))
 		return false;
 
-	tgt_media = vos_policy_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY,
-					    seg_size, VOS_IOS_AGGREGATION);
+	tgt_media = agg_media_select(agg_param, obj, seg_size);
 	/* Some data can be migrated from SCM to NVMe to alleviate SCM pressure */
 	if (src_media != tgt_media)
 		return true;
 
+	if (lgc_cnt == 1)
+		return false;
+
+	/*
+	 * Adaptive policy: Hot data is likely to be read soon, condense it earlier to
+	 * speed up the reads; Cold data is rarely read, don't relocate it unless the
+	 * akey is badly fragmented.
+	 */
+	temp = agg_akey_temp(agg_param);
+	if (temp == AGG_TEMP_COLD && agg_param->ap_akey_exts < AGG_COLD_FRAG_CNT)
+		return false;
+
 	/*
 	 * Only trigger SCM to SCM data migration when there are enough amount of
 	 * SCM records accumulated.
 	 */
-	if (tgt_media == DAOS_MEDIA_SCM)
+	if (tgt_media == DAOS_MEDIA_SCM) {
+		if (temp == AGG_TEMP_HOT)
+			return lgc_cnt >= AGG_HOT_MERGE_CNT;
 		return lgc_cnt >= VOS_EVT_ORDER;
+	}
 
 	/*
 	 * Only trigger NVMe to NVMe data migration when:
@@ -1664,6 +1895,10 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
 	if (seg_blks < vos_agg_nvme_thresh)
 		return false;
 
+	/* Rewriting cold data just for alignment doesn't pay off */
+	if (temp == AGG_TEMP_COLD)
+		return lgc_cnt >= VOS_EVT_ORDER;
+
 	nvme_blks = (seg_blks / vos_agg_nvme_thresh);
 	return (lgc_cnt >= VOS_EVT_ORDER) || (seg_blks == (nvme_blks * vos_agg_nvme_thresh));
 }
@@ -1679,7 +1914,8 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
  * 4. If only records coalescing within same media (eg. merging small SCM records to a
  *    larger SCM record, or merging small NVMe records to a larger NVMe record), make
  *    a trade-off between VOS tree condensing and data relocating (which consumes CPU
- *    & storage bandwidth, yet likely to generate more fragmentations).
+ *    & storage bandwidth, yet likely to generate more fragmentations). The trade-off
+ *    takes the write temperature of akey into account when DAOS_VOS_AGG_ADAPTIVE is set.
  */
 static bool
 need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
@@ -1718,7 +1954,8 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 			return true;
 
 		if (i == 0 || (hole != bio_addr_is_hole(&phy_ent->pe_addr))) {
-			if (i && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+			if (i && need_merge(ih, agg_param, src_media, hole, lgc_cnt,
+					    seg_width * mw->mw_rsize))
 				return true;
 
 			src_media = phy_ent->pe_addr.ba_type;
@@ -1742,7 +1979,8 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 		hole = bio_addr_is_hole(&phy_ent->pe_addr);
 	}
 
-	if (lgc_cnt && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+	if (lgc_cnt && need_merge(ih, agg_param, src_media, hole, lgc_cnt,
+				  seg_width * mw->mw_rsize))
 		return true;
 
 	clear_merge_window(mw);
@@ -2166,8 +2404,9 @@ out:
 }
 
 static int
-set_window_size(struct agg_merge_window *mw, vos_iter_entry_t *entry)
+set_window_size(struct vos_agg_param *agg_param, vos_iter_entry_t *entry)
 {
+	struct agg_merge_window	*mw = &agg_param->ap_window;
 	struct dcs_csum_info	*csum_info = &entry->ie_csum;
 	daos_size_t		 rsize = entry->ie_rsize;
 
@@ -2190,6 +2429,13 @@ set_window_size(struct agg_merge_window *mw, vos_iter_entry_t *entry)
 			       mw->mw_flush_thresh);
 		} else if (rsize < (VOS_MW_FLUSH_THRESH / 2)) {
 			mw->mw_flush_thresh = VOS_MW_FLUSH_THRESH;
+			/*
+			 * Hot data is likely to be overwritten again, flush it in smaller
+			 * windows to bound the data being rewritten at a time.
+			 */
+			if (rsize < (VOS_MW_FLUSH_THRESH / 8) &&
+			    agg_akey_temp(agg_param) == AGG_TEMP_HOT)
+				mw->mw_flush_thresh = VOS_MW_FLUSH_THRESH / 4;
 		} else {
 			mw->mw_flush_thresh = (rsize < VOS_MW_FLUSH_THRESH) ?
 						rsize * 2 : rsize;
@@ -2274,7 +2520,10 @@ vos_agg_ev(daos_handle_t ih, vos_iter_entry_t *entry,
 		DP_EXT(&phy_ext), entry->ie_epoch, entry->ie_minor_epc,
 		entry->ie_vis_flags, evt_vis2dbg(entry->ie_vis_flags));
 
-	rc = set_window_size(mw, entry);
+	if (!(entry->ie_vis_flags & VOS_VIS_FLAG_COVERED))
+		agg_param->ap_akey_exts++;
+
+	rc = set_window_size(agg_param, entry);
 	if (rc)
 		goto out;
 
@@ -2619,6 +2868,275 @@ struct agg_data {
 	struct vos_iter_anchors	ad_anchors;
 };
 
+static int
+agg_iterate(struct agg_data *ad)
+{
+	struct vos_agg_param	*agg_param = &ad->ad_agg_param;
+	int			 rc;
+
+	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
+			 vos_aggregate_pre_cb, vos_aggregate_post_cb, agg_param, NULL);
+	if (rc != 0 || agg_param->ap_nospc_err)
+		close_merge_window(&agg_param->ap_window, rc);
+	else if (agg_param->ap_csum_err)
+		close_merge_window(&agg_param->ap_window, -DER_CSUM);
+
+	return rc;
+}
+
+/*
+ * Report the net SCM space freed by the aggregation pass, and the read & write
+ * amplification in percent of freed size.
+ */
+static void
+agg_pass_report(struct vos_container *cont, struct vos_agg_param *agg_param)
+{
+	struct vos_agg_metrics	*vam = agg_cont2metrics(cont);
+	uint64_t		 scm_freed = 0;
+	uint64_t		 read_amp, write_amp;
+
+	if (agg_param->ap_scm_freed > agg_param->ap_scm_alloc)
+		scm_freed = agg_param->ap_scm_freed - agg_param->ap_scm_alloc;
+	if (agg_param->ap_tier_size != 0)
+		D_DEBUG(DB_EPC, DF_CONT": moved "DF_U64" cold bytes to NVMe, SCM freed "DF_U64"\n",
+			DP_CONT(cont->vc_pool->vp_id, cont->vc_id), agg_param->ap_tier_size,
+			scm_freed);
+	if (vam && vam->vam_scm_freed)
+		d_tm_set_gauge(vam->vam_scm_freed, scm_freed);
+
+	if (agg_param->ap_free_size == 0)
+		return;
+
+	read_amp = agg_param->ap_read_size * 100 / agg_param->ap_free_size;
+	write_amp = agg_param->ap_rewrite_size * 100 / agg_param->ap_free_size;
+	D_DEBUG(DB_EPC, DF_CONT": read "DF_U64", rewritten "DF_U64", freed "DF_U64
+		" bytes, read amp "DF_U64"%%, write amp "DF_U64"%%\n",
+		DP_CONT(cont->vc_pool->vp_id, cont->vc_id), agg_param->ap_read_size,
+		agg_param->ap_rewrite_size, agg_param->ap_free_size, read_amp, write_amp);
+
+	if (vam == NULL)
+		return;
+	if (vam->vam_read_amp)
+		d_tm_set_gauge(vam->vam_read_amp, read_amp);
+	if (vam->vam_write_amp)
+		d_tm_set_gauge(vam->vam_write_amp, write_amp);
+}
+
+/* Same as the stack size of the aggregation ULT, DSS_DEEP_STACK_SZ */
+#define AGG_PART_STACK_SZ	(64 << 10)
+
+static void
+agg_part_report(struct vos_agg_param *agg_param, int rc)
+{
+	struct vos_container	*cont = vos_hdl2cont(agg_param->ap_coh);
+
+	D_DEBUG(DB_EPC, DF_CONT": partition %u/%u scanned "DF_U64" objects: "DF_RC"\n",
+		DP_CONT(cont->vc_pool->vp_id, cont->vc_id), agg_param->ap_part,
+		agg_param->ap_part_ctl->pc_parts, agg_param->ap_part_objs, DP_RC(rc));
+}
+
+static void
+agg_part_ult(void *arg)
+{
+	struct agg_data		*ad = arg;
+	struct vos_agg_param	*agg_param = &ad->ad_agg_param;
+	struct agg_part_ctl	*pc = agg_param->ap_part_ctl;
+	int			 rc;
+
+	rc = agg_iterate(ad);
+	agg_part_report(agg_param, rc);
+	if (rc != 0 && pc->pc_rc == 0)
+		pc->pc_rc = rc;
+	if (agg_param->ap_csum_err)
+		pc->pc_csum_err = 1;
+	if (agg_param->ap_nospc_err)
+		pc->pc_nospc_err = 1;
+
+	ABT_mutex_lock(pc->pc_lock);
+	D_ASSERT(pc->pc_running > 0);
+	pc->pc_running--;
+	ABT_cond_signal(pc->pc_park_cond);
+	ABT_mutex_unlock(pc->pc_lock);
+}
+
+static void
+agg_part_ctl_fini(struct agg_part_ctl *pc)
+{
+	if (pc->pc_park_cond != ABT_COND_NULL)
+		ABT_cond_free(&pc->pc_park_cond);
+	if (pc->pc_yield_cond != ABT_COND_NULL)
+		ABT_cond_free(&pc->pc_yield_cond);
+	if (pc->pc_lock != ABT_MUTEX_NULL)
+		ABT_mutex_free(&pc->pc_lock);
+}
+
+static int
+agg_part_ctl_init(struct agg_part_ctl *pc, uint32_t parts)
+{
+	int	rc;
+
+	memset(pc, 0, sizeof(*pc));
+	pc->pc_lock = ABT_MUTEX_NULL;
+	pc->pc_yield_cond = ABT_COND_NULL;
+	pc->pc_park_cond = ABT_COND_NULL;
+	pc->pc_parts = parts;
+	pc->pc_tight = 1;
+
+	rc = ABT_mutex_create(&pc->pc_lock);
+	if (rc != ABT_SUCCESS)
+		goto failed;
+	rc = ABT_cond_create(&pc->pc_yield_cond);
+	if (rc != ABT_SUCCESS)
+		goto failed;
+	rc = ABT_cond_create(&pc->pc_park_cond);
+	if (rc != ABT_SUCCESS)
+		goto failed;
+	return 0;
+failed:
+	agg_part_ctl_fini(pc);
+	return dss_abterr2der(rc);
+}
+
+/*
+ * Aggregate the container with @parts ULTs on the current xstream, each of them
+ * iterates the object tree but only aggregates the objects of its own partition,
+ * so that the merge windows of different objects flush to NVMe concurrently. The
+ * caller's ULT coordinates the others, it is the only one calling the yield function.
+ */
+static int
+agg_run_parts(struct vos_container *cont, struct agg_data *ad, uint32_t parts)
+{
+	struct agg_part_ctl	 pc;
+	struct agg_data		*helpers;
+	ABT_thread		*ults;
+	ABT_thread_attr		 attr = ABT_THREAD_ATTR_NULL;
+	ABT_pool		 pool;
+	uint32_t		 created = 0;
+	uint32_t		 i;
+	int			 rc;
+
+	D_ALLOC_ARRAY(helpers, parts - 1);
+	if (helpers == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC_ARRAY(ults, parts - 1);
+	if (ults == NULL)
+		D_GOTO(free_helpers, rc = -DER_NOMEM);
+
+	rc = ABT_self_get_last_pool(&pool);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free_ults, rc = dss_abterr2der(rc));
+
+	rc = ABT_thread_attr_create(&attr);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free_ults, rc = dss_abterr2der(rc));
+
+	rc = ABT_thread_attr_set_stacksize(attr, AGG_PART_STACK_SZ);
+	if (rc != ABT_SUCCESS)
+		D_GOTO(free_attr, rc = dss_abterr2der(rc));
+
+	rc = agg_part_ctl_init(&pc, parts);
+	if (rc != 0)
+		D_GOTO(free_attr, rc);
+	ad->ad_agg_param.ap_part_ctl = &pc;
+	ad->ad_agg_param.ap_part = 0;
+	ad->ad_agg_param.ap_part_coord = 1;
+
+	for (i = 0; i < parts - 1; i++) {
+		helpers[i] = *ad;
+		helpers[i].ad_agg_param.ap_part = i + 1;
+		helpers[i].ad_agg_param.ap_part_coord = 0;
+		merge_window_init(&helpers[i].ad_agg_param.ap_window);
+	}
+
+	for (i = 0; i < parts - 1; i++) {
+		ABT_mutex_lock(pc.pc_lock);
+		pc.pc_running++;
+		ABT_mutex_unlock(pc.pc_lock);
+		rc = ABT_thread_create(pool, agg_part_ult, &helpers[i], attr, &ults[i]);
+		if (rc != ABT_SUCCESS) {
+			ABT_mutex_lock(pc.pc_lock);
+			pc.pc_running--;
+			ABT_mutex_unlock(pc.pc_lock);
+			break;
+		}
+		created++;
+	}
+	if (created < parts - 1)
+		D_DEBUG(DB_EPC, DF_CONT": %u of %u partition ULTs created\n",
+			DP_CONT(cont->vc_pool->vp_id, cont->vc_id), created, parts - 1);
+
+	rc = agg_iterate(ad);
+	agg_part_report(&ad->ad_agg_param, rc);
+	/* Stop the helper ULTs as well, HAE won't be bumped anyway */
+	if (rc != 0) {
+		ABT_mutex_lock(pc.pc_lock);
+		pc.pc_abort = 1;
+		pc.pc_parked = 0;
+		ABT_cond_broadcast(pc.pc_yield_cond);
+		ABT_mutex_unlock(pc.pc_lock);
+	}
+
+	/* The partitions without ULT are aggregated by the coordinator */
+	for (i = created; i < parts - 1 && rc == 0 && !pc.pc_abort; i++) {
+		helpers[i].ad_agg_param.ap_part_coord = 1;
+		rc = agg_iterate(&helpers[i]);
+		agg_part_report(&helpers[i].ad_agg_param, rc);
+		if (helpers[i].ad_agg_param.ap_csum_err)
+			ad->ad_agg_param.ap_csum_err = 1;
+		if (helpers[i].ad_agg_param.ap_nospc_err)
+			ad->ad_agg_param.ap_nospc_err = 1;
+	}
+
+	/*
+	 * Keep yielding on behalf of the helper ULTs until all of them are done, but
+	 * only once all the running ones are parked, so that the helpers run between
+	 * two yields of the coordinator instead of spinning through the throttle.
+	 */
+	ABT_mutex_lock(pc.pc_lock);
+	while (pc.pc_running > 0) {
+		if (pc.pc_parked < pc.pc_running) {
+			ABT_cond_wait(pc.pc_park_cond, pc.pc_lock);
+			continue;
+		}
+		ABT_mutex_unlock(pc.pc_lock);
+		vos_aggregate_yield(&ad->ad_agg_param);
+		ABT_mutex_lock(pc.pc_lock);
+	}
+	ABT_mutex_unlock(pc.pc_lock);
+
+	for (i = 0; i < created; i++)
+		ABT_thread_free(&ults[i]);
+
+	for (i = 0; i < parts - 1; i++) {
+		if (merge_window_status(&helpers[i].ad_agg_param.ap_window) != MW_CLOSED)
+			D_ASSERTF(false, "Merge window resource leaked.\n");
+		ad->ad_agg_param.ap_read_size += helpers[i].ad_agg_param.ap_read_size;
+		ad->ad_agg_param.ap_rewrite_size += helpers[i].ad_agg_param.ap_rewrite_size;
+		ad->ad_agg_param.ap_free_size += helpers[i].ad_agg_param.ap_free_size;
+		ad->ad_agg_param.ap_scm_freed += helpers[i].ad_agg_param.ap_scm_freed;
+		ad->ad_agg_param.ap_scm_alloc += helpers[i].ad_agg_param.ap_scm_alloc;
+		ad->ad_agg_param.ap_tier_size += helpers[i].ad_agg_param.ap_tier_size;
+	}
+
+	if (rc == 0)
+		rc = pc.pc_rc;
+	if (pc.pc_csum_err)
+		ad->ad_agg_param.ap_csum_err = 1;
+	if (pc.pc_nospc_err)
+		ad->ad_agg_param.ap_nospc_err = 1;
+
+	ad->ad_agg_param.ap_part_ctl = NULL;
+	agg_part_ctl_fini(&pc);
+free_attr:
+	ABT_thread_attr_free(&attr);
+free_ults:
+	D_FREE(ults);
+free_helpers:
+	D_FREE(helpers);
+	return rc;
+}
+
 int
 vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	      int (*yield_func)(void *arg), void *yield_arg, uint32_t flags)
@@ -2680,20 +3198,21 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	ad->ad_agg_param.ap_discard = 0;
 	ad->ad_agg_param.ap_yield_func = yield_func;
 	ad->ad_agg_param.ap_yield_arg = yield_arg;
+	ad->ad_agg_param.ap_epr_hi = epr->epr_hi;
 	run_agg = true;
 	merge_window_init(&ad->ad_agg_param.ap_window);
 	ad->ad_agg_param.ap_flags = flags;
 
 	ad->ad_iter_param.ip_flags |= VOS_IT_FOR_PURGE;
-	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
-			 vos_aggregate_pre_cb, vos_aggregate_post_cb,
-			 &ad->ad_agg_param, NULL);
+	if (vos_agg_ults > 1)
+		rc = agg_run_parts(cont, ad, vos_agg_ults);
+	else
+		rc = agg_iterate(ad);
+	agg_pass_report(cont, &ad->ad_agg_param);
 	if (rc != 0 || ad->ad_agg_param.ap_nospc_err) {
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
 		goto exit;
 	} else if (ad->ad_agg_param.ap_csum_err) {
 		rc = -DER_CSUM;	/* Inform caller the csum error */
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
 		/* HAE needs be updated for csum error case */
 	}
 
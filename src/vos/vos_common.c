@@ -419,6 +419,8 @@ vos_tls_fini(void *data)
 	umem_fini_txd(&tls->vtl_txd);
 	if (tls->vtl_ts_table)
 		vos_ts_table_free(&tls->vtl_ts_table);
+	if (tls->vtl_ilog_cache)
+		ilog_cache_destroy(tls->vtl_ilog_cache);
 	D_FREE(tls);
 }
 
@@ -467,6 +469,12 @@ vos_tls_init(int xs_id, int tgt_id)
 		goto failed;
 	}
 
+	rc = ilog_cache_create(tgt_id, &tls->vtl_ilog_cache);
+	if (rc) {
+		D_ERROR("Error in creating ilog status cache: "DF_RC"\n", DP_RC(rc));
+		goto failed;
+	}
+
 	if (tgt_id < 0)
 		/** skip sensor setup on standalone vos & sys xstream */
 		return tls;
@@ -550,6 +558,30 @@ vos_mod_init(void)
 	D_INFO("Set aggregate NVMe record threshold to %u blocks (blk_sz:%lu).\n",
 	       vos_agg_nvme_thresh, VOS_BLK_SZ);
 
+	d_getenv_int("DAOS_VOS_AGG_ULTS", &vos_agg_ults);
+	if (vos_agg_ults == 0)
+		vos_agg_ults = 1;
+	else if (vos_agg_ults > VOS_AGG_ULTS_MAX)
+		vos_agg_ults = VOS_AGG_ULTS_MAX;
+	if (vos_agg_ults > 1)
+		D_INFO("Aggregate each container with %u ULTs.\n", vos_agg_ults);
+
+	d_getenv_bool("DAOS_VOS_AGG_ADAPTIVE", &vos_agg_adaptive);
+	d_getenv_int("DAOS_VOS_AGG_COLD_SEC", &vos_agg_cold_sec);
+	if (vos_agg_cold_sec < VOS_AGG_HOT_RATIO)
+		vos_agg_cold_sec = VOS_AGG_COLD_SEC;
+	if (vos_agg_adaptive)
+		D_INFO("Adaptive aggregation enabled, cold data threshold %u seconds.\n",
+		       vos_agg_cold_sec);
+
+	d_getenv_int("DAOS_VOS_TIER_COLD_SEC", &vos_tier_cold_sec);
+	if (vos_tier_cold_sec != 0)
+		D_INFO("Move cold data to NVMe after %u seconds.\n", vos_tier_cold_sec);
+
+	d_getenv_bool("DAOS_VOS_LAZY_INDEX", &vos_lazy_index);
+	if (vos_lazy_index)
+		D_INFO("Index active DTX entries lazily after container open.\n");
+
 	d_getenv_bool("DAOS_DKEY_PUNCH_PROPAGATE", &vos_dkey_punch_propagate);
 	D_INFO("DKEY punch propagation is %s\n", vos_dkey_punch_propagate ? "enabled" : "disabled");
 
@@ -566,7 +598,8 @@ vos_mod_fini(void)
 static inline int
 vos_metrics_count(void)
 {
-	return vea_metrics_count();
+	return vea_metrics_count() +
+	       (sizeof(struct vos_gc_metrics) / sizeof(struct d_tm_node_t *));
 }
 
 static void
@@ -581,6 +614,7 @@ vos_metrics_free(void *data)
 
 #define VOS_AGG_DIR	"vos_aggregation"
 #define VOS_SPACE_DIR	"vos_space"
+#define VOS_GC_DIR	"vos_gc"
 
 static inline char *
 agg_op2str(unsigned int agg_op)
@@ -603,6 +637,7 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	struct vos_pool_metrics		*vp_metrics;
 	struct vos_agg_metrics		*vam;
 	struct vos_space_metrics	*vsm;
+	struct vos_gc_metrics		*vgm;
 	char				desc[40];
 	int				i, rc;
 
@@ -620,6 +655,7 @@ vos_metrics_alloc(const char *path, int tgt_id)
 
 	vam = &vp_metrics->vp_agg_metrics;
 	vsm = &vp_metrics->vp_space_metrics;
+	vgm = &vp_metrics->vp_gc_metrics;
 
 	/* VOS aggregation EPR scan duration */
 	rc = d_tm_add_metric(&vam->vam_epr_dur, D_TM_DURATION | D_TM_CLOCK_THREAD_CPUTIME,
@@ -691,6 +727,42 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create 'merged_size' telemetry : "DF_RC"\n", DP_RC(rc));
 
+	/* VOS aggregation total size read for merging */
+	rc = d_tm_add_metric(&vam->vam_read_size, D_TM_COUNTER, "total read size", "bytes",
+			     "%s/%s/read_size/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'read_size' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation total freed EV size */
+	rc = d_tm_add_metric(&vam->vam_free_size, D_TM_COUNTER, "total freed size", "bytes",
+			     "%s/%s/freed_size/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'freed_size' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation read amplification of last pass */
+	rc = d_tm_add_metric(&vam->vam_read_amp, D_TM_GAUGE, "bytes read per freed byte",
+			     "%", "%s/%s/read_amp/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'read_amp' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation write amplification of last pass */
+	rc = d_tm_add_metric(&vam->vam_write_amp, D_TM_GAUGE, "bytes rewritten per freed byte",
+			     "%", "%s/%s/write_amp/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'write_amp' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation total cold data size moved to NVMe */
+	rc = d_tm_add_metric(&vam->vam_tier_size, D_TM_COUNTER, "total tiered size", "bytes",
+			     "%s/%s/tiered_size/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'tiered_size' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS aggregation SCM space freed by last pass */
+	rc = d_tm_add_metric(&vam->vam_scm_freed, D_TM_GAUGE, "SCM space freed by last pass",
+			     "bytes", "%s/%s/scm_freed/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'scm_freed' telemetry : "DF_RC"\n", DP_RC(rc));
+
 	/* VOS space SCM used metric */
 	rc = d_tm_add_metric(&vsm->vsm_scm_used, D_TM_GAUGE, "SCM space used", "bytes",
 			     "%s/%s/scm_used/tgt_%u", path, VOS_SPACE_DIR, tgt_id);
@@ -703,6 +775,36 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create 'nvme_used' telemetry : "DF_RC"\n", DP_RC(rc));
 
+	/* VOS GC reclaimed SCM space */
+	rc = d_tm_add_metric(&vgm->vgm_reclaimed, D_TM_COUNTER, "GC reclaimed SCM space",
+			     "bytes", "%s/%s/reclaimed/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'reclaimed' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS GC reclaim rate */
+	rc = d_tm_add_metric(&vgm->vgm_reclaim_rate, D_TM_GAUGE, "GC reclaim rate",
+			     "bytes/sec", "%s/%s/reclaim_rate/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'reclaim_rate' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS GC backlog */
+	rc = d_tm_add_metric(&vgm->vgm_backlog, D_TM_GAUGE, "GC queued items", "items",
+			     "%s/%s/backlog/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'backlog' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS GC estimated time to drain */
+	rc = d_tm_add_metric(&vgm->vgm_drain_time, D_TM_GAUGE, "GC estimated time to drain",
+			     "sec", "%s/%s/drain_time/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'drain_time' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	/* VOS GC credits per batch */
+	rc = d_tm_add_metric(&vgm->vgm_credits, D_TM_GAUGE, "GC credits per batch", NULL,
+			     "%s/%s/credits/tgt_%u", path, VOS_GC_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'credits' telemetry : "DF_RC"\n", DP_RC(rc));
+
 	/* Initialize the vos_space_metrics timeout counter */
 	vsm->vsm_last_update_ts = 0;
 
@@ -23,6 +23,9 @@
 
 #include "vos_internal.h"
 
+/* Don't index active DTX entries on container open */
+bool vos_lazy_index;
+
 /**
  * Parameters for vos_cont_df btree
  */
@@ -372,6 +375,7 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 	else
 		cont->vc_cmt_dtx_indexed = 0;
 	cont->vc_cmt_dtx_reindex_pos = cont->vc_cont_df->cd_dtx_committed_head;
+	cont->vc_act_dtx_reindex_pos = cont->vc_cont_df->cd_dtx_active_head;
 	D_INIT_LIST_HEAD(&cont->vc_dtx_act_list);
 	cont->vc_dtx_committed_count = 0;
 	cont->vc_solo_dtx_epoch = d_hlc_get();
@@ -436,10 +440,13 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		}
 	}
 
-	rc = vos_dtx_act_reindex(cont);
-	if (rc != 0) {
-		D_ERROR("Fail to reindex active DTX entries: %d\n", rc);
-		goto exit;
+	/* The active DTX table will be indexed on the first access, or in background */
+	if (!vos_lazy_index) {
+		rc = vos_dtx_act_reindex(cont);
+		if (rc != 0) {
+			D_ERROR("Fail to reindex active DTX entries: %d\n", rc);
+			goto exit;
+		}
 	}
 
 	rc = cont_insert(cont, &ukey, &pkey, coh);
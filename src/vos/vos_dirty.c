@@ -0,0 +1,259 @@
+/**
+ * (C) Copyright 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Dirty object log.
+ *
+ * Once enabled on a pool, every object modified by an update or a punch is
+ * recorded in a DRAM hash table, so that incremental reintegration only has
+ * to migrate the objects that changed while a target was out. The log is not
+ * persistent, it is lost when the pool is closed, and it degrades to "every
+ * object is dirty" if it grows larger than VOS_DIRTY_MAX entries.
+ *
+ * The log alone does not make reintegration safe, the returning target must
+ * also still hold its old data. That is what the persistent pool stamp is for.
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include "vos_internal.h"
+
+/* Max objects tracked per pool, every object is dirty beyond that */
+#define VOS_DIRTY_MAX	(1 << 20)
+
+struct vos_dirty_key {
+	uuid_t			dk_cont;
+	daos_unit_oid_t		dk_oid;
+};
+
+struct vos_dirty_ent {
+	d_list_t		de_link;
+	struct vos_dirty_key	de_key;
+	/* The highest epoch the object was modified at */
+	daos_epoch_t		de_epoch;
+};
+
+static inline struct vos_dirty_ent *
+dirty_rlink2ent(d_list_t *rlink)
+{
+	return container_of(rlink, struct vos_dirty_ent, de_link);
+}
+
+/* Layout version and padding don't identify the object shard, leave them out */
+static inline void
+dirty_key_init(struct vos_dirty_key *key, struct vos_container *cont, daos_unit_oid_t oid)
+{
+	memset(key, 0, sizeof(*key));
+	uuid_copy(key->dk_cont, cont->vc_id);
+	key->dk_oid.id_pub = oid.id_pub;
+	key->dk_oid.id_shard = oid.id_shard;
+}
+
+static bool
+dirty_key_cmp(struct d_hash_table *htable, d_list_t *rlink,
+	      const void *key, unsigned int ksize)
+{
+	struct vos_dirty_ent	*ent = dirty_rlink2ent(rlink);
+
+	D_ASSERT(ksize == sizeof(struct vos_dirty_key));
+	return memcmp(&ent->de_key, key, ksize) == 0;
+}
+
+static uint32_t
+dirty_key_hash(struct d_hash_table *htable, const void *key,
+	       unsigned int ksize)
+{
+	return d_hash_string_u32((const char *)key, ksize);
+}
+
+static uint32_t
+dirty_rec_hash(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct vos_dirty_ent	*ent = dirty_rlink2ent(rlink);
+
+	return d_hash_string_u32((const char *)&ent->de_key, sizeof(ent->de_key));
+}
+
+/* Entries are owned by the table, they are freed once removed */
+static bool
+dirty_rec_decref(struct d_hash_table *htable, d_list_t *rlink)
+{
+	return true;
+}
+
+static void
+dirty_rec_free(struct d_hash_table *htable, d_list_t *rlink)
+{
+	struct vos_dirty_ent	*ent = dirty_rlink2ent(rlink);
+
+	D_FREE(ent);
+}
+
+static d_hash_table_ops_t dirty_hash_ops = {
+	.hop_key_cmp	= dirty_key_cmp,
+	.hop_key_hash	= dirty_key_hash,
+	.hop_rec_hash	= dirty_rec_hash,
+	.hop_rec_decref	= dirty_rec_decref,
+	.hop_rec_free	= dirty_rec_free,
+};
+
+void
+vos_dirty_fini(struct vos_pool *pool)
+{
+	if (pool->vp_dirty_hash != NULL) {
+		d_hash_table_destroy(pool->vp_dirty_hash, true);
+		pool->vp_dirty_hash = NULL;
+	}
+	pool->vp_dirty_epoch = 0;
+	pool->vp_dirty_nr = 0;
+	pool->vp_dirty_overflow = 0;
+}
+
+int
+vos_pool_dirty_track(daos_handle_t poh, daos_epoch_t epoch)
+{
+	struct vos_pool	*pool = vos_hdl2pool(poh);
+	int		 rc;
+
+	if (pool == NULL)
+		return -DER_NO_HDL;
+
+	if (epoch == 0) {
+		if (pool->vp_dirty_epoch != 0)
+			D_DEBUG(DB_MGMT, DF_UUID": stop dirty tracking, "DF_U64" objects\n",
+				DP_UUID(pool->vp_id), pool->vp_dirty_nr);
+		vos_dirty_fini(pool);
+		return 0;
+	}
+
+	/* Already tracking, keep the earliest start */
+	if (pool->vp_dirty_epoch != 0)
+		return 0;
+
+	rc = d_hash_table_create(D_HASH_FT_NOLOCK, 13, /* 8k buckets */
+				 NULL, &dirty_hash_ops, &pool->vp_dirty_hash);
+	if (rc) {
+		D_ERROR(DF_UUID": Init dirty hash failed. "DF_RC"\n", DP_UUID(pool->vp_id),
+			DP_RC(rc));
+		return rc;
+	}
+
+	pool->vp_dirty_epoch = epoch;
+	D_DEBUG(DB_MGMT, DF_UUID": start dirty tracking from "DF_X64"\n",
+		DP_UUID(pool->vp_id), epoch);
+	return 0;
+}
+
+int
+vos_pool_dirty_query(daos_handle_t poh, daos_epoch_t *epoch, uint64_t *nr)
+{
+	struct vos_pool	*pool = vos_hdl2pool(poh);
+
+	if (pool == NULL)
+		return -DER_NO_HDL;
+
+	*epoch = pool->vp_dirty_overflow ? 0 : pool->vp_dirty_epoch;
+	if (nr != NULL)
+		*nr = pool->vp_dirty_nr;
+	return 0;
+}
+
+void
+vos_dirty_mark(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_t epoch)
+{
+	struct vos_pool		*pool = cont->vc_pool;
+	struct vos_dirty_key	 key;
+	struct vos_dirty_ent	*ent;
+	d_list_t		*rlink;
+	int			 rc;
+
+	if (pool->vp_dirty_hash == NULL || pool->vp_dirty_overflow)
+		return;
+
+	dirty_key_init(&key, cont, oid);
+	rlink = d_hash_rec_find(pool->vp_dirty_hash, &key, sizeof(key));
+	if (rlink != NULL) {
+		ent = dirty_rlink2ent(rlink);
+		if (ent->de_epoch < epoch)
+			ent->de_epoch = epoch;
+		return;
+	}
+
+	if (pool->vp_dirty_nr >= VOS_DIRTY_MAX)
+		goto overflow;
+
+	D_ALLOC_PTR(ent);
+	if (ent == NULL)
+		goto overflow;
+
+	ent->de_key = key;
+	ent->de_epoch = epoch;
+	rc = d_hash_rec_insert(pool->vp_dirty_hash, &ent->de_key, sizeof(ent->de_key),
+			       &ent->de_link, false);
+	D_ASSERT(rc == 0);
+	pool->vp_dirty_nr++;
+	return;
+
+overflow:
+	/* Not able to tell which objects are clean anymore, drop the log */
+	D_WARN(DF_UUID": dirty log overflow after "DF_U64" objects\n",
+	       DP_UUID(pool->vp_id), pool->vp_dirty_nr);
+	d_hash_table_destroy(pool->vp_dirty_hash, true);
+	pool->vp_dirty_hash = NULL;
+	pool->vp_dirty_overflow = 1;
+}
+
+bool
+vos_obj_is_dirty(daos_handle_t coh, daos_unit_oid_t oid)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct vos_pool		*pool;
+	struct vos_dirty_key	 key;
+
+	D_ASSERT(cont != NULL);
+	pool = cont->vc_pool;
+	if (pool->vp_dirty_hash == NULL)
+		return true;
+
+	dirty_key_init(&key, cont, oid);
+	return d_hash_rec_find(pool->vp_dirty_hash, &key, sizeof(key)) != NULL;
+}
+
+int
+vos_pool_stamp_set(daos_handle_t poh, uint64_t stamp)
+{
+	struct vos_pool		*pool = vos_hdl2pool(poh);
+	struct vos_pool_df	*pool_df;
+	int			 rc;
+
+	if (pool == NULL)
+		return -DER_NO_HDL;
+
+	pool_df = pool->vp_pool_df;
+	if (pool_df->pd_reint_stamp == stamp)
+		return 0;
+
+	rc = umem_tx_begin(&pool->vp_umm, NULL);
+	if (rc != 0)
+		return rc;
+
+	rc = umem_tx_add_ptr(&pool->vp_umm, &pool_df->pd_reint_stamp,
+			     sizeof(pool_df->pd_reint_stamp));
+	if (rc == 0)
+		pool_df->pd_reint_stamp = stamp;
+
+	return umem_tx_end(&pool->vp_umm, rc);
+}
+
+int
+vos_pool_stamp_get(daos_handle_t poh, uint64_t *stamp)
+{
+	struct vos_pool	*pool = vos_hdl2pool(poh);
+
+	if (pool == NULL)
+		return -DER_NO_HDL;
+
+	*stamp = pool->vp_pool_df->pd_reint_stamp;
+	return 0;
+}
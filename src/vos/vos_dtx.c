@@ -1107,6 +1107,7 @@ vos_dtx_check_availability(daos_handle_t coh, uint32_t entry,
 	struct vos_container		*cont;
 	struct vos_dtx_act_ent		*dae = NULL;
 	bool				 found;
+	int				 rc;
 
 	cont = vos_hdl2cont(coh);
 	D_ASSERT(cont != NULL);
@@ -1145,6 +1146,10 @@ vos_dtx_check_availability(daos_handle_t coh, uint32_t entry,
 
 	D_ASSERTF(epoch != 0, "Invalid epoch for DTX (lid: %x) availability check\n", entry);
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		return rc;
+
 	found = lrua_lookupx(cont->vc_dtx_array, (entry & DTX_LID_SOLO_MASK) - DTX_LID_RESERVED,
 			     epoch, &dae);
 	if (!found) {
@@ -1538,6 +1543,9 @@ vos_dtx_deregister_record(struct umem_instance *umm, daos_handle_t coh,
 	if (cont == NULL)
 		return;
 
+	if (vos_dtx_act_ready(cont) != 0)
+		return;
+
 	found = lrua_lookupx(cont->vc_dtx_array, entry - DTX_LID_RESERVED,
 			     epoch, &dae);
 	if (!found) {
@@ -1784,6 +1792,10 @@ vos_dtx_check(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t *epoch,
 	cont = vos_hdl2cont(coh);
 	D_ASSERT(cont != NULL);
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		return rc;
+
 	d_iov_set(&kiov, dti, sizeof(*dti));
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
@@ -1894,6 +1906,10 @@ vos_dtx_load_mbs(daos_handle_t coh, struct dtx_id *dti, struct dtx_memberships *
 	cont = vos_hdl2cont(coh);
 	D_ASSERT(cont != NULL);
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		return rc;
+
 	d_iov_set(&kiov, dti, sizeof(*dti));
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
@@ -1931,6 +1947,10 @@ vos_dtx_commit_internal(struct vos_container *cont, struct dtx_id dtis[],
 	bool				 fatal = false;
 	bool				 allocated = false;
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		return rc;
+
 	dbd = umem_off2ptr(umm, cont_df->cd_dtx_committed_tail);
 	if (dbd == NULL)
 		goto new_blob;
@@ -2194,6 +2214,10 @@ vos_dtx_abort(daos_handle_t coh, struct dtx_id *dti, daos_epoch_t epoch)
 	D_ASSERT(cont != NULL);
 	D_ASSERT(epoch != 0);
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		goto out;
+
 	d_iov_set(&kiov, dti, sizeof(*dti));
 	d_iov_set(&riov, NULL, 0);
 	rc = dbtree_lookup(cont->vc_dtx_active_hdl, &kiov, &riov);
@@ -2362,6 +2386,10 @@ vos_dtx_set_flags(daos_handle_t coh, struct dtx_id dtis[], int count, uint32_t f
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		goto out;
+
 	umm = vos_cont2umm(cont);
 	rc = umem_tx_begin(umm, NULL);
 	if (rc != 0)
@@ -2510,11 +2538,18 @@ vos_dtx_stat(daos_handle_t coh, struct dtx_stat *stat, uint32_t flags)
 {
 	struct vos_container	*cont;
 	struct vos_cont_df	*cont_df;
+	int			 rc;
 
 	cont = vos_hdl2cont(coh);
 	D_ASSERT(cont != NULL);
 
-	if (d_list_empty(&cont->vc_dtx_act_list)) {
+	/* The active DTX list is incomplete until the active DTX table is indexed. */
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0) {
+		D_ERROR("Failed to index active DTX for cont "DF_UUID": "DF_RC"\n",
+			DP_UUID(cont->vc_id), DP_RC(rc));
+		stat->dtx_oldest_active_time = 0;
+	} else if (d_list_empty(&cont->vc_dtx_act_list)) {
 		stat->dtx_oldest_active_time = 0;
 	} else {
 		struct vos_dtx_act_ent	*dae;
@@ -2624,120 +2659,160 @@ vos_dtx_mark_sync(daos_handle_t coh, daos_unit_oid_t oid, daos_epoch_t epoch)
 	return 0;
 }
 
-int
-vos_dtx_act_reindex(struct vos_container *cont)
+static int
+dtx_act_reindex_blob(struct vos_container *cont, struct vos_dtx_blob_df *dbd)
 {
 	struct umem_instance		*umm = vos_cont2umm(cont);
 	struct vos_cont_df		*cont_df = cont->vc_cont_df;
-	struct vos_dtx_blob_df		*dbd;
-	umem_off_t			 dbd_off = cont_df->cd_dtx_active_head;
 	d_iov_t				 kiov;
 	d_iov_t				 riov;
 	uint64_t			 start_time = daos_gettime_coarse();
+	int				 dbd_count = 0;
 	int				 rc = 0;
 	int				 i;
 
-	while (!UMOFF_IS_NULL(dbd_off)) {
-		int	dbd_count = 0;
-
-		dbd = umem_off2ptr(umm, dbd_off);
-		D_ASSERT(dbd->dbd_magic == DTX_ACT_BLOB_MAGIC);
+	D_ASSERT(dbd->dbd_magic == DTX_ACT_BLOB_MAGIC);
 
-		for (i = 0; i < dbd->dbd_index; i++) {
-			struct vos_dtx_act_ent_df	*dae_df;
-			struct vos_dtx_act_ent		*dae;
+	for (i = 0; i < dbd->dbd_index; i++) {
+		struct vos_dtx_act_ent_df	*dae_df;
+		struct vos_dtx_act_ent		*dae;
 
-			dae_df = &dbd->dbd_active_data[i];
-			if (dae_df->dae_flags & DTE_INVALID)
-				continue;
+		dae_df = &dbd->dbd_active_data[i];
+		if (dae_df->dae_flags & DTE_INVALID)
+			continue;
 
-			if (daos_is_zero_dti(&dae_df->dae_xid)) {
-				D_WARN("Hit zero active DTX entry.\n");
-				continue;
-			}
+		if (daos_is_zero_dti(&dae_df->dae_xid)) {
+			D_WARN("Hit zero active DTX entry.\n");
+			continue;
+		}
 
-			if (dae_df->dae_lid < DTX_LID_RESERVED) {
-				D_ERROR("Corruption in DTX table found, lid=%d"
-					" is invalid\n", dae_df->dae_lid);
-				D_GOTO(out, rc = -DER_IO);
-			}
-			rc = lrua_allocx_inplace(cont->vc_dtx_array,
-					 dae_df->dae_lid - DTX_LID_RESERVED,
-					 dae_df->dae_epoch, &dae);
-			if (rc != 0) {
-				if (rc == -DER_NOMEM) {
-					D_ERROR("Not enough memory for DTX "
-						"table\n");
-				} else {
-					D_ERROR("Corruption in DTX table found,"
-						" lid=%d is invalid rc="DF_RC
-						"\n", dae_df->dae_lid,
-						DP_RC(rc));
-					rc = -DER_IO;
-				}
-				D_GOTO(out, rc);
+		if (dae_df->dae_lid < DTX_LID_RESERVED) {
+			D_ERROR("Corruption in DTX table found, lid=%d"
+				" is invalid\n", dae_df->dae_lid);
+			D_GOTO(out, rc = -DER_IO);
+		}
+		rc = lrua_allocx_inplace(cont->vc_dtx_array,
+				 dae_df->dae_lid - DTX_LID_RESERVED,
+				 dae_df->dae_epoch, &dae);
+		if (rc != 0) {
+			if (rc == -DER_NOMEM) {
+				D_ERROR("Not enough memory for DTX "
+					"table\n");
+			} else {
+				D_ERROR("Corruption in DTX table found,"
+					" lid=%d is invalid rc="DF_RC
+					"\n", dae_df->dae_lid,
+					DP_RC(rc));
+				rc = -DER_IO;
 			}
-			D_ASSERT(dae != NULL);
-
-			D_DEBUG(DB_TRACE, "Re-indexed lid DTX: "DF_DTI
-				" lid=%d\n", DP_DTI(&DAE_XID(dae)),
-				DAE_LID(dae));
-
-			memcpy(&dae->dae_base, dae_df, sizeof(dae->dae_base));
-			dae->dae_df_off = umem_ptr2off(umm, dae_df);
-			dae->dae_dbd = dbd;
-			dae->dae_prepared = 1;
-			D_INIT_LIST_HEAD(&dae->dae_link);
+			D_GOTO(out, rc);
+		}
+		D_ASSERT(dae != NULL);
 
-			if (DAE_REC_CNT(dae) > DTX_INLINE_REC_CNT) {
-				size_t	size;
-				int	count;
+		D_DEBUG(DB_TRACE, "Re-indexed lid DTX: "DF_DTI
+			" lid=%d\n", DP_DTI(&DAE_XID(dae)),
+			DAE_LID(dae));
 
-				count = DAE_REC_CNT(dae) - DTX_INLINE_REC_CNT;
-				size = sizeof(*dae->dae_records) * count;
+		memcpy(&dae->dae_base, dae_df, sizeof(dae->dae_base));
+		dae->dae_df_off = umem_ptr2off(umm, dae_df);
+		dae->dae_dbd = dbd;
+		dae->dae_prepared = 1;
+		D_INIT_LIST_HEAD(&dae->dae_link);
 
-				D_ALLOC(dae->dae_records, size);
-				if (dae->dae_records == NULL) {
-					dtx_evict_lid(cont, dae);
-					D_GOTO(out, rc = -DER_NOMEM);
-				}
+		if (DAE_REC_CNT(dae) > DTX_INLINE_REC_CNT) {
+			size_t	size;
+			int	count;
 
-				memcpy(dae->dae_records,
-				       umem_off2ptr(umm, dae_df->dae_rec_off),
-				       size);
-				dae->dae_rec_cap = count;
-			}
+			count = DAE_REC_CNT(dae) - DTX_INLINE_REC_CNT;
+			size = sizeof(*dae->dae_records) * count;
 
-			d_iov_set(&kiov, &DAE_XID(dae), sizeof(DAE_XID(dae)));
-			d_iov_set(&riov, dae, sizeof(*dae));
-			rc = dbtree_upsert(cont->vc_dtx_active_hdl,
-					   BTR_PROBE_EQ, DAOS_INTENT_UPDATE,
-					   &kiov, &riov, NULL);
-			if (rc != 0) {
-				D_FREE(dae->dae_records);
+			D_ALLOC(dae->dae_records, size);
+			if (dae->dae_records == NULL) {
 				dtx_evict_lid(cont, dae);
-				goto out;
+				D_GOTO(out, rc = -DER_NOMEM);
 			}
 
-			dae->dae_start_time = start_time;
-			d_list_add_tail(&dae->dae_link, &cont->vc_dtx_act_list);
-			dbd_count++;
+			memcpy(dae->dae_records,
+			       umem_off2ptr(umm, dae_df->dae_rec_off),
+			       size);
+			dae->dae_rec_cap = count;
 		}
 
-		D_ASSERTF(dbd_count == dbd->dbd_count,
-			  "Unmatched active DTX count %d/%d, cap %d, idx %d for blob %p ("
-			  UMOFF_PF"), head "UMOFF_PF", tail "UMOFF_PF"\n",
-			  dbd_count, dbd->dbd_count, dbd->dbd_cap, dbd->dbd_index, dbd,
-			  UMOFF_P(dbd_off), UMOFF_P(cont_df->cd_dtx_active_head),
-			  UMOFF_P(cont_df->cd_dtx_active_tail));
+		d_iov_set(&kiov, &DAE_XID(dae), sizeof(DAE_XID(dae)));
+		d_iov_set(&riov, dae, sizeof(*dae));
+		rc = dbtree_upsert(cont->vc_dtx_active_hdl,
+				   BTR_PROBE_EQ, DAOS_INTENT_UPDATE,
+				   &kiov, &riov, NULL);
+		if (rc != 0) {
+			D_FREE(dae->dae_records);
+			dtx_evict_lid(cont, dae);
+			goto out;
+		}
 
-		dbd_off = dbd->dbd_next;
+		dae->dae_start_time = start_time;
+		d_list_add_tail(&dae->dae_link, &cont->vc_dtx_act_list);
+		dbd_count++;
 	}
 
+	D_ASSERTF(dbd_count == dbd->dbd_count,
+		  "Unmatched active DTX count %d/%d, cap %d, idx %d for blob %p ("
+		  UMOFF_PF"), head "UMOFF_PF", tail "UMOFF_PF"\n",
+		  dbd_count, dbd->dbd_count, dbd->dbd_cap, dbd->dbd_index, dbd,
+		  UMOFF_P(umem_ptr2off(umm, dbd)), UMOFF_P(cont_df->cd_dtx_active_head),
+		  UMOFF_P(cont_df->cd_dtx_active_tail));
+
 out:
 	return rc > 0 ? 0 : rc;
 }
 
+/* Index the active DTX entries in the next blob, return 1 if all of them are indexed. */
+static int
+dtx_act_reindex_next(struct vos_container *cont)
+{
+	struct vos_dtx_blob_df	*dbd;
+	int			 rc;
+
+	dbd = umem_off2ptr(vos_cont2umm(cont), cont->vc_act_dtx_reindex_pos);
+	if (dbd == NULL) {
+		cont->vc_act_dtx_reindex_pos = UMOFF_NULL;
+		cont->vc_act_dtx_indexed = 1;
+		return 1;
+	}
+
+	rc = dtx_act_reindex_blob(cont, dbd);
+	if (rc != 0)
+		return rc;
+
+	cont->vc_act_dtx_reindex_pos = dbd->dbd_next;
+	return 0;
+}
+
+int
+vos_dtx_act_reindex(struct vos_container *cont)
+{
+	int	rc;
+
+	do {
+		rc = dtx_act_reindex_next(cont);
+	} while (rc == 0);
+
+	return rc > 0 ? 0 : rc;
+}
+
+int
+vos_dtx_act_reindex_next(daos_handle_t coh)
+{
+	struct vos_container	*cont;
+
+	cont = vos_hdl2cont(coh);
+	D_ASSERT(cont != NULL);
+
+	if (cont->vc_act_dtx_indexed)
+		return 1;
+
+	return dtx_act_reindex_next(cont);
+}
+
 int
 vos_dtx_cmt_reindex(daos_handle_t coh)
 {
@@ -2939,6 +3014,10 @@ vos_dtx_attach(struct dtx_handle *dth, bool persistent, bool exist)
 	cont = vos_hdl2cont(dth->dth_coh);
 	D_ASSERT(cont != NULL);
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		goto out;
+
 	if (dth->dth_ent != NULL) {
 		D_ASSERT(persistent);
 		D_ASSERT(dth->dth_active == 0);
@@ -3141,6 +3220,8 @@ vos_dtx_cache_reset(daos_handle_t coh, bool force)
 		return rc;
 	}
 
+	cont->vc_act_dtx_indexed = 0;
+	cont->vc_act_dtx_reindex_pos = cont->vc_cont_df->cd_dtx_active_head;
 	rc = vos_dtx_act_reindex(cont);
 	if (rc != 0) {
 		D_ERROR("Fail to reindex active DTX table for "DF_UUID": "DF_RC"\n",
@@ -71,6 +71,10 @@ dtx_iter_prep(vos_iter_type_t type, vos_iter_param_t *param,
 	if (cont == NULL)
 		return -DER_INVAL;
 
+	rc = vos_dtx_act_ready(cont);
+	if (rc != 0)
+		return rc;
+
 	D_ALLOC_PTR(oiter);
 	if (oiter == NULL)
 		return -DER_NOMEM;
@@ -1,5 +1,5 @@
 /**
- * (C) Copyright 2019-2022 Intel Corporation.
+ * (C) Copyright 2019-2023 Intel Corporation.
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -15,12 +15,8 @@
 #include <daos_srv/vos.h>
 #include "vos_internal.h"
 
-enum {
-	GC_CREDS_MIN	= 1,	/**< minimum credits for vos_gc_run/pool() */
-	GC_CREDS_SLACK	= 8,	/**< credits for slack mode */
-	GC_CREDS_TIGHT	= 32,	/**< credits for tight mode */
-	GC_CREDS_MAX	= 4096,	/**< maximum credits for vos_gc_run/pool() */
-};
+/** Sampling window of the adaptive GC controller, in msec */
+#define GC_CTL_WINDOW	1000
 
 /**
  * Default garbage bag size consumes <= 4K space
@@ -1058,6 +1054,169 @@ gc_wait(void)
 #endif
 }
 
+/** Sample the SCM space in use, values beyond the pool size are rejected */
+static int
+gc_scm_used(struct vos_pool *pool, uint64_t *used)
+{
+	uint64_t	val = 0;
+	int		rc;
+
+	rc = pmemobj_ctl_get(pool->vp_umm.umm_pool, "stats.heap.curr_allocated", &val);
+	if (rc) {
+		rc = umem_tx_errno(rc);
+		D_DEBUG(DB_TRACE, "pool="DF_UUID" failed to query SCM usage: "DF_RC"\n",
+			DP_UUID(pool->vp_id), DP_RC(rc));
+		return rc;
+	}
+
+	if (val > pool->vp_pool_df->pd_scm_sz) {
+		D_DEBUG(DB_TRACE, "pool="DF_UUID" bogus SCM usage "DF_U64" > "DF_U64"\n",
+			DP_UUID(pool->vp_id), val, pool->vp_pool_df->pd_scm_sz);
+		return -DER_INVAL;
+	}
+
+	*used = val;
+	return 0;
+}
+
+/** Estimate the number of items queued in a garbage bin */
+static uint64_t
+gc_bin_backlog(struct umem_instance *umm, struct vos_gc_bin_df *bin)
+{
+	struct vos_gc_bag_df	*bag;
+
+	if (bin->bin_bag_nr == 0)
+		return 0;
+
+	bag = umem_off2ptr(umm, bin->bin_bag_last);
+	return (uint64_t)(bin->bin_bag_nr - 1) * bin->bin_bag_size + bag->bag_item_nr;
+}
+
+/**
+ * Number of items queued in the pool and in the containers it is draining.
+ * Only the top level items are counted, a destroyed object with millions of
+ * keys is a single item until it is flattened into the key bins.
+ */
+static uint64_t
+gc_pool_backlog(struct vos_pool *pool)
+{
+	struct vos_container	*cont;
+	uint64_t		 backlog = 0;
+	int			 i;
+
+	for (i = 0; i < GC_MAX; i++)
+		backlog += gc_bin_backlog(&pool->vp_umm, &pool->vp_pool_df->pd_gc_bins[i]);
+
+	d_list_for_each_entry(cont, &pool->vp_gc_cont, vc_gc_link) {
+		for (i = 0; i < GC_CONT; i++)
+			backlog += gc_bin_backlog(&pool->vp_umm,
+						  &cont->vc_cont_df->cd_gc_bins[i]);
+	}
+
+	return backlog;
+}
+
+/** Close the sampling window of the GC controller and report its metrics */
+static void
+gc_ctl_window(struct vos_pool *pool, uint64_t now)
+{
+	struct vos_gc_ctl	*ctl = &pool->vp_gc_ctl;
+	struct vos_gc_metrics	*vgm;
+	uint64_t		 elapsed = now - ctl->gcc_win_start;
+	uint64_t		 backlog;
+	uint64_t		 used = ctl->gcc_scm_cur;
+	uint64_t		 rate;
+
+	backlog = gc_pool_backlog(pool);
+
+	/* Falling behind if the backlog isn't shrinking or reclaim can't keep
+	 * up with the space consumed by foreground I/O.
+	 */
+	ctl->gcc_behind = backlog != 0 &&
+			  (backlog >= ctl->gcc_backlog || used > ctl->gcc_scm_used);
+
+	if (pool->vp_metrics != NULL && elapsed != 0) {
+		vgm = &pool->vp_metrics->vp_gc_metrics;
+		d_tm_set_gauge(vgm->vgm_reclaim_rate, ctl->gcc_win_bytes * 1000 / elapsed);
+		d_tm_set_gauge(vgm->vgm_backlog, backlog);
+		rate = ctl->gcc_win_items * 1000 / elapsed;
+		d_tm_set_gauge(vgm->vgm_drain_time, rate != 0 ? backlog / rate : 0);
+	}
+
+	D_DEBUG(DB_TRACE, "pool="DF_UUID" reclaimed "DF_U64" bytes/"DF_U64" items in "
+		DF_U64" ms, backlog "DF_U64" -> "DF_U64", behind=%d\n", DP_UUID(pool->vp_id),
+		ctl->gcc_win_bytes, ctl->gcc_win_items, elapsed, ctl->gcc_backlog, backlog,
+		ctl->gcc_behind);
+
+	ctl->gcc_win_start = now;
+	ctl->gcc_win_bytes = 0;
+	ctl->gcc_win_items = 0;
+	ctl->gcc_backlog = backlog;
+	ctl->gcc_scm_used = used;
+}
+
+/** Nothing left to reclaim, restart from the default credits next time */
+static void
+gc_ctl_reset(struct vos_pool *pool)
+{
+	struct vos_gc_metrics	*vgm;
+
+	memset(&pool->vp_gc_ctl, 0, sizeof(pool->vp_gc_ctl));
+	if (pool->vp_metrics == NULL)
+		return;
+
+	vgm = &pool->vp_metrics->vp_gc_metrics;
+	d_tm_set_gauge(vgm->vgm_reclaim_rate, 0);
+	d_tm_set_gauge(vgm->vgm_backlog, 0);
+	d_tm_set_gauge(vgm->vgm_drain_time, 0);
+}
+
+/**
+ * Size the credits of the next GC batch. Credits double every window while
+ * GC is falling behind and halve otherwise, within a range given by the
+ * foreground load reported by the yield callback of vos_gc_pool().
+ */
+static int
+gc_ctl_credits(struct vos_pool *pool, int load)
+{
+	struct vos_gc_ctl	*ctl = &pool->vp_gc_ctl;
+	uint64_t		 now = daos_getmtime_coarse();
+	int			 lo;
+	int			 hi;
+
+	if (ctl->gcc_win_start == 0) {
+		ctl->gcc_credits = GC_CREDS_TIGHT;
+		ctl->gcc_win_start = now;
+		ctl->gcc_backlog = gc_pool_backlog(pool);
+		ctl->gcc_scm_used = ctl->gcc_scm_cur;
+	} else if (now >= ctl->gcc_win_start + GC_CTL_WINDOW) {
+		gc_ctl_window(pool, now);
+		if (ctl->gcc_behind)
+			ctl->gcc_credits *= 2;
+		else
+			ctl->gcc_credits /= 2;
+	}
+
+	switch (load) {
+	case VOS_GC_YIELD_IDLE:
+	case VOS_GC_YIELD_PRESSURE:
+		lo = GC_CREDS_TIGHT;
+		hi = GC_CREDS_BOOST;
+		break;
+	default:
+		/* Stay out of the way of foreground I/O unless GC is behind */
+		lo = GC_CREDS_MIN;
+		hi = ctl->gcc_behind ? GC_CREDS_TIGHT : GC_CREDS_SLACK;
+		break;
+	}
+
+	ctl->gcc_credits = min(max(ctl->gcc_credits, lo), hi);
+	if (pool->vp_metrics != NULL)
+		d_tm_set_gauge(pool->vp_metrics->vp_gc_metrics.vgm_credits, ctl->gcc_credits);
+
+	return ctl->gcc_credits;
+}
+
 int
 vos_gc_pool_tight(daos_handle_t poh, int *credits)
 {
@@ -1083,9 +1242,12 @@ vos_gc_pool_tight(daos_handle_t poh, int *credits)
 	}
 	total -= *credits; /* subtract the remained credits */
 
+	pool->vp_gc_ctl.gcc_win_items += total;
+
 	if (empty) {
 		if (total != 0) /* did something */
 			gc_log_pool(pool);
+		gc_ctl_reset(pool);
 		/*
 		 * Recheck since vea_free() called when drain sv/ev record may
 		 * result in yield on transaction end callback.
@@ -1100,7 +1262,8 @@ vos_gc_pool_tight(daos_handle_t poh, int *credits)
 struct vos_gc_param {
 	int		(*vgc_yield_func)(void *arg);
 	void		*vgc_yield_arg;
-	uint32_t	 vgc_credits;
+	/** Foreground load reported by vgc_yield_func, see VOS_GC_YIELD_* */
+	int		 vgc_load;
 };
 
 static inline bool
@@ -1113,7 +1276,7 @@ vos_gc_yield(void *arg)
 	D_ASSERT(vos_dth_get() == NULL);
 
 	if (param->vgc_yield_func == NULL) {
-		param->vgc_credits = GC_CREDS_TIGHT;
+		param->vgc_load = VOS_GC_YIELD_IDLE;
 		bio_yield();
 		return false;
 	}
@@ -1122,8 +1285,7 @@ vos_gc_yield(void *arg)
 	if (rc < 0)	/* Abort */
 		return true;
 
-	/* rc == 0: tight mode; rc == 1: slack mode */
-	param->vgc_credits = (rc == 0) ? GC_CREDS_TIGHT : GC_CREDS_SLACK;
+	param->vgc_load = rc;
 
 	return false;
 }
@@ -1136,6 +1298,10 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 	struct vos_pool		*pool = vos_hdl2pool(poh);
 	struct vos_tls		*tls  = vos_tls_get();
 	struct vos_gc_param	 param;
+	struct vos_gc_ctl	*ctl = &pool->vp_gc_ctl;
+	uint64_t		 used_before = 0;
+	uint64_t		 used_after = 0;
+	bool			 have_used;
 	uint32_t		 nr_flushed = 0;
 	int			 rc = 0, total = 0;
 
@@ -1145,7 +1311,7 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 
 	param.vgc_yield_func	= yield_func;
 	param.vgc_yield_arg	= yield_arg;
-	param.vgc_credits	= GC_CREDS_TIGHT;
+	param.vgc_load		= VOS_GC_YIELD_IDLE;
 
 	/* To accelerate flush on container destroy done */
 	if (!gc_have_pool(pool)) {
@@ -1156,8 +1322,16 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 
 	tls->vtl_gc_running++;
 
+	/*
+	 * SCM usage is sampled at both ends of the cycle rather than around
+	 * each batch, the controller works from the cached start sample.
+	 */
+	have_used = gc_scm_used(pool, &used_before) == 0;
+	if (have_used)
+		ctl->gcc_scm_cur = used_before;
+
 	while (1) {
-		int	creds = param.vgc_credits;
+		int	creds = gc_ctl_credits(pool, param.vgc_load);
 
 		if (credits > 0 && (credits - total) < creds)
 			creds = credits - total;
@@ -1181,6 +1355,19 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 		}
 	}
 
+	if (have_used && total != 0 && gc_scm_used(pool, &used_after) == 0) {
+		/* the controller state is reset once the pool is drained */
+		if (ctl->gcc_win_start != 0)
+			ctl->gcc_scm_cur = used_after;
+		if (used_before > used_after) {
+			if (ctl->gcc_win_start != 0)
+				ctl->gcc_win_bytes += used_before - used_after;
+			if (pool->vp_metrics != NULL)
+				d_tm_inc_counter(pool->vp_metrics->vp_gc_metrics.vgm_reclaimed,
+						 used_before - used_after);
+		}
+	}
+
 	if (total != 0) /* did something */
 		D_DEBUG(DB_TRACE, "GC consumed %d credits\n", total);
 
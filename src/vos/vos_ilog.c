@@ -12,7 +12,7 @@
 
 #include "vos_internal.h"
 
-static int
+int
 vos_ilog_status_get(struct umem_instance *umm, uint32_t tx_id,
 		    daos_epoch_t epoch, uint32_t intent, bool retry, void *args)
 {
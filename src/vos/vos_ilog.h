@@ -189,6 +189,11 @@ vos_ilog_check_(struct vos_ilog_info *info, const daos_epoch_range_t *epr_in,
 void
 vos_ilog_desc_cbs_init(struct ilog_desc_cbs *cbs, daos_handle_t coh);
 
+/** Status callback for the incarnation log, see dc_log_status_cb */
+int
+vos_ilog_status_get(struct umem_instance *umm, uint32_t tx_id, daos_epoch_t epoch,
+		    uint32_t intent, bool retry, void *args);
+
 /** Aggregate (or discard) the incarnation log in the specified range
  *
  * \param	coh[IN]		container handle
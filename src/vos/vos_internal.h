@@ -115,6 +115,20 @@ enum {
  */
 #define VOS_MW_NVME_THRESH	256		/* 256 * VOS_BLK_SZ = 1MB */
 
+/*
+ * Max # of ULTs aggregating a container in parallel, each of them owns a partition
+ * of the object ID space and its own merge window.
+ */
+#define VOS_AGG_ULTS_MAX	8
+
+/*
+ * Adaptive aggregation policy: akeys not written for VOS_AGG_COLD_SEC seconds
+ * (before the upper bound of aggregation epoch range) are regarded as cold, the
+ * akeys written within 1/VOS_AGG_HOT_RATIO of that are regarded as hot.
+ */
+#define VOS_AGG_COLD_SEC	600
+#define VOS_AGG_HOT_RATIO	10
+
 /*
  * Aggregation/Discard ULT yield when certain amount of credits consumed.
  *
@@ -140,7 +154,12 @@ enum {
 #define VOS_NOSPC_ERROR_INTVL	60	/* seconds */
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_agg_ults;
+extern bool vos_agg_adaptive;
+extern unsigned int vos_agg_cold_sec;
+extern unsigned int vos_tier_cold_sec;
 extern bool vos_dkey_punch_propagate;
+extern bool vos_lazy_index;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -185,6 +204,12 @@ struct vos_agg_metrics {
 	struct d_tm_node_t	*vam_del_ev;		/* Deleted EV records */
 	struct d_tm_node_t	*vam_merge_recs;	/* Total merged EV records */
 	struct d_tm_node_t	*vam_merge_size;	/* Total merged size */
+	struct d_tm_node_t	*vam_read_size;		/* Total size read for merging */
+	struct d_tm_node_t	*vam_free_size;		/* Total EV size freed */
+	struct d_tm_node_t	*vam_read_amp;		/* Read per freed byte, in percent */
+	struct d_tm_node_t	*vam_write_amp;		/* Rewritten per freed byte, in percent */
+	struct d_tm_node_t	*vam_tier_size;		/* Total cold size moved to NVMe */
+	struct d_tm_node_t	*vam_scm_freed;		/* SCM size freed by last pass */
 };
 
 struct vos_space_metrics {
@@ -193,13 +218,50 @@ struct vos_space_metrics {
 	uint64_t		 vsm_last_update_ts;	/* Timeout counter */
 };
 
+struct vos_gc_metrics {
+	struct d_tm_node_t	*vgm_reclaimed;		/* SCM bytes reclaimed */
+	struct d_tm_node_t	*vgm_reclaim_rate;	/* SCM bytes reclaimed per second */
+	struct d_tm_node_t	*vgm_backlog;		/* Queued GC items */
+	struct d_tm_node_t	*vgm_drain_time;	/* Estimated time to drain the backlog */
+	struct d_tm_node_t	*vgm_credits;		/* Credits per GC batch */
+};
+
 struct vos_pool_metrics {
 	void			*vp_vea_metrics;
 	struct vos_agg_metrics	 vp_agg_metrics;
 	struct vos_space_metrics vp_space_metrics;
+	struct vos_gc_metrics	 vp_gc_metrics;
 	/* TODO: add more metrics for VOS */
 };
 
+enum {
+	GC_CREDS_MIN	= 1,	/**< minimum credits for vos_gc_run/pool() */
+	GC_CREDS_SLACK	= 8,	/**< credits for slack mode */
+	GC_CREDS_TIGHT	= 32,	/**< credits for tight mode */
+	GC_CREDS_BOOST	= 256,	/**< maximum credits of the adaptive controller */
+	GC_CREDS_MAX	= 4096,	/**< maximum credits for vos_gc_run/pool() */
+};
+
+/** Adaptive GC controller state of a pool, see gc_ctl_credits() */
+struct vos_gc_ctl {
+	/** Start of the current sampling window, in msec */
+	uint64_t		gcc_win_start;
+	/** SCM bytes reclaimed in the current window */
+	uint64_t		gcc_win_bytes;
+	/** Items reclaimed (credits consumed) in the current window */
+	uint64_t		gcc_win_items;
+	/** SCM bytes in use at the start of the window */
+	uint64_t		gcc_scm_used;
+	/** SCM bytes in use at the last sample, taken once per vos_gc_pool() cycle */
+	uint64_t		gcc_scm_cur;
+	/** Queued GC items at the start of the window */
+	uint64_t		gcc_backlog;
+	/** Credits per GC batch */
+	int			gcc_credits;
+	/** The backlog or the used space kept growing in the last window */
+	bool			gcc_behind;
+};
+
 /**
  * VOS pool (DRAM)
  */
@@ -227,6 +289,8 @@ struct vos_pool {
 	daos_handle_t		vp_cont_th;
 	/** GC statistics of this pool */
 	struct vos_gc_stat	vp_gc_stat;
+	/** Adaptive GC controller */
+	struct vos_gc_ctl	vp_gc_ctl;
 	/** link chain on vos_tls::vtl_gc_pools */
 	d_list_t		vp_gc_link;
 	/** List of open containers with objects in gc pool */
@@ -243,6 +307,18 @@ struct vos_pool {
 	daos_size_t		vp_space_held[DAOS_MEDIA_MAX];
 	/** Dedup hash */
 	struct d_hash_table	*vp_dedup_hash;
+	/** Dirty object log, see vos_pool_dirty_track() */
+	struct d_hash_table	*vp_dirty_hash;
+	/** Epoch the dirty tracking started from, 0 if not tracking */
+	daos_epoch_t		 vp_dirty_epoch;
+	/** Number of objects in the dirty log */
+	uint64_t		 vp_dirty_nr;
+	/** Dirty log overflowed, every object is dirty */
+	uint32_t		 vp_dirty_overflow:1;
+	/** Last access time of objects, see vos_policy_obj_access() */
+	uint32_t		*vp_atime;
+	/** When the access time tracking started, in seconds */
+	uint64_t		 vp_atime_start;
 	struct vos_pool_metrics	*vp_metrics;
 	/* The count of committed DTXs for the whole pool. */
 	uint32_t		 vp_dtx_committed_count;
@@ -299,6 +375,8 @@ struct vos_container {
 	uint64_t		vc_io_nospc_ts;
 	/* The (next) position for committed DTX entries reindex. */
 	umem_off_t		vc_cmt_dtx_reindex_pos;
+	/* The (next) position for active DTX entries reindex. */
+	umem_off_t		vc_act_dtx_reindex_pos;
 	/* The epoch for the latest committed solo DTX. Any solo
 	 * * transaction with older epoch must have been committed.
 	 */
@@ -306,7 +384,8 @@ struct vos_container {
 	/* Various flags */
 	unsigned int		vc_in_aggregation:1,
 				vc_in_discard:1,
-				vc_cmt_dtx_indexed:1;
+				vc_cmt_dtx_indexed:1,
+				vc_act_dtx_indexed:1;
 	unsigned int		vc_obj_discard_count;
 	unsigned int		vc_open_count;
 };
@@ -710,7 +789,8 @@ vos_dtx_post_handle(struct vos_container *cont,
 		    int count, bool abort, bool rollback);
 
 /**
- * Establish indexed active DTX table in DRAM.
+ * Establish indexed active DTX table in DRAM, it only indexes the entries that
+ * have not been indexed by vos_dtx_act_reindex_next() yet.
  *
  * \param cont	[IN]	Pointer to the container.
  *
@@ -719,6 +799,19 @@ vos_dtx_post_handle(struct vos_container *cont,
 int
 vos_dtx_act_reindex(struct vos_container *cont);
 
+/**
+ * The active DTX table has to be fully indexed before it is looked up or
+ * modified, see vos_lazy_index.
+ */
+static inline int
+vos_dtx_act_ready(struct vos_container *cont)
+{
+	if (likely(cont->vc_act_dtx_indexed))
+		return 0;
+
+	return vos_dtx_act_reindex(cont);
+}
+
 enum vos_tree_class {
 	/** the first reserved tree class */
 	VOS_BTR_BEGIN		= DBTREE_VOS_BEGIN,
@@ -1077,6 +1170,14 @@ struct vos_iter_ops {
 	int	(*iop_fetch)(struct vos_iterator *iter,
 			     vos_iter_entry_t *it_entry,
 			     daos_anchor_t *anchor);
+	/**
+	 * Optional, fetch up to @nr records from the cursor and move the
+	 * cursor past them, see vos_iter_fetch_batch(). Returns -DER_NOSYS
+	 * to fall back to iop_fetch and iop_next.
+	 */
+	int	(*iop_fetch_batch)(struct vos_iterator *iter,
+				   vos_iter_entry_t *it_entries,
+				   daos_anchor_t *anchors, unsigned int *nr);
 	/** copy out the record data */
 	int	(*iop_copy)(struct vos_iterator *iter,
 			    vos_iter_entry_t *it_entry, d_iov_t *iov_out);
@@ -1227,6 +1328,12 @@ vos_dedup_fini(struct vos_pool *pool);
 void
 vos_dedup_invalidate(struct vos_pool *pool);
 
+/* vos_dirty.c */
+void
+vos_dirty_fini(struct vos_pool *pool);
+void
+vos_dirty_mark(struct vos_container *cont, daos_unit_oid_t oid, daos_epoch_t epoch);
+
 umem_off_t
 vos_reserve_scm(struct vos_container *cont, struct vos_rsrvd_scm *rsrvd_scm,
 		daos_size_t size);
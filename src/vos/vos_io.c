@@ -1514,6 +1514,7 @@ fetch_dkey:
 	if (rc != 0)
 		goto out;
 set_ioc:
+	vos_policy_obj_access(ioc->ic_cont, oid);
 	*ioh = vos_ioc2ioh(ioc);
 out:
 	vos_dth_set(NULL);
@@ -2418,8 +2419,11 @@ abort:
 
 	err = vos_tx_end(ioc->ic_cont, dth, &ioc->ic_rsrvd_scm,
 			 &ioc->ic_blk_exts, tx_started, err);
-	if (err == 0)
+	if (err == 0) {
 		vos_dedup_process(vos_cont2pool(ioc->ic_cont), &ioc->ic_dedup_entries, false);
+		vos_dirty_mark(ioc->ic_cont, ioc->ic_oid, ioc->ic_epr.epr_hi);
+		vos_policy_obj_access(ioc->ic_cont, ioc->ic_oid);
+	}
 
 	if (dtx_is_valid_handle(dth)) {
 		if (err == 0)
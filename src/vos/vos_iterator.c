@@ -403,6 +403,70 @@ vos_iter_fetch(daos_handle_t ih, vos_iter_entry_t *it_entry,
 	return rc;
 }
 
+static int
+iter_fetch_batch(struct vos_iterator *iter, vos_iter_entry_t *it_entries,
+		 daos_anchor_t *anchors, unsigned int *nr)
+{
+	unsigned int	i;
+	int		rc = 0;
+
+	for (i = 0; i < *nr; i++) {
+		rc = iter->it_ops->iop_fetch(iter, &it_entries[i],
+					     anchors != NULL ? &anchors[i] : NULL);
+		if (rc != 0)
+			break;
+
+		rc = iter->it_ops->iop_next(iter, NULL);
+		if (rc != 0) {
+			i++;
+			break;
+		}
+	}
+	*nr = i;
+
+	return rc;
+}
+
+int
+vos_iter_fetch_batch(daos_handle_t ih, vos_iter_entry_t *it_entries,
+		     daos_anchor_t *anchors, unsigned int *nr)
+{
+	struct vos_iterator *iter = vos_hdl2iter(ih);
+	struct dtx_handle   *old;
+	int		     rc;
+
+	rc = iter_verify_state(iter);
+	if (rc) {
+		*nr = 0;
+		return rc;
+	}
+
+	D_ASSERT(iter->it_ops != NULL);
+	if (iter->it_filter_cb != NULL) {
+		*nr = 0;
+		return -DER_NOSYS;
+	}
+	if (*nr == 0)
+		return 0;
+
+	old = vos_dth_get();
+	vos_dth_set(iter->it_dth);
+	rc = -DER_NOSYS;
+	if (iter->it_ops->iop_fetch_batch != NULL)
+		rc = iter->it_ops->iop_fetch_batch(iter, it_entries, anchors, nr);
+	if (rc == -DER_NOSYS)
+		rc = iter_fetch_batch(iter, it_entries, anchors, nr);
+	vos_dth_set(old);
+	if (rc == 0)
+		iter->it_state = VOS_ITS_OK;
+	else if (rc == -DER_NONEXIST)
+		iter->it_state = VOS_ITS_END;
+	else
+		iter->it_state = VOS_ITS_NONE;
+
+	return rc;
+}
+
 int
 vos_iter_copy(daos_handle_t ih, vos_iter_entry_t *it_entry,
 	      d_iov_t *iov_out)
@@ -124,8 +124,11 @@ struct vos_pool_df {
 	 * a new format, containers with old format can be attached at here.
 	 */
 	uint64_t				pd_reserv_upgrade;
-	/** Reserved for future usage */
-	uint64_t				pd_reserv;
+	/**
+	 * Identity of the storage backing the pool when its target was last in service,
+	 * see vos_pool_stamp_set(). Zero if the target never served I/O from this pool.
+	 */
+	uint64_t				pd_reint_stamp;
 	/** Unique PoolID for each VOS pool assigned on creation */
 	uuid_t					pd_id;
 	/** Total space in bytes on SCM */
@@ -538,6 +538,8 @@ reset:
 		vos_ts_set_wupdate(ts_set, epr.epr_hi);
 
 	rc = vos_tx_end(cont, dth, NULL, NULL, true, rc);
+	if (rc == 0)
+		vos_dirty_mark(cont, oid, epr.epr_hi);
 	if (dtx_is_valid_handle(dth)) {
 		if (rc == 0)
 			dth->dth_cos_done = 1;
@@ -1038,13 +1040,17 @@ key_iter_match(struct vos_obj_iter *oiter, vos_iter_entry_t *ent, daos_anchor_t
  * traverses the tree until a matched item is found.
  */
 static int
-key_iter_match_probe(struct vos_obj_iter *oiter, daos_anchor_t *anchor, uint32_t flags)
+key_iter_match_probe(struct vos_obj_iter *oiter, vos_iter_entry_t *ent, daos_anchor_t *anchor,
+		     uint32_t flags)
 {
 	static __thread vos_iter_entry_t	entry;
 	int					rc;
 
+	/* The caller doesn't need the matched entry */
+	if (ent == NULL)
+		ent = &entry;
 retry:
-	rc = key_iter_match(oiter, &entry, anchor, flags);
+	rc = key_iter_match(oiter, ent, anchor, flags);
 	switch (rc) {
 	default:
 		/** Either there is an error, we aborted the iterator, or
@@ -1084,7 +1090,7 @@ key_iter_probe(struct vos_obj_iter *oiter, daos_anchor_t *anchor, uint32_t flags
 	if (rc)
 		D_GOTO(out, rc);
 
-	rc = key_iter_match_probe(oiter, anchor, flags);
+	rc = key_iter_match_probe(oiter, NULL, anchor, flags);
  out:
 	return rc;
 }
@@ -1098,11 +1104,46 @@ key_iter_next(struct vos_obj_iter *oiter, daos_anchor_t *anchor)
 	if (rc)
 		D_GOTO(out, rc);
 
-	rc = key_iter_match_probe(oiter, anchor, 0);
+	rc = key_iter_match_probe(oiter, NULL, anchor, 0);
 out:
 	return rc;
 }
 
+/**
+ * Moving the cursor already fills the entry of the next matched key, keep it
+ * instead of fetching the key and checking its incarnation log again.
+ */
+static int
+key_iter_fetch_batch(struct vos_obj_iter *oiter, vos_iter_entry_t *ents,
+		     daos_anchor_t *anchors, unsigned int *nr)
+{
+	vos_iter_entry_t	*ent;
+	unsigned int		 i;
+	int			 rc;
+
+	rc = key_iter_fetch(oiter, &ents[0], anchors != NULL ? &anchors[0] : NULL, false, 0);
+	if (rc != 0) {
+		*nr = 0;
+		return rc;
+	}
+
+	for (i = 1; i <= *nr; i++) {
+		rc = dbtree_iter_next(oiter->it_hdl);
+		if (rc != 0)
+			break;
+
+		/* The last move only positions the cursor for the next call */
+		ent = i < *nr ? &ents[i] : NULL;
+		rc = key_iter_match_probe(oiter, ent,
+					  ent != NULL && anchors != NULL ? &anchors[i] : NULL, 0);
+		if (rc != 0)
+			break;
+	}
+	*nr = min(i, *nr);
+
+	return rc;
+}
+
 /**
  * Iterator for the d-key tree.
  */
@@ -1995,6 +2036,23 @@ vos_obj_iter_fetch(struct vos_iterator *iter, vos_iter_entry_t *it_entry,
 	}
 }
 
+static int
+vos_obj_iter_fetch_batch(struct vos_iterator *iter, vos_iter_entry_t *it_entries,
+			 daos_anchor_t *anchors, unsigned int *nr)
+{
+	struct vos_obj_iter *oiter = vos_iter2oiter(iter);
+
+	switch (iter->it_type) {
+	default:
+		/* Use the generic fetch and next */
+		return -DER_NOSYS;
+
+	case VOS_ITER_DKEY:
+	case VOS_ITER_AKEY:
+		return key_iter_fetch_batch(oiter, it_entries, anchors, nr);
+	}
+}
+
 static int
 vos_obj_iter_copy(struct vos_iterator *iter, vos_iter_entry_t *it_entry,
 		  d_iov_t *iov_out)
@@ -2261,6 +2319,7 @@ struct vos_iter_ops	vos_obj_iter_ops = {
 	.iop_probe		= vos_obj_iter_probe,
 	.iop_next		= vos_obj_iter_next,
 	.iop_fetch		= vos_obj_iter_fetch,
+	.iop_fetch_batch	= vos_obj_iter_fetch_batch,
 	.iop_copy		= vos_obj_iter_copy,
 	.iop_process		= vos_obj_iter_process,
 	.iop_empty		= vos_obj_iter_empty,
@@ -12,6 +12,9 @@
 #include <daos_srv/policy.h>
 #include "vos_policy.h"
 
+/* Cold data not accessed for this many seconds is moved to NVMe, 0 to disable */
+unsigned int vos_tier_cold_sec;
+
 /* policy functions definitions */
 
 /* policy based on io size
@@ -59,3 +62,81 @@ vos_policy_media_select(struct vos_pool *pool, daos_iod_type_t type,
 {
 	return vos_policies[pool->vp_policy_desc.policy](pool, type, size);
 }
+
+enum daos_media_type_t
+vos_policy_media_select_cold(struct vos_pool *pool, daos_iod_type_t type,
+			     daos_size_t size)
+{
+	/* Not worth wasting most of a NVMe block for a tiny record */
+	if (pool->vp_vea_info == NULL || size < VOS_POLICY_TIER_MIN)
+		return vos_policy_media_select(pool, type, size, VOS_IOS_AGGREGATION);
+
+	return DAOS_MEDIA_NVME;
+}
+
+/* Access time tracking
+ *
+ * The last access time of objects is kept in a fixed size array indexed by the
+ * hash of object ID, so the tracking costs neither allocation nor lookup on the
+ * I/O path. Objects sharing a slot look as hot as the hottest of them, which only
+ * delays their move to NVMe.
+ */
+static inline uint32_t
+atime_slot(struct vos_container *cont, daos_unit_oid_t oid)
+{
+	uint64_t	key;
+
+	key = oid.id_pub.lo ^ oid.id_pub.hi ^ ((uint64_t)oid.id_shard << 32);
+	key ^= d_hash_string_u32((const char *)cont->vc_id, sizeof(uuid_t));
+
+	return d_hash_mix64(key) & (VOS_POLICY_ATIME_SLOTS - 1);
+}
+
+static inline uint32_t *
+atime_array(struct vos_pool *pool)
+{
+	if (vos_tier_cold_sec == 0 || pool->vp_vea_info == NULL)
+		return NULL;
+
+	if (pool->vp_atime == NULL) {
+		D_ALLOC_ARRAY(pool->vp_atime, VOS_POLICY_ATIME_SLOTS);
+		if (pool->vp_atime == NULL)
+			return NULL;
+		pool->vp_atime_start = daos_gettime_coarse();
+	}
+
+	return pool->vp_atime;
+}
+
+void
+vos_policy_obj_access(struct vos_container *cont, daos_unit_oid_t oid)
+{
+	struct vos_pool	*pool = cont->vc_pool;
+	uint32_t	*atime = atime_array(pool);
+
+	if (atime == NULL)
+		return;
+
+	/* Seconds since the tracking started, 0 for never accessed */
+	atime[atime_slot(cont, oid)] = daos_gettime_coarse() - pool->vp_atime_start + 1;
+}
+
+bool
+vos_policy_obj_cold(struct vos_container *cont, daos_unit_oid_t oid)
+{
+	struct vos_pool	*pool = cont->vc_pool;
+	uint32_t	*atime = atime_array(pool);
+	uint64_t	 now;
+	uint32_t	 last;
+
+	if (atime == NULL)
+		return false;
+
+	/* Not tracked long enough to tell */
+	now = daos_gettime_coarse() - pool->vp_atime_start + 1;
+	if (now <= vos_tier_cold_sec)
+		return false;
+
+	last = atime[atime_slot(cont, oid)];
+	return now - last >= vos_tier_cold_sec;
+}
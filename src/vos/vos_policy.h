@@ -21,8 +21,27 @@
 #define VOS_POLICY_SCM_SHIFT		(12)  /* 4k */
 #define VOS_POLICY_SCM_THRESHOLD	(1ULL << VOS_POLICY_SCM_SHIFT)
 
+/* Cold records smaller than this are kept on SCM */
+#define VOS_POLICY_TIER_MIN		(VOS_BLK_SZ >> 3)	/* 512 bytes */
+
+/* Slots for access time tracking, 64KB per pool */
+#define VOS_POLICY_ATIME_SLOTS		(1U << 14)
+
 enum daos_media_type_t
 vos_policy_media_select(struct vos_pool *pool, daos_iod_type_t type,
 			daos_size_t size, enum vos_io_stream ios);
 
+/* Media for the cold data relocated by aggregation */
+enum daos_media_type_t
+vos_policy_media_select_cold(struct vos_pool *pool, daos_iod_type_t type,
+			     daos_size_t size);
+
+/* Record an access to the object, for telling cold objects */
+void
+vos_policy_obj_access(struct vos_container *cont, daos_unit_oid_t oid);
+
+/* Is the object not accessed for vos_tier_cold_sec seconds? */
+bool
+vos_policy_obj_cold(struct vos_container *cont, daos_unit_oid_t oid);
+
 #endif /* __VOS_POLICY_H__ */
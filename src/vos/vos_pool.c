@@ -154,10 +154,15 @@ pool_hop_free(struct d_ulink *hlink)
 			D_DEBUG(DB_MGMT, "Unlocked VOS pool memory: "DF_U64" bytes at "DF_X64"\n",
 				pool->vp_size, pool->vp_umm.umm_base);
 	}
-	if (pool->vp_uma.uma_pool)
+	if (pool->vp_uma.uma_pool) {
+		/* Cached ilog roots point into the mapping that goes away */
+		ilog_cache_flush();
 		vos_pmemobj_close(pool->vp_uma.uma_pool);
+	}
 
 	vos_dedup_fini(pool);
+	vos_dirty_fini(pool);
+	D_FREE(pool->vp_atime);
 
 	if (pool->vp_dying)
 		vos_delete_blob(pool->vp_id);
@@ -25,6 +25,7 @@
 /* Forward declarations */
 struct vos_ts_table;
 struct dtx_handle;
+struct ilog_status_cache;
 
 /** VOS thread local storage structure */
 struct vos_tls {
@@ -53,6 +54,8 @@ struct vos_tls {
 	struct daos_profile		*vtl_dp;
 	/** In-memory object cache for the PMEM object table */
 	struct daos_lru_cache		*vtl_ocache;
+	/** Resolved status of incarnation log entries for hot keys */
+	struct ilog_status_cache	*vtl_ilog_cache;
 	/** pool open handle hash table */
 	struct d_hash_table		*vtl_pool_hhash;
 	/** container open handle hash table */
@@ -990,7 +990,7 @@ class DaosServer():
         return self.test_pool
 
 
-def il_cmd(dfuse, cmd, check_read=True, check_write=True, check_fstat=True):
+def il_cmd(dfuse, cmd, check_read=True, check_write=True, check_fstat=True, env=None):
     """Run a command under the interception library
 
     Do not run valgrind here, not because it's not useful
@@ -998,6 +998,8 @@ def il_cmd(dfuse, cmd, check_read=True, check_write=True, check_fstat=True):
     linking differently so some memory is wrongly lost that
     would be freed in the _fini() function, and a lot of
     commands do not free all memory anyway.
+
+    Additional environment variables for the command can be passed in env.
     """
     my_env = get_base_env()
     prefix = f'dnt_dfuse_il_{get_inc_id()}_'
@@ -1008,6 +1010,8 @@ def il_cmd(dfuse, cmd, check_read=True, check_write=True, check_fstat=True):
     # pylint: disable=protected-access
     my_env['DAOS_AGENT_DRPC_DIR'] = dfuse._daos.agent_dir
     my_env['D_IL_REPORT'] = '2'
+    if env:
+        my_env.update(env)
     ret = subprocess.run(cmd, env=my_env, check=False)
     print(f'Logged il to {log_name}')
     print(ret)
@@ -1977,6 +1981,41 @@ class PosixTests():
         assert files == files2
         assert len(files) == count
 
+    @needs_dfuse
+    def test_readdir_cache(self):
+        """Test that local changes are visible through the dfuse directory listing cache.
+
+        List a directory so the listing is cached, then add entries of each type and re-list,
+        the new entries should be reported immediately.
+        """
+        test_dir = join(self.dfuse.dir, 'test_dir')
+        os.mkdir(test_dir)
+        count = 10
+        for idx in range(count):
+            with open(join(test_dir, f'file_{idx}'), 'w'):
+                pass
+
+        files = os.listdir(test_dir)
+        assert len(files) == count
+
+        os.mkdir(join(test_dir, 'new_dir'))
+        os.symlink('file_0', join(test_dir, 'new_link'))
+        os.mknod(join(test_dir, 'new_file'))
+
+        post_files = os.listdir(test_dir)
+        print(files)
+        print(post_files)
+        assert len(post_files) == count + 3
+        for fname in ('new_dir', 'new_link', 'new_file'):
+            assert fname in post_files
+
+        with open(join(test_dir, 'file_1'), 'w') as fd:
+            fd.write('test')
+        with os.scandir(test_dir) as entries:
+            for entry in entries:
+                if entry.name == 'file_1':
+                    assert entry.stat().st_size == 4
+
     @needs_dfuse
     def test_readdir_unlink(self):
         """Test readdir where a entry is removed mid read
@@ -2170,6 +2209,46 @@ class PosixTests():
                      check_fstat=False)
         assert ret.returncode == 0
 
+    @needs_dfuse_with_opt(caching=False)
+    def test_il_buffered(self):
+        """Read and write through the interception library with read-ahead and write-behind
+
+        Use requests smaller than the windows so reads are served from read-ahead and writes
+        are held behind, then check the data is flushed on fsync and close.
+        """
+        buf_env = {'D_IL_READAHEAD': str(64 * 1024), 'D_IL_WRITEBEHIND': str(64 * 1024)}
+
+        src_file = join(self.dfuse.dir, 'il_buf_src')
+        data = os.urandom(1024 * 1024 + 100)
+        with open(src_file, 'wb') as fd:
+            fd.write(data)
+
+        def _check_data(fname):
+            with open(fname, 'rb') as fd:
+                assert fd.read() == data
+
+        # Sequential read via read-ahead, and write-behind flushed on close.
+        dst_file = join(self.dfuse.dir, 'il_buf_dst')
+        ret = il_cmd(self.dfuse, ['dd', f'if={src_file}', f'of={dst_file}', 'bs=4k'],
+                     check_fstat=False, env=buf_env)
+        assert ret.returncode == 0
+        _check_data(dst_file)
+
+        # Read back what was written behind.
+        with tempfile.NamedTemporaryFile(prefix='dnt_il_buf_') as local_file:
+            ret = il_cmd(self.dfuse, ['dd', f'if={dst_file}', f'of={local_file.name}', 'bs=4k'],
+                         check_write=False, check_fstat=False, env=buf_env)
+            assert ret.returncode == 0
+            _check_data(local_file.name)
+
+        # Write-behind flushed on fsync, with writes that are not a multiple of the window.
+        sync_file = join(self.dfuse.dir, 'il_buf_sync')
+        ret = il_cmd(self.dfuse,
+                     ['dd', f'if={src_file}', f'of={sync_file}', 'bs=3000', 'conv=fsync'],
+                     check_fstat=False, env=buf_env)
+        assert ret.returncode == 0
+        _check_data(sync_file)
+
     @needs_dfuse
     def test_xattr(self):
         """Perform basic tests with extended attributes"""
@@ -4253,6 +4332,8 @@ class AllocFailTest():
         self.check_daos_stderr = False
         self.expected_stdout = None
         self.use_il = False
+        # Additional environment for the command.
+        self.env = {}
         self.wf = conf.wf
         # Instruct the fault injection code to skip daos_init().
         self.skip_daos_init = True
@@ -4356,6 +4437,8 @@ class AllocFailTest():
         if self.use_il:
             cmd_env['LD_PRELOAD'] = join(self.conf['PREFIX'], 'lib64', 'libioil.so')
 
+        cmd_env.update(self.env)
+
         cmd_env['DAOS_AGENT_DRPC_DIR'] = self.conf.agent_dir
 
         if callable(self.cmd):
@@ -4526,6 +4609,40 @@ def test_alloc_fail_cat(server, conf):
     return rc
 
 
+def test_alloc_fail_il_buffered(server, conf):
+    """Run the Interception library with read-ahead and write-behind under fault injection
+
+    Copy a file in small blocks and fsync it, so faults in the read-ahead and write-behind
+    paths have to be reported by read, write, fsync or close.
+    """
+    pool = server.get_test_pool_obj()
+    container = create_cont(conf, pool, ctype='POSIX', label='il_buf')
+
+    dfuse = DFuse(server, conf, container=container)
+    dfuse.use_valgrind = False
+    dfuse.start()
+
+    src_file = join(dfuse.dir, 'src_file')
+
+    with open(src_file, 'wb') as fd:
+        fd.write(os.urandom(64 * 1024))
+
+    def get_cmd(loc):
+        return ['dd', f'if={src_file}', f'of={join(dfuse.dir, f"test_{loc}")}', 'bs=4k',
+                'conv=fsync', 'status=none']
+
+    test_cmd = AllocFailTest(conf, 'il-buffered', get_cmd)
+    test_cmd.use_il = True
+    test_cmd.env = {'D_IL_READAHEAD': str(16 * 1024), 'D_IL_WRITEBEHIND': str(16 * 1024)}
+    test_cmd.check_stderr = False
+    test_cmd.wf = conf.wf
+
+    rc = test_cmd.launch()
+    dfuse.stop()
+    container.destroy()
+    return rc
+
+
 def test_alloc_fail_il_cp(server, conf):
     """Run the Interception library with fault injection
 
@@ -4822,6 +4939,9 @@ def run(wf, args):
                 # Copy (read/write) via IL, requires dfuse.
                 fatal_errors.add_result(test_alloc_fail_il_cp(server, conf))
 
+                # Copy via IL with read-ahead and write-behind, requires dfuse.
+                fatal_errors.add_result(test_alloc_fail_il_buffered(server, conf))
+
             if args.perf_check:
                 check_readdir_perf(server, conf)
 
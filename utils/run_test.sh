@@ -250,6 +250,7 @@ if [ -d "/mnt/daos" ]; then
     run_test "${SL_BUILD_DIR}/src/engine/tests/drpc_progress_tests"
     run_test "${SL_BUILD_DIR}/src/engine/tests/drpc_handler_tests"
     run_test "${SL_BUILD_DIR}/src/engine/tests/drpc_listener_tests"
+    run_test "${SL_BUILD_DIR}/src/engine/tests/sched_tests"
 
     COMP="UTEST_mgmt"
     run_test "${SL_BUILD_DIR}/src/mgmt/tests/srv_drpc_tests"